@@ -16,6 +16,10 @@ Usage:
     python3 ai_toolchain.py --frames N           # Capture N frames
     python3 ai_toolchain.py --screenshot         # Use screenshot method
     python3 ai_toolchain.py --loop <dir> [N]     # Full dev cycle
+    python3 ai_toolchain.py --save-replay F      # Save the input log
+    python3 ai_toolchain.py --replay F --loop <dir>  # Play it back
+    python3 ai_toolchain.py --project pacman --var score --var lives
+    python3 ai_toolchain.py --project pong --watch-var score1 --hits 3
 
 For AI Integration:
     The script provides visual feedback through ASCII/color representation
@@ -31,8 +35,11 @@ import sys
 import os
 import subprocess
 import argparse
+import re
 from pathlib import Path
 
+from symbols import SymbolDB
+
 try:
     from PIL import Image
     HAS_PIL = True
@@ -116,6 +123,39 @@ def send_command(s, cmd):
         return ""
 
 
+MEM_LINE = re.compile(r'>C:([0-9a-fA-F]{4})((?: {1,2}[0-9a-fA-F]{2}(?= |$))+)')
+
+
+def monitor_batch(s, commands, timeout=2.0):
+    """
+    Send monitor commands in one write and read until each has printed
+    its "(C:$xxxx)" prompt, so no reply is left over for the next call.
+    commands is a list, or one command as a string. Returns the replies,
+    or "" when they were not all there within timeout seconds.
+    """
+    if isinstance(commands, str):
+        commands = [commands]
+    blocking = s.gettimeout()
+    s.settimeout(0.1)
+    try:
+        s.sendall(''.join(f"{c}\n" for c in commands).encode())
+        data = b""
+        deadline = time.time() + timeout
+        while data.count(b"(C:$") < len(commands):
+            if time.time() > deadline:
+                return ""
+            try:
+                chunk = s.recv(65536)
+            except socket.timeout:
+                continue
+            if not chunk:
+                return ""
+            data += chunk
+    finally:
+        s.settimeout(blocking)
+    return data.decode(errors='replace')
+
+
 # =============================================================================
 # Screen RAM Reading (Direct Memory Access)
 # =============================================================================
@@ -217,8 +257,16 @@ def get_sprite_data(s):
     return sprites
 
 
-def get_game_vars(s):
-    """Read common game variables from zero page."""
+def get_game_vars(s, db=None, names=('head_x', 'head_y')):
+    """
+    Read game variables by name (symbols.py), in one monitor request.
+
+    Without symbols for the names, falls back to snake's head_x/head_y
+    at $02/$03.
+    """
+    if db is not None and any(n in db for n in names):
+        return read_vars(s, db, [n for n in names if n in db])
+
     response = send_command(s, "m 0002 000f")
     
     vars = {}
@@ -240,6 +288,149 @@ def get_game_vars(s):
     return vars
 
 
+def read_memory(s, start, end):
+    """Read bytes start..end (inclusive) through the monitor."""
+    response = monitor_batch(s, f"m {start:04x} {end:04x}")
+
+    data = bytearray(end - start + 1)
+    for line in response.splitlines():
+        m = MEM_LINE.search(line)
+        if m:
+            offset = int(m.group(1), 16) - start
+            for p in m.group(2).split():
+                if 0 <= offset < len(data):
+                    data[offset] = int(p, 16)
+                offset += 1
+    return bytes(data)
+
+
+def write_memory(s, addr, data, chunk=16):
+    """Write bytes at addr through the monitor ('>' commands, one batch)."""
+    return monitor_batch(s, [f"> {addr + i:04x} " + ' '.join(f"{b:02x}" for b in data[i:i + chunk])
+                             for i in range(0, len(data), chunk)],
+                         timeout=5.0)
+
+
+# =============================================================================
+# Symbols - Variables and watchpoints by name (symbols.py)
+# =============================================================================
+
+def read_vars(s, db, names):
+    """
+    Values of named variables ("score", "ghost_x[2]", "lives+1").
+
+    One "m" command per variable, all sent at once. One-byte variables
+    come back as int, two-byte ones as a little-endian word, longer ones
+    as a list of bytes.
+    """
+    spans = {name: db.resolve(name) for name in names}
+    response = monitor_batch(s, [f"m {a:04x} {a + n - 1:04x}"
+                                 for a, n in spans.values()])
+    mem = {}
+    for line in response.splitlines():
+        m = MEM_LINE.search(line)
+        if m:
+            addr = int(m.group(1), 16)
+            for i, p in enumerate(m.group(2).split()):
+                mem[addr + i] = int(p, 16)
+
+    values = {}
+    for name, (addr, size) in spans.items():
+        data = [mem.get(a, 0) for a in range(addr, addr + size)]
+        values[name] = (data[0] if size == 1 else
+                        data[0] | data[1] << 8 if size == 2 else data)
+    return values
+
+
+def watch_var(s, db, name, hits=5, timeout=10.0):
+    """
+    Stop on each write to a named variable and print its new value.
+
+    Sets a store watchpoint over the variable, resumes, and reports the
+    PC and value at each of the first hits stops; the watchpoint is
+    deleted again afterwards.
+    """
+    addr, size = db.resolve(name)
+    reply = monitor_batch(s, [f"watch store {addr:04x} {addr + size - 1:04x}"])
+    m = re.search(r'WATCH:\s*(\d+)', reply)
+    if not m:
+        print(f"✗ Could not set a watchpoint on {name}: {reply.strip()}")
+        return False
+    number = m.group(1)
+    print(f"Watching {name} (${addr:04X}, {size} byte{'s' * (size > 1)})")
+
+    for hit in range(1, hits + 1):
+        s.sendall(b"x\n")
+        data = b""
+        deadline = time.time() + timeout
+        while time.time() < deadline:
+            try:
+                chunk = s.recv(4096)
+            except socket.timeout:
+                continue
+            if not chunk:
+                break
+            data += chunk
+            if b"Stop on" in data and data.rstrip().endswith(b")"):
+                break
+        text = data.decode(errors='replace')
+        if "Stop on" not in text:
+            print(f"  no write in {timeout:.0f}s")
+            break
+        pc = re.search(r'\.C:([0-9a-fA-F]{4})', text)
+        where = ''
+        if pc:
+            pc = int(pc.group(1), 16)
+            where = f" at ${pc:04X} ({db.name_at(pc)})"
+        print(f"  #{hit}: {name} = {read_vars(s, db, [name])[name]}{where}")
+
+    monitor_batch(s, [f"del {number}"])
+    return True
+
+
+# =============================================================================
+# Replay Logs (common/replay.s)
+# =============================================================================
+
+REPLAY_BASE = 0xC000
+REPLAY_TOP = 0xC800
+REPLAY_HEADER = 16
+REPLAY_MAGIC = b"RPLY"
+REPLAY_PLAY = 2
+
+
+def save_replay(s, path):
+    """Save the game's input log (header + used entries) to a file."""
+    header = read_memory(s, REPLAY_BASE, REPLAY_BASE + REPLAY_HEADER - 1)
+    if header[:4] != REPLAY_MAGIC:
+        return False, "No replay log at $C000 (game not linked with replay.s?)"
+    used = header[8] | (header[9] << 8)
+    frames = header[10] | (header[11] << 8)
+    if used > REPLAY_TOP - REPLAY_BASE - REPLAY_HEADER:
+        return False, f"Bad replay log length {used}"
+    log = b""
+    if used:
+        log = read_memory(s, REPLAY_BASE + REPLAY_HEADER,
+                          REPLAY_BASE + REPLAY_HEADER + used - 1)
+    with open(path, 'wb') as f:
+        f.write(header + log)
+    seed = header[6] | (header[7] << 8)
+    return True, f"Saved {frames} frames ({used} bytes, seed ${seed:04X}) to {path}"
+
+
+def load_replay(path):
+    """Replay file as (address, bytes) to write before RUN, in play mode."""
+    with open(path, 'rb') as f:
+        data = bytearray(f.read())
+    if data[:4] != REPLAY_MAGIC or len(data) < REPLAY_HEADER:
+        raise ValueError(f"{path} is not a replay log")
+    if len(data) > REPLAY_TOP - REPLAY_BASE:
+        raise ValueError(f"{path} does not fit below $C800")
+    data[4] = REPLAY_PLAY
+    data[10:15] = bytes(5)      # frames, hold frame, held flag
+    return (REPLAY_BASE, bytes(data))
+
+
 # =============================================================================
 # Screen Display
 # =============================================================================
@@ -382,8 +573,12 @@ def start_vice(project_dir, prg_file=None):
         return False
 
 
-def reload_program(project_dir, prg_file=None):
-    """Reload program in running VICE."""
+def reload_program(project_dir, prg_file=None, preload=None):
+    """Reload program in running VICE.
+
+    preload: optional (address, bytes) written after loading, before RUN
+    (e.g. a replay log from load_replay()).
+    """
     if prg_file is None:
         prg_files = list(Path(project_dir).glob('*.prg'))
         if not prg_files:
@@ -403,6 +598,9 @@ def reload_program(project_dir, prg_file=None):
         
         sock.sendall(f'l "{prg_path}" 0\n'.encode())
         time.sleep(0.5)
+
+        if preload:
+            write_memory(sock, *preload)
         
         sock.sendall(b"g 0810\n")
         time.sleep(0.3)
@@ -418,7 +616,8 @@ def reload_program(project_dir, prg_file=None):
 # AI Development Loop
 # =============================================================================
 
-def development_loop(project_dir, iterations=1, use_screenshot=False):
+def development_loop(project_dir, iterations=1, use_screenshot=False,
+                     replay=None):
     """
     Run the AI development feedback loop.
     
@@ -427,7 +626,12 @@ def development_loop(project_dir, iterations=1, use_screenshot=False):
     2. Run/reload in VICE
     3. Capture visual state
     4. Return analysis for AI to process
+
+    With replay (a file from --save-replay) every run plays the same
+    input and seed, so captures are comparable across builds.
     """
+    preload = load_replay(replay) if replay else None
+
     print(f"\n{'='*60}")
     print(f"AI Development Loop - {iterations} iteration(s)")
     print(f"Project: {project_dir}")
@@ -447,10 +651,12 @@ def development_loop(project_dir, iterations=1, use_screenshot=False):
         # Run/Reload
         if check_vice_running():
             print("Reloading in VICE...")
-            reload_program(project_dir)
+            reload_program(project_dir, preload=preload)
         else:
             print("Starting VICE...")
             start_vice(project_dir)
+            if preload:
+                reload_program(project_dir, preload=preload)
         
         # Wait for game to initialize
         print("Waiting for game to start...")
@@ -469,7 +675,7 @@ def development_loop(project_dir, iterations=1, use_screenshot=False):
         else:
             s = connect_vice()
             if s:
-                vars = get_game_vars(s)
+                vars = get_game_vars(s, SymbolDB.for_project(project_dir))
                 screen_data = get_screen(s)
                 color_data = get_color_ram(s)
                 sprites = get_sprite_data(s)
@@ -505,6 +711,10 @@ Modes:
   --frames N        Capture N frames
   --screenshot      Use screenshot method (shows sprites)
   --loop DIR [N]    Full build/run/capture cycle
+  --save-replay F   Save the running game's input log (common/replay.s)
+  --replay F        With --loop: play input log F back on every run
+  --var NAME        Print variables by name (symbols of --project)
+  --watch-var NAME  Stop on writes to a variable, print each new value
 
 Examples:
   %(prog)s                           # Monitor screen RAM
@@ -524,14 +734,62 @@ AI Feedback Loop:
     parser.add_argument('--loop', metavar='DIR', help='Development loop')
     parser.add_argument('--iterations', '-n', type=int, default=1, help='Loop iterations')
     parser.add_argument('--no-color', action='store_true', help='Disable colors')
+    parser.add_argument('--save-replay', metavar='FILE', help='Save input log')
+    parser.add_argument('--replay', metavar='FILE', help='Play input log back')
+    parser.add_argument('--project', metavar='DIR',
+                        help='Symbols from this project (default: last build.sh)')
+    parser.add_argument('--var', action='append', metavar='NAME',
+                        help='Read variable by name (repeatable)')
+    parser.add_argument('--watch-var', metavar='NAME',
+                        help='Watch writes to a variable')
+    parser.add_argument('--hits', type=int, default=5,
+                        help='Writes to report with --watch-var')
     
     args = parser.parse_args()
     
     # Development loop mode
     if args.loop:
-        development_loop(args.loop, args.iterations, args.screenshot)
+        development_loop(args.loop, args.iterations, args.screenshot,
+                         args.replay)
         return 0
+
+    # Save the input log of the last run
+    if args.save_replay:
+        s = connect_vice()
+        if not s:
+            print("Could not connect to VICE.")
+            return 1
+        ok, msg = save_replay(s, args.save_replay)
+        s.send(b"x\n")  # Resume
+        s.close()
+        print(msg)
+        return 0 if ok else 1
     
+    # Variables and watchpoints by name
+    db = SymbolDB.for_project(args.project)
+    if args.var or args.watch_var:
+        if db is None:
+            print(f"No symbols for {args.project or 'the last build'}: build first.")
+            return 1
+        for name in (args.var or []) + [args.watch_var] * bool(args.watch_var):
+            try:
+                db.resolve(name)
+            except KeyError:
+                print(f"✗ Unknown symbol: {name}")
+                return 1
+        s = connect_vice()
+        if not s:
+            print("Could not connect to VICE.")
+            return 1
+        if args.var:
+            for name, value in read_vars(s, db, args.var).items():
+                addr, _ = db.resolve(name)
+                print(f"{name} = {value}  (${addr:04X})")
+        ok = watch_var(s, db, args.watch_var, args.hits) if args.watch_var else True
+        s.send(b"x\n")  # Resume
+        s.close()
+        return 0 if ok else 1
+
     # Screenshot mode
     if args.screenshot:
         if not check_vice_running():
@@ -549,7 +807,7 @@ AI Feedback Loop:
     
     frames = 0
     while True:
-        game_vars = get_game_vars(s)
+        game_vars = get_game_vars(s, db)
         screen = get_screen(s)
         color = get_color_ram(s)
         sprites = get_sprite_data(s)
@@ -12,13 +12,20 @@
 #include <stdlib.h>
 #include <joystick.h>
 
+#include "sprmove.h"
+#include "shadow.h"
+#include "sfx.h"
+#include "replay.h"
+#include "level.h"
+#include "levels.h"
+
 /* ── Screen Dimensions ────────────────────────────────── */
 #define SCREEN_WIDTH   40
 #define SCREEN_HEIGHT  25
 
 /* ── Play-field (character coordinates) ───────────────── */
 #define FIELD_LEFT      1   /* left wall column */
-#define FIELD_RIGHT    27   /* right wall column (keeps sprite X<255) */
+#define FIELD_RIGHT    27   /* right wall column (HUD panel beyond) */
 #define FIELD_TOP       2   /* top wall row */
 #define FIELD_BOTTOM   24   /* bottom (death) row */
 #define FIELD_W        (FIELD_RIGHT - FIELD_LEFT - 1)  /* 25 usable cols */
@@ -48,18 +55,16 @@
 #define VIC_SPR_DBL_Y   (*(unsigned char*)0xD017)
 
 /* Sprite 0 = paddle, Sprite 1 = ball */
-#define SPR0_X  (*(unsigned char*)0xD000)
-#define SPR0_Y  (*(unsigned char*)0xD001)
-#define SPR1_X  (*(unsigned char*)0xD002)
-#define SPR1_Y  (*(unsigned char*)0xD003)
+#define SPR_PADDLE  0
+#define SPR_BALL    1
 
 #define SPR0_COL (*(unsigned char*)0xD027)
 #define SPR1_COL (*(unsigned char*)0xD028)
 
-/* Sprite-background collision register */
-#define VIC_SPR_BG_COLL  (*(unsigned char*)0xD01F)
-/* Sprite-sprite  collision register */
-#define VIC_SPR_SPR_COLL (*(unsigned char*)0xD01E)
+/* Collision bits from the raster IRQ's latches of $D01E/$D01F
+ * (shd_coll_spr / shd_coll_bg): ball on paddle, ball on a brick/wall */
+#define COLL_PADDLE  ((1 << SPR_PADDLE) | (1 << SPR_BALL))
+#define COLL_BALL    (1 << SPR_BALL)
 
 /* Coordinate helpers:  screen char → sprite pixel */
 #define SPRITE_X_OFS  24   /* hardware X offset */
@@ -67,23 +72,6 @@
 #define CHAR2SPR_X(c) (SPRITE_X_OFS + (c) * 8)
 #define CHAR2SPR_Y(r) (SPRITE_Y_OFS + (r) * 8)
 
-/* ── SID registers ────────────────────────────────────── */
-#define SID_V1_FREQ_LO  (*(unsigned char*)0xD400)
-#define SID_V1_FREQ_HI  (*(unsigned char*)0xD401)
-#define SID_V1_PW_LO    (*(unsigned char*)0xD402)
-#define SID_V1_PW_HI    (*(unsigned char*)0xD403)
-#define SID_V1_CTRL     (*(unsigned char*)0xD404)
-#define SID_V1_AD       (*(unsigned char*)0xD405)
-#define SID_V1_SR       (*(unsigned char*)0xD406)
-
-#define SID_V2_FREQ_LO  (*(unsigned char*)0xD407)
-#define SID_V2_FREQ_HI  (*(unsigned char*)0xD408)
-#define SID_V2_CTRL     (*(unsigned char*)0xD40B)
-#define SID_V2_AD       (*(unsigned char*)0xD40C)
-#define SID_V2_SR       (*(unsigned char*)0xD40D)
-
-#define SID_VOLUME       (*(unsigned char*)0xD418)
-
 /* ── Colors ───────────────────────────────────────────── */
 #define BLACK    0
 #define WHITE    1
@@ -121,12 +109,9 @@
 #define DIR_LEFT  1
 #define DIR_RIGHT 2
 
-/* ── Fixed-point ball position (8.8) ──────────────────── */
-/* We use 16-bit values: hi byte = pixel, lo byte = fraction */
-static unsigned int ball_x;  /* 8.8 fixed point */
-static unsigned int ball_y;
-static int ball_dx;           /* signed 8.8 velocity */
-static int ball_dy;
+/* ── Ball ─────────────────────────────────────────────── */
+/* Position and 8.8 velocity live in the shared sprite motion
+ * module: spr_x/spr_xf, spr_y/spr_yf, spr_dx/spr_dy[SPR_BALL] */
 
 /* ── Paddle ───────────────────────────────────────────── */
 #define PADDLE_Y_CHAR   22            /* paddle row in char coords */
@@ -150,8 +135,12 @@ static unsigned char bricks_left;
 static unsigned char game_state;
 static unsigned char demo_mode;
 static unsigned char frame_count;
-static unsigned char sound_timer;
+static unsigned char state_timer;     /* frames left in a timed state */
 static unsigned char bricks[BRICK_ROWS][BRICK_COLS]; /* 0=gone, 1+=hp */
+/* Ball's cell in the last two frames, newest first: the frames the
+ * collision latch describes (0xFF = none) */
+static unsigned char hist_cx[2], hist_cy[2];
+static unsigned char coll_skip;       /* latches still from before a hit */
 
 /* Brick row colors per level (cycling palette) */
 static const unsigned char brick_colors[5] = {
@@ -205,64 +194,42 @@ static void init_sprite_data(void) {
  *  SOUND
  * ================================================================ */
 
-static void init_sound(void) {
-    SID_VOLUME = 15;
-    SID_V1_AD  = 0x00;   /* instant attack, no decay */
-    SID_V1_SR  = 0xA0;   /* sustain medium, fast release */
-    SID_V2_AD  = 0x09;   /* short attack+decay for bounce */
-    SID_V2_SR  = 0x00;
-}
+/* Effects for the IRQ player: header, steps, terminator (see sfx.h) */
 
 /* Short high-pitched "tink" for wall bounce */
-static void sound_bounce(void) {
-    SID_V1_FREQ_LO = 0x00;
-    SID_V1_FREQ_HI = 0x30;
-    SID_V1_CTRL    = 0x81; /* noise, gate on */
-    sound_timer = 3;
-}
+static const unsigned char fx_bounce[] = {
+    SFX_V1, 1, 0x00, 0xA0,
+    SFX_STEP(3, 0x81, 0x3000, 0, 0x08),    /* noise */
+    SFX_END
+};
 
 /* Medium "thud" for paddle hit */
-static void sound_paddle(void) {
-    SID_V1_FREQ_LO = 0x00;
-    SID_V1_FREQ_HI = 0x18;
-    SID_V1_CTRL    = 0x21; /* sawtooth, gate on */
-    sound_timer = 4;
-}
+static const unsigned char fx_paddle[] = {
+    SFX_V1, 1, 0x00, 0xA0,
+    SFX_STEP(4, 0x21, 0x1800, 0, 0x08),    /* sawtooth */
+    SFX_END
+};
 
 /* Satisfying "pop" for brick break */
-static void sound_brick(void) {
-    SID_V2_FREQ_LO = 0x00;
-    SID_V2_FREQ_HI = 0x28;
-    SID_V2_CTRL    = 0x11; /* triangle, gate on */
-    sound_timer = 5;
-}
+static const unsigned char fx_brick[] = {
+    SFX_V2, 1, 0x09, 0x00,                 /* short attack+decay */
+    SFX_STEP(5, 0x11, 0x2800, 0, 0x08),    /* triangle */
+    SFX_END
+};
 
 /* Descending death tone */
-static void sound_die(void) {
-    unsigned char i;
-    for (i = 0x30; i > 0x05; i -= 2) {
-        SID_V1_FREQ_HI = i;
-        SID_V1_CTRL = 0x21;
-        waitvsync();
-    }
-    SID_V1_CTRL = 0x20;
-}
+static const unsigned char fx_die[] = {
+    SFX_V1, 3, 0x00, 0xA0,
+    SFX_STEP(22, 0x21, 0x3000, -2, 0x08),
+    SFX_END
+};
 
 /* Ascending victory jingle */
-static void sound_win(void) {
-    unsigned char i;
-    for (i = 0x10; i < 0x40; i += 3) {
-        SID_V1_FREQ_HI = i;
-        SID_V1_CTRL = 0x11;
-        waitvsync();
-    }
-    SID_V1_CTRL = 0x10;
-}
-
-static void sound_off(void) {
-    SID_V1_CTRL = 0x00;
-    SID_V2_CTRL = 0x00;
-}
+static const unsigned char fx_win[] = {
+    SFX_V1, 3, 0x00, 0xA0,
+    SFX_STEP(16, 0x11, 0x1000, 3, 0x08),
+    SFX_END
+};
 
 /* ================================================================
  *  DRAWING
@@ -295,79 +262,63 @@ static void draw_border(void) {
     }
 }
 
-/* Draw bricks from the array */
-static void draw_bricks(void) {
-    unsigned char *scr = (unsigned char*)0x0400;
-    unsigned char *col = (unsigned char*)0xD800;
-    unsigned char r, c, k;
-    unsigned int pos;
-    unsigned char color;
-
-    bricks_left = 0;
-
-    for (r = 0; r < BRICK_ROWS; ++r) {
-        for (c = 0; c < BRICK_COLS; ++c) {
-            pos = (unsigned int)(BRICK_START_Y + r) * 40
-                + (BRICK_START_X + c * BRICK_CHAR_W);
-
-            if (bricks[r][c] > 0) {
-                ++bricks_left;
-                /* Color based on hit-points (multi-hit) or row color */
-                if (bricks[r][c] > 1) {
-                    color = hp_colors[bricks[r][c] - 1];
-                } else {
-                    color = brick_colors[r % 5];
-                }
-                for (k = 0; k < BRICK_CHAR_W; ++k) {
-                    scr[pos + k] = CHAR_BRICK;
-                    col[pos + k] = color;
-                }
-            } else {
-                for (k = 0; k < BRICK_CHAR_W; ++k) {
-                    scr[pos + k] = CHAR_SPACE;
-                    col[pos + k] = BLACK;
-                }
-            }
-        }
-    }
-}
+/* Bricks to redraw, one bit per column (bit c = column c). Hits and
+ * level loads only mark bricks here; flush_bricks() draws a few per
+ * frame, so a whole new wall builds up over a handful of frames
+ * instead of stalling one. */
+static unsigned char brick_dirty[BRICK_ROWS];
 
-/* Erase a single brick visually */
-static void erase_brick(unsigned char r, unsigned char c) {
-    unsigned char *scr = (unsigned char*)0x0400;
-    unsigned char *col = (unsigned char*)0xD800;
-    unsigned int pos;
-    unsigned char k;
+#define BRICK_FLUSH     8   /* bricks drawn per frame, at most */
 
-    pos = (unsigned int)(BRICK_START_Y + r) * 40
-        + (BRICK_START_X + c * BRICK_CHAR_W);
-    for (k = 0; k < BRICK_CHAR_W; ++k) {
-        scr[pos + k] = CHAR_SPACE;
-        col[pos + k] = BLACK;
-    }
+static void mark_brick(unsigned char r, unsigned char c) {
+    brick_dirty[r] |= (unsigned char)(1 << c);
 }
 
-/* Redraw a single brick (when damaged but not destroyed) */
-static void redraw_brick(unsigned char r, unsigned char c) {
+/* Draw one brick as its hit points say: gone, row colour or hp colour */
+static void draw_brick(unsigned char r, unsigned char c) {
     unsigned char *scr = (unsigned char*)0x0400;
     unsigned char *col = (unsigned char*)0xD800;
     unsigned int pos;
-    unsigned char k, color;
+    unsigned char k, chr, color;
 
     pos = (unsigned int)(BRICK_START_Y + r) * 40
         + (BRICK_START_X + c * BRICK_CHAR_W);
 
-    if (bricks[r][c] > 1) {
-        color = hp_colors[bricks[r][c] - 1];
+    if (bricks[r][c] == 0) {
+        chr = CHAR_SPACE;
+        color = BLACK;
     } else {
-        color = brick_colors[r % 5];
+        chr = CHAR_BRICK;
+        /* Color based on hit-points (multi-hit) or row color */
+        if (bricks[r][c] > 1) {
+            color = hp_colors[bricks[r][c] - 1];
+        } else {
+            color = brick_colors[r % 5];
+        }
     }
     for (k = 0; k < BRICK_CHAR_W; ++k) {
-        scr[pos + k] = CHAR_BRICK;
+        scr[pos + k] = chr;
         col[pos + k] = color;
     }
 }
 
+/* Draw up to BRICK_FLUSH marked bricks; once a frame */
+static void flush_bricks(void) {
+    unsigned char r, c, bit;
+    unsigned char n = BRICK_FLUSH;
+
+    for (r = 0; r < BRICK_ROWS; ++r) {
+        if (brick_dirty[r] == 0) continue;
+        for (c = 0, bit = 1; c < BRICK_COLS; ++c, bit <<= 1) {
+            if (brick_dirty[r] & bit) {
+                brick_dirty[r] &= ~bit;
+                draw_brick(r, c);
+                if (--n == 0) return;
+            }
+        }
+    }
+}
+
 static void draw_hud(void) {
     gotoxy(0, 0);
     textcolor(WHITE);
@@ -421,30 +372,12 @@ static void draw_hud(void) {
  *  LEVEL GENERATION
  * ================================================================ */
 
-static void generate_level(void) {
-    unsigned char r, c;
-
-    for (r = 0; r < BRICK_ROWS; ++r) {
-        for (c = 0; c < BRICK_COLS; ++c) {
-            if (level == 1) {
-                /* Level 1: all single-hit */
-                bricks[r][c] = 1;
-            } else if (level == 2) {
-                /* Level 2: top row 2-hit */
-                bricks[r][c] = (r == 0) ? 2 : 1;
-            } else if (level == 3) {
-                /* Level 3: checkerboard 2-hit */
-                bricks[r][c] = ((r + c) & 1) ? 2 : 1;
-            } else if (level == 4) {
-                /* Level 4: gradient – top rows harder */
-                bricks[r][c] = (unsigned char)(BRICK_ROWS - r);
-                if (bricks[r][c] > 3) bricks[r][c] = 3;
-            } else {
-                /* Level 5+: all 2-hit with random 3-hit */
-                bricks[r][c] = ((rand() & 3) == 0) ? 3 : 2;
-            }
-        }
-    }
+/* Unpack this level's wall from the bank (levelgen.py, levels.h) and
+ * mark every brick for redraw; the bank repeats after LEVEL_COUNT */
+static void load_level(void) {
+    bricks_left = lv_unpack(&bricks[0][0],
+        level_bank + (level - 1) % LEVEL_COUNT * LEVEL_SIZE);
+    memset(brick_dirty, (1 << BRICK_COLS) - 1, BRICK_ROWS);
 }
 
 /* ================================================================
@@ -467,11 +400,12 @@ static void init_sprites(void) {
     SPR1_COL = WHITE;        /* ball */
 }
 
+/* Paddle only – the ball is already in spr_x/spr_y; spr_flush()
+ * stages both for the raster IRQ, which writes them in the border */
 static void update_sprites(void) {
-    SPR0_X = paddle_x;
-    SPR0_Y = PADDLE_Y_SPR;
-    SPR1_X = (unsigned char)(ball_x >> 8);
-    SPR1_Y = (unsigned char)(ball_y >> 8);
+    spr_x[SPR_PADDLE] = paddle_x;
+    spr_y[SPR_PADDLE] = PADDLE_Y_SPR;
+    spr_flush();
 }
 
 /* ================================================================
@@ -502,16 +436,15 @@ static void move_paddle(unsigned char dir) {
 
 static void launch_ball(void) {
     /* Place ball just above paddle, slight right bias */
-    ball_x = ((unsigned int)paddle_x + 12) << 8;
-    ball_y = ((unsigned int)(PADDLE_Y_SPR - 8)) << 8;
-    ball_dx =  0x0140;   /* ~1.25 px/frame right */
-    ball_dy = -0x0180;   /* ~1.5  px/frame up */
+    SPR_PLACE(SPR_BALL, paddle_x + 12, PADDLE_Y_SPR - 8);
+    spr_dx[SPR_BALL] =  0x0140;   /* ~1.25 px/frame right */
+    spr_dy[SPR_BALL] = -0x0180;   /* ~1.5  px/frame up */
 }
 
 /* Convert ball sprite pos → char column & row for collision */
 static void ball_to_char(unsigned char *cx, unsigned char *cy) {
-    unsigned char bx = (unsigned char)(ball_x >> 8);
-    unsigned char by = (unsigned char)(ball_y >> 8);
+    unsigned char bx = (unsigned char)spr_x[SPR_BALL];
+    unsigned char by = spr_y[SPR_BALL];
     /* add 2 for ball centre (4px ball) */
     *cx = (bx - SPRITE_X_OFS + 2) >> 3;
     *cy = (by - SPRITE_Y_OFS + 2) >> 3;
@@ -531,129 +464,143 @@ static unsigned char check_brick_at(unsigned char cx, unsigned char cy) {
     if (bc >= BRICK_COLS) return 0;
     if (bricks[br][bc] == 0) return 0;
 
-    /* Hit! */
+    /* Hit! Gone or recoloured at the next flush_bricks() */
     --bricks[br][bc];
+    mark_brick(br, bc);
     if (bricks[br][bc] == 0) {
-        erase_brick(br, bc);
         --bricks_left;
         score += 10 * level;
-        sound_brick();
+        sfx_play(fx_brick);
     } else {
-        /* brick damaged but alive – change its color */
-        redraw_brick(br, bc);
         score += 5;
-        sound_bounce();
+        sfx_play(fx_bounce);
     }
     return 1;
 }
 
+/* Drop collisions latched while the ball was not in play */
+static void clear_collisions(void) {
+    shd_coll_spr = 0;
+    shd_coll_bg = 0;
+}
+
 static void move_ball(void) {
     unsigned char bx, by;
     unsigned char cx, cy;
     unsigned char hit;
-    int next_x, next_y;
-    unsigned char paddle_left, paddle_right;
+    unsigned char coll_spr, coll_bg;
     unsigned char ball_centre;
     signed char offset;
 
+    /* What the frames since the last call touched (see shadow.h) */
+    coll_spr = shd_coll_spr;
+    coll_bg = shd_coll_bg;
+    clear_collisions();
+
     /* Advance position */
-    next_x = (int)ball_x + ball_dx;
-    next_y = (int)ball_y + ball_dy;
+    spr_move(1 << SPR_BALL);
 
     /* ---- Wall collisions (X axis) ---- */
-    bx = (unsigned char)(next_x >> 8);
+    bx = (unsigned char)spr_x[SPR_BALL];
     if (bx <= BALL_MIN_X) {
-        ball_dx = -ball_dx;
-        next_x  = (int)((unsigned int)BALL_MIN_X << 8) + 0x0100;
-        sound_bounce();
+        spr_dx[SPR_BALL] = -spr_dx[SPR_BALL];
+        spr_x[SPR_BALL]  = BALL_MIN_X + 1;
+        spr_xf[SPR_BALL] = 0;
+        sfx_play(fx_bounce);
     } else if (bx >= BALL_MAX_X) {
-        ball_dx = -ball_dx;
-        next_x  = (int)((unsigned int)(BALL_MAX_X - 1) << 8);
-        sound_bounce();
+        spr_dx[SPR_BALL] = -spr_dx[SPR_BALL];
+        spr_x[SPR_BALL]  = BALL_MAX_X - 1;
+        spr_xf[SPR_BALL] = 0;
+        sfx_play(fx_bounce);
     }
 
     /* ---- Wall collision (top) ---- */
-    by = (unsigned char)(next_y >> 8);
+    by = spr_y[SPR_BALL];
     if (by <= BALL_MIN_Y) {
-        ball_dy = -ball_dy;
-        next_y  = (int)((unsigned int)BALL_MIN_Y << 8) + 0x0100;
-        sound_bounce();
+        spr_dy[SPR_BALL] = -spr_dy[SPR_BALL];
+        spr_y[SPR_BALL]  = BALL_MIN_Y + 1;
+        spr_yf[SPR_BALL] = 0;
+        sfx_play(fx_bounce);
     }
 
     /* ---- Death (bottom) ---- */
     if (by >= BALL_MAX_Y) {
+        sfx_play(fx_die);
+        state_timer = 22;       /* hold for the death tone */
         game_state = STATE_DYING;
         return;
     }
 
-    /* Commit position */
-    ball_x = (unsigned int)next_x;
-    ball_y = (unsigned int)next_y;
-
-    /* ---- Paddle collision ---- */
-    by = (unsigned char)(ball_y >> 8);
-    bx = (unsigned char)(ball_x >> 8);
-
-    if (ball_dy > 0) {  /* ball moving down */
-        if (by >= PADDLE_Y_SPR - 4 && by <= PADDLE_Y_SPR + 2) {
-            paddle_left  = paddle_x;
-            paddle_right = paddle_x + 48; /* double-width sprite */
-            if (bx >= paddle_left && bx <= paddle_right) {
-                /* Reflect Y */
-                ball_dy = -ball_dy;
-                ball_y  = ((unsigned int)(PADDLE_Y_SPR - 5)) << 8;
-
-                /* Angle based on hit position */
-                ball_centre = (unsigned char)(bx - paddle_left);  /* 0..47 */
-                offset = (signed char)ball_centre - 24; /* -24..+23 */
-
-                /* Horizontal speed influenced by hit position */
-                ball_dx = (int)offset * 6;  /* wider angle at edges */
-
-                /* Clamp minimum X speed so ball doesn't go straight up */
-                if (ball_dx > -0x0060 && ball_dx < 0x0060) {
-                    ball_dx = (ball_dx >= 0) ? 0x0060 : -0x0060;
-                }
-                /* Clamp max */
-                if (ball_dx >  0x0250) ball_dx =  0x0250;
-                if (ball_dx < -0x0250) ball_dx = -0x0250;
+    /* ---- Paddle collision: the sprites touched ---- */
+    bx = (unsigned char)spr_x[SPR_BALL];
+
+    /* Ball moving down and touching the paddle sprite */
+    if (spr_dy[SPR_BALL] > 0 && (coll_spr & COLL_PADDLE) == COLL_PADDLE) {
+        /* Reflect Y */
+        spr_dy[SPR_BALL] = -spr_dy[SPR_BALL];
+        spr_y[SPR_BALL]  = PADDLE_Y_SPR - 5;
+        spr_yf[SPR_BALL] = 0;
+
+        /* Angle based on hit position (paddle is 48 px,
+         * double-width); the ball can overlap either end */
+        if (bx < paddle_x) {
+            ball_centre = 0;
+        } else {
+            ball_centre = (unsigned char)(bx - paddle_x);
+            if (ball_centre > 47) ball_centre = 47;
+        }
+        offset = (signed char)ball_centre - 24; /* -24..+23 */
 
-                /* Ensure ball always moves up fast enough */
-                if (ball_dy > -0x0100) ball_dy = -0x0100;
+        /* Horizontal speed influenced by hit position */
+        spr_dx[SPR_BALL] = (int)offset * 6;  /* wider angle at edges */
 
-                /* Slight speed-up per level */
-                if (ball_dy > -0x0280) {
-                    ball_dy -= 0x0008;  /* get slightly faster */
-                }
-
-                sound_paddle();
-            }
+        /* Clamp minimum X speed so ball doesn't go straight up */
+        if (spr_dx[SPR_BALL] > -0x0060 && spr_dx[SPR_BALL] < 0x0060) {
+            spr_dx[SPR_BALL] = (spr_dx[SPR_BALL] >= 0) ? 0x0060 : -0x0060;
         }
-    }
-
-    /* ---- Brick collision ---- */
-    /* Check the 4 corners of the ball (approx 4×4 px) */
-    hit = 0;
+        /* Clamp max */
+        if (spr_dx[SPR_BALL] >  0x0250) spr_dx[SPR_BALL] =  0x0250;
+        if (spr_dx[SPR_BALL] < -0x0250) spr_dx[SPR_BALL] = -0x0250;
 
-    /* Ball centre for brick test */
-    ball_to_char(&cx, &cy);
+        /* Ensure ball always moves up fast enough */
+        if (spr_dy[SPR_BALL] > -0x0100) spr_dy[SPR_BALL] = -0x0100;
 
-    /* Test cell the ball centre is in */
-    if (check_brick_at(cx, cy)) hit = 1;
+        /* Slight speed-up per level */
+        if (spr_dy[SPR_BALL] > -0x0280) {
+            spr_dy[SPR_BALL] -= 0x0008;  /* get slightly faster */
+        }
 
-    /* Also test one cell above/below based on ball direction */
-    if (ball_dy < 0) {
-        /* moving up – check cell above */
-        if (cy > 0 && check_brick_at(cx, cy - 1)) hit = 1;
-    } else {
-        /* moving down – check cell below */
-        if (check_brick_at(cx, cy + 1)) hit = 1;
+        sfx_play(fx_paddle);
     }
 
-    /* If we hit a brick, reverse Y */
-    if (hit) {
-        ball_dy = -ball_dy;
+    /* ---- Brick collision ---- */
+    /* Only when the ball sprite touched background pixels (a brick
+     * or a wall); the cell test then finds which brick. The latch
+     * describes where the ball was two frames ago, so the cells of
+     * the last two frames are tested as well as the one ahead. */
+    ball_to_char(&cx, &cy);
+    if (coll_skip) {
+        --coll_skip;
+    } else if (coll_bg & COLL_BALL) {
+        /* First brick found: the cell the ball centre is in, one
+         * cell above/below it by direction, then the older cells */
+        hit = check_brick_at(cx, cy)
+           || (spr_dy[SPR_BALL] < 0 ? cy > 0 && check_brick_at(cx, cy - 1)
+                                    : check_brick_at(cx, cy + 1))
+           || check_brick_at(hist_cx[0], hist_cy[0])
+           || check_brick_at(hist_cx[1], hist_cy[1]);
+
+        /* If we hit a brick, reverse Y; the next two latches saw
+         * the ball before it turned */
+        if (hit) {
+            spr_dy[SPR_BALL] = -spr_dy[SPR_BALL];
+            coll_skip = 2;
+        }
     }
+    hist_cx[1] = hist_cx[0];
+    hist_cy[1] = hist_cy[0];
+    hist_cx[0] = cx;
+    hist_cy[0] = cy;
 
     /* Win condition */
     if (bricks_left == 0) {
@@ -666,7 +613,7 @@ static void move_ball(void) {
  * ================================================================ */
 
 static void demo_ai(void) {
-    unsigned char bx = (unsigned char)(ball_x >> 8);
+    unsigned char bx = (unsigned char)spr_x[SPR_BALL];
     unsigned char paddle_mid = paddle_x + 24;
 
     if (bx < paddle_mid - 4)
@@ -679,15 +626,16 @@ static void demo_ai(void) {
  *  INPUT
  * ================================================================ */
 
+/* In game: this frame's input from rp_frame(), recorded or played back */
 static unsigned char read_joy_dir(void) {
-    unsigned char joy = joy_read(JOY_2);
+    unsigned char joy = rp_joy(JOY_2);
     if (JOY_LEFT(joy))  return DIR_LEFT;
     if (JOY_RIGHT(joy)) return DIR_RIGHT;
     return DIR_NONE;
 }
 
 static unsigned char read_joy_fire(void) {
-    unsigned char joy = joy_read(JOY_2);
+    unsigned char joy = rp_joy(JOY_2);
     return JOY_FIRE(joy);
 }
 
@@ -757,20 +705,22 @@ static void init_round(void) {
     paddle_x = CHAR2SPR_X(FIELD_LEFT + 1 + FIELD_W / 2 - PADDLE_WIDTH / 2);
 
     /* Ball stuck to paddle */
-    ball_x = ((unsigned int)(paddle_x + 12)) << 8;
-    ball_y = ((unsigned int)(PADDLE_Y_SPR - 8)) << 8;
-    ball_dx = 0;
-    ball_dy = 0;
+    SPR_PLACE(SPR_BALL, paddle_x + 12, PADDLE_Y_SPR - 8);
+    spr_dx[SPR_BALL] = 0;
+    spr_dy[SPR_BALL] = 0;
+    clear_collisions();
+    hist_cy[0] = hist_cy[1] = 0xFF;
+    coll_skip = 0;
 
     game_state = STATE_LAUNCH;
 }
 
+/* Walls and HUD; the bricks follow from flush_bricks() */
 static void draw_field(void) {
     clrscr();
     bgcolor(BLACK);
     bordercolor(BLUE);
     draw_border();
-    draw_bricks();
     draw_hud();
 }
 
@@ -782,14 +732,10 @@ static void game_loop(void) {
     unsigned char dir;
 
     while (1) {
-        waitvsync();
+        shd_wait();
+        rp_frame();
         ++frame_count;
-
-        /* Sound auto-off */
-        if (sound_timer > 0) {
-            --sound_timer;
-            if (sound_timer == 0) sound_off();
-        }
+        flush_bricks();
 
         /* ── STATE: LAUNCH (ball on paddle) ──────────── */
         if (game_state == STATE_LAUNCH) {
@@ -804,8 +750,7 @@ static void game_loop(void) {
                 dir = read_joy_dir();
                 move_paddle(dir);
                 /* Ball tracks paddle */
-                ball_x = ((unsigned int)(paddle_x + 12)) << 8;
-                ball_y = ((unsigned int)(PADDLE_Y_SPR - 8)) << 8;
+                SPR_PLACE(SPR_BALL, paddle_x + 12, PADDLE_Y_SPR - 8);
                 if (read_joy_fire()) {
                     launch_ball();
                     game_state = STATE_PLAY;
@@ -835,9 +780,9 @@ static void game_loop(void) {
             continue;
         }
 
-        /* ── STATE: DYING ─────────────────────────────── */
+        /* ── STATE: DYING (frozen while the tone plays) ── */
         if (game_state == STATE_DYING) {
-            sound_die();
+            if (--state_timer) continue;
             --lives;
             if (lives == 0) {
                 game_state = STATE_LOST;
@@ -850,22 +795,29 @@ static void game_loop(void) {
 
         /* ── STATE: WON ──────────────────────────────── */
         if (game_state == STATE_WON) {
-            sound_win();
+            sfx_play(fx_win);
             gotoxy(13, 12);
             textcolor(YELLOW);
             cprintf("LEVEL CLEAR!");
-            /* Wait ~3 seconds */
-            {
-                unsigned char w;
-                for (w = 0; w < 180; ++w) waitvsync();
+            /* The next wall builds up behind the banner */
+            if (!demo_mode) {
+                ++level;
+                load_level();
             }
-            if (demo_mode) return;
+            state_timer = 180;      /* ~3 seconds */
+            game_state = STATE_NEXT_LVL;
+            continue;
+        }
 
-            ++level;
-            generate_level();
-            draw_field();
-            init_round();
-            update_sprites();
+        /* ── STATE: NEXT_LVL (banner up, frames keep running) ── */
+        if (game_state == STATE_NEXT_LVL) {
+            draw_hud();
+            if (--state_timer == 0) {
+                if (demo_mode) return;
+                cclearxy(13, 12, 12);
+                init_round();
+                update_sprites();
+            }
             continue;
         }
 
@@ -898,8 +850,9 @@ int main(void) {
     bgcolor(BLACK);
     bordercolor(BLUE);
 
-    init_sound();
     init_sprites();
+    shd_install(SHD_LINE);
+    sfx_init();
 
     joy_install(joy_static_stddrv);
 
@@ -908,7 +861,7 @@ title_screen:
 
     /* Wait for fire or timeout → demo */
     title_timer = 0;
-    while (!read_joy_fire() && title_timer < 300) {
+    while (!rp_start() && title_timer < 300) {
         waitvsync();
         ++title_timer;
     }
@@ -918,15 +871,18 @@ title_screen:
     lives = 3;
     level = 1;
     frame_count = 0;
-    sound_timer = 0;
 
-    if (read_joy_fire()) {
+    if (rp_start()) {
         demo_mode = 0;
     } else {
         demo_mode = 1;
     }
 
-    generate_level();
+    /* Seed and start logging (or play back) this run; demos are not
+     * logged, so the last game's log stays there to be saved */
+    demo_mode = rp_begin(demo_mode ? RP_DEMO : 0) & RP_DEMO;
+
+    load_level();
     draw_field();
     init_round();
     update_sprites();
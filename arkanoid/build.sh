@@ -2,7 +2,8 @@
 # Build Arkanoid using cc65
 cd "$(dirname "$0")"
 
-cl65 -t c64 -O -o arkanoid.prg arkanoid.c
+python3 ../common/levelgen.py 6 8 levels.h
+cl65 -t c64 -C arkanoid.cfg -O -I ../common -g -m arkanoid.map -Ln arkanoid.lbl -Wl --dbgfile,arkanoid.dbg -o arkanoid.prg arkanoid.c ../common/sprmove.s ../common/shadow.s ../common/sfx.s ../common/replay.s ../common/level.s
 
 if [[ -f arkanoid.prg ]]; then
     echo "Built arkanoid.prg ($(stat -c%s arkanoid.prg) bytes)"
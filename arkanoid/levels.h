@@ -0,0 +1,268 @@
+#ifndef ARKANOID_LEVELS_H
+#define ARKANOID_LEVELS_H
+
+/* Generated by levelgen.py. Edit the patterns there, then rerun it. */
+
+#define LEVEL_COUNT 32
+#define LEVEL_SIZE  13
+
+static const unsigned char level_bank[LEVEL_COUNT * LEVEL_SIZE] = {
+    /* level 1 */
+    0x68,
+    0x00,0xFF,   /* 11111111 */
+    0x00,0xFF,   /* 11111111 */
+    0x00,0xFF,   /* 11111111 */
+    0x00,0xFF,   /* 11111111 */
+    0x00,0xFF,   /* 11111111 */
+    0x00,0xFF,   /* 11111111 */
+    /* level 2 */
+    0x68,
+    0xFF,0x00,   /* 22222222 */
+    0x00,0xFF,   /* 11111111 */
+    0x00,0xFF,   /* 11111111 */
+    0x00,0xFF,   /* 11111111 */
+    0x00,0xFF,   /* 11111111 */
+    0x00,0xFF,   /* 11111111 */
+    /* level 3 */
+    0x68,
+    0x55,0xAA,   /* 12121212 */
+    0xAA,0x55,   /* 21212121 */
+    0x55,0xAA,   /* 12121212 */
+    0xAA,0x55,   /* 21212121 */
+    0x55,0xAA,   /* 12121212 */
+    0xAA,0x55,   /* 21212121 */
+    /* level 4 */
+    0x68,
+    0xFF,0xFF,   /* 33333333 */
+    0xFF,0xFF,   /* 33333333 */
+    0xFF,0xFF,   /* 33333333 */
+    0xFF,0xFF,   /* 33333333 */
+    0xFF,0x00,   /* 22222222 */
+    0x00,0xFF,   /* 11111111 */
+    /* level 5 */
+    0x68,
+    0x00,0xA5,   /* 1.1..1.1 */
+    0x00,0x81,   /* 1......1 */
+    0x00,0x42,   /* .1....1. */
+    0x00,0xA5,   /* 1.1..1.1 */
+    0x88,0x35,   /* 2.1121.1 */
+    0x40,0x9B,   /* 12.11.11 */
+    /* level 6 */
+    0x68,
+    0x00,0x3C,   /* ..1111.. */
+    0x18,0x76,   /* .113211. */
+    0x3D,0xCE,   /* 11223312 */
+    0x3C,0xC3,   /* 11222211 */
+    0x38,0x46,   /* .122211. */
+    0x04,0x38,   /* ..1112.. */
+    /* level 7 */
+    0x68,
+    0x06,0xF9,   /* 11111221 */
+    0x00,0x00,   /* ........ */
+    0x00,0xFF,   /* 11111111 */
+    0x00,0x00,   /* ........ */
+    0xFF,0x06,   /* 22222332 */
+    0x00,0x00,   /* ........ */
+    /* level 8 */
+    0x68,
+    0xFF,0xFF,   /* 33333333 */
+    0x99,0xE7,   /* 31122113 */
+    0xEB,0x95,   /* 32212123 */
+    0x81,0xFF,   /* 31111113 */
+    0x83,0xFD,   /* 31111123 */
+    0xEF,0xEF,   /* 333.3333 */
+    /* level 9 */
+    0x68,
+    0x00,0xFB,   /* 11111.11 */
+    0x02,0xF5,   /* 1111.121 */
+    0x81,0x6E,   /* 211.1112 */
+    0x17,0xE0,   /* 1112.222 */
+    0x41,0xBA,   /* 12111.12 */
+    0x10,0xED,   /* 111211.1 */
+    /* level 10 */
+    0x68,
+    0x00,0x24,   /* ..1..1.. */
+    0xF0,0x0F,   /* 22221111 */
+    0xC2,0x25,   /* 221..121 */
+    0x00,0xFF,   /* 11111111 */
+    0x21,0xC6,   /* 112..112 */
+    0x81,0x24,   /* 2.1..1.2 */
+    /* level 11 */
+    0x68,
+    0x00,0x3C,   /* ..1111.. */
+    0x18,0x7E,   /* .113311. */
+    0xFD,0x1A,   /* 22233212 */
+    0x3C,0xE3,   /* 11322211 */
+    0x1A,0x64,   /* .112212. */
+    0x38,0x04,   /* ..2221.. */
+    /* level 12 */
+    0x68,
+    0xFF,0x04,   /* 22222322 */
+    0x00,0x00,   /* ........ */
+    0x24,0xDB,   /* 11211211 */
+    0x00,0x00,   /* ........ */
+    0x28,0xD7,   /* 11212111 */
+    0x00,0x00,   /* ........ */
+    /* level 13 */
+    0x68,
+    0xFF,0xFF,   /* 33333333 */
+    0x81,0xFF,   /* 31111113 */
+    0xE9,0x97,   /* 32212113 */
+    0xE1,0x9F,   /* 32211113 */
+    0x8D,0xF3,   /* 31112213 */
+    0xBF,0xBF,   /* 3.333333 */
+    /* level 14 */
+    0x68,
+    0xDC,0x21,   /* 221222.1 */
+    0x06,0xF8,   /* 1111122. */
+    0xAA,0x54,   /* 2121212. */
+    0x98,0x65,   /* 211221.1 */
+    0x28,0xD6,   /* 1121211. */
+    0xD0,0x2D,   /* 221211.1 */
+    /* level 15 */
+    0x68,
+    0x98,0x67,   /* 21122111 */
+    0x30,0x4E,   /* .122111. */
+    0x28,0xD7,   /* 11212111 */
+    0x8A,0x51,   /* 21.12.21 */
+    0x81,0x3C,   /* 2.1111.2 */
+    0x1E,0x60,   /* .112222. */
+    /* level 16 */
+    0x68,
+    0x00,0x18,   /* ...11... */
+    0x08,0x34,   /* ..1121.. */
+    0x38,0x4E,   /* .122311. */
+    0x7C,0x02,   /* .222221. */
+    0x30,0x0C,   /* ..2211.. */
+    0x10,0x08,   /* ...21... */
+    /* level 17 */
+    0x68,
+    0xA8,0x02,   /* 2.2.2.1. */
+    0x88,0x22,   /* 2.1.2.1. */
+    0xAA,0x00,   /* 2.2.2.2. */
+    0xA0,0x0A,   /* 2.2.1.1. */
+    0xAA,0x28,   /* 2.3.3.2. */
+    0x08,0xA2,   /* 1.1.2.1. */
+    /* level 18 */
+    0x68,
+    0xFF,0xFF,   /* 33333333 */
+    0xB3,0xCD,   /* 31221123 */
+    0xE1,0x9F,   /* 32211113 */
+    0xE5,0x9B,   /* 32211213 */
+    0xE7,0x99,   /* 32211223 */
+    0xFD,0xFD,   /* 333333.3 */
+    /* level 19 */
+    0x68,
+    0x6A,0x94,   /* 1221212. */
+    0x11,0xEC,   /* 111211.2 */
+    0x92,0x69,   /* 21121.21 */
+    0x60,0x9D,   /* 122111.1 */
+    0x32,0xCC,   /* 1122112. */
+    0xB8,0x46,   /* 2122211. */
+    /* level 20 */
+    0x68,
+    0xE1,0x1E,   /* 22211112 */
+    0x7C,0x02,   /* .222221. */
+    0xFC,0x03,   /* 22222211 */
+    0x4C,0xB3,   /* 12112211 */
+    0x6E,0x91,   /* 12212221 */
+    0x0A,0xF5,   /* 11112121 */
+    /* level 21 */
+    0x68,
+    0x04,0x38,   /* ..1112.. */
+    0x18,0x7E,   /* .113311. */
+    0xFC,0x17,   /* 22232311 */
+    0xBE,0x51,   /* 21232221 */
+    0x38,0x56,   /* .123211. */
+    0x2C,0x10,   /* ..2122.. */
+    /* level 22 */
+    0x68,
+    0xF7,0x08,   /* 22221222 */
+    0x00,0x00,   /* ........ */
+    0xEF,0x10,   /* 22212222 */
+    0x00,0x00,   /* ........ */
+    0xFF,0x86,   /* 32222332 */
+    0x00,0x00,   /* ........ */
+    /* level 23 */
+    0x68,
+    0xFF,0xFF,   /* 33333333 */
+    0xF5,0x8B,   /* 32221213 */
+    0x93,0xED,   /* 31121123 */
+    0x83,0xFD,   /* 31111123 */
+    0xC9,0xB7,   /* 32112113 */
+    0xEF,0xEF,   /* 333.3333 */
+    /* level 24 */
+    0x68,
+    0xF5,0x02,   /* 2222.212 */
+    0x6A,0x85,   /* 122.2121 */
+    0x51,0xA6,   /* 1212.112 */
+    0x23,0xD8,   /* 11211.22 */
+    0x77,0x80,   /* 1222.222 */
+    0x98,0x63,   /* 21122.11 */
+    /* level 25 */
+    0x68,
+    0xCE,0x31,   /* 22112221 */
+    0x0E,0xF1,   /* 11112221 */
+    0xB1,0x0C,   /* 2.2211.2 */
+    0xD3,0x08,   /* 22.21.22 */
+    0x7A,0x04,   /* .222212. */
+    0x7E,0x00,   /* .222222. */
+    /* level 26 */
+    0x68,
+    0x6C,0x12,   /* .221221. */
+    0xFE,0x11,   /* 22232221 */
+    0x7C,0xB7,   /* 12332311 */
+    0x3E,0xC1,   /* 11222221 */
+    0x5F,0xA0,   /* 12122222 */
+    0x3E,0x40,   /* .122222. */
+    /* level 27 */
+    0x68,
+    0xA8,0x02,   /* 2.2.2.1. */
+    0x8A,0x20,   /* 2.1.2.2. */
+    0xAA,0xA0,   /* 3.3.2.2. */
+    0xA8,0x02,   /* 2.2.2.1. */
+    0xAA,0x00,   /* 2.2.2.2. */
+    0x02,0xA8,   /* 1.1.1.2. */
+    /* level 28 */
+    0x68,
+    0xFF,0xFF,   /* 33333333 */
+    0xD7,0xA9,   /* 32121223 */
+    0xFB,0x85,   /* 32222123 */
+    0xB7,0xC9,   /* 31221223 */
+    0xD3,0xAD,   /* 32121123 */
+    0xFB,0xFB,   /* 33333.33 */
+    /* level 29 */
+    0x68,
+    0x35,0xC2,   /* 1122.212 */
+    0xAE,0x41,   /* 212.2221 */
+    0xC0,0x37,   /* 2211.111 */
+    0xEB,0x10,   /* 22212.22 */
+    0xDC,0x21,   /* 221222.1 */
+    0xD3,0x28,   /* 22121.22 */
+    /* level 30 */
+    0x68,
+    0xE9,0x16,   /* 22212112 */
+    0xBC,0x43,   /* 21222211 */
+    0xD9,0x02,   /* 22.22.12 */
+    0x6C,0x93,   /* 12212211 */
+    0x2E,0xD1,   /* 11212221 */
+    0x54,0xAB,   /* 12121211 */
+    /* level 31 */
+    0x68,
+    0x0C,0x30,   /* ..1122.. */
+    0x78,0x06,   /* .222211. */
+    0xFE,0x3D,   /* 22333321 */
+    0xFE,0x31,   /* 22332221 */
+    0x3E,0x48,   /* .122322. */
+    0x3C,0x00,   /* ..2222.. */
+    /* level 32 */
+    0x68,
+    0x28,0x82,   /* 1.2.2.1. */
+    0x8A,0x20,   /* 2.1.2.2. */
+    0xAA,0x08,   /* 2.2.3.2. */
+    0xA8,0x02,   /* 2.2.2.1. */
+    0x00,0xAA,   /* 1.1.1.1. */
+    0x2A,0x80   /* 1.2.2.2. */
+};
+
+#endif
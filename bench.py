@@ -0,0 +1,408 @@
+#!/usr/bin/env python3
+"""
+bench.py - Demo-mode AI benchmark: game score against AI CPU cost
+
+Runs each game's demo AI in its own headless VICE (warp mode, private
+remote monitor port) for N calls of the AI routine and times every call
+with the monitor stopwatch: a breakpoint on the routine's entry, then
+"return" to its RTS. Each call becomes a CSV row:
+
+    frame    AI calls so far (one per game frame while the demo plays)
+    run      demo run number (a run ends with a game over / score reset)
+    cycles   CPU cycles of the call
+    lines    the same in PAL raster lines (63 cycles each)
+    score    the game's score after the call
+    lives    lives (shields) left, where the game has them
+
+Results go to bench/<build>/<project>.csv, <build> being the git
+revision, and a summary per project is printed: finished runs, mean and
+best score, mean survival (frames per run), mean and worst AI cost, and
+score per 1000 AI cycles. Compare two builds with --compare.
+
+Games linked with common/replay.s get a fixed rand() seed per run (set
+at srand() entry: --seed, plus the run number), so two builds of a game
+meet the same waves. The assembly games seed themselves, and a raster
+IRQ that lands inside a call is counted in its cycles: compare means
+over a few thousand frames, not single calls.
+
+Usage:
+    python3 bench.py                          # Every game, 2000 frames
+    python3 bench.py dreadline sky_miner -n 5000
+    python3 bench.py pong -o bench/before     # Own output directory
+    python3 bench.py --compare bench/before bench/after
+    python3 bench.py --list                   # Games and AI routines
+
+Requirements:
+    - cc65 (cl65) and VICE (x64sc) on PATH
+    - VICE 3.5+ for the monitor's keybuf command (pong's title)
+
+Author: C64AIToolChain Project
+"""
+
+import argparse
+import csv
+import os
+import re
+import subprocess
+import sys
+import time
+from concurrent.futures import ThreadPoolExecutor
+from pathlib import Path
+
+from ai_toolchain import MEM_LINE, connect_vice, monitor_batch
+from build_all import build_many
+from regress import VICE, sys_address
+from symbols import SymbolDB
+
+ROOT = Path(__file__).resolve().parent
+RESULTS = ROOT / 'bench'
+
+BASE_PORT = 6560
+CALL_TIMEOUT = 3.0      # seconds of warp-mode emulation between AI calls
+START_TIMEOUT = 30.0    # title screen to the first AI call
+CYCLES_PER_LINE = 63    # PAL
+
+FIELDS = ['frame', 'run', 'cycles', 'lines', 'score', 'lives']
+
+# =============================================================================
+# BENCH - Each game's AI routine and the variables it is judged by
+# =============================================================================
+#
+# 'ai' is the routine timed (symbol name as in the source), 'score' a
+# field as in game_state.py: ('u8', sym), ('u16', sym) or
+# ('u16lh', lo, hi). 'lives' is optional. 'keys' are typed on the title
+# screen (monitor keybuf) for games without a demo timeout.
+
+BENCH = {
+    'arkanoid':  {'ai': 'demo_ai', 'score': ('u16', 'score'), 'lives': 'lives'},
+    'invaders':  {'ai': 'demo_ai', 'score': ('u16', 'score'), 'lives': 'lives'},
+    'meteor':    {'ai': 'demo_ai', 'score': ('u16', 'score'), 'lives': 'lives'},
+    'pacman_c':  {'ai': 'demo_ai', 'score': ('u16', 'score'), 'lives': 'lives'},
+    'pacman':    {'ai': 'demo_ai', 'score': ('u16lh', 'score_lo', 'score_hi'),
+                  'lives': 'lives'},
+    'dreadline': {'ai': 'move_player_demo', 'score': ('u16', 'score'),
+                  'lives': 'shields'},
+    'sky_miner': {'ai': 'move_player_demo', 'score': ('u16', 'score'),
+                  'lives': 'lives'},
+    'pong':      {'ai': 'cpu_ai', 'score': ('u8', 'score2'), 'keys': '1'},
+    'tetris_v1': {'ai': 'ai_move', 'score': ('u16lh', 'score_lo', 'score_hi')},
+    'tetris_v2': {'ai': 'ai_update', 'score': ('u16', 'score')},
+    'snake':     {'ai': 'ai_move', 'score': ('u8', 'score')},
+    'snake2':    {'ai': 'ai_move', 'score': ('u16lh', 'score_lo', 'score_hi')},
+}
+
+
+def build_label():
+    """Git revision of the tree being benchmarked ("abc1234-dirty")."""
+    try:
+        return subprocess.run(
+            ['git', 'describe', '--always', '--dirty'], cwd=ROOT,
+            capture_output=True, text=True, check=True).stdout.strip()
+    except (OSError, subprocess.CalledProcessError):
+        return time.strftime('%Y%m%d-%H%M%S')
+
+
+# =============================================================================
+# MONITOR - Breakpoints and the stopwatch
+# =============================================================================
+
+def wait_stop(s, timeout, resume=True):
+    """Resume (or, just after "g", keep running) until the next
+    breakpoint; its address, or None on timeout."""
+    if resume:
+        s.sendall(b"x\n")
+    data = b""
+    deadline = time.time() + timeout
+    while time.time() < deadline:
+        try:
+            chunk = s.recv(4096)
+        except OSError:
+            continue
+        if not chunk:
+            break
+        data += chunk
+        if b"Stop on" in data and data.rstrip().endswith(b")"):
+            m = re.search(rb'Stop on\s+exec\s+([0-9a-fA-F]{4})', data)
+            return int(m.group(1), 16) if m else None
+    return None
+
+
+def set_break(s, addr):
+    reply = monitor_batch(s, [f"break {addr:04x}"])
+    m = re.search(r'BREAK:\s*(\d+)', reply)
+    return m.group(1) if m else None
+
+
+def time_call(s, spans):
+    """
+    At a stop on the AI entry: run to its RTS and return (cycles, memory)
+    with memory the bytes of spans [(addr, size)] afterwards.
+    """
+    commands = ["sw reset", "ret", "sw"]
+    commands += [f"m {a:04x} {a + n - 1:04x}" for a, n in spans]
+    reply = monitor_batch(s, commands, timeout=CALL_TIMEOUT)
+    replies = re.split(r'\(C:\$[0-9a-fA-F]{4}\)', reply)
+    cycles = None
+    if len(replies) > 3:
+        m = (re.search(r'(\d+)\s*cycles', replies[2])
+             or re.search(r'(\d+)', replies[2]))
+        if m:
+            cycles = int(m.group(1))
+    mem = {}
+    for line in reply.splitlines():
+        m = MEM_LINE.search(line)
+        if m:
+            addr = int(m.group(1), 16)
+            for i, p in enumerate(m.group(2).split()):
+                mem[addr + i] = int(p, 16)
+    return cycles, mem
+
+
+def field_spans(db, spec):
+    """(addr, size) of every byte a score/lives field reads."""
+    if spec[0] == 'u16lh':
+        return [(db[spec[1]], 1), (db[spec[2]], 1)]
+    return [(db[spec[1]], 2 if spec[0] == 'u16' else 1)]
+
+
+def field_value(db, spec, mem):
+    if spec[0] == 'u16lh':
+        return mem.get(db[spec[1]], 0) | mem.get(db[spec[2]], 0) << 8
+    addr = db[spec[1]]
+    if spec[0] == 'u16':
+        return mem.get(addr, 0) | mem.get(addr + 1, 0) << 8
+    return mem.get(addr, 0)
+
+
+# =============================================================================
+# RUN - One game in one emulator
+# =============================================================================
+
+def run_project(name, frames, port, seed):
+    """Benchmark one game; returns (name, rows, messages)."""
+    bench = BENCH[name]
+    project = ROOT / name
+    db = SymbolDB.for_project(project)
+    if db is None:
+        return name, None, ["no symbol files: build first"]
+    missing = [n for n in [bench['ai'], *bench['score'][1:]]
+               + ([bench['lives']] if 'lives' in bench else []) if n not in db]
+    if missing:
+        return name, None, [f"symbols not found: {', '.join(missing)}"]
+    prg = project / Path(db.sources[0]).with_suffix('.prg').name
+    if not prg.exists():
+        return name, None, [f"{prg.name} not built"]
+
+    ai = db[bench['ai']]
+    lives_spec = ('u8', bench['lives']) if 'lives' in bench else None
+    spans = field_spans(db, bench['score'])
+    if lives_spec:
+        spans += field_spans(db, lives_spec)
+    srand = db['srand'] if seed is not None and 'srand' in db else None
+
+    vice = subprocess.Popen(
+        [VICE, '-console', '-warp', '-sounddev', 'dummy',
+         '-remotemonitor', '-remotemonitoraddress', f'ip4://127.0.0.1:{port}'],
+        cwd=project, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+    try:
+        s = None
+        for _ in range(50):
+            time.sleep(0.1)
+            s = connect_vice('127.0.0.1', port)
+            if s:
+                break
+        if not s:
+            return name, None, ["VICE did not open its monitor"]
+
+        # Let the KERNAL finish its reset, then load, arm, run
+        time.sleep(1.0)
+        monitor_batch(s, [f'l "{prg}" 0'])
+        if not set_break(s, ai):
+            return name, None, [f"could not break at {bench['ai']}"]
+        if srand is not None:
+            set_break(s, srand)
+        s.sendall(f"g {sys_address(prg):04x}\n".encode())
+
+        rows = []
+        run = 0
+        seeds = 0
+        last_score = last_lives = None
+        keys = bench.get('keys')
+        waited = 0.0
+        resume = False
+        while len(rows) < frames:
+            pc = wait_stop(s, CALL_TIMEOUT if keys else START_TIMEOUT, resume)
+            resume = True
+            if pc is None:
+                if keys and waited < START_TIMEOUT:
+                    # Title screen without a demo timeout: type the start key
+                    monitor_batch(s, [f"keybuf {keys}"])
+                    waited += CALL_TIMEOUT
+                    continue
+                return name, rows, [f"no {bench['ai']} call after frame {len(rows)}"]
+            if pc == srand:
+                value = (seed + seeds) & 0xFFFF
+                monitor_batch(s, [f"r A = ${value & 0xFF:02x}, X = ${value >> 8:02x}"])
+                seeds += 1
+                continue
+
+            cycles, mem = time_call(s, spans)
+            if cycles is None:
+                return name, rows, [f"no stopwatch reading at frame {len(rows)}"]
+            score = field_value(db, bench['score'], mem)
+            lives = field_value(db, lives_spec, mem) if lives_spec else ''
+            if rows and (score < last_score or (last_lives == 0 and lives)):
+                run += 1
+            last_score, last_lives = score, lives
+            rows.append({'frame': len(rows) + 1, 'run': run, 'cycles': cycles,
+                         'lines': round(cycles / CYCLES_PER_LINE, 1),
+                         'score': score, 'lives': lives})
+            waited = 0.0
+        s.sendall(b"quit\n")
+        s.close()
+        return name, rows, []
+    finally:
+        try:
+            vice.wait(timeout=2)
+        except subprocess.TimeoutExpired:
+            vice.kill()
+
+
+# =============================================================================
+# RESULTS - CSV files and summaries
+# =============================================================================
+
+def write_csv(path, rows):
+    path.parent.mkdir(parents=True, exist_ok=True)
+    with open(path, 'w', newline='') as f:
+        writer = csv.DictWriter(f, fieldnames=FIELDS)
+        writer.writeheader()
+        writer.writerows(rows)
+
+
+def read_csv(path):
+    with open(path, newline='') as f:
+        return [{k: float(v) if v not in ('', None) else None
+                 for k, v in row.items()} for row in csv.DictReader(f)]
+
+
+def summarize(rows):
+    """Per-game figures from a run's rows (dict), None without rows."""
+    if not rows:
+        return None
+    runs = {}
+    for row in rows:
+        runs.setdefault(int(row['run']), []).append(row)
+    # The last run was cut off by the frame limit: its score counts only
+    # when no run finished
+    finished = [r for k, r in runs.items() if k < max(runs)] or list(runs.values())
+    finals = [r[-1]['score'] for r in finished]
+    cycles = [row['cycles'] for row in rows]
+    total = sum(cycles)
+    return {
+        'frames': len(rows),
+        'runs': len(finished),
+        'score': sum(finals) / len(finals),
+        'best': max(r[-1]['score'] for r in runs.values()),
+        'survival': sum(len(r) for r in finished) / len(finished),
+        'lines': total / len(cycles) / CYCLES_PER_LINE,
+        'worst': max(cycles) / CYCLES_PER_LINE,
+        'per_kcycle': (sum(r[-1]['score'] for r in runs.values()) * 1000 / total
+                       if total else 0.0),
+    }
+
+
+def print_summary(name, s):
+    print(f"✓ {name}: {s['frames']} frames, {s['runs']} run(s), "
+          f"score {s['score']:.0f} (best {s['best']:.0f}), "
+          f"survival {s['survival']:.0f} frames")
+    print(f"    AI {s['lines']:.2f} lines/frame (worst {s['worst']:.1f}), "
+          f"{s['per_kcycle']:.3f} points per 1000 cycles")
+
+
+def compare(a_dir, b_dir):
+    """Side-by-side summaries of two result directories."""
+    a_dir, b_dir = Path(a_dir), Path(b_dir)
+    names = sorted({p.stem for p in a_dir.glob('*.csv')}
+                   & {p.stem for p in b_dir.glob('*.csv')})
+    if not names:
+        print(f"✗ No game benchmarked in both {a_dir} and {b_dir}")
+        return 1
+    print(f"{'':12s} {'score':>15s} {'survival':>15s} {'AI lines':>15s} "
+          f"{'pts/kcycle':>17s}")
+    for name in names:
+        a = summarize(read_csv(a_dir / f'{name}.csv'))
+        b = summarize(read_csv(b_dir / f'{name}.csv'))
+        if a is None or b is None:
+            print(f"{name:12s} (no rows)")
+            continue
+        cols = []
+        for key, fmt in (('score', '.0f'), ('survival', '.0f'),
+                         ('lines', '.2f'), ('per_kcycle', '.3f')):
+            cols.append(f"{a[key]:{fmt}} → {b[key]:{fmt}}")
+        print(f"{name:12s} {cols[0]:>15s} {cols[1]:>15s} {cols[2]:>15s} "
+              f"{cols[3]:>17s}")
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Demo-mode AI benchmark: score against AI CPU cost')
+    parser.add_argument('projects', nargs='*', help='Games (default: all in BENCH)')
+    parser.add_argument('-n', '--frames', type=int, default=2000,
+                        help='AI calls to record per game (default 2000)')
+    parser.add_argument('-o', '--output', metavar='DIR',
+                        help='Result directory (default: bench/<git revision>)')
+    parser.add_argument('-j', '--jobs', type=int, default=os.cpu_count() or 1,
+                        help='Emulators in parallel')
+    parser.add_argument('--seed', type=int, default=1,
+                        help='First rand() seed of replay.s games (default 1)')
+    parser.add_argument('--compare', nargs=2, metavar=('BEFORE', 'AFTER'),
+                        help='Compare two result directories')
+    parser.add_argument('--list', action='store_true',
+                        help='List games and their AI routines')
+    parser.add_argument('--no-build', action='store_true', help='Skip the build')
+    args = parser.parse_args()
+
+    if args.compare:
+        return compare(*args.compare)
+    if args.list:
+        for name, bench in BENCH.items():
+            print(f"{name:12s} {bench['ai']}")
+        return 0
+
+    names = args.projects or list(BENCH)
+    unknown = [n for n in names if n not in BENCH]
+    if unknown:
+        parser.error(f"no benchmark for: {', '.join(unknown)} (see --list)")
+    out = Path(args.output) if args.output else RESULTS / build_label()
+
+    if not args.no_build and not build_many(names, args.jobs, quiet=True):
+        return 1
+
+    start = time.time()
+    with ThreadPoolExecutor(max_workers=max(1, args.jobs)) as pool:
+        jobs = [pool.submit(run_project, name, args.frames, BASE_PORT + i,
+                            args.seed)
+                for i, name in enumerate(names)]
+        results = [job.result() for job in jobs]
+
+    failed = 0
+    for name, rows, messages in results:
+        if rows:
+            write_csv(out / f'{name}.csv', rows)
+        summary = summarize(rows) if rows and not messages else None
+        if summary:
+            print_summary(name, summary)
+        else:
+            print(f"✗ {name}")
+            failed += 1
+        for m in messages:
+            print(f"    {m}")
+    print(f"{len(results) - failed}/{len(results)} games in "
+          f"{time.time() - start:.1f}s, results in {out}")
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -7,6 +7,9 @@
 #include <conio.h>
 #include <stdlib.h>
 
+#include "sprmove.h"
+#include "shadow.h"
+
 // Sprite pointers at end of screen RAM
 #define SPRITE_PTRS ((unsigned char*)0x07F8)
 
@@ -17,10 +20,6 @@
 #define VIC_SPR_DBL_X  (*(unsigned char*)0xD01D)
 #define VIC_SPR_DBL_Y  (*(unsigned char*)0xD017)
 
-// Sprite positions
-#define SPR0_X (*(unsigned char*)0xD000)
-#define SPR0_Y (*(unsigned char*)0xD001)
-
 // Sprite color
 #define SPR0_COL (*(unsigned char*)0xD027)
 
@@ -37,12 +36,19 @@
 // Sprite data location - $3000 (block 192)
 #define SPRITE_DATA 0x3000
 #define SPRITE_BLOCK_BALL 192
+#define SPR_BALL 0
 
 // Screen boundaries (sprite coordinates)
 #define WALL_TOP     50
 #define WALL_BOTTOM  235
 #define WALL_LEFT    24
-#define WALL_RIGHT   255
+#define WALL_RIGHT   344   // 24 + 320: full width via spr_x bit 8
+
+// Visible width of the expanded ball sprite
+#define BALL_W       40
+
+// Ball speed per axis: 2.0 px/frame plus a random fraction (8.8)
+#define BALL_SPEED   0x0200
 
 // Colors
 #define BLACK   0
@@ -64,10 +70,6 @@ static const unsigned char ball_colors[8] = {
 };
 
 // Game variables
-static unsigned char ball_x;
-static unsigned char ball_y;
-static signed char ball_dx;
-static signed char ball_dy;
 static unsigned char color_index;
 static unsigned char bounce_count;
 
@@ -96,11 +98,6 @@ static const unsigned char ball_sprite[63] = {
     0x00, 0x00, 0x00   // Row 20
 };
 
-// Wait for vertical blank
-void wait_vblank(void) {
-    while (VIC.rasterline != 255) ;
-}
-
 // Initialize SID
 void init_sound(void) {
     SID_VOLUME = 15;
@@ -151,64 +148,53 @@ void init_sprite(void) {
 
 // Initialize ball position and velocity
 void init_ball(void) {
-    ball_x = 140;
-    ball_y = 140;
-
-    // Random initial direction
-    ball_dx = (rand() & 1) ? 2 : -2;
-    ball_dy = (rand() & 1) ? 2 : -2;
+    SPR_PLACE(SPR_BALL, 140, 140);
 
-    // Add some variation
-    if (rand() & 1) ball_dx += (ball_dx > 0) ? 1 : -1;
-    if (rand() & 1) ball_dy += (ball_dy > 0) ? 1 : -1;
+    // Random direction, sub-pixel speed variation
+    spr_dx[SPR_BALL] = BALL_SPEED + (rand() & 0xFF);
+    spr_dy[SPR_BALL] = BALL_SPEED + (rand() & 0xFF);
+    if (rand() & 1) spr_dx[SPR_BALL] = -spr_dx[SPR_BALL];
+    if (rand() & 1) spr_dy[SPR_BALL] = -spr_dy[SPR_BALL];
 
     color_index = 0;
     bounce_count = 0;
 }
 
-// Update sprite position
-void update_sprite(void) {
-    SPR0_X = ball_x;
-    SPR0_Y = ball_y;
-}
-
 // Move ball and handle collisions
 void move_ball(void) {
-    unsigned char new_x, new_y;
     unsigned char bounced = 0;
     unsigned char pitch = 0x20;
 
-    new_x = ball_x + ball_dx;
-    new_y = ball_y + ball_dy;
+    spr_move(1 << SPR_BALL);
 
     // Left wall
-    if (new_x <= WALL_LEFT || (ball_dx < 0 && new_x > ball_x)) {
-        ball_dx = -ball_dx;
-        new_x = WALL_LEFT + 1;
+    if ((int)spr_x[SPR_BALL] <= WALL_LEFT) {
+        spr_dx[SPR_BALL] = -spr_dx[SPR_BALL];
+        spr_x[SPR_BALL] = WALL_LEFT + 1;
         bounced = 1;
         pitch = 0x30;
     }
 
     // Right wall
-    if (new_x >= WALL_RIGHT - 24) {
-        ball_dx = -ball_dx;
-        new_x = WALL_RIGHT - 25;
+    if ((int)spr_x[SPR_BALL] >= WALL_RIGHT - BALL_W) {
+        spr_dx[SPR_BALL] = -spr_dx[SPR_BALL];
+        spr_x[SPR_BALL] = WALL_RIGHT - BALL_W - 1;
         bounced = 1;
         pitch = 0x28;
     }
 
     // Top wall
-    if (new_y <= WALL_TOP) {
-        ball_dy = -ball_dy;
-        new_y = WALL_TOP + 1;
+    if (spr_y[SPR_BALL] <= WALL_TOP) {
+        spr_dy[SPR_BALL] = -spr_dy[SPR_BALL];
+        spr_y[SPR_BALL] = WALL_TOP + 1;
         bounced = 1;
         pitch = 0x38;
     }
 
     // Bottom wall
-    if (new_y >= WALL_BOTTOM - 24) {
-        ball_dy = -ball_dy;
-        new_y = WALL_BOTTOM - 25;
+    if (spr_y[SPR_BALL] >= WALL_BOTTOM - 24) {
+        spr_dy[SPR_BALL] = -spr_dy[SPR_BALL];
+        spr_y[SPR_BALL] = WALL_BOTTOM - 25;
         bounced = 1;
         pitch = 0x20;
     }
@@ -225,9 +211,6 @@ void move_ball(void) {
             bordercolor(ball_colors[color_index]);
         }
     }
-
-    ball_x = new_x;
-    ball_y = new_y;
 }
 
 // Draw status
@@ -253,6 +236,7 @@ int main(void) {
     init_sound();
     init_sprite();
     init_ball();
+    shd_install(SHD_LINE);
 
     // Title
     gotoxy(12, 12);
@@ -268,7 +252,7 @@ int main(void) {
 
     // Main loop
     while (1) {
-        wait_vblank();
+        shd_wait();
         frame++;
 
         // Sound off after short time
@@ -277,7 +261,7 @@ int main(void) {
         }
 
         move_ball();
-        update_sprite();
+        spr_flush();
 
         // Update status occasionally
         if ((frame & 15) == 0) {
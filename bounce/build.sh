@@ -2,7 +2,7 @@
 # Build Bouncing Ball using cc65
 cd "$(dirname "$0")"
 
-cl65 -t c64 -O -o bounce.prg bounce.c
+cl65 -t c64 -O -I ../common -g -m bounce.map -Ln bounce.lbl -Wl --dbgfile,bounce.dbg -o bounce.prg bounce.c ../common/sprmove.s ../common/shadow.s
 
 if [[ -f bounce.prg ]]; then
     echo "Built bounce.prg ($(stat -c%s bounce.prg) bytes)"
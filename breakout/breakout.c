@@ -6,8 +6,15 @@
 #include <c64.h>
 #include <conio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <joystick.h>
 
+#include "sprmove.h"
+#include "ball.h"
+#include "shadow.h"
+#include "level.h"
+#include "levels.h"
+
 // Sprite pointers
 #define SPRITE_PTRS ((unsigned char*)0x07F8)
 
@@ -18,11 +25,7 @@
 #define VIC_SPR_DBL_Y  (*(unsigned char*)0xD017)
 #define VIC_SPR_MCOLOR (*(unsigned char*)0xD01C)
 
-// Sprite positions and colors
-#define SPR0_X   (*(unsigned char*)0xD000)
-#define SPR0_Y   (*(unsigned char*)0xD001)
-#define SPR1_X   (*(unsigned char*)0xD002)
-#define SPR1_Y   (*(unsigned char*)0xD003)
+// Sprite colors
 #define SPR0_COL (*(unsigned char*)0xD027)
 #define SPR1_COL (*(unsigned char*)0xD028)
 
@@ -36,13 +39,17 @@
 // Sprite memory at $3000
 #define SPRITE_DATA 0x3000
 
+// Sprite numbers
+#define SPR_PADDLE 0
+#define SPR_BALL   1
+
 // Play area: columns 1-28 (leaving col 0 and 29+ for walls/score)
 // Sprite X = 24 + column*8
 // Column 1 = X 32, Column 28 = X 248
 #define PLAY_LEFT_COL   1
 #define PLAY_RIGHT_COL  28
 #define WALL_LEFT       (24 + PLAY_LEFT_COL * 8)      // 32
-#define WALL_RIGHT      (24 + (PLAY_RIGHT_COL+1) * 8) // 256, but we use 248
+#define WALL_RIGHT      (24 + (PLAY_RIGHT_COL+1) * 8) // 256 (spr_x is 9-bit)
 #define WALL_TOP        58
 #define PADDLE_Y        216
 
@@ -52,6 +59,7 @@
 #define BRICK_WIDTH     4
 #define BRICK_START_COL 1
 #define BRICK_START_Y   3
+#define BRICK_FLUSH     8   // bricks redrawn per frame, at most
 
 // Colors
 #define BLACK   0
@@ -67,18 +75,21 @@
 
 // Game state
 static unsigned char paddle_x;
-static unsigned char ball_x, ball_y;
-static signed char ball_dx, ball_dy;
 static unsigned int score;
 static unsigned char lives;
-static unsigned char bricks[BRICK_ROWS][BRICK_COLS];
+static unsigned char bricks[BRICK_ROWS][BRICK_COLS];   // hit points, 0 = gone
+static unsigned char brick_dirty[BRICK_ROWS];           // bit c: redraw column c
 static unsigned char bricks_left;
 static unsigned char serve_mode;
 static unsigned char level;
+static unsigned char banner_timer;      // frames until the level banner goes
 
 // Brick colors per row
 static const unsigned char row_colors[5] = { RED, ORANGE, YELLOW, GREEN, CYAN };
 
+// Colors of bricks that take more than one hit (index: hit points)
+static const unsigned char hp_colors[4] = { BLACK, BLACK, GREY, WHITE };
+
 // Paddle sprite - horizontal bar (18 pixels wide)
 static const unsigned char paddle_data[63] = {
     0x00,0x00,0x00, 0x00,0x00,0x00, 0x00,0x00,0x00,
@@ -112,6 +123,13 @@ static const unsigned char ball_data[63] = {
 #define PADDLE_WIDTH 18
 #define BALL_SIZE    8
 
+// Ball speed (8.8 fixed point, along its direction): BALL_SPEED on
+// level 1, BALL_SPEED_UP more per level up to BALL_SPEED_MAX
+#define BALL_SPEED     0x02C0
+#define BALL_SPEED_UP  0x0020
+#define BALL_SPEED_MAX 0x0480
+#define BALL_SERVE_DIR 10       // 43 degrees (see ball.h)
+
 void wait_vblank(void) {
     while (VIC.rasterline != 255);
 }
@@ -161,13 +179,15 @@ void init_sprites(void) {
     VIC_SPR_HI_X = 0;
 }
 
-void draw_brick(unsigned char row, unsigned char col, unsigned char visible) {
+// Draw one brick as its hit points say
+void draw_brick(unsigned char row, unsigned char col) {
     unsigned char *scr = (unsigned char*)0x0400;
     unsigned char *clr = (unsigned char*)0xD800;
     unsigned int pos;
     unsigned char i;
-    unsigned char chr = visible ? 160 : 32;
-    unsigned char color = row_colors[row];
+    unsigned char hp = bricks[row][col];
+    unsigned char chr = hp ? 160 : 32;
+    unsigned char color = hp > 1 ? hp_colors[hp] : row_colors[row];
 
     pos = (BRICK_START_Y + row) * 40 + BRICK_START_COL + (col * BRICK_WIDTH);
     for (i = 0; i < BRICK_WIDTH; i++) {
@@ -176,18 +196,32 @@ void draw_brick(unsigned char row, unsigned char col, unsigned char visible) {
     }
 }
 
-void init_bricks(void) {
-    unsigned char r, c;
-    bricks_left = 0;
+// Redraw up to BRICK_FLUSH bricks marked in brick_dirty; once a frame,
+// so a new wall appears over a few frames without stopping the game
+void flush_bricks(void) {
+    unsigned char r, c, bit;
+    unsigned char n = BRICK_FLUSH;
+
     for (r = 0; r < BRICK_ROWS; r++) {
-        for (c = 0; c < BRICK_COLS; c++) {
-            bricks[r][c] = 1;
-            bricks_left++;
-            draw_brick(r, c, 1);
+        if (!brick_dirty[r]) continue;
+        for (c = 0, bit = 1; c < BRICK_COLS; c++, bit <<= 1) {
+            if (brick_dirty[r] & bit) {
+                brick_dirty[r] &= ~bit;
+                draw_brick(r, c);
+                if (--n == 0) return;
+            }
         }
     }
 }
 
+// Unpack this level's wall from the bank (levels.h, from levelgen.py)
+// and mark every brick for redraw
+void init_bricks(void) {
+    bricks_left = lv_unpack(&bricks[0][0],
+        level_bank + (level - 1) % LEVEL_COUNT * LEVEL_SIZE);
+    memset(brick_dirty, (1 << BRICK_COLS) - 1, BRICK_ROWS);
+}
+
 void draw_field(void) {
     unsigned char y;
     unsigned char *scr = (unsigned char*)0x0400;
@@ -220,19 +254,17 @@ void init_game(void) {
     // Center paddle in play area
     paddle_x = WALL_LEFT + 90;  // Center-ish
 
-    // Ball on paddle
-    ball_x = paddle_x + 6;
-    ball_y = PADDLE_Y - 12;
-    ball_dx = 2;
-    ball_dy = -2;
+    // Ball on paddle, a little faster every level
+    SPR_PLACE(SPR_BALL, paddle_x + 6, PADDLE_Y - 12);
+    ball_speed = BALL_SPEED + (level - 1) * BALL_SPEED_UP;
+    if (ball_speed > BALL_SPEED_MAX) ball_speed = BALL_SPEED_MAX;
     serve_mode = 1;
 }
 
 void update_sprites(void) {
-    SPR0_X = paddle_x;
-    SPR0_Y = PADDLE_Y;
-    SPR1_X = ball_x;
-    SPR1_Y = ball_y;
+    spr_x[SPR_PADDLE] = paddle_x;
+    spr_y[SPR_PADDLE] = PADDLE_Y;
+    spr_flush();
 }
 
 void draw_status(void) {
@@ -264,19 +296,19 @@ void read_input(void) {
     if (JOY_LEFT(joy) && paddle_x > WALL_LEFT + 4) {
         paddle_x -= speed;
     }
-    if (JOY_RIGHT(joy) && paddle_x < 248 - PADDLE_WIDTH - 4) {
+    if (JOY_RIGHT(joy) && paddle_x < WALL_RIGHT - PADDLE_WIDTH - 4) {
         paddle_x += speed;
     }
 
     // Ball follows paddle in serve mode
     if (serve_mode) {
-        ball_x = paddle_x + (PADDLE_WIDTH / 2) - (BALL_SIZE / 2);
-        ball_y = PADDLE_Y - 12;
+        SPR_PLACE(SPR_BALL, paddle_x + (PADDLE_WIDTH / 2) - (BALL_SIZE / 2),
+                  PADDLE_Y - 12);
 
         if (JOY_FIRE(joy)) {
             serve_mode = 0;
-            ball_dx = (rand() & 1) ? 2 : -2;
-            ball_dy = -2;
+            ball_aim(BALL_SERVE_DIR | BALL_ALONG_NEG
+                     | ((rand() & 1) ? BALL_ACROSS_NEG : 0));
         }
     }
 }
@@ -309,10 +341,11 @@ unsigned char check_brick_hit(unsigned char bx, unsigned char by) {
     if (brick_col < 0 || brick_col >= BRICK_COLS) return 0;
 
     if (bricks[brick_row][brick_col]) {
-        bricks[brick_row][brick_col] = 0;
-        bricks_left--;
-        draw_brick(brick_row, brick_col, 0);
-        score += 10 * level;
+        brick_dirty[brick_row] |= 1 << brick_col;
+        if (--bricks[brick_row][brick_col] == 0) {
+            bricks_left--;
+            score += 10 * level;
+        }
         sound_bounce(0x30 + brick_row * 8);
         return 1;
     }
@@ -322,33 +355,20 @@ unsigned char check_brick_hit(unsigned char bx, unsigned char by) {
 void move_ball(void) {
     unsigned char new_x, new_y;
     unsigned char hit = 0;
+    unsigned char walls;
     signed char paddle_center_offset;
 
     if (serve_mode) return;
 
-    new_x = ball_x + ball_dx;
-    new_y = ball_y + ball_dy;
-
-    // Left wall collision (sprite X = 32 is column 1)
-    if (new_x <= WALL_LEFT + 8) {
-        ball_dx = -ball_dx;
-        new_x = WALL_LEFT + 9;
-        sound_bounce(0x20);
-    }
-
-    // Right wall collision (column 29 = sprite X 256, but we use 248)
-    if (new_x >= 248 - BALL_SIZE) {
-        ball_dx = -ball_dx;
-        new_x = 248 - BALL_SIZE - 1;
-        sound_bounce(0x20);
-    }
-
-    // Top wall collision
-    if (new_y <= WALL_TOP) {
-        ball_dy = -ball_dy;
-        new_y = WALL_TOP + 1;
+    // Move; ball_step() bounces off the side walls and the top
+    walls = ball_step();
+    if (walls & BALL_HIT_TOP) {
         sound_bounce(0x28);
+    } else if (walls) {
+        sound_bounce(0x20);
     }
+    new_x = (unsigned char)spr_x[SPR_BALL];
+    new_y = spr_y[SPR_BALL];
 
     // Brick collision - check ball corners
     hit = check_brick_hit(new_x + 2, new_y + 2);
@@ -357,19 +377,16 @@ void move_ball(void) {
     if (!hit) hit = check_brick_hit(new_x + BALL_SIZE - 2, new_y + BALL_SIZE - 2);
 
     if (hit) {
-        ball_dy = -ball_dy;
+        spr_dy[SPR_BALL] = -spr_dy[SPR_BALL];
     }
 
     // Paddle collision
-    if (new_y >= PADDLE_Y - 10 && ball_dy > 0) {
+    if (new_y >= PADDLE_Y - 10 && spr_dy[SPR_BALL] > 0) {
         if (new_x + BALL_SIZE >= paddle_x && new_x <= paddle_x + PADDLE_WIDTH) {
-            // Calculate angle based on where ball hits paddle
+            // Angle from where the ball hits the paddle, out of the
+            // ball.s direction table: steeper towards the ends
             paddle_center_offset = (signed char)((new_x + BALL_SIZE/2) - (paddle_x + PADDLE_WIDTH/2));
-            ball_dx = paddle_center_offset / 3;
-            if (ball_dx == 0) ball_dx = (rand() & 1) ? 1 : -1;
-            if (ball_dx > 3) ball_dx = 3;
-            if (ball_dx < -3) ball_dx = -3;
-            ball_dy = -2;
+            ball_aim(BALL_DIR(paddle_center_offset, 0) | BALL_ALONG_NEG);
             new_y = PADDLE_Y - 11;
             sound_bounce(0x38);
         }
@@ -402,8 +419,8 @@ void move_ball(void) {
         return;
     }
 
-    ball_x = new_x;
-    ball_y = new_y;
+    spr_x[SPR_BALL] = new_x;
+    spr_y[SPR_BALL] = new_y;
 }
 
 int main(void) {
@@ -415,6 +432,15 @@ int main(void) {
 
     init_sound();
     init_sprites();
+    shd_install(SHD_LINE);
+
+    // Ball physics: main axis Y, walls left, right and top
+    ball_spr = SPR_BALL;
+    ball_vertical = 1;
+    ball_top = WALL_TOP + 1;
+    ball_bottom = BALL_NO_BOTTOM;
+    ball_left = WALL_LEFT + 9;
+    ball_right = WALL_RIGHT - BALL_SIZE - 1;
     joy_install(joy_static_stddrv);
 
     // Title screen
@@ -454,8 +480,9 @@ int main(void) {
 
     // Main loop
     while (1) {
-        wait_vblank();
+        shd_wait();
         frame++;
+        flush_bricks();
 
         if ((frame & 7) == 0) sound_off();
 
@@ -476,15 +503,17 @@ int main(void) {
             gotoxy(10, 12);
             textcolor(YELLOW);
             cprintf("LEVEL %u COMPLETE!", level);
+            banner_timer = 120;
 
-            frame = 0;
-            while (frame < 120) { wait_vblank(); frame++; }
-
-            draw_field();
+            // The next wall builds up while the ball waits on the paddle
             init_bricks();
             init_game();
             draw_status();
         }
+
+        if (banner_timer && --banner_timer == 0) {
+            cclearxy(10, 12, 19);
+        }
     }
 
     return 0;
@@ -1,6 +1,7 @@
 #!/bin/bash
 cd "$(dirname "$0")"
-cl65 -t c64 -O -o breakout.prg breakout.c
+python3 ../common/levelgen.py 5 7 levels.h
+cl65 -t c64 -O -I ../common -g -m breakout.map -Ln breakout.lbl -Wl --dbgfile,breakout.dbg -o breakout.prg breakout.c ../common/sprmove.s ../common/ball.s ../common/shadow.s ../common/level.s
 if [[ -f breakout.prg ]]; then
     echo "Built breakout.prg ($(stat -c%s breakout.prg) bytes)"
 else
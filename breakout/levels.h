@@ -0,0 +1,236 @@
+#ifndef BREAKOUT_LEVELS_H
+#define BREAKOUT_LEVELS_H
+
+/* Generated by levelgen.py. Edit the patterns there, then rerun it. */
+
+#define LEVEL_COUNT 32
+#define LEVEL_SIZE  11
+
+static const unsigned char level_bank[LEVEL_COUNT * LEVEL_SIZE] = {
+    /* level 1 */
+    0x57,
+    0x00,0xFE,   /* 1111111 */
+    0x00,0xFE,   /* 1111111 */
+    0x00,0xFE,   /* 1111111 */
+    0x00,0xFE,   /* 1111111 */
+    0x00,0xFE,   /* 1111111 */
+    /* level 2 */
+    0x57,
+    0xFE,0x00,   /* 2222222 */
+    0x00,0xFE,   /* 1111111 */
+    0x00,0xFE,   /* 1111111 */
+    0x00,0xFE,   /* 1111111 */
+    0x00,0xFE,   /* 1111111 */
+    /* level 3 */
+    0x57,
+    0x54,0xAA,   /* 1212121 */
+    0xAA,0x54,   /* 2121212 */
+    0x54,0xAA,   /* 1212121 */
+    0xAA,0x54,   /* 2121212 */
+    0x54,0xAA,   /* 1212121 */
+    /* level 4 */
+    0x57,
+    0xFE,0xFE,   /* 3333333 */
+    0xFE,0xFE,   /* 3333333 */
+    0xFE,0xFE,   /* 3333333 */
+    0xFE,0x00,   /* 2222222 */
+    0x00,0xFE,   /* 1111111 */
+    /* level 5 */
+    0x57,
+    0xA0,0x0A,   /* 2.2.1.1 */
+    0x00,0x82,   /* 1.....1 */
+    0x00,0x44,   /* .1...1. */
+    0x00,0xAA,   /* 1.1.1.1 */
+    0x02,0xB8,   /* 1.111.2 */
+    /* level 6 */
+    0x57,
+    0x10,0x28,   /* ..121.. */
+    0x10,0x7C,   /* .11311. */
+    0x38,0xC6,   /* 1122211 */
+    0x10,0x7C,   /* .11311. */
+    0x00,0x38,   /* ..111.. */
+    /* level 7 */
+    0x57,
+    0xA8,0x02,   /* 2.2.2.1 */
+    0x00,0xAA,   /* 1.1.1.1 */
+    0xAA,0x08,   /* 2.2.3.2 */
+    0x08,0xA2,   /* 1.1.2.1 */
+    0x08,0xA2,   /* 1.1.2.1 */
+    /* level 8 */
+    0x57,
+    0xFE,0xFE,   /* 3333333 */
+    0xC2,0xBE,   /* 3211113 */
+    0x82,0xFE,   /* 3111113 */
+    0xB2,0xCE,   /* 3122113 */
+    0xBE,0xBE,   /* 3.33333 */
+    /* level 9 */
+    0x57,
+    0x82,0x78,   /* 21111.2 */
+    0xE6,0x10,   /* 2221.22 */
+    0x00,0xFA,   /* 11111.1 */
+    0x00,0xFC,   /* 111111. */
+    0x30,0xCA,   /* 11221.1 */
+    /* level 10 */
+    0x57,
+    0x08,0x74,   /* .11121. */
+    0x24,0xCA,   /* 112.121 */
+    0x00,0x92,   /* 1..1..1 */
+    0x04,0x40,   /* .1...2. */
+    0x00,0x44,   /* .1...1. */
+    /* level 11 */
+    0x57,
+    0x78,0x14,   /* .22321. */
+    0xBC,0x42,   /* 2122221 */
+    0x7C,0xAA,   /* 1232321 */
+    0x3E,0xD0,   /* 1123222 */
+    0x54,0x38,   /* .21312. */
+    /* level 12 */
+    0x57,
+    0x20,0xDE,   /* 1121111 */
+    0x00,0x00,   /* ....... */
+    0x08,0xF6,   /* 1111211 */
+    0x00,0x00,   /* ....... */
+    0xFE,0xC0,   /* 3322222 */
+    /* level 13 */
+    0x57,
+    0xFE,0xFE,   /* 3333333 */
+    0x82,0xFE,   /* 3111113 */
+    0x9A,0xE6,   /* 3112213 */
+    0x8A,0xF6,   /* 3111213 */
+    0xBE,0xBE,   /* 3.33333 */
+    /* level 14 */
+    0x57,
+    0x36,0x48,   /* .122122 */
+    0x18,0xA6,   /* 1.12211 */
+    0x92,0x4C,   /* 21.2112 */
+    0x28,0x96,   /* 1.21211 */
+    0x14,0x6A,   /* .112121 */
+    /* level 15 */
+    0x57,
+    0x20,0x18,   /* ..211.. */
+    0x08,0x74,   /* .11121. */
+    0x10,0x00,   /* ...2... */
+    0x46,0x90,   /* 12.1.22 */
+    0x04,0xFA,   /* 1111121 */
+    /* level 16 */
+    0x57,
+    0x10,0x28,   /* ..121.. */
+    0x50,0x2C,   /* .21211. */
+    0x7C,0x82,   /* 1222221 */
+    0x3C,0x40,   /* .12222. */
+    0x10,0x28,   /* ..121.. */
+    /* level 17 */
+    0x57,
+    0x82,0x28,   /* 2.1.1.2 */
+    0x22,0x88,   /* 1.2.1.2 */
+    0xAA,0x00,   /* 2.2.2.2 */
+    0x80,0x2A,   /* 2.1.1.1 */
+    0xAA,0x02,   /* 2.2.2.3 */
+    /* level 18 */
+    0x57,
+    0xFE,0xFE,   /* 3333333 */
+    0x96,0xEA,   /* 3112123 */
+    0xA6,0xDA,   /* 3121123 */
+    0xDE,0xA2,   /* 3212223 */
+    0xEE,0xEE,   /* 333.333 */
+    /* level 19 */
+    0x57,
+    0x3A,0x44,   /* .122212 */
+    0x1A,0xA4,   /* 1.12212 */
+    0x40,0x9E,   /* 12.1111 */
+    0x44,0xAA,   /* 121.121 */
+    0x86,0x58,   /* 21.1122 */
+    /* level 20 */
+    0x57,
+    0xAA,0x44,   /* 212.212 */
+    0x28,0x54,   /* .12121. */
+    0xC4,0x12,   /* 22.1.21 */
+    0x32,0x88,   /* 1.221.2 */
+    0x9A,0x20,   /* 2.122.2 */
+    /* level 21 */
+    0x57,
+    0x3C,0x50,   /* .12322. */
+    0xFE,0x18,   /* 2223322 */
+    0xFE,0x78,   /* 2333322 */
+    0xFC,0x02,   /* 2222221 */
+    0x1C,0x70,   /* .11322. */
+    /* level 22 */
+    0x57,
+    0x88,0x22,   /* 2.1.2.1 */
+    0xA0,0x0A,   /* 2.2.1.1 */
+    0xAA,0xAA,   /* 3.3.3.3 */
+    0x80,0x2A,   /* 2.1.1.1 */
+    0x2A,0x80,   /* 1.2.2.2 */
+    /* level 23 */
+    0x57,
+    0xFE,0xFE,   /* 3333333 */
+    0xFE,0x82,   /* 3222223 */
+    0x9E,0xE2,   /* 3112223 */
+    0xA6,0xDA,   /* 3121123 */
+    0xDE,0xDE,   /* 33.3333 */
+    /* level 24 */
+    0x57,
+    0x30,0xCA,   /* 11221.1 */
+    0xA4,0x52,   /* 2121.21 */
+    0xF2,0x08,   /* 22221.2 */
+    0x30,0xC6,   /* 1122.11 */
+    0xA8,0x46,   /* 212.211 */
+    /* level 25 */
+    0x57,
+    0x92,0x44,   /* 21.2.12 */
+    0x8E,0x70,   /* 2111222 */
+    0x3C,0xC2,   /* 1122221 */
+    0xF4,0x0A,   /* 2222121 */
+    0x50,0x86,   /* 12.2.11 */
+    /* level 26 */
+    0x57,
+    0x28,0x10,   /* ..212.. */
+    0x58,0x34,   /* .21321. */
+    0x78,0xBE,   /* 1233311 */
+    0x58,0x24,   /* .21221. */
+    0x38,0x00,   /* ..222.. */
+    /* level 27 */
+    0x57,
+    0x82,0x28,   /* 2.1.1.2 */
+    0x88,0x22,   /* 2.1.2.1 */
+    0xAA,0x82,   /* 3.2.2.3 */
+    0x08,0xA2,   /* 1.1.2.1 */
+    0x20,0x8A,   /* 1.2.1.1 */
+    /* level 28 */
+    0x57,
+    0xFE,0xFE,   /* 3333333 */
+    0x9E,0xE2,   /* 3112223 */
+    0xFE,0x82,   /* 3222223 */
+    0xFE,0x82,   /* 3222223 */
+    0xFA,0xFA,   /* 33333.3 */
+    /* level 29 */
+    0x57,
+    0xC6,0x18,   /* 22.1122 */
+    0xA0,0x4E,   /* 212.111 */
+    0x22,0xD4,   /* 1121.12 */
+    0x80,0x6E,   /* 211.111 */
+    0x44,0x9A,   /* 12.1121 */
+    /* level 30 */
+    0x57,
+    0xC4,0x12,   /* 22.1.21 */
+    0x9E,0x60,   /* 2112222 */
+    0xA0,0x5E,   /* 2121111 */
+    0x64,0x08,   /* .22.12. */
+    0x06,0xF8,   /* 1111122 */
+    /* level 31 */
+    0x57,
+    0x7C,0x10,   /* .22322. */
+    0xFC,0x0A,   /* 2222321 */
+    0x7E,0xF8,   /* 1333322 */
+    0x3E,0xE8,   /* 1132322 */
+    0x7C,0x00,   /* .22222. */
+    /* level 32 */
+    0x57,
+    0x28,0x82,   /* 1.2.2.1 */
+    0xA8,0x02,   /* 2.2.2.1 */
+    0xAA,0xA2,   /* 3.3.2.3 */
+    0xAA,0x00,   /* 2.2.2.2 */
+    0x02,0xA8   /* 1.1.1.2 */
+};
+
+#endif
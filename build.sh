@@ -24,8 +24,12 @@ if [[ ! -f "$PROJECT_DIR/build.sh" ]]; then
   exit 1
 fi
 
-# Build
-( cd "$PROJECT_DIR" && bash ./build.sh )
+# Build (incrementally through build_all.py when Python is available)
+if command -v python3 >/dev/null 2>&1; then
+  python3 "$ROOT_DIR/build_all.py" -q "$PROJECT"
+else
+  ( cd "$PROJECT_DIR" && bash ./build.sh )
+fi
 
 # Determine output PRG inside project
 PRG_IN_PROJECT="${2:-}"
@@ -46,10 +50,13 @@ fi
 # For compatibility with existing VS Code task, always expose a root-level snake.prg
 cp -f "$PROJECT_DIR/$PRG_IN_PROJECT" "$ROOT_DIR/snake.prg"
 
-# Also expose map if present (useful when building snake/ or tetris)
-if [[ -f "$PROJECT_DIR/${PRG_IN_PROJECT%.prg}.map" ]]; then
-  cp -f "$PROJECT_DIR/${PRG_IN_PROJECT%.prg}.map" "$ROOT_DIR/snake.map"
-fi
+# Also expose the symbol files (map, VICE labels, ld65 debug info) so the
+# monitor tools can resolve variables by name
+for EXT in map lbl dbg; do
+  if [[ -f "$PROJECT_DIR/${PRG_IN_PROJECT%.prg}.$EXT" ]]; then
+    cp -f "$PROJECT_DIR/${PRG_IN_PROJECT%.prg}.$EXT" "$ROOT_DIR/snake.$EXT"
+  fi
+done
 
 SIZE=$(stat -c%s "$ROOT_DIR/snake.prg" 2>/dev/null || wc -c < "$ROOT_DIR/snake.prg")
 echo "Built $PROJECT/$PRG_IN_PROJECT -> snake.prg ($SIZE bytes)"
@@ -0,0 +1,668 @@
+#!/usr/bin/env python3
+"""
+build_all.py - Parallel incremental builder for the C64 projects
+
+Reads each project's own recipe (build.sh, or the Makefile for the
+Makefile projects) and runs it as a dependency graph:
+
+    generators (spritegen.py, pack.py, ...)  ->  generated headers
+    cl65 -c per source file                  ->  object files
+    cl65 link                                ->  <project>.prg
+
+Every step is keyed by a content hash of what it reads (sources, the
+headers cc65/ca65 report through --create-dep, flags, linker config,
+the cc65 version), and its results are kept in .buildcache/. A step
+whose key is cached is not run again, so editing one header only
+recompiles the files that include it, and a shared ../common/*.s file
+is assembled once for all projects with the same flags.
+
+Projects build concurrently, and their compile steps share one pool of
+workers. Objects go to .buildcache/, never next to the sources, so
+parallel builds no longer race on ../common/*.o.
+
+A project whose input files all have the size and mtime recorded by its
+last build is skipped without hashing or starting any tool, which keeps
+a no-op build of the whole tree well under a second.
+
+After each link the memory layout is checked with memmap.py: code or
+BSS running into sprite data, charsets or the C stack is reported.
+
+A build.sh line the recipe reader does not understand makes that
+project fall back to running its build.sh as a whole (one at a time),
+rebuilt only when a file in its directory changes.
+
+Usage:
+    python3 build_all.py                 # Build every project
+    python3 build_all.py pong arkanoid   # Build some
+    python3 build_all.py -j 4            # At most 4 jobs at once
+    python3 build_all.py --force         # Ignore the cache
+    python3 build_all.py --clean         # Drop .buildcache/
+    python3 build_all.py -n pong         # Show the recipe, build nothing
+
+Requirements:
+    - cc65 (cl65) on PATH
+
+Author: C64AIToolChain Project
+"""
+
+import argparse
+import hashlib
+import json
+import os
+import re
+import shlex
+import shutil
+import subprocess
+import sys
+import threading
+import time
+from concurrent.futures import ThreadPoolExecutor
+from functools import lru_cache
+from pathlib import Path
+
+ROOT = Path(__file__).resolve().parent
+CACHE = ROOT / '.buildcache'
+OBJECTS = CACHE / 'objects'     # content-addressed objects
+GENERATED = CACHE / 'generated' # content-addressed generator outputs
+DEPS = CACHE / 'deps'           # header lists from --create-dep
+STATE = CACHE / 'state'         # per project: stamps and keys
+
+# Files never treated as inputs of a project
+OUTPUT_SUFFIXES = {'.prg', '.o', '.map', '.lbl', '.dbg', '.d64', '.png', '.mp4',
+                   '.gif', '.jpg', '.vsf'}
+
+# cl65 options by the step they belong to; the rest of the line is files
+OPTS_BOTH = {'-t', '--target', '--cpu'}
+OPTS_COMPILE_ARG = {'-I', '-D', '--include-dir', '--asm-include-dir',
+                    '--asm-define', '--bin-include-dir'}
+OPTS_COMPILE = {'-O', '-Oi', '-Or', '-Os', '-Oir', '-Ors', '-Ois', '-Oirs',
+                '-g', '-T', '--debug-info', '--add-source'}
+OPTS_LINK_ARG = {'-C', '-m', '-Ln', '-u', '-S', '-Wl', '--config', '--mapfile',
+                 '--start-addr', '--lib', '--obj', '--lib-path'}
+OPTS_LINK = {'-vm'}
+
+# Shell lines of a build.sh that do not change what gets built
+IGNORED = re.compile(r'^(#|cd\b|echo\b|set\b|if\b|then\b|else\b|fi\b|exit\b)')
+ASSIGN = re.compile(r'^([A-Za-z_][A-Za-z0-9_]*)=(.*)$')
+
+print_lock = threading.Lock()
+
+
+def log(msg):
+    with print_lock:
+        print(msg, flush=True)
+
+
+def sha(*parts):
+    h = hashlib.sha1()
+    for p in parts:
+        h.update(p if isinstance(p, bytes) else str(p).encode())
+        h.update(b'\0')
+    return h.hexdigest()
+
+
+def file_hash(path):
+    try:
+        return hashlib.sha1(Path(path).read_bytes()).hexdigest()
+    except OSError:
+        return None
+
+
+def stat_of(path):
+    try:
+        st = os.stat(path)
+        return [st.st_mtime_ns, st.st_size]
+    except OSError:
+        return None
+
+
+def rel(path):
+    """Path relative to the repo root, for keys and messages."""
+    return os.path.relpath(path, ROOT)
+
+
+@lru_cache(maxsize=None)
+def toolchain_id():
+    """cl65 version string, part of every compile and link key."""
+    try:
+        r = subprocess.run(['cl65', '--version'], capture_output=True, text=True)
+        return (r.stdout + r.stderr).strip()
+    except OSError:
+        return 'cl65 missing'
+
+
+# ---------------------------------------------------------------------------
+# Recipes
+# ---------------------------------------------------------------------------
+
+class Recipe:
+    """What one project builds and from what."""
+
+    def __init__(self, name):
+        self.name = name
+        self.dir = ROOT / name
+        self.script = None      # build.sh / Makefile, itself an input
+        self.gens = []          # (command list, input paths, output paths)
+        self.compile = []       # cl65 options for -c
+        self.link = []          # cl65 options for the link
+        self.sources = []       # as written, relative to the project
+        self.output = None
+        self.fallback = None    # why build.sh has to run as a whole
+
+    def describe(self):
+        lines = [f"{self.name}:"]
+        if self.fallback:
+            lines.append(f"  bash ./build.sh  ({self.fallback})")
+            return '\n'.join(lines)
+        for cmd, ins, outs in self.gens:
+            lines.append(f"  gen  {' '.join(cmd)}")
+        for src in self.sources:
+            lines.append(f"  cc   cl65 -c {' '.join(self.compile)} {src}")
+        lines.append(f"  link cl65 {' '.join(self.link)} -o {self.output}")
+        return '\n'.join(lines)
+
+
+def split_cl65(recipe, args):
+    """Sort cl65 arguments into compile/link options and sources."""
+    i = 0
+    while i < len(args):
+        a = args[i]
+        take = None
+        for opt in OPTS_BOTH | OPTS_COMPILE_ARG | OPTS_LINK_ARG | {'-o'}:
+            if a == opt and i + 1 < len(args):
+                take = [a, args[i + 1]]
+                i += 2
+                break
+            if len(opt) == 2 and a.startswith(opt) and len(a) > 2 \
+                    and not a.startswith('--'):
+                take = [opt, a[2:]]
+                i += 1
+                break
+        if take:
+            opt, val = take
+            if opt == '-o':
+                recipe.output = val
+            elif opt in OPTS_BOTH:
+                recipe.compile += take
+                recipe.link += take
+            elif opt in OPTS_COMPILE_ARG:
+                recipe.compile += take
+            else:
+                recipe.link += take
+            continue
+        if a in OPTS_COMPILE:
+            recipe.compile.append(a)
+        elif a in OPTS_LINK:
+            recipe.link.append(a)
+        elif a.startswith('-'):
+            recipe.fallback = f"unknown cl65 option {a}"
+            return
+        elif a.endswith(('.c', '.s')):
+            recipe.sources.append(a)
+        else:
+            recipe.fallback = f"unknown cl65 argument {a}"
+            return
+        i += 1
+
+
+def script_inputs(pdir, script):
+    """Files in the project a generator script names, e.g. deck_bitmap.pgm."""
+    text = script.read_text(errors='replace')
+    return sorted(p for p in pdir.iterdir()
+                  if p.is_file() and p != script and p.name in text
+                  and p.suffix not in OUTPUT_SUFFIXES)
+
+
+def recipe_from_build_sh(recipe):
+    text = recipe.script.read_text().replace('\\\n', ' ')
+    env = {}
+    for raw in text.splitlines():
+        line = raw.strip()
+        if not line or line.startswith('#!') or IGNORED.match(line):
+            continue
+        m = ASSIGN.match(line)
+        if m:
+            # SCRIPT_DIR=$(cd ... && pwd), NAME=$(basename "$PWD"): the
+            # only forms the projects use
+            var, val = m.groups()
+            if 'basename' in val:
+                env[var] = recipe.name
+            elif 'pwd' in val or 'dirname' in val:
+                env[var] = '.'
+            else:
+                env[var] = shlex.split(val)[0] if val else ''
+            continue
+        for var, val in env.items():
+            line = line.replace('${' + var + '}', val).replace('$' + var, val)
+        words = shlex.split(line)
+        if '$' in line:
+            recipe.fallback = f"unexpanded variable: {raw.strip()}"
+            return
+        if words[0] == 'python3' and len(words) >= 2:
+            script = recipe.dir / words[1]
+            recipe.gens.append((words, [script] + script_inputs(recipe.dir, script),
+                                ()))
+        elif words[0] == 'cl65':
+            if recipe.output:
+                recipe.fallback = "more than one cl65 command"
+                return
+            split_cl65(recipe, words[1:])
+            if recipe.fallback:
+                return
+        else:
+            recipe.fallback = f"unknown command: {raw.strip()}"
+            return
+    if not recipe.output or not recipe.sources:
+        recipe.fallback = "no cl65 command"
+
+
+def recipe_from_makefile(recipe):
+    text = recipe.script.read_text().replace('\\\n', ' ')
+    var = {}
+    rules = {}
+    for line in text.splitlines():
+        m = re.match(r'^([A-Z_]+)\s*[:?]?=\s*(.*)$', line)
+        if m:
+            var[m.group(1)] = m.group(2).strip()
+            continue
+        m = re.match(r'^([^\s:=]+)\s*:\s*([^=]*)$', line)
+        if m:
+            rules[m.group(1)] = m.group(2).split()
+
+    def expand(s):
+        return re.sub(r'\$\((\w+)\)', lambda m: expand(var.get(m.group(1), '')), s)
+
+    if expand(var.get('CC', 'cl65')) != 'cl65' or 'SOURCES' not in var:
+        recipe.fallback = "Makefile without CC = cl65 and SOURCES"
+        return
+    split_cl65(recipe, shlex.split(expand(var.get('CFLAGS', ''))
+                                   + ' ' + expand(var.get('LDFLAGS', ''))))
+    recipe.sources = expand(var['SOURCES']).split()
+    recipe.output = expand(var.get('PROGRAM', f"{recipe.name}.prg"))
+    for target in expand(var.get('PACKED', '')).split():
+        if target in rules:
+            prereqs = [expand(p) for p in rules[target]]
+        elif '%_z.h' in rules and target.endswith('_z.h'):
+            stem = target[:-len('_z.h')]
+            prereqs = [p.replace('%', stem) for p in rules['%_z.h']]
+        else:
+            recipe.fallback = f"no rule for {target}"
+            return
+        recipe.gens.append((['make', '-s', target],
+                            [recipe.dir / p for p in prereqs],
+                            (target,)))
+
+
+@lru_cache(maxsize=None)
+def read_recipe(name):
+    recipe = Recipe(name)
+    if (recipe.dir / 'build.sh').is_file():
+        recipe.script = recipe.dir / 'build.sh'
+        recipe_from_build_sh(recipe)
+    elif (recipe.dir / 'Makefile').is_file():
+        recipe.script = recipe.dir / 'Makefile'
+        recipe_from_makefile(recipe)
+    else:
+        recipe.fallback = "no build.sh or Makefile"
+    return recipe
+
+
+def all_projects():
+    return sorted(p.name for p in ROOT.iterdir()
+                  if p.is_dir() and not p.name.startswith(('.', '_'))
+                  and ((p / 'build.sh').is_file() or (p / 'Makefile').is_file()))
+
+
+# ---------------------------------------------------------------------------
+# Steps
+# ---------------------------------------------------------------------------
+
+def store(src, dst):
+    """Atomically place src's content at dst (both on this filesystem)."""
+    tmp = f"{dst}.{os.getpid()}.{threading.get_ident()}"
+    shutil.copyfile(src, tmp)
+    os.replace(tmp, dst)
+
+
+def restore(src, dst):
+    """Copy a cached file into the tree, leaving it alone when equal."""
+    if file_hash(dst) != file_hash(src):
+        store(src, dst)
+
+
+def run(cmd, cwd):
+    r = subprocess.run(cmd, cwd=cwd, capture_output=True, text=True)
+    return r.returncode == 0, (r.stdout + r.stderr).strip()
+
+
+def snapshot_dir(pdir):
+    return {p.name: stat_of(p) for p in pdir.iterdir() if p.is_file()}
+
+
+def run_generator(recipe, cmd, inputs, outputs, counts, force=False):
+    """Run one header generator, or restore its outputs from the cache."""
+    key = sha('gen', ' '.join(cmd), *[file_hash(p) for p in inputs])
+    cached = GENERATED / key
+    manifest = cached / 'outputs.json'
+    if manifest.exists() and not force:
+        for name in json.loads(manifest.read_text()):
+            restore(cached / name, recipe.dir / name)
+        counts['cached'] += 1
+        return True, ''
+
+    before = snapshot_dir(recipe.dir)
+    ok, out = run(cmd, recipe.dir)
+    if not ok:
+        return False, f"{' '.join(cmd)}\n{out}"
+    after = snapshot_dir(recipe.dir)
+    made = list(outputs) or sorted(
+        n for n, st in after.items()
+        if before.get(n) != st and Path(n).suffix not in OUTPUT_SUFFIXES)
+    tmp = GENERATED / f"{key}.{os.getpid()}.{threading.get_ident()}"
+    tmp.mkdir(parents=True, exist_ok=True)
+    for name in made:
+        shutil.copyfile(recipe.dir / name, tmp / name)
+    (tmp / 'outputs.json').write_text(json.dumps(made))
+    if force:
+        shutil.rmtree(cached, ignore_errors=True)
+    try:
+        os.replace(tmp, cached)
+    except OSError:
+        shutil.rmtree(tmp, ignore_errors=True)  # another job stored it first
+    counts['ran'] += 1
+    return True, ''
+
+
+def parse_deps(path, cwd):
+    """Files listed in a make-style dependency file from --create-dep."""
+    text = Path(path).read_text().replace('\\\n', ' ')
+    files = []
+    for line in text.splitlines():
+        if ':' in line:
+            for word in line.split(':', 1)[1].split():
+                files.append(os.path.normpath(os.path.join(cwd, word)))
+    return sorted(set(files))
+
+
+class Compiler:
+    """
+    Shared pool of compile jobs; one job per distinct object key.
+
+    With force, cached objects are only reused once this run has
+    compiled them (a ../common source shared by several projects).
+    """
+
+    def __init__(self, jobs, force=False):
+        self.pool = ThreadPoolExecutor(max_workers=jobs)
+        self.lock = threading.Lock()
+        self.running = {}
+        self.force = force
+        self.fresh = set()
+
+    def object_for(self, recipe, src):
+        """Future of (ok, object path or error text, compiled?)."""
+        path = os.path.normpath(recipe.dir / src)
+        what = sha('cc', rel(path), *recipe.compile)
+        deps_file = DEPS / f"{what}.json"
+        key = None
+        if deps_file.exists() and (not self.force or what in self.fresh):
+            deps = json.loads(deps_file.read_text())
+            hashes = [file_hash(d) for d in deps]
+            if None not in hashes:
+                key = sha(what, toolchain_id(), *deps, *hashes)
+                if (OBJECTS / f"{key}.o").exists():
+                    return None, OBJECTS / f"{key}.o"
+        with self.lock:
+            job = self.running.get(what)
+            if job is None:
+                job = self.pool.submit(self.compile, recipe, src, path, what,
+                                       deps_file)
+                self.running[what] = job
+        return job, None
+
+    def compile(self, recipe, src, path, what, deps_file):
+        tag = f"{os.getpid()}.{threading.get_ident()}"
+        tmp_obj = OBJECTS / f"tmp.{tag}.o"
+        tmp_dep = DEPS / f"tmp.{tag}.d"
+        cmd = (['cl65', '-c'] + recipe.compile +
+               ['--create-dep', str(tmp_dep), '-o', str(tmp_obj), src])
+        ok, out = run(cmd, recipe.dir)
+        if not ok:
+            tmp_obj.unlink(missing_ok=True)
+            tmp_dep.unlink(missing_ok=True)
+            with self.lock:
+                self.running.pop(what, None)
+            return False, f"{rel(path)}:\n{out}"
+        deps = [path]
+        if tmp_dep.exists():
+            deps = sorted(set(deps + parse_deps(tmp_dep, recipe.dir)))
+            tmp_dep.unlink()
+        key = sha(what, toolchain_id(), *deps, *[file_hash(d) for d in deps])
+        os.replace(tmp_obj, OBJECTS / f"{key}.o")
+        tmp = deps_file.with_suffix(f".{tag}")
+        tmp.write_text(json.dumps(deps))
+        os.replace(tmp, deps_file)
+        with self.lock:
+            self.running.pop(what, None)
+            self.fresh.add(what)
+        return True, OBJECTS / f"{key}.o"
+
+
+def object_name(src):
+    """Readable object name in the map file: ../common/sfx.s -> common_sfx.o"""
+    parts = [p for p in Path(src).with_suffix('.o').parts if p not in ('.', '..')]
+    return '_'.join(parts)
+
+
+def input_files(recipe):
+    """Every file whose stamp decides if the project is up to date."""
+    files = {str(recipe.script)}
+    for _, ins, outs in recipe.gens:
+        files.update(str(p) for p in ins)
+    for src in recipe.sources:
+        path = os.path.normpath(recipe.dir / src)
+        files.add(path)
+        deps_file = DEPS / f"{sha('cc', rel(path), *recipe.compile)}.json"
+        if deps_file.exists():
+            files.update(json.loads(deps_file.read_text()))
+    for opt, val in zip(recipe.link, recipe.link[1:]):
+        if opt == '-C':
+            files.add(str(recipe.dir / val))
+    return files
+
+
+def symbol_files(recipe):
+    """Map, label and debug files the link writes next to the .prg."""
+    files = []
+    for opt, val in zip(recipe.link, recipe.link[1:]):
+        if opt in ('-m', '--mapfile', '-Ln'):
+            files.append(recipe.dir / val)
+        elif opt == '-Wl' and val.startswith('--dbgfile,'):
+            files.append(recipe.dir / val.split(',', 1)[1])
+    return files
+
+
+def fallback_files(recipe):
+    """Project files plus the ../common files its build script names."""
+    text = recipe.script.read_text()
+    files = {str(p) for p in recipe.dir.iterdir()
+             if p.is_file() and p.suffix not in OUTPUT_SUFFIXES}
+    for name in re.findall(r'\.\./common/[\w.]+', text):
+        files.add(os.path.normpath(recipe.dir / name))
+    return files
+
+
+def stamps(files):
+    return {rel(f): stat_of(f) for f in sorted(files)}
+
+
+def load_state(name):
+    try:
+        return json.loads((STATE / f"{name}.json").read_text())
+    except (OSError, ValueError):
+        return {}
+
+
+def save_state(name, state):
+    tmp = STATE / f"{name}.json.tmp"
+    tmp.write_text(json.dumps(state, indent=1))
+    os.replace(tmp, STATE / f"{name}.json")
+
+
+fallback_lock = threading.Lock()
+
+
+def up_to_date(state, out):
+    """Last build's stamps still match the tree (no hashing, no tools)."""
+    if not state or stat_of(out) != state.get('output'):
+        return False
+    return all(stat_of(ROOT / f) == st for f, st in state['inputs'].items())
+
+
+def check_layout(name):
+    """Report overlaps and VIC-bank problems of a fresh link (memmap.py)."""
+    import memmap
+    for problem in memmap.problems(name):
+        log(f"✗ {name}: {problem}")
+
+
+def build(name, compiler, force=False):
+    """Build one project; returns (name, ok, message)."""
+    recipe = read_recipe(name)
+    state = {} if force else load_state(name)
+
+    if recipe.fallback:
+        out = recipe.dir / (recipe.output or f"{name}.prg")
+        if up_to_date(state, out) and state.get('fallback'):
+            return name, True, 'up to date'
+        with fallback_lock:     # plain cl65 builds share ../common/*.o
+            ok, msg = run(['bash', './build.sh'] if recipe.script.name == 'build.sh'
+                          else ['make', '-s'], recipe.dir)
+        if not ok:
+            return name, False, msg
+        prgs = sorted(recipe.dir.glob('*.prg'))
+        out = out if out.exists() else (prgs[0] if prgs else out)
+        save_state(name, {'fallback': recipe.fallback,
+                          'inputs': stamps(fallback_files(recipe)),
+                          'output': stat_of(out)})
+        return name, True, f"built {out.name} via build.sh ({recipe.fallback})"
+
+    out = recipe.dir / recipe.output
+    if up_to_date(state, out) and all(f.exists() for f in symbol_files(recipe)):
+        return name, True, 'up to date'
+
+    counts = {'ran': 0, 'cached': 0}
+    for cmd, ins, outs in recipe.gens:
+        ok, msg = run_generator(recipe, cmd, ins, outs, counts, force)
+        if not ok:
+            return name, False, msg
+
+    jobs = [compiler.object_for(recipe, src) for src in recipe.sources]
+    objects = []
+    errors = []
+    compiled = 0
+    for src, (job, obj) in zip(recipe.sources, jobs):
+        if job is not None:
+            ok, obj = job.result()
+            if not ok:
+                errors.append(obj)
+                continue
+            compiled += 1
+        objects.append((src, obj))
+    if errors:
+        return name, False, '\n'.join(errors)
+
+    # Link from per-project names so map files read like before
+    objdir = CACHE / 'link' / name
+    objdir.mkdir(parents=True, exist_ok=True)
+    linked = []
+    for src, obj in objects:
+        dst = objdir / object_name(src)
+        restore(obj, dst)
+        linked.append(os.path.relpath(dst, recipe.dir))
+    cfg = [file_hash(recipe.dir / v) for o, v in zip(recipe.link, recipe.link[1:])
+           if o == '-C']
+    key = sha('link', toolchain_id(), *recipe.link, *cfg,
+              *[Path(o).name for _, o in objects])
+    relinked = False
+    if (force or key != state.get('link') or file_hash(out) != state.get('prg')
+            or not all(f.exists() for f in symbol_files(recipe))):
+        ok, msg = run(['cl65'] + recipe.link + ['-o', recipe.output] + linked,
+                      recipe.dir)
+        if not ok:
+            return name, False, msg
+        relinked = True
+
+    save_state(name, {'inputs': stamps(input_files(recipe)),
+                      'output': stat_of(out), 'link': key,
+                      'prg': file_hash(out)})
+    if relinked:
+        check_layout(name)
+    if not relinked and not compiled and not counts['ran']:
+        return name, True, 'up to date'
+    return name, True, (f"built {recipe.output} ({out.stat().st_size} bytes; "
+                        f"{compiled} compiled, {len(objects) - compiled} cached)")
+
+
+def build_many(names, jobs=None, force=False, quiet=False):
+    """Build projects in parallel; True when all of them built."""
+    jobs = max(1, jobs or os.cpu_count() or 1)
+    for d in (OBJECTS, GENERATED, DEPS, STATE):
+        d.mkdir(parents=True, exist_ok=True)
+    compiler = Compiler(jobs, force)
+    failed = 0
+    with ThreadPoolExecutor(max_workers=jobs) as pool:
+        for name, ok, msg in pool.map(lambda n: build(n, compiler, force), names):
+            failed += not ok
+            if not ok:
+                log(f"✗ {name}\n{msg}")
+            elif not quiet:
+                log(f"✓ {name}: {msg}")
+    compiler.pool.shutdown()
+    return failed == 0
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Parallel incremental builder for the C64 projects')
+    parser.add_argument('projects', nargs='*', help='Projects (default: all)')
+    parser.add_argument('-j', '--jobs', type=int, default=os.cpu_count() or 1,
+                        help='Jobs in parallel')
+    parser.add_argument('-q', '--quiet', action='store_true',
+                        help='Print failures only')
+    parser.add_argument('--force', action='store_true',
+                        help='Rebuild everything, ignoring the cache')
+    parser.add_argument('--clean', action='store_true',
+                        help='Remove .buildcache/ and exit')
+    parser.add_argument('-n', '--dry-run', action='store_true',
+                        help='Print each recipe, build nothing')
+    args = parser.parse_args()
+
+    if args.clean:
+        shutil.rmtree(CACHE, ignore_errors=True)
+        return 0
+
+    names = args.projects or all_projects()
+    for name in names:
+        if not (ROOT / name).is_dir():
+            print(f"✗ {name}: no such project")
+            return 1
+    if args.dry_run:
+        for name in names:
+            print(read_recipe(name).describe())
+        return 0
+
+    if shutil.which('cl65') is None:
+        print("✗ cl65 not found: install cc65 (nothing was built, the "
+              ".prg files in the tree are the last ones built elsewhere)")
+        return 1
+
+    start = time.time()
+    ok = build_many(names, args.jobs, args.force, args.quiet)
+    if not args.quiet:
+        print(f"{len(names)} projects in {time.time() - start:.2f}s")
+    return 0 if ok else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
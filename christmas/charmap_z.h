@@ -0,0 +1,50 @@
+/* Packed by common/pack.py from charmap.h: 2048 -> 913 bytes */
+#define CHARMAP_Z_SIZE 2048
+const unsigned char charmap_z[] = {
+    0, 0, 138, 1, 0, 17, 3, 3, 3, 4, 4, 8, 8, 0, 16, 48, 128, 64, 32, 16,
+    16, 8, 4, 3, 132, 25, 0, 35, 248, 7, 7, 3, 1, 0, 0, 0, 0, 255, 84, 0,
+    128, 192, 48, 28, 12, 0, 0, 0, 0, 2, 4, 8, 16, 240, 96, 64, 128, 0, 0, 0,
+    0, 4, 2, 4, 130, 1, 0, 131, 71, 0, 45, 7, 15, 0, 0, 0, 0, 128, 192, 240,
+    248, 32, 32, 64, 64, 64, 32, 32, 32, 4, 4, 4, 5, 6, 0, 0, 0, 31, 111, 159,
+    31, 63, 63, 127, 127, 252, 251, 249, 252, 252, 254, 254, 255, 32, 0, 48, 240, 131, 99, 0,
+    7, 1, 1, 1, 3, 3, 7, 127, 255, 139, 1, 0, 10, 0, 128, 128, 192, 224, 224, 224,
+    240, 15, 15, 31, 130, 56, 0, 7, 248, 248, 252, 254, 254, 239, 135, 135, 132, 152, 0, 28,
+    128, 0, 1, 1, 3, 7, 7, 15, 15, 255, 255, 255, 253, 248, 248, 220, 12, 135, 207, 255,
+    255, 127, 127, 127, 255, 192, 224, 224, 240, 129, 44, 0, 132, 91, 0, 26, 3, 63, 63, 127,
+    207, 130, 130, 135, 239, 255, 255, 248, 80, 8, 28, 31, 255, 255, 227, 97, 97, 127, 255, 255,
+    255, 15, 159, 132, 104, 0, 8, 0, 128, 192, 192, 224, 240, 248, 0, 0, 132, 194, 0, 129,
+    112, 0, 130, 141, 0, 15, 254, 252, 248, 248, 252, 255, 255, 255, 255, 127, 63, 63, 127, 249,
+    252, 254, 133, 48, 0, 130, 154, 0, 11, 248, 7, 7, 15, 15, 31, 63, 63, 63, 240, 224,
+    241, 132, 178, 0, 4, 247, 227, 193, 195, 242, 131, 38, 0, 2, 159, 15, 15, 132, 21, 0,
+    8, 252, 248, 252, 254, 246, 193, 193, 227, 99, 132, 183, 0, 10, 192, 63, 63, 63, 31, 15,
+    7, 3, 0, 30, 254, 131, 43, 0, 2, 31, 28, 28, 130, 101, 0, 31, 255, 63, 60, 59,
+    248, 255, 255, 255, 248, 124, 62, 255, 127, 255, 255, 255, 63, 123, 227, 193, 195, 255, 255, 240,
+    192, 192, 224, 192, 192, 128, 0, 0, 132, 240, 0, 12, 31, 255, 252, 252, 252, 255, 255, 255,
+    199, 240, 56, 60, 60, 129, 66, 0, 131, 88, 0, 1, 192, 224, 130, 239, 0, 6, 3, 15,
+    63, 63, 127, 127, 255, 136, 124, 0, 12, 255, 131, 135, 199, 127, 63, 63, 127, 255, 224, 240,
+    248, 252, 135, 48, 0, 7, 1, 3, 0, 0, 1, 7, 15, 63, 132, 42, 0, 11, 254, 252,
+    252, 247, 199, 131, 135, 239, 63, 63, 63, 224, 132, 41, 0, 0, 7, 131, 121, 1, 16, 63,
+    251, 227, 227, 247, 159, 31, 159, 255, 192, 192, 224, 240, 240, 240, 240, 224, 129, 190, 0, 129,
+    17, 2, 130, 56, 0, 2, 1, 7, 7, 131, 65, 0, 6, 248, 240, 255, 199, 131, 131, 199,
+    131, 77, 0, 6, 248, 224, 240, 240, 248, 192, 128, 131, 106, 0, 134, 79, 1, 12, 255, 254,
+    254, 255, 255, 207, 135, 240, 185, 31, 15, 15, 31, 134, 231, 1, 7, 253, 248, 252, 228, 130,
+    195, 227, 247, 129, 152, 0, 130, 139, 1, 129, 128, 1, 132, 194, 0, 6, 243, 193, 195, 243,
+    127, 135, 143, 134, 44, 0, 11, 252, 240, 240, 248, 95, 240, 240, 240, 255, 127, 127, 255, 129,
+    208, 0, 130, 9, 1, 132, 88, 1, 131, 110, 0, 131, 35, 1, 0, 63, 134, 111, 0, 7,
+    15, 15, 15, 120, 29, 31, 31, 191, 134, 17, 1, 10, 248, 255, 254, 254, 254, 255, 63, 63,
+    63, 255, 31, 132, 39, 0, 129, 252, 1, 0, 254, 129, 16, 2, 131, 167, 0, 0, 250, 132,
+    43, 0, 0, 249, 130, 21, 1, 2, 254, 255, 127, 131, 255, 1, 128, 211, 1, 139, 159, 2,
+    131, 189, 1, 19, 254, 190, 31, 255, 255, 255, 252, 60, 30, 31, 63, 252, 248, 56, 30, 31,
+    127, 127, 255, 191, 130, 46, 0, 129, 160, 0, 131, 50, 2, 131, 158, 1, 13, 248, 248, 240,
+    240, 120, 63, 31, 7, 1, 0, 248, 240, 240, 248, 130, 50, 1, 128, 140, 0, 130, 93, 2,
+    135, 176, 1, 0, 199, 132, 236, 0, 9, 143, 15, 143, 255, 255, 255, 227, 195, 195, 227, 130,
+    40, 0, 7, 252, 253, 255, 255, 255, 255, 126, 126, 131, 40, 0, 129, 183, 0, 132, 64, 0,
+    129, 85, 0, 0, 224, 132, 60, 0, 132, 69, 0, 1, 252, 192, 130, 7, 0, 1, 191, 31,
+    133, 128, 2, 8, 251, 255, 255, 255, 255, 223, 199, 7, 1, 132, 155, 1, 0, 240, 129, 67,
+    0, 134, 192, 1, 11, 63, 0, 0, 255, 255, 254, 252, 240, 128, 0, 0, 192, 132, 1, 3,
+    0, 63, 132, 249, 3, 133, 17, 3, 130, 255, 3, 131, 48, 0, 7, 124, 0, 0, 0, 0,
+    241, 224, 128, 132, 16, 0, 3, 127, 63, 31, 7, 132, 72, 0, 2, 255, 47, 15, 130, 114,
+    1, 130, 100, 1, 130, 139, 2, 2, 0, 255, 63, 132, 0, 2, 129, 1, 0, 133, 112, 0,
+    0, 87, 133, 48, 0, 131, 8, 0, 128, 5, 4, 240, 1, 0, 254, 1, 0, 254, 1, 0,
+    254, 1, 0, 254, 1, 0, 254, 1, 0, 254, 1, 0, 255
+};
@@ -0,0 +1,22 @@
+/* Packed by common/pack.py from img.h: 1000 -> 358 bytes */
+#define IMG_Z_SIZE 1000
+const unsigned char img_z[] = {
+    0, 0, 143, 1, 0, 1, 1, 0, 163, 1, 0, 2, 2, 3, 4, 160, 38, 0, 5, 5,
+    6, 0, 0, 7, 8, 160, 41, 0, 3, 9, 10, 11, 12, 161, 119, 0, 3, 13, 14, 15,
+    16, 161, 40, 0, 3, 17, 18, 19, 20, 161, 40, 0, 4, 21, 19, 19, 22, 23, 159, 39,
+    0, 5, 24, 19, 19, 25, 26, 27, 158, 39, 0, 7, 28, 29, 30, 31, 32, 19, 19, 33,
+    156, 39, 0, 9, 34, 35, 36, 37, 19, 19, 19, 19, 38, 39, 155, 40, 0, 10, 40, 19,
+    19, 41, 42, 43, 19, 19, 44, 45, 46, 154, 40, 0, 10, 47, 19, 19, 19, 19, 48, 49,
+    50, 51, 52, 53, 154, 40, 0, 1, 54, 19, 131, 1, 0, 2, 55, 56, 57, 153, 39, 0,
+    1, 58, 59, 131, 39, 0, 3, 60, 61, 19, 62, 151, 121, 0, 2, 63, 64, 18, 131, 39,
+    0, 5, 65, 66, 19, 19, 19, 67, 150, 69, 1, 0, 68, 132, 117, 0, 1, 19, 69, 130,
+    6, 0, 0, 70, 149, 40, 0, 1, 71, 72, 130, 32, 0, 1, 73, 74, 130, 7, 0, 1,
+    75, 76, 150, 120, 0, 6, 77, 19, 19, 19, 19, 78, 79, 130, 39, 0, 2, 80, 81, 82,
+    149, 39, 0, 6, 83, 19, 19, 19, 73, 84, 85, 130, 39, 0, 4, 86, 87, 19, 88, 89,
+    146, 39, 0, 6, 90, 91, 19, 19, 19, 92, 93, 130, 38, 0, 6, 94, 95, 96, 19, 19,
+    19, 97, 146, 243, 0, 12, 98, 19, 99, 100, 101, 102, 19, 103, 103, 104, 105, 106, 107, 131,
+    208, 0, 1, 108, 109, 144, 40, 0, 10, 110, 111, 112, 113, 114, 115, 116, 117, 118, 119, 19,
+    134, 1, 0, 0, 120, 145, 81, 0, 5, 121, 19, 122, 123, 19, 124, 130, 32, 0, 7, 103,
+    125, 19, 126, 127, 128, 129, 130, 146, 161, 0, 14, 131, 132, 0, 133, 134, 135, 136, 137, 19,
+    19, 138, 139, 0, 140, 130, 157, 130, 2, 3, 141, 142, 143, 144, 143, 22, 0, 255
+};
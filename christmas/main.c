@@ -4,6 +4,11 @@
 #include <unistd.h>
 #include <serial.h>
 #include <conio.h>
+#include <string.h>
+
+#include "shadow.h"
+#include "sfx.h"
+#include "unpack.h"
 
 #define ANSI_COLOR_RED "\x1b[31m"
 #define ANSI_COLOR_GREEN "\x1b[32m"
@@ -32,92 +37,55 @@
 #define HW "commodore 128"
 #endif // __C64__
 
-#include "img.h"
-#include "charmap.h"
-#include "clrs.h"
+// Packed from img.h and charmap.h by the Makefile (see ../common/pack.py)
+#include "img_z.h"
+#include "charmap_z.h"
 
 #define FCOLOR1 13
 #define FCOLOR2 7
 
-// SID chip registers
-#define SID_BASE 0xD400
-#define SID_FREQ_LO    (SID_BASE + 0)
-#define SID_FREQ_HI    (SID_BASE + 1)
-#define SID_PW_LO      (SID_BASE + 2)
-#define SID_PW_HI      (SID_BASE + 3)
-#define SID_CTRL       (SID_BASE + 4)
-#define SID_AD         (SID_BASE + 5)
-#define SID_SR         (SID_BASE + 6)
-#define SID_VOLUME     (SID_BASE + 24)
-
-// Note frequencies (high byte values for common notes)
-// These are approximate SID frequency values
-static const unsigned int note_freqs[] = {
-    0,      // REST
-    4291,   // C4
-    4547,   // C#4
-    4817,   // D4
-    5103,   // D#4
-    5407,   // E4
-    5728,   // F4
-    6069,   // F#4
-    6430,   // G4
-    6812,   // G#4
-    7217,   // A4
-    7647,   // A#4
-    8101,   // B4
-    8583,   // C5
-    9094,   // C#5
-    9634,   // D5
-    10207,  // D#5
-    10814,  // E5
-    11457,  // F5
-    12139,  // F#5
-    12860,  // G5
-};
-
-// Note indices: 0=REST, 1=C4, 2=C#4, 3=D4, 4=D#4, 5=E4, 6=F4, 7=F#4, 8=G4, 9=G#4, 10=A4, 11=A#4, 12=B4, 13=C5, 14=C#5, 15=D5, 16=D#5, 17=E5, 18=F5, 19=F#5, 20=G5
-
-// Jingle Bells melody (simplified)
+// Note frequencies (SID frequency register values)
+#define NOTE_C4  4291
+#define NOTE_D4  4817
+#define NOTE_E4  5407
+#define NOTE_F4  5728
+#define NOTE_G4  6430
+#define NOTE_A4  7217
+#define NOTE_B4  8101
+#define NOTE_C5  8583
+#define NOTE_D5  9634
+#define NOTE_E5  10814
+#define NOTE_G5  12860
+
+// One beat = 8 frames. Notes release for the last frame so repeated
+// notes retrigger; the IRQ player runs the melody (see sfx.h)
+#define NOTE(f) SFX_STEP(7, 0x11, f, 0, 0x08), SFX_STEP(1, 0x10, f, 0, 0x08)
+#define REST    SFX_STEP(8, 0x10, 0, 0, 0x08)
+
+// Jingle Bells melody (simplified), looped on voice 1
 // E E E | E E E | E G C D | E ...
-#define NOTE_C4  1
-#define NOTE_D4  3
-#define NOTE_E4  5
-#define NOTE_F4  6
-#define NOTE_G4  8
-#define NOTE_A4  10
-#define NOTE_B4  12
-#define NOTE_C5  13
-#define NOTE_D5  15
-#define NOTE_E5  17
-#define NOTE_G5  20
-#define REST     0
-
 static const unsigned char melody[] = {
+    SFX_V1, 1, 0x09, 0x00,     // Attack=0, Decay=9, Sustain=0, Release=0
     // Jingle Bells - first part
-    NOTE_E4, NOTE_E4, NOTE_E4, REST,
-    NOTE_E4, NOTE_E4, NOTE_E4, REST,
-    NOTE_E4, NOTE_G4, NOTE_C4, NOTE_D4,
-    NOTE_E4, REST, REST, REST,
-    NOTE_F4, NOTE_F4, NOTE_F4, NOTE_F4,
-    NOTE_F4, NOTE_E4, NOTE_E4, NOTE_E4,
-    NOTE_E4, NOTE_D4, NOTE_D4, NOTE_E4,
-    NOTE_D4, REST, NOTE_G4, REST,
-    NOTE_E4, NOTE_E4, NOTE_E4, REST,
-    NOTE_E4, NOTE_E4, NOTE_E4, REST,
-    NOTE_E4, NOTE_G4, NOTE_C4, NOTE_D4,
-    NOTE_E4, REST, REST, REST,
-    NOTE_F4, NOTE_F4, NOTE_F4, NOTE_F4,
-    NOTE_F4, NOTE_E4, NOTE_E4, NOTE_E4,
-    NOTE_G4, NOTE_G4, NOTE_F4, NOTE_D4,
-    NOTE_C4, REST, REST, REST,
-    0xFF  // End marker
+    NOTE(NOTE_E4), NOTE(NOTE_E4), NOTE(NOTE_E4), REST,
+    NOTE(NOTE_E4), NOTE(NOTE_E4), NOTE(NOTE_E4), REST,
+    NOTE(NOTE_E4), NOTE(NOTE_G4), NOTE(NOTE_C4), NOTE(NOTE_D4),
+    NOTE(NOTE_E4), REST, REST, REST,
+    NOTE(NOTE_F4), NOTE(NOTE_F4), NOTE(NOTE_F4), NOTE(NOTE_F4),
+    NOTE(NOTE_F4), NOTE(NOTE_E4), NOTE(NOTE_E4), NOTE(NOTE_E4),
+    NOTE(NOTE_E4), NOTE(NOTE_D4), NOTE(NOTE_D4), NOTE(NOTE_E4),
+    NOTE(NOTE_D4), REST, NOTE(NOTE_G4), REST,
+    NOTE(NOTE_E4), NOTE(NOTE_E4), NOTE(NOTE_E4), REST,
+    NOTE(NOTE_E4), NOTE(NOTE_E4), NOTE(NOTE_E4), REST,
+    NOTE(NOTE_E4), NOTE(NOTE_G4), NOTE(NOTE_C4), NOTE(NOTE_D4),
+    NOTE(NOTE_E4), REST, REST, REST,
+    NOTE(NOTE_F4), NOTE(NOTE_F4), NOTE(NOTE_F4), NOTE(NOTE_F4),
+    NOTE(NOTE_F4), NOTE(NOTE_E4), NOTE(NOTE_E4), NOTE(NOTE_E4),
+    NOTE(NOTE_G4), NOTE(NOTE_G4), NOTE(NOTE_F4), NOTE(NOTE_D4),
+    NOTE(NOTE_C4), REST, REST, REST,
+    SFX_LOOP
 };
 
-static unsigned char melody_pos = 0;
-static unsigned int note_timer = 0;
-#define NOTE_DURATION 8
-
 char data[40];
 int sy = 25;
 int sx = 40;
@@ -125,14 +93,14 @@ int sx = 40;
 #define MAX_SNOW 30
 #define SNOW_CHAR 255
 
+// Screen image as unpacked; snow restores the cells it passes from here
+static unsigned char img[IMG_Z_SIZE];
+
 int main()
 {
 
     int i;
-    int j;
-    int k = 0;
     int offset;
-    int delay;
     
     // Snow variables
     int snow_x[MAX_SNOW];
@@ -156,79 +124,37 @@ int main()
     // Set character set to upper/lower case
     POKE(53272, (PEEK(53272) & 240) + 12);
 
-    // Initialize character map (all 256 chars = 2048 bytes)
-    // We copy all 256 chars; char 255 will be overwritten for snow below
-    for (i = 0; i < 256 * 8; i++)
-    {
-        POKE(12288 + i, charmap[i]);
-    }
+    // Unpack the character map (all 256 chars = 2048 bytes)
+    // straight into charset RAM; char 255 is overwritten for snow below
+    unpack((void *)12288, charmap_z);
     
     // Define Snow Character at index 255 (overwrites charmap[255])
     for(i=0; i<8; i++) {
         POKE(12288 + SNOW_CHAR*8 + i, snow_pattern[i]);
     }
 
-    // Draw the image
-    for (j = 0; j < 25; j++)
-    {
-        for (i = 0; i < 40; i++)
-        {
-            POKE(PLACE(i, j), img[k]);
-            
-            // Color logic: Top 5 rows get FCOLOR2, rest get FCOLOR1
-            if (j>4)
-            {
-                POKE(COLOR(i, j), FCOLOR1);
-            }
-            else
-            {
-                POKE(COLOR(i, j), FCOLOR2);
-            }
+    // Draw the image: unpack onto the screen, keep a copy for the snow
+    unpack((void *)1024, img_z);
+    memcpy(img, (void *)1024, IMG_Z_SIZE);
 
-            k += 1;
-        }
-    }
+    // Color logic: Top 5 rows get FCOLOR2, rest get FCOLOR1
+    memset((void *)55296, FCOLOR2, 5 * 40);
+    memset((void *)(55296 + 5 * 40), FCOLOR1, 20 * 40);
 
     // Set border to a nice static color
     POKE(53280, 14); // Light blue border
 
-    // Initialize SID for music
-    POKE(SID_VOLUME, 15);      // Max volume
-    POKE(SID_AD, 0x09);        // Attack=0, Decay=9
-    POKE(SID_SR, 0x00);        // Sustain=0, Release=0
-    POKE(SID_PW_LO, 0x00);     // Pulse width
-    POKE(SID_PW_HI, 0x08);     // 50% duty cycle
+    // Start the music: the raster IRQ plays it from here on
+    shd_install(SHD_LINE);
+    sfx_init();
+    sfx_play(melody);
 
     // Main loop: Snow animation
     while (1)
     {
-        // Small delay for animation
-        for(delay = 0; delay < 250; delay++);
-        
-        // --- Music Logic ---
-        note_timer++;
-        if(note_timer >= NOTE_DURATION) {
-            note_timer = 0;
-            
-            // Get next note
-            if(melody[melody_pos] == 0xFF) {
-                melody_pos = 0;  // Loop the melody
-            }
-            
-            if(melody[melody_pos] == REST) {
-                // Silence - gate off
-                POKE(SID_CTRL, 0x10);  // Gate off, pulse wave
-            } else {
-                // Play note
-                unsigned int freq = note_freqs[melody[melody_pos]];
-                POKE(SID_FREQ_LO, freq & 0xFF);
-                POKE(SID_FREQ_HI, (freq >> 8) & 0xFF);
-                POKE(SID_CTRL, 0x11);  // Gate on, pulse wave
-            }
-            melody_pos++;
-        }
-        // ------------------
-        
+        // One snow step per frame
+        shd_wait();
+
         // --- Snow Logic ---
         // Spawn new snow at top
         if (rand() % 2 == 0) {
@@ -0,0 +1,65 @@
+/*
+ * ball.h - 8.8 fixed-point ball physics (see ball.s)
+ *
+ * The ball is a sprmove sprite; ball.s adds a direction table and wall
+ * bounces on top of spr_move(). Set the ball up once:
+ *
+ *   ball_spr = SPR_BALL;
+ *   ball_vertical = 0;              travels left/right (pong)
+ *   ball_top = 58;  ball_bottom = 234;
+ *   ball_left = BALL_NO_LEFT;  ball_right = BALL_NO_RIGHT;
+ *
+ * then call ball_step() once a frame instead of spr_move(), and
+ * ball_aim() on every rebound off a paddle:
+ *
+ *   ball_aim(BALL_DIR(offset, 1) | BALL_ALONG_NEG);
+ *
+ * A wall bounce mirrors the ball's overshoot about the wall, so a fast
+ * ball lands where it would have bounced to and never passes a wall.
+ * The 9-bit X walls work as 16-bit numbers; ball_top must be < 128.
+ */
+
+#ifndef BALL_H
+#define BALL_H
+
+#include "sprmove.h"
+
+#define BALL_DIRS       16      /* directions 8 + 3.5n degrees off axis */
+#define BALL_ACROSS_NEG 0x40    /* ball_aim: negative across the axis */
+#define BALL_ALONG_NEG  0x80    /* ball_aim: negative along the axis */
+
+#define BALL_NO_LEFT    0x0000  /* ball_left/ball_right/ball_bottom: no wall */
+#define BALL_NO_RIGHT   0xFFFF
+#define BALL_NO_BOTTOM  0xFF
+
+/* ball_step() results */
+#define BALL_HIT_TOP    0x01
+#define BALL_HIT_BOTTOM 0x02
+#define BALL_HIT_LEFT   0x04
+#define BALL_HIT_RIGHT  0x08
+
+/* Direction for a paddle hit offset (ball centre - paddle centre, in
+ * pixels) scaled down by shift: flatter near the centre, steeper
+ * towards the ends, across the axis to the side that was hit */
+#define BALL_DIR(offset, shift) \
+    ((offset) < 0 \
+        ? (-(offset) >> (shift) > BALL_DIRS - 1 ? BALL_DIRS - 1 : -(offset) >> (shift)) \
+            | BALL_ACROSS_NEG \
+        : ((offset) >> (shift) > BALL_DIRS - 1 ? BALL_DIRS - 1 : (offset) >> (shift)))
+
+extern unsigned char ball_spr;       /* sprite number of the ball */
+extern unsigned char ball_vertical;  /* 0: main axis X, else Y */
+extern unsigned int  ball_speed;     /* 8.8 pixels per frame, for ball_aim */
+extern unsigned char ball_top;       /* Y walls, sprite Y */
+extern unsigned char ball_bottom;
+extern unsigned int  ball_left;      /* X walls, 9-bit sprite X */
+extern unsigned int  ball_right;
+
+/* Velocity at ball_speed in direction (0 to BALL_DIRS-1) | sign bits */
+void __fastcall__ ball_aim(unsigned char dir);
+
+/* Move the ball one frame and bounce it off the walls; returns the
+ * BALL_HIT_ bits of the walls it hit */
+unsigned char ball_step(void);
+
+#endif
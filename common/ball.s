@@ -0,0 +1,279 @@
+; ball.s - 8.8 fixed-point ball physics on top of sprmove.s
+;
+; C entry points (see ball.h):
+;   void __fastcall__ ball_aim(unsigned char dir);
+;   unsigned char ball_step(void);
+;
+; The ball is one sprmove sprite (ball_spr): its position and velocity
+; are spr_x/spr_xf, spr_y/spr_yf and spr_dx/spr_dy. ball_aim sets the
+; velocity from a table of directions at ball_speed, so rebounds need
+; no branching on direction in C. ball_step moves the ball and reflects
+; it off the walls by mirroring the overshoot about the wall in 8.8:
+; the ball ends where a continuous bounce would put it, however far it
+; moved this frame, and no frame can carry it through a wall.
+
+.export _ball_spr, _ball_vertical, _ball_speed
+.export _ball_top, _ball_bottom, _ball_left, _ball_right
+.export _ball_aim, _ball_step
+.import _spr_x, _spr_y, _spr_xf, _spr_yf, _spr_dx, _spr_dy, _spr_move
+.importzp ptr1, tmp1, tmp2, tmp3
+
+HIT_TOP    = $01
+HIT_BOTTOM = $02
+HIT_LEFT   = $04
+HIT_RIGHT  = $08
+
+.segment "BSS"
+
+_ball_spr:      .res 1          ; sprmove sprite number of the ball
+_ball_vertical: .res 1          ; 0: travels along X (pong), else Y
+_ball_speed:    .res 2          ; 8.8 pixels per frame, for ball_aim
+_ball_top:      .res 1          ; Y walls (sprite Y)
+_ball_bottom:   .res 1
+_ball_left:     .res 2          ; X walls (9-bit sprite X)
+_ball_right:    .res 2
+hits:           .res 1
+along:          .res 2
+across:         .res 2
+
+.segment "RODATA"
+
+; Direction n is 8 + 3.5n degrees off the main axis (8 to 60.5).
+; cos and sin as 0.8 fractions: round(256 * cos), round(256 * sin)
+cos_tab:
+    .byte $FE,$FB,$F7,$F3,$ED,$E7,$E0,$D8,$CF,$C6,$BB,$B0,$A5,$98,$8B,$7E
+sin_tab:
+    .byte $24,$33,$42,$51,$60,$6E,$7C,$8A,$96,$A3,$AF,$BA,$C4,$CE,$D7,$DF
+
+.segment "CODE"
+
+; A = factor (0.8); ptr1 = factor * ball_speed >> 8
+scale:
+    sta tmp1
+    lda #0
+    sta ptr1
+    sta ptr1 + 1
+    ldy #8
+@bit:
+    lsr tmp1                    ; next factor bit, low first
+    bcc @shift
+    clc
+    lda ptr1
+    adc _ball_speed
+    sta ptr1
+    lda ptr1 + 1
+    adc _ball_speed + 1
+    sta ptr1 + 1
+@shift:
+    ror ptr1 + 1                ; 24-bit product >> 1; the low byte
+    ror ptr1                    ; falls out of the carry
+    ror tmp2
+    dey
+    bne @bit
+    rts
+
+; A = direction (0-15) | BALL_ACROSS_NEG | BALL_ALONG_NEG, at ball_speed
+_ball_aim:
+    sta tmp3
+    and #$0F
+    tax
+    lda sin_tab, x
+    pha
+    lda cos_tab, x
+    jsr scale
+    lda ptr1
+    sta along
+    lda ptr1 + 1
+    sta along + 1
+    pla
+    jsr scale
+    lda ptr1
+    sta across
+    lda ptr1 + 1
+    sta across + 1
+
+    bit tmp3                    ; N: BALL_ALONG_NEG, V: BALL_ACROSS_NEG
+    bpl @across
+    sec
+    lda #0
+    sbc along
+    sta along
+    lda #0
+    sbc along + 1
+    sta along + 1
+@across:
+    bit tmp3
+    bvc @store
+    sec
+    lda #0
+    sbc across
+    sta across
+    lda #0
+    sbc across + 1
+    sta across + 1
+
+@store:
+    lda _ball_spr
+    asl a
+    tay                         ; word index
+    lda _ball_vertical
+    bne @vertical
+    lda along
+    sta _spr_dx, y
+    lda along + 1
+    sta _spr_dx + 1, y
+    lda across
+    sta _spr_dy, y
+    lda across + 1
+    sta _spr_dy + 1, y
+    rts
+@vertical:
+    lda along
+    sta _spr_dy, y
+    lda along + 1
+    sta _spr_dy + 1, y
+    lda across
+    sta _spr_dx, y
+    lda across + 1
+    sta _spr_dx + 1, y
+    rts
+
+; Negate the 8.8 velocity word at _spr_dx/_spr_dy + Y
+negate_dx:
+    sec
+    lda #0
+    sbc _spr_dx, y
+    sta _spr_dx, y
+    lda #0
+    sbc _spr_dx + 1, y
+    sta _spr_dx + 1, y
+    rts
+
+negate_dy:
+    sec
+    lda #0
+    sbc _spr_dy, y
+    sta _spr_dy, y
+    lda #0
+    sbc _spr_dy + 1, y
+    sta _spr_dy + 1, y
+    rts
+
+; Move the ball one frame; returns the HIT_ bits of the walls it
+; bounced off
+_ball_step:
+    ldx _ball_spr
+    lda #0
+    sta hits
+    sec
+@mask:
+    rol a                       ; A = 1 << ball_spr
+    dex
+    bpl @mask
+    jsr _spr_move
+
+    ldx _ball_spr
+    txa
+    asl a
+    tay                         ; word index
+
+    ; Top: above the wall by d, put it d below
+    lda _spr_y, x
+    cmp _ball_top
+    bcs @bottom
+    sec
+    lda #0
+    sbc _spr_yf, x
+    sta _spr_yf, x
+    lda _ball_top
+    sbc _spr_y, x               ; whole pixels of the overshoot
+    clc
+    adc _ball_top
+    sta _spr_y, x
+    jsr negate_dy
+    lda #HIT_TOP
+    sta hits
+    bne @left
+
+    ; Bottom: below the wall by d, put it d above
+@bottom:
+    lda _ball_bottom
+    cmp _spr_y, x
+    bcs @left
+    lda _spr_y, x
+    sec
+    sbc _ball_bottom
+    sta tmp1
+    sec
+    lda #0
+    sbc _spr_yf, x
+    sta _spr_yf, x
+    lda _ball_bottom
+    sbc tmp1
+    sta _spr_y, x
+    jsr negate_dy
+    lda #HIT_BOTTOM
+    sta hits
+
+    ; Left (16-bit X)
+@left:
+    lda _spr_x, y
+    cmp _ball_left
+    lda _spr_x + 1, y
+    sbc _ball_left + 1
+    bcs @right                  ; x >= left
+    sec
+    lda #0
+    sbc _spr_xf, x
+    sta _spr_xf, x
+    lda _ball_left              ; overshoot = left - x (- borrow)
+    sbc _spr_x, y
+    sta tmp1
+    lda _ball_left + 1
+    sbc _spr_x + 1, y
+    sta tmp2
+    clc
+    lda _ball_left
+    adc tmp1
+    sta _spr_x, y
+    lda _ball_left + 1
+    adc tmp2
+    sta _spr_x + 1, y
+    jsr negate_dx
+    lda hits
+    ora #HIT_LEFT
+    sta hits
+    bne @done
+
+@right:
+    lda _ball_right
+    cmp _spr_x, y
+    lda _ball_right + 1
+    sbc _spr_x + 1, y
+    bcs @done                   ; right >= x
+    lda _spr_x, y               ; overshoot = x - right
+    sec
+    sbc _ball_right
+    sta tmp1
+    lda _spr_x + 1, y
+    sbc _ball_right + 1
+    sta tmp2
+    sec
+    lda #0
+    sbc _spr_xf, x
+    sta _spr_xf, x
+    lda _ball_right
+    sbc tmp1
+    sta _spr_x, y
+    lda _ball_right + 1
+    sbc tmp2
+    sta _spr_x + 1, y
+    jsr negate_dx
+    lda hits
+    ora #HIT_RIGHT
+    sta hits
+
+@done:
+    lda hits
+    ldx #0
+    rts
@@ -0,0 +1,21 @@
+/*
+ * level.h - brick level decoder (see level.s)
+ *
+ * levelgen.py runs on the host from the project's build.sh and writes
+ * levels.h: level_bank[], LEVEL_COUNT levels of LEVEL_SIZE bytes, each
+ * a packed ROWS x COLS wall with 0-3 hit points per brick. Decode one
+ * straight into the game's brick array:
+ *
+ *   bricks_left = lv_unpack(&bricks[0][0],
+ *                           level_bank + (level - 1) % LEVEL_COUNT * LEVEL_SIZE);
+ */
+
+#ifndef LEVEL_H
+#define LEVEL_H
+
+/* Unpack a level's hit points to dst (rows * cols bytes, 0 = no
+ * brick); returns the number of bricks */
+unsigned char __fastcall__ lv_unpack(unsigned char *dst,
+                                     const unsigned char *level);
+
+#endif
@@ -0,0 +1,88 @@
+; level.s - brick level decoder for banks written by levelgen.py
+;
+; C entry point (see level.h):
+;   unsigned char __fastcall__ lv_unpack(unsigned char *dst,
+;                                        const unsigned char *level);
+;
+; Level format:
+;   byte 0    rows << 4 | cols (cols 1-8)
+;   per row   hit point bit 1 bitmap, then bit 0 bitmap, MSB first
+;
+; Every brick is two shifts into A and a store: about 36 cycles a
+; brick, 2000 for a 6x8 wall, against several frames for a wall built
+; and drawn brick by brick in C.
+
+.export _lv_unpack
+.import popax
+.importzp ptr1, ptr2, tmp1, tmp2, tmp3, tmp4
+
+.segment "BSS"
+
+count:  .res 1                  ; bricks with hit points
+
+.segment "CODE"
+
+; Stack: dst; A/X = level. Fills rows * cols bytes at dst with hit
+; points, 0 for no brick, and returns the number of bricks
+_lv_unpack:
+    sta ptr1                    ; level
+    stx ptr1 + 1
+    jsr popax
+    sta ptr2                    ; dst
+    stx ptr2 + 1
+
+    ldy #0
+    sty count
+    lda (ptr1), y
+    and #$0F
+    sta tmp3                    ; cols
+    lda (ptr1), y
+    lsr a
+    lsr a
+    lsr a
+    lsr a
+    sta tmp4                    ; rows
+
+@row:
+    ldy #1
+    lda (ptr1), y
+    sta tmp1                    ; hit point bit 1
+    iny
+    lda (ptr1), y
+    sta tmp2                    ; hit point bit 0
+    lda ptr1
+    clc
+    adc #2
+    sta ptr1
+    bcc @bricks
+    inc ptr1 + 1
+@bricks:
+    ldx tmp3
+    ldy #0
+@brick:
+    lda #0
+    asl tmp1
+    rol a
+    asl tmp2
+    rol a
+    sta (ptr2), y
+    beq @next
+    inc count
+@next:
+    iny
+    dex
+    bne @brick
+
+    tya                         ; dst += cols
+    clc
+    adc ptr2
+    sta ptr2
+    bcc @row_done
+    inc ptr2 + 1
+@row_done:
+    dec tmp4
+    bne @row
+
+    lda count
+    ldx #0
+    rts
@@ -0,0 +1,196 @@
+#!/usr/bin/env python3
+"""
+levelgen.py - compile a bank of brick levels for level.s
+
+Builds LEVEL_COUNT brick layouts for a ROWS x COLS wall (COLS <= 8)
+from a few seeded pattern generators and writes them, packed, to a C
+header that lv_unpack() (common/level.s) decodes into the game's
+bricks[ROWS][COLS] array:
+
+    python3 ../common/levelgen.py 6 8 levels.h -n 32
+
+Level format (decoded by common/level.s):
+    byte 0        ROWS << 4 | COLS
+    per row       two bitmaps, MSB = leftmost brick: hit point bit 1,
+                  then hit point bit 0. Hit points 0 (no brick) to 3
+
+The first four levels are fixed openers (all 1 hp, a hard top row, a
+checkerboard, a gradient); later ones cycle through the pattern
+generators with density and hit points rising with the level number.
+The same --seed always gives the same bank, so replays of a game built
+from it meet the same walls.
+"""
+
+import argparse
+import random
+from pathlib import Path
+
+MAX_HP = 3
+MIN_BRICKS = 8          # a level with fewer is generated again
+
+
+# =============================================================================
+# PATTERNS - Each returns rows of hit points, 0 = no brick
+# =============================================================================
+
+def full(rows, cols, rng, lv):
+    return [[1] * cols for _ in range(rows)]
+
+
+def hard_top(rows, cols, rng, lv):
+    return [[2 if r == 0 else 1] * cols for r in range(rows)]
+
+
+def checker(rows, cols, rng, lv):
+    return [[2 if (r + c) & 1 else 1 for c in range(cols)] for r in range(rows)]
+
+
+def gradient(rows, cols, rng, lv):
+    return [[min(rows - r, MAX_HP)] * cols for r in range(rows)]
+
+
+def mirror(rows, cols, rng, lv):
+    """Random left half, mirrored; denser as levels go up."""
+    density = min(0.45 + lv * 0.02, 0.9)
+    half = (cols + 1) // 2
+    grid = []
+    for _ in range(rows):
+        left = [1 if rng.random() < density else 0 for _ in range(half)]
+        grid.append(left + left[:cols - half][::-1])
+    return grid
+
+
+def diamond(rows, cols, rng, lv):
+    """Diamond around the wall's centre, its core harder."""
+    cr, cc = (rows - 1) / 2, (cols - 1) / 2
+    size = rng.uniform(0.6, 1.0) * (cr + cc)
+    grid = []
+    for r in range(rows):
+        row = []
+        for c in range(cols):
+            d = abs(r - cr) + abs(c - cc)
+            row.append(0 if d > size else 2 if d < size / 2 else 1)
+        grid.append(row)
+    return grid
+
+
+def stripes(rows, cols, rng, lv):
+    """Every other row or column, one of them hard."""
+    if rng.random() < 0.5:
+        grid = [[1 if r % 2 == 0 else 0] * cols for r in range(rows)]
+    else:
+        grid = [[1 if c % 2 == 0 else 0 for c in range(cols)] for _ in range(rows)]
+    hard = rng.randrange(0, rows, 2)
+    grid[hard] = [2 if v else 0 for v in grid[hard]]
+    return grid
+
+
+def frame(rows, cols, rng, lv):
+    """Hard outer ring around a soft core, with a way in."""
+    grid = [[3 if r in (0, rows - 1) or c in (0, cols - 1) else 1
+             for c in range(cols)] for r in range(rows)]
+    grid[rows - 1][rng.randrange(1, cols - 1)] = 0
+    return grid
+
+
+def wall(rows, cols, rng, lv):
+    """Full rows, each with a gap that wanders."""
+    gap = rng.randrange(cols)
+    grid = []
+    for r in range(rows):
+        row = [1] * cols
+        row[gap] = 0
+        gap = max(0, min(cols - 1, gap + rng.choice((-1, 1))))
+        grid.append(row)
+    return grid
+
+
+OPENERS = [full, hard_top, checker, gradient]
+PATTERNS = [mirror, diamond, stripes, frame, wall]
+
+
+def toughen(grid, rng, lv):
+    """Raise random bricks' hit points with the level number."""
+    chance = min(lv * 0.03, 0.6)
+    return [[min(v + (rng.random() < chance), MAX_HP) if v else 0 for v in row]
+            for row in grid]
+
+
+def make_level(rows, cols, rng, lv):
+    """Hit points of level lv (0-based)."""
+    if lv < len(OPENERS):
+        return OPENERS[lv](rows, cols, rng, lv)
+    pattern = PATTERNS[(lv - len(OPENERS)) % len(PATTERNS)]
+    while True:
+        grid = toughen(pattern(rows, cols, rng, lv), rng, lv)
+        if sum(1 for row in grid for v in row if v) >= min(MIN_BRICKS, rows * cols):
+            return grid
+
+
+# =============================================================================
+# OUTPUT
+# =============================================================================
+
+def pack(grid, cols):
+    """Header byte and the two bitmaps of every row."""
+    data = [len(grid) << 4 | cols]
+    for row in grid:
+        hi = lo = 0
+        for c, hp in enumerate(row):
+            bit = 0x80 >> c
+            if hp & 2:
+                hi |= bit
+            if hp & 1:
+                lo |= bit
+        data += [hi, lo]
+    return data
+
+
+def write_header(path, rows, cols, levels):
+    guard = f"{Path.cwd().name}_{Path(path).stem}_h".upper()
+    size = 1 + 2 * rows
+    lines = [
+        f"#ifndef {guard}",
+        f"#define {guard}",
+        "",
+        "/* Generated by levelgen.py. Edit the patterns there, then rerun it. */",
+        "",
+        f"#define LEVEL_COUNT {len(levels)}",
+        f"#define LEVEL_SIZE  {size}",
+        "",
+        "static const unsigned char level_bank[LEVEL_COUNT * LEVEL_SIZE] = {",
+    ]
+    for n, grid in enumerate(levels):
+        data = pack(grid, cols)
+        lines.append(f"    /* level {n + 1} */")
+        lines.append(f"    0x{data[0]:02X},")
+        for r, row in enumerate(grid):
+            art = ''.join(str(v) if v else '.' for v in row)
+            hi, lo = data[1 + 2 * r], data[2 + 2 * r]
+            last = n == len(levels) - 1 and r == rows - 1
+            lines.append(f"    0x{hi:02X},0x{lo:02X}{'' if last else ','}   /* {art} */")
+    lines += ["};", "", "#endif", ""]
+    Path(path).write_text("\n".join(lines))
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Compile a packed brick level bank")
+    ap.add_argument("rows", type=int, help="brick rows (1-15)")
+    ap.add_argument("cols", type=int, help="bricks per row (1-8)")
+    ap.add_argument("output", help="header to write, e.g. levels.h")
+    ap.add_argument("-n", "--count", type=int, default=32, help="levels (default 32)")
+    ap.add_argument("--seed", type=int, default=64, help="pattern seed")
+    args = ap.parse_args()
+
+    if not (1 <= args.rows <= 15 and 1 <= args.cols <= 8):
+        ap.error("the wall must be 1-15 rows of 1-8 bricks")
+    rng = random.Random(args.seed)
+    levels = [make_level(args.rows, args.cols, rng, lv) for lv in range(args.count)]
+    write_header(args.output, args.rows, args.cols, levels)
+    bricks = sum(1 for grid in levels for row in grid for v in row if v)
+    print(f"{args.output}: {args.count} levels, {bricks} bricks, "
+          f"{args.count * (1 + 2 * args.rows)} bytes")
+
+
+if __name__ == "__main__":
+    main()
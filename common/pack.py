@@ -0,0 +1,145 @@
+#!/usr/bin/env python3
+"""
+pack.py - pack a C byte array for the unpack.s decruncher
+
+Reads the first {...} byte list of a C header, as written by the image
+and charset converters (img.h, charmap.h, kanji-charset.h, ...), and
+writes a header holding the packed bytes:
+
+    python3 ../common/pack.py img.h img_z.h img_z
+
+Format (LZ77, byte aligned, decoded by common/unpack.s):
+    $00-$7F   (n + 1) literal bytes follow
+    $80-$FE   copy (n & $7F) + 3 bytes from dst - offset;
+              the 16-bit offset follows, low byte first.
+              Offset 1 repeats the last byte (runs)
+    $FF       end of data
+
+The parse is optimal for this format: every position keeps the cheapest
+way to reach it, using the longest match found there at any length.
+"""
+
+import re
+import sys
+
+MIN_MATCH = 3
+MAX_MATCH = 0x7F + MIN_MATCH - 1     # $FE is the longest match token
+MAX_LITERAL = 0x80
+MAX_OFFSET = 0xFFFF
+END = 0xFF
+
+
+def read_array(path):
+    """Byte values of the first {...} initializer in a C header."""
+    with open(path) as f:
+        text = f.read()
+    text = re.sub(r"/\*.*?\*/", "", text, flags=re.S)
+    text = re.sub(r"//[^\n]*", "", text)
+    body = text[text.index("{") + 1:text.index("}")]
+    return bytes(int(v, 0) & 0xFF for v in re.findall(r"0[xX][0-9a-fA-F]+|\d+", body))
+
+
+def longest_matches(data):
+    """(length, offset) of the longest earlier match at every position."""
+    n = len(data)
+    heads = {}
+    best = [(0, 0)] * n
+    for i in range(n):
+        key = data[i:i + MIN_MATCH]
+        if len(key) == MIN_MATCH:
+            length, offset = 0, 0
+            for j in reversed(heads.get(key, ())):
+                if i - j > MAX_OFFSET:
+                    break
+                m = MIN_MATCH
+                while m < MAX_MATCH and i + m < n and data[j + m] == data[i + m]:
+                    m += 1
+                if m > length:
+                    length, offset = m, i - j
+                    if m == MAX_MATCH:
+                        break
+            best[i] = (length, offset)
+            heads.setdefault(key, []).append(i)
+    return best
+
+
+def pack(data):
+    n = len(data)
+    matches = longest_matches(data)
+    INF = float("inf")
+    cost = [INF] * (n + 1)
+    step = [None] * (n + 1)
+    cost[0] = 0
+    for i in range(n):
+        if cost[i] == INF:
+            continue
+        for run in range(1, min(MAX_LITERAL, n - i) + 1):
+            c = cost[i] + 1 + run
+            if c < cost[i + run]:
+                cost[i + run] = c
+                step[i + run] = ("lit", i, run)
+        length, offset = matches[i]
+        for m in range(MIN_MATCH, length + 1):
+            c = cost[i] + 3
+            if c < cost[i + m]:
+                cost[i + m] = c
+                step[i + m] = ("copy", i, m, offset)
+
+    tokens = []
+    pos = n
+    while pos:
+        tokens.append(step[pos])
+        pos = step[pos][1]
+    out = bytearray()
+    for tok in reversed(tokens):
+        if tok[0] == "lit":
+            _, start, run = tok
+            out.append(run - 1)
+            out += data[start:start + run]
+        else:
+            _, _, m, offset = tok
+            out += bytes((0x80 + m - MIN_MATCH, offset & 0xFF, offset >> 8))
+    out.append(END)
+    return bytes(out)
+
+
+def unpack(packed):
+    """Reference decoder, same as unpack.s."""
+    out = bytearray()
+    i = 0
+    while packed[i] != END:
+        tok = packed[i]
+        if tok < 0x80:
+            out += packed[i + 1:i + 2 + tok]
+            i += 2 + tok
+        else:
+            offset = packed[i + 1] | packed[i + 2] << 8
+            for _ in range(tok - 0x80 + MIN_MATCH):
+                out.append(out[-offset])
+            i += 3
+    return bytes(out)
+
+
+def main():
+    if len(sys.argv) != 4:
+        print("usage: pack.py input.h output.h array_name", file=sys.stderr)
+        sys.exit(1)
+    src, dst, name = sys.argv[1:]
+    data = read_array(src)
+    packed = pack(data)
+    if unpack(packed) != data:
+        sys.exit("pack.py: round trip failed for " + src)
+
+    lines = [", ".join(str(b) for b in packed[k:k + 20])
+             for k in range(0, len(packed), 20)]
+    with open(dst, "w") as f:
+        f.write("/* Packed by common/pack.py from {}: {} -> {} bytes */\n"
+                .format(src, len(data), len(packed)))
+        f.write("#define {}_SIZE {}\n".format(name.upper(), len(data)))
+        f.write("const unsigned char {}[] = {{\n    {}\n}};\n"
+                .format(name, ",\n    ".join(lines)))
+    print("{}: {} -> {} bytes".format(dst, len(data), len(packed)))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,52 @@
+/*
+ * particles.h - fixed-point character-cell particle engine
+ * (see particles.s)
+ *
+ * Particles live in structure-of-arrays form with 8.8 positions in
+ * character cells. Velocities are signed bytes in 1/128 cell per frame,
+ * so drag and gravity are table lookups. pt_update() first restores the
+ * background under every particle and then moves and draws them all, so
+ * a particle never erases one drawn earlier in the same frame.
+ *
+ *   pt_bg_chr = img; pt_bg_col = clrs; pt_init();
+ *   i = pt_alloc();
+ *   if (i != PT_NONE) { pt_x[i] = 20; pt_y[i] = 12; pt_vx[i] = -64; ... }
+ */
+
+#ifndef PARTICLES_H
+#define PARTICLES_H
+
+#define PT_MAX   128
+#define PT_NONE  0xFF
+#define PT_FADE  16      /* pt_fade[] covers life 0..PT_FADE-1 */
+
+/* 1000-byte screen and colour images restored under particles */
+extern const unsigned char *pt_bg_chr;
+extern const unsigned char *pt_bg_col;
+
+/* Per-particle fields, indexed by the slot pt_alloc() returns */
+extern unsigned char pt_x[PT_MAX];     /* column (integer part) */
+extern unsigned char pt_xf[PT_MAX];    /* column fraction */
+extern unsigned char pt_y[PT_MAX];     /* row */
+extern unsigned char pt_yf[PT_MAX];
+extern signed char   pt_vx[PT_MAX];    /* 1/128 cell per frame */
+extern signed char   pt_vy[PT_MAX];
+extern unsigned char pt_col[PT_MAX];
+extern unsigned char pt_chr[PT_MAX];
+extern unsigned char pt_life[PT_MAX];  /* frames left */
+
+/* Screen code by remaining life; 0 keeps the particle's own pt_chr */
+extern unsigned char pt_fade[PT_FADE];
+
+extern unsigned char pt_count;         /* live particles */
+
+/* Empty the pool and build the background row tables */
+void pt_init(void);
+
+/* Take a free slot (PT_NONE if full); fill its fields before pt_update() */
+unsigned char pt_alloc(void);
+
+/* Erase, move (drag, gravity, life) and redraw every particle */
+void pt_update(void);
+
+#endif
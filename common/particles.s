@@ -0,0 +1,306 @@
+; particles.s - fixed-point character-cell particle engine
+;
+; C entry points (see particles.h):
+;   void pt_init(void);
+;   unsigned char pt_alloc(void);
+;   void pt_update(void);
+;
+; Fields are structure-of-arrays indexed by slot. Live slots are kept
+; dense in act[] and free ones on a stack, so allocation and release are
+; O(1) and the frame loop never visits dead slots.
+;
+; Position: column/row byte plus fraction (8.8 cells). Velocity: signed
+; byte in 1/128 cell per frame, added twice to the 8.8 position. Each
+; frame vx = drag[vx] and vy = fall[vy], where both tables apply the
+; 14/16 drag and fall adds gravity first, so there are no multiplies.
+;
+; Screen writes go through row address tables; a particle remembers the
+; cell it was drawn in so the erase pass needs no arithmetic.
+
+.export _pt_init, _pt_alloc, _pt_update
+.export _pt_bg_chr, _pt_bg_col, _pt_fade, _pt_count
+.export _pt_x, _pt_xf, _pt_y, _pt_yf, _pt_vx, _pt_vy
+.export _pt_col, _pt_chr, _pt_life
+.importzp ptr1, ptr2, ptr3, ptr4, tmp1, tmp2
+
+PT_MAX   = 128
+PT_NONE  = $FF
+PT_FADE  = 16
+
+SCR_W    = 40
+SCR_H    = 25
+SCREEN   = $0400
+COLRAM   = $D800
+
+GRAVITY  = 6                    ; 1/128 cell per frame, per frame
+
+.segment "BSS"
+
+_pt_x:     .res PT_MAX
+_pt_xf:    .res PT_MAX
+_pt_y:     .res PT_MAX
+_pt_yf:    .res PT_MAX
+_pt_vx:    .res PT_MAX
+_pt_vy:    .res PT_MAX
+_pt_col:   .res PT_MAX
+_pt_chr:   .res PT_MAX
+_pt_life:  .res PT_MAX
+pt_px:     .res PT_MAX          ; cell last drawn in
+pt_py:     .res PT_MAX          ; PT_NONE: nothing to erase
+
+act:       .res PT_MAX          ; live slots, dense
+free:      .res PT_MAX          ; free slot stack
+nfree:     .res 1
+_pt_count: .res 1
+
+_pt_fade:  .res PT_FADE
+_pt_bg_chr: .res 2
+_pt_bg_col: .res 2
+
+bgc_lo:    .res SCR_H           ; background rows
+bgc_hi:    .res SCR_H
+bgk_lo:    .res SCR_H
+bgk_hi:    .res SCR_H
+
+.segment "RODATA"
+
+scr_lo:
+.repeat SCR_H, R
+    .byte <(SCREEN + R * SCR_W)
+.endrepeat
+scr_hi:
+.repeat SCR_H, R
+    .byte >(SCREEN + R * SCR_W)
+.endrepeat
+col_lo:
+.repeat SCR_H, R
+    .byte <(COLRAM + R * SCR_W)
+.endrepeat
+col_hi:
+.repeat SCR_H, R
+    .byte >(COLRAM + R * SCR_W)
+.endrepeat
+
+; v * 14 / 16 for every signed v (index = v as a byte)
+drag:
+.repeat 256, I
+    .byte <(((I & $7F) - (I & $80)) * 14 / 16)
+.endrepeat
+
+; (v + GRAVITY) * 14 / 16
+fall:
+.repeat 256, I
+    .byte <(((I & $7F) - (I & $80) + GRAVITY) * 14 / 16)
+.endrepeat
+
+.segment "CODE"
+
+_pt_init:
+    ldx #PT_MAX - 1
+@free:
+    txa
+    sta free, x
+    dex
+    bpl @free
+    lda #PT_MAX
+    sta nfree
+    lda #0
+    sta _pt_count
+
+    lda _pt_bg_chr
+    sta ptr1
+    lda _pt_bg_chr + 1
+    sta ptr1 + 1
+    lda _pt_bg_col
+    sta ptr2
+    lda _pt_bg_col + 1
+    sta ptr2 + 1
+    ldx #0
+@row:
+    lda ptr1
+    sta bgc_lo, x
+    clc
+    adc #SCR_W
+    sta ptr1
+    lda ptr1 + 1
+    sta bgc_hi, x
+    adc #0
+    sta ptr1 + 1
+    lda ptr2
+    sta bgk_lo, x
+    clc
+    adc #SCR_W
+    sta ptr2
+    lda ptr2 + 1
+    sta bgk_hi, x
+    adc #0
+    sta ptr2 + 1
+    inx
+    cpx #SCR_H
+    bne @row
+    rts
+
+_pt_alloc:
+    ldx nfree
+    beq @full
+    dex
+    stx nfree
+    lda free, x
+    ldx _pt_count
+    sta act, x
+    inc _pt_count
+    tax
+    lda #PT_NONE
+    sta pt_py, x
+    txa
+    ldx #0
+    rts
+@full:
+    lda #PT_NONE
+    ldx #0
+    rts
+
+_pt_update:
+    lda _pt_count
+    bne @erase_all
+    rts
+
+    ; Pass 1: restore the background under every particle
+@erase_all:
+    lda #0
+    sta tmp1
+@erase:
+    ldy tmp1
+    ldx act, y
+    ldy pt_py, x
+    cpy #PT_NONE
+    beq @erase_next
+    lda scr_lo, y
+    sta ptr1
+    lda scr_hi, y
+    sta ptr1 + 1
+    lda col_lo, y
+    sta ptr2
+    lda col_hi, y
+    sta ptr2 + 1
+    lda bgc_lo, y
+    sta ptr3
+    lda bgc_hi, y
+    sta ptr3 + 1
+    lda bgk_lo, y
+    sta ptr4
+    lda bgk_hi, y
+    sta ptr4 + 1
+    ldy pt_px, x
+    lda (ptr3), y
+    sta (ptr1), y
+    lda (ptr4), y
+    sta (ptr2), y
+@erase_next:
+    inc tmp1
+    lda tmp1
+    cmp _pt_count
+    bne @erase
+
+    ; Pass 2: move, age and draw
+    lda #0
+    sta tmp1
+@move:
+    ldy tmp1
+    cpy _pt_count
+    bcc @live
+    rts
+
+    ; Dead: release the slot and move the last live one into place
+@kill:
+    lda #PT_NONE
+    sta pt_py, x
+    txa
+    ldy nfree
+    sta free, y
+    inc nfree
+    dec _pt_count
+    ldy _pt_count
+    lda act, y
+    ldy tmp1
+    sta act, y
+    jmp @move
+
+@live:
+    ldx act, y
+
+    ldy #0                      ; x += vx * 2
+    lda _pt_vx, x
+    bpl @xpos
+    dey
+@xpos:
+    asl
+    clc
+    adc _pt_xf, x
+    sta _pt_xf, x
+    tya
+    adc _pt_x, x
+    sta _pt_x, x
+
+    ldy #0                      ; y += vy * 2
+    lda _pt_vy, x
+    bpl @ypos
+    dey
+@ypos:
+    asl
+    clc
+    adc _pt_yf, x
+    sta _pt_yf, x
+    tya
+    adc _pt_y, x
+    sta _pt_y, x
+
+    ldy _pt_vx, x               ; drag, and gravity on vy
+    lda drag, y
+    sta _pt_vx, x
+    ldy _pt_vy, x
+    lda fall, y
+    sta _pt_vy, x
+
+    dec _pt_life, x
+    beq @kill
+    lda _pt_x, x                ; off screen (negative wraps high)
+    cmp #SCR_W
+    bcs @kill
+    ldy _pt_y, x
+    beq @kill                   ; row 0 is kept clear, as before
+    cpy #SCR_H
+    bcs @kill
+
+    lda _pt_chr, x              ; shape, or the fade one for this life
+    sta tmp2
+    lda _pt_life, x
+    cmp #PT_FADE
+    bcs @draw
+    tay
+    lda _pt_fade, y
+    beq @draw_y
+    sta tmp2
+@draw_y:
+    ldy _pt_y, x
+@draw:
+    lda scr_lo, y
+    sta ptr1
+    lda scr_hi, y
+    sta ptr1 + 1
+    lda col_lo, y
+    sta ptr2
+    lda col_hi, y
+    sta ptr2 + 1
+    tya
+    sta pt_py, x
+    ldy _pt_x, x
+    tya
+    sta pt_px, x
+    lda tmp2
+    sta (ptr1), y
+    lda _pt_col, x
+    sta (ptr2), y
+
+    inc tmp1
+    jmp @move
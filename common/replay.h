@@ -0,0 +1,55 @@
+/*
+ * replay.h - deterministic joystick recorder and player (see replay.s)
+ *
+ * Every frame's joystick bytes and the rand() seed of a run go to a
+ * run-length coded log at RP_BASE ($C000-$C7FF), outside the program,
+ * so runs can be saved through the monitor and played back exactly:
+ *
+ *   python3 ai_toolchain.py --save-replay run.rpl
+ *   python3 ai_toolchain.py --replay run.rpl --loop pong/
+ *
+ * rp_start() replaces the title screen's fire check, rp_begin() seeds
+ * rand() at the start of each run and logs the game mode, rp_frame()
+ * samples (or plays) both ports once per frame and rp_joy() returns
+ * that frame's byte:
+ *
+ *   while (!rp_start()) waitvsync();
+ *   two_player = rp_begin(two_player ? RP_2P : 0) & RP_2P;
+ *   for (;;) { shd_wait(); rp_frame(); joy = rp_joy(JOY_2); ... }
+ *
+ * Link with the joystick driver installed (joy_install()).
+ */
+
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#define RP_BASE   0xC000
+#define RP_LOG    (RP_BASE + 16)
+
+#define RP_OFF    0      /* live input, nothing logged */
+#define RP_RECORD 1
+#define RP_PLAY   2
+
+/* rp_begin() game byte: the run's mode, restored on playback */
+#define RP_DEMO   0x01   /* unattended demo: played live, not logged */
+#define RP_2P     0x02   /* two players */
+
+/* Start a run: record a new log with a fresh seed and this game byte,
+ * or rewind the one the host left in RP_PLAY mode; either way srand()
+ * the run's seed. Returns the game byte to run with: the one given, or
+ * the recorded one on playback. RP_DEMO runs are not logged, so they
+ * leave the last log for the host */
+unsigned char __fastcall__ rp_begin(unsigned char game);
+
+/* Once per game frame: sample both ports (and log them), or play the
+ * next frame of the log */
+void rp_frame(void);
+
+/* This frame's joystick byte for JOY_1 or JOY_2 */
+unsigned char __fastcall__ rp_joy(unsigned char port);
+
+/* Title screens: fire on port 2, or 1 straight away when a playback is
+ * waiting */
+unsigned char rp_start(void);
+
+#endif
@@ -0,0 +1,317 @@
+; replay.s - deterministic joystick recorder and player
+;
+; C entry points (see replay.h):
+;   unsigned char __fastcall__ rp_begin(unsigned char game);
+;   void rp_frame(void);
+;   unsigned char __fastcall__ rp_joy(unsigned char port);
+;   unsigned char rp_start(void);
+;
+; The log lives at a fixed address, RP_BASE ($C000), just below the C
+; stack and clear of every game's code, data and VIC bank. It is not
+; cleared at start-up, so the host can write a log through the monitor
+; before RUN and have it played, or read one back after a run.
+;
+;   +0   "RPLY" (ASCII)
+;   +4   mode: RP_OFF, RP_RECORD or RP_PLAY
+;   +5   game: the run's mode byte from rp_begin() (players, ...)
+;   +6   rand() seed, low byte first
+;   +8   log bytes used
+;   +10  frames recorded or played
+;   +12  hold frame (0: none): rp_frame() waits there until the host
+;        changes it, with +14 set meanwhile (regress.py snapshots)
+;   +16  log: 3-byte entries (port 2, port 1, frames), run-length coded
+;
+; Without the magic (power-on RAM) rp_begin() starts a new recording.
+; Demo runs (RP_DEMO in the game byte) are not recorded: they play live
+; and leave the last log, and its header, for the host to save.
+; When a recording fills the log, or a playback runs out, the mode drops
+; to RP_OFF and input is live again.
+
+.export _rp_begin, _rp_frame, _rp_joy, _rp_start
+.import _joy_read, _srand
+.importzp ptr1
+
+RP_BASE   = $C000
+RP_TOP    = $C800               ; C stack starts here
+RP_LOG    = RP_BASE + 16
+RP_SIZE   = RP_TOP - RP_LOG
+
+rp_mode   = RP_BASE + 4
+rp_game   = RP_BASE + 5
+rp_seed   = RP_BASE + 6
+rp_used   = RP_BASE + 8
+rp_frames = RP_BASE + 10
+rp_hold   = RP_BASE + 12
+rp_held   = RP_BASE + 14
+
+RP_OFF    = 0
+RP_RECORD = 1
+RP_PLAY   = 2
+
+RP_DEMO   = $01                 ; game byte: unattended demo run
+
+JOY_1     = 0
+JOY_2     = 1
+JOY_FIRE  = $10                 ; JOY_BTN_1_MASK
+
+CIA1_TA   = $DC04               ; free-running timer, seeds a recording
+
+.segment "RODATA"
+
+magic:  .byte $52, $50, $4C, $59   ; "RPLY" in ASCII, not PETSCII
+
+.segment "BSS"
+
+joy:    .res 2                  ; this frame, by port (JOY_1, JOY_2)
+run:    .res 1                  ; play: frames left in the current entry
+game:   .res 1                  ; rp_begin: the run's game byte
+pos:    .res 2                  ; play: next entry
+
+.segment "CODE"
+
+; Z set when the log header is ours
+check:
+    ldx #3
+@byte:
+    lda RP_BASE, x
+    cmp magic, x
+    bne @done
+    dex
+    bpl @byte
+    lda #0
+@done:
+    rts
+
+; A = game byte; returns the one to run with: A, or the recorded one
+; when playing back
+_rp_begin:
+    sta game
+    jsr check
+    bne @record
+    lda rp_mode
+    cmp #RP_PLAY
+    bne @demo
+    lda #<RP_LOG
+    sta pos
+    lda #>RP_LOG
+    sta pos + 1
+    lda #0
+    sta run
+    lda rp_game
+    sta game
+    jmp @seed
+
+@demo:
+    lda game                    ; a demo keeps the last log as it is
+    and #RP_DEMO
+    beq @record
+    lda #RP_OFF
+    sta rp_mode
+    lda CIA1_TA
+    ldx CIA1_TA + 1
+    jsr _srand
+    jmp @done
+
+@record:
+    ldx #3
+@magic:
+    lda magic, x
+    sta RP_BASE, x
+    dex
+    bpl @magic
+    lda game
+    sta rp_game
+    and #RP_DEMO                ; power-on RAM: a header, but no log
+    bne @off
+    lda #RP_RECORD
+    bne @mode                   ; always
+@off:
+    lda #RP_OFF
+@mode:
+    sta rp_mode
+    lda CIA1_TA
+    sta rp_seed
+    lda CIA1_TA + 1
+    sta rp_seed + 1
+    lda #0
+    sta rp_used
+    sta rp_used + 1
+    sta rp_hold
+    sta rp_hold + 1
+    sta rp_held
+
+@seed:
+    lda #0
+    sta rp_frames
+    sta rp_frames + 1
+    lda rp_seed
+    ldx rp_seed + 1
+    jsr _srand
+@done:
+    lda game
+    ldx #0
+    rts
+
+_rp_frame:
+    lda rp_mode
+    cmp #RP_PLAY
+    bne @live
+    jmp @play
+
+@live:
+    lda #JOY_1
+    jsr _joy_read
+    sta joy
+    lda #JOY_2
+    jsr _joy_read
+    sta joy + 1
+    lda rp_mode
+    cmp #RP_RECORD
+    bne @done
+
+    lda rp_used                 ; ptr1 = last entry
+    clc
+    adc #<(RP_LOG - 3)
+    sta ptr1
+    lda rp_used + 1
+    adc #>(RP_LOG - 3)
+    sta ptr1 + 1
+    lda rp_used
+    ora rp_used + 1
+    beq @append
+    ldy #0                      ; same input: extend the run
+    lda (ptr1), y
+    cmp joy + 1
+    bne @append
+    iny
+    lda (ptr1), y
+    cmp joy
+    bne @append
+    iny
+    lda (ptr1), y
+    cmp #$FF
+    beq @append
+    adc #1                      ; carry clear after cmp
+    sta (ptr1), y
+    jmp count
+
+@append:
+    lda rp_used                 ; room for one more entry?
+    cmp #<(RP_SIZE - 2)
+    lda rp_used + 1
+    sbc #>(RP_SIZE - 2)
+    bcs @stop
+    ldy #3
+    lda joy + 1
+    sta (ptr1), y
+    iny
+    lda joy
+    sta (ptr1), y
+    iny
+    lda #1
+    sta (ptr1), y
+    lda rp_used
+    clc
+    adc #3
+    sta rp_used
+    bcc @logged
+    inc rp_used + 1
+@logged:
+    jmp count
+@done:
+    rts
+
+@stop:
+    lda #RP_OFF                 ; log full or played out: live from here
+    sta rp_mode
+    jmp @live
+
+@play:
+    lda run
+    bne @same
+    lda rp_used                 ; ptr1 = end of the log
+    clc
+    adc #<RP_LOG
+    sta ptr1
+    lda rp_used + 1
+    adc #>RP_LOG
+    sta ptr1 + 1
+    lda pos
+    cmp ptr1
+    lda pos + 1
+    sbc ptr1 + 1
+    bcs @stop
+    lda pos
+    sta ptr1
+    lda pos + 1
+    sta ptr1 + 1
+    ldy #0
+    lda (ptr1), y
+    sta joy + 1
+    iny
+    lda (ptr1), y
+    sta joy
+    iny
+    lda (ptr1), y
+    sta run
+    lda pos
+    clc
+    adc #3
+    sta pos
+    bcc @same
+    inc pos + 1
+@same:
+    dec run
+    jmp count
+
+; Count one logged frame; at the hold frame wait for the host
+count:
+    inc rp_frames
+    bne @hold
+    inc rp_frames + 1
+@hold:
+    lda rp_hold
+    ora rp_hold + 1
+    beq @done
+    lda rp_frames
+    cmp rp_hold
+    bne @done
+    lda rp_frames + 1
+    cmp rp_hold + 1
+    bne @done
+    lda #1
+    sta rp_held
+@wait:
+    lda rp_hold
+    cmp rp_frames
+    bne @go
+    lda rp_hold + 1
+    cmp rp_frames + 1
+    beq @wait
+@go:
+    lda #0
+    sta rp_held
+@done:
+    rts
+
+_rp_joy:
+    tax
+    lda joy, x
+    ldx #0
+    rts
+
+_rp_start:
+    jsr check
+    bne @live
+    lda rp_mode
+    cmp #RP_PLAY
+    bne @live
+    lda #1
+    ldx #0
+    rts
+@live:
+    lda #JOY_2
+    jsr _joy_read
+    and #JOY_FIRE
+    ldx #0
+    rts
@@ -0,0 +1,32 @@
+/*
+ * rng.h - fast 8-bit random numbers (see rng.s)
+ *
+ * An 8-bit LFSR in place of rand() for per-frame game rolls: no 16-bit
+ * state and no division. Percent rolls compare a byte against a
+ * threshold, ranges scale a byte by multiplication:
+ *
+ *   if (rng_next() < RNG_PCT(8)) { ... }   about 8% of the time
+ *   x = rng_below(PLAY_W);                 0..PLAY_W-1
+ *
+ * Seed it from rand() after rp_begin() so replays see the same rolls:
+ *
+ *   rp_begin();
+ *   rng_seed((unsigned char)rand());
+ */
+
+#ifndef RNG_H
+#define RNG_H
+
+/* Byte threshold for a p percent roll, p < 100 */
+#define RNG_PCT(p) ((unsigned char)((p) * 256 / 100))
+
+/* Restart the sequence; 0 is taken as 1 */
+void __fastcall__ rng_seed(unsigned char seed);
+
+/* Next byte, 1..255 */
+unsigned char rng_next(void);
+
+/* Next value in 0..n-1 (n = 1..255) */
+unsigned char __fastcall__ rng_below(unsigned char n);
+
+#endif
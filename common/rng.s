@@ -0,0 +1,64 @@
+; rng.s - 8-bit Galois LFSR random bytes for cc65/ca65
+;
+; C entry points (see rng.h):
+;   void __fastcall__ rng_seed(unsigned char seed);
+;   unsigned char rng_next(void);
+;   unsigned char __fastcall__ rng_below(unsigned char n);
+;
+; The state steps through all 255 non-zero bytes (polynomial $11D).
+; rng_next clocks it eight times, so consecutive results share no bits
+; the way single shifts would. rng_below scales a byte into 0..n-1 with
+; an 8x8 shift-add multiply, keeping the high byte: no division, unlike
+; rand() % n, which goes through cc65's 16-bit divide.
+
+.export _rng_seed, _rng_next, _rng_below
+.importzp tmp1, tmp2
+
+.segment "DATA"
+
+state:  .byte 1                 ; never 0: 0 is the LFSR's dead state
+
+.segment "CODE"
+
+; A = seed; 0 is taken as 1
+_rng_seed:
+    cmp #0
+    bne @set
+    lda #1
+@set:
+    sta state
+    rts
+
+; Returns 1..255 in A (X = 0)
+_rng_next:
+    lda state
+    ldy #8
+@step:
+    asl a
+    bcc @skip
+    eor #$1D
+@skip:
+    dey
+    bne @step
+    sta state
+    ldx #0
+    rts
+
+; A = n; returns (rng_next() * n) >> 8, which is 0..n-1
+_rng_below:
+    sta tmp1
+    jsr _rng_next
+    sta tmp2
+    lda #0
+    ldy #8
+@bit:
+    lsr tmp2                    ; next multiplier bit
+    bcc @shift
+    clc
+    adc tmp1
+@shift:
+    ror a                       ; product high byte, carry in at the top
+    dey
+    bne @bit
+    ldx #0
+    rts
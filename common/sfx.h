@@ -0,0 +1,44 @@
+/*
+ * sfx.h - IRQ-driven SID sound effects and music (see sfx.s)
+ *
+ * Effects are byte tables: a 4-byte header followed by 6-byte steps and
+ * an SFX_END or SFX_LOOP terminator. sfx_play() only queues the effect;
+ * the shadow.s raster IRQ steps every voice once per frame. Link with
+ * shadow.s and call sfx_init() after shd_install().
+ *
+ *   static const unsigned char fx_zap[] = {
+ *       SFX_V1, 2, 0x00, 0xA0,                  voice, priority, AD, SR
+ *       SFX_STEP(6, 0x21, 0x3000, -4, 0x08),    frames, ctl, freq, slide, pw
+ *       SFX_END
+ *   };
+ */
+
+#ifndef SFX_H
+#define SFX_H
+
+#define SFX_V1    0
+#define SFX_V2    1
+#define SFX_V3    2
+#define SFX_KEEP  0x80   /* or into the voice: don't restart if playing */
+
+#define SFX_END   0x00   /* gate off, voice free */
+#define SFX_LOOP  0xFF   /* back to the first step */
+
+#define SFX_HDR   4
+#define SFX_PITCH (SFX_HDR + 3)   /* freq hi of the first step */
+
+/* One step: hold for frames, freq hi += slide every frame */
+#define SFX_STEP(frames, ctl, freq, slide, pw) \
+    (frames), (ctl), (unsigned char)(freq), (unsigned char)((freq) >> 8), \
+    (unsigned char)(slide), (pw)
+
+/* Silence all voices, set volume 15, hook the per-frame player */
+void sfx_init(void);
+
+/* Start an effect on its voice unless a higher priority one is playing */
+void __fastcall__ sfx_play(const unsigned char *fx);
+
+/* Release a voice (SFX_V1..SFX_V3) at the next frame */
+void __fastcall__ sfx_stop(unsigned char voice);
+
+#endif
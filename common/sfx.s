@@ -0,0 +1,280 @@
+; sfx.s - IRQ-driven SID sound effects and music
+;
+; C entry points (see sfx.h):
+;   void sfx_init(void);
+;   void __fastcall__ sfx_play(const unsigned char *fx);
+;   void __fastcall__ sfx_stop(unsigned char voice);
+;
+; sfx_tick runs once per frame from the shadow.s raster IRQ, so sound
+; timing does not depend on the game loop keeping up. Each voice plays
+; one effect; a new effect takes the voice only if its priority is at
+; least that of the effect already playing.
+;
+; Effect layout (all bytes):
+;   voice | SFX_KEEP, priority, AD, SR
+;   step: frames, ctl, freq lo, freq hi, slide, pulse hi   (repeated)
+;   0     end: gate off, voice free
+;   $FF   loop back to the first step
+; slide is a signed value added to freq hi every frame of the step.
+; SFX_KEEP: if this effect is already playing, sfx_play leaves it alone.
+
+.export _sfx_init, _sfx_play, _sfx_stop
+.import _shd_sid, _shd_sid_dirty, _shd_hook
+.importzp ptr1, tmp1, tmp2, tmp3
+
+SID_FLO  = $D400
+SID_FHI  = $D401
+SID_PWH  = $D403
+SID_CTL  = $D404
+SID_AD   = $D405
+SID_SR   = $D406
+SID_VOL  = $18                  ; shadow offset of $D418
+
+SFX_HDR       = 4
+SFX_STEP_SIZE = 6
+SFX_LOOP      = $FF
+
+; Voice states
+SFX_IDLE  = 0
+SFX_START = 1                   ; gate off this frame, first step next
+SFX_RUN   = 2
+SFX_STOP  = 3
+
+; Per-voice arrays are indexed by the SID register offset of the voice
+; (0, 7, 14), so one X serves both the state and the chip.
+VSLOTS = 15
+
+.segment "BSS"
+
+v_state:   .res VSLOTS
+v_prio:    .res VSLOTS
+v_timer:   .res VSLOTS
+v_ctl:     .res VSLOTS
+v_fhi:     .res VSLOTS
+v_slide:   .res VSLOTS
+v_ad:      .res VSLOTS
+v_sr:      .res VSLOTS
+v_pos_lo:  .res VSLOTS          ; next step
+v_pos_hi:  .res VSLOTS
+v_loop_lo: .res VSLOTS          ; first step (also identifies the effect)
+v_loop_hi: .res VSLOTS
+
+.segment "RODATA"
+
+voice_ofs: .byte 0, 7, 14
+
+.segment "CODE"
+
+_sfx_init:
+    php
+    sei
+    ldx #VSLOTS - 1
+    lda #0
+@clear:
+    sta v_state, x
+    sta v_prio, x
+    dex
+    bpl @clear
+    sta SID_CTL
+    sta SID_CTL + 7
+    sta SID_CTL + 14
+
+    lda #15                     ; master volume through the shadow
+    sta _shd_sid + SID_VOL
+    lda #1
+    sta _shd_sid_dirty + SID_VOL
+
+    lda #<sfx_tick
+    sta _shd_hook
+    lda #>sfx_tick
+    sta _shd_hook + 1
+    plp
+    rts
+
+; A/X = effect
+_sfx_play:
+    sta ptr1
+    stx ptr1 + 1
+    clc                         ; tmp2/tmp3 = first step
+    adc #SFX_HDR
+    sta tmp2
+    txa
+    adc #0
+    sta tmp3
+
+    ldy #0
+    lda (ptr1), y
+    sta tmp1                    ; voice | SFX_KEEP
+    and #$03
+    tax
+    lda voice_ofs, x
+    tax
+
+    php
+    sei
+    lda v_state, x
+    beq @take                   ; idle voice
+
+    bit tmp1
+    bpl @prio
+    lda v_loop_lo, x            ; SFX_KEEP: already playing this one?
+    cmp tmp2
+    bne @prio
+    lda v_loop_hi, x
+    cmp tmp3
+    beq @done
+
+@prio:
+    ldy #1
+    lda (ptr1), y
+    cmp v_prio, x
+    bcc @done                   ; lower priority than what's playing
+
+@take:
+    ldy #1
+    lda (ptr1), y
+    sta v_prio, x
+    iny
+    lda (ptr1), y
+    sta v_ad, x
+    iny
+    lda (ptr1), y
+    sta v_sr, x
+    lda tmp2
+    sta v_loop_lo, x
+    sta v_pos_lo, x
+    lda tmp3
+    sta v_loop_hi, x
+    sta v_pos_hi, x
+    lda #0
+    sta v_ctl, x
+    lda #SFX_START
+    sta v_state, x
+@done:
+    plp
+    rts
+
+; A = voice (0-2): release it at the next tick
+_sfx_stop:
+    and #$03
+    tax
+    lda voice_ofs, x
+    tax
+    lda v_state, x
+    beq @idle
+    lda #SFX_STOP
+    sta v_state, x
+@idle:
+    rts
+
+; Called from the raster IRQ after the shadow flush
+sfx_tick:
+    lda ptr1                    ; the IRQ may have interrupted C code
+    pha
+    lda ptr1 + 1
+    pha
+
+    ldx #14
+@voice:
+    lda v_state, x
+    bne @active
+    jmp @next
+@active:
+    cmp #SFX_RUN
+    beq @run
+    cmp #SFX_START
+    beq @start
+    jmp @end                    ; SFX_STOP
+
+@start:
+    lda #0                      ; hard gate off restarts the envelope
+    sta SID_CTL, x
+    lda v_ad, x
+    sta SID_AD, x
+    lda v_sr, x
+    sta SID_SR, x
+    lda #SFX_RUN
+    sta v_state, x
+    lda #1
+    sta v_timer, x
+    jmp @next
+
+@run:
+    dec v_timer, x
+    beq @fetch
+    lda v_slide, x
+    bne @slide
+    jmp @next
+@slide:
+    clc
+    adc v_fhi, x
+    sta v_fhi, x
+    sta SID_FHI, x
+    jmp @next
+
+@fetch:
+    lda v_pos_lo, x
+    sta ptr1
+    lda v_pos_hi, x
+    sta ptr1 + 1
+    ldy #0
+    lda (ptr1), y
+    beq @end
+    cmp #SFX_LOOP
+    bne @step
+    lda v_loop_lo, x
+    sta ptr1
+    lda v_loop_hi, x
+    sta ptr1 + 1
+    lda (ptr1), y
+@step:
+    sta v_timer, x
+    iny
+    lda (ptr1), y
+    sta v_ctl, x
+    iny
+    lda (ptr1), y
+    sta SID_FLO, x
+    iny
+    lda (ptr1), y
+    sta v_fhi, x
+    sta SID_FHI, x
+    iny
+    lda (ptr1), y
+    sta v_slide, x
+    iny
+    lda (ptr1), y
+    sta SID_PWH, x
+    lda v_ctl, x                ; control last: gate on with all set
+    sta SID_CTL, x
+
+    clc
+    lda ptr1
+    adc #SFX_STEP_SIZE
+    sta v_pos_lo, x
+    lda ptr1 + 1
+    adc #0
+    sta v_pos_hi, x
+    jmp @next
+
+@end:
+    lda v_ctl, x
+    and #$FE                    ; gate off, let the release run
+    sta SID_CTL, x
+    lda #SFX_IDLE
+    sta v_state, x
+    sta v_prio, x
+
+@next:
+    txa
+    sec
+    sbc #7
+    tax
+    bcc @out
+    jmp @voice
+@out:
+    pla
+    sta ptr1 + 1
+    pla
+    sta ptr1
+    rts
@@ -0,0 +1,82 @@
+/*
+ * shadow.h - shadow VIC-II/SID registers flushed by a raster IRQ
+ * (see shadow.s)
+ *
+ * Write registers with SHD_VIC()/SHD_SID() instead of poking the chips.
+ * The raster IRQ installed by shd_install() copies every dirty register
+ * in one burst at a fixed line and then bumps shd_frame; shd_wait()
+ * replaces the raster busy-wait in the main loop. Register arguments are
+ * offsets from $D000 / $D400.
+ */
+
+#ifndef SHADOW_H
+#define SHADOW_H
+
+#define SHD_VIC_COUNT 0x2F    /* $D000-$D02E */
+#define SHD_SID_COUNT 0x19    /* $D400-$D418 */
+
+#define SHD_LINE      251     /* flush line, lower border */
+
+#define SHD_MAX_SPLITS 16
+
+/* Split line for text row r (default vertical scroll): two lines
+ * above its first pixel row, so the KERNAL dispatch and the register
+ * writes are done before the row starts */
+#define SHD_ROW_LINE(r) (0x32 + (r) * 8 - 2)
+
+/* VIC-II offsets shared between games */
+#define SHD_SPR_HI_X  0x10
+#define SHD_SPR_ENA   0x15
+
+extern unsigned char shd_vic[SHD_VIC_COUNT];
+extern unsigned char shd_vic_dirty[SHD_VIC_COUNT];
+extern unsigned char shd_sid[SHD_SID_COUNT];
+extern unsigned char shd_sid_dirty[SHD_SID_COUNT];
+extern volatile unsigned char shd_frame;
+
+/* Called from the IRQ after every flush (sound engines hook in here) */
+extern void (*shd_hook)(void);
+
+/*
+ * Mid-frame splits: at each shd_split_line[i] (ascending, above the flush
+ * line) the IRQ stores the split's $D021-$D023 and $D016, and the values
+ * hold until the next split. Fill all the tables, then set
+ * shd_split_count; change the count right after shd_wait(). 0 disables
+ * the splits.
+ */
+extern unsigned char shd_split_count;
+extern unsigned char shd_split_line[SHD_MAX_SPLITS];
+extern unsigned char shd_split_d016[SHD_MAX_SPLITS];   /* fine scroll */
+extern unsigned char shd_split_d021[SHD_MAX_SPLITS];   /* background */
+extern unsigned char shd_split_d022[SHD_MAX_SPLITS];   /* multicolour 1 */
+extern unsigned char shd_split_d023[SHD_MAX_SPLITS];   /* multicolour 2 */
+
+/*
+ * Collision latches: every flush ORs in $D01E (sprite-sprite) and $D01F
+ * (sprite-background) as the frame just shown left them, bit n for
+ * sprite n. That frame used the positions staged two logic frames ago.
+ * Read and clear them right after shd_wait(); the chip registers
+ * themselves are cleared by the IRQ's read.
+ */
+extern volatile unsigned char shd_coll_spr;
+extern volatile unsigned char shd_coll_bg;
+
+/* Seed the mirrors and hook the raster IRQ at the given line */
+void __fastcall__ shd_install(unsigned char line);
+
+/* Wait for the next flush (start of a new logic frame) */
+void shd_wait(void);
+
+/* Queue a register write for the next flush */
+#define SHD_VIC(reg, v) (shd_vic[reg] = (v), shd_vic_dirty[reg] = 1)
+#define SHD_SID(reg, v) (shd_sid[reg] = (v), shd_sid_dirty[reg] = 1)
+
+/* Show / hide the sprites in a bit mask through the $D015 mirror */
+#define SHD_SPR_SHOW(m) SHD_VIC(SHD_SPR_ENA, shd_vic[SHD_SPR_ENA] | (m))
+#define SHD_SPR_HIDE(m) SHD_VIC(SHD_SPR_ENA, shd_vic[SHD_SPR_ENA] & ~(m))
+
+/* Sprite n position, low 8 bits of X (bit 8 lives in SHD_SPR_HI_X) */
+#define SHD_SPR_X(n, v) SHD_VIC((n) * 2, v)
+#define SHD_SPR_Y(n, v) SHD_VIC((n) * 2 + 1, v)
+
+#endif
@@ -0,0 +1,245 @@
+; shadow.s - shadow VIC-II/SID registers flushed by a raster IRQ
+;
+; C entry points (see shadow.h):
+;   void __fastcall__ shd_install(unsigned char line);
+;   void shd_wait(void);
+;   void (*shd_hook)(void);     per-frame routine run after the flush
+;   shd_split_*                 mid-frame splits
+;   shd_coll_spr, shd_coll_bg  collision latches
+;
+; Game code writes RAM mirrors of $D000-$D02E and $D400-$D418 and sets a
+; dirty byte per register. A raster IRQ at a fixed line copies only the
+; dirty registers to the chips in one burst and then bumps shd_frame, so
+; logic can run during the visible frame without tearing and without
+; read-modify-writing write-only SID registers.
+;
+; The handler chains through the KERNAL vector at $0314: CIA timer IRQs
+; still reach the KERNAL (keyboard, jiffy clock), raster IRQs end in
+; $EA81 which restores the registers and returns.
+;
+; Splits: when shd_split_count is non-zero the same IRQ first fires at
+; each shd_split_line[] (ascending, above the flush line) and stores
+; the split's $D016 and background/multicolour registers, so rows can
+; have their own colours and fine scroll.
+;
+; Collisions: the flush first reads $D01E/$D01F, which hold what the
+; frame just displayed touched, and ORs them into shd_coll_spr and
+; shd_coll_bg. Reading clears the chip's latches, so games take the
+; collision bits from these two bytes instead of the registers.
+
+.export _shd_vic, _shd_vic_dirty, _shd_sid, _shd_sid_dirty
+.export _shd_frame, _shd_hook
+.export _shd_split_count, _shd_split_line, _shd_split_d016
+.export _shd_split_d021, _shd_split_d022, _shd_split_d023
+.export _shd_install, _shd_wait
+.export _shd_coll_spr, _shd_coll_bg
+
+SHD_VIC_COUNT = $2F             ; $D000-$D02E
+SHD_SID_COUNT = $19             ; $D400-$D418
+SHD_MAX_SPLITS = 16
+
+VIC_BASE   = $D000
+VIC_CTRL1  = $D011
+VIC_RASTER = $D012
+VIC_CTRL2  = $D016
+VIC_BG0    = $D021
+VIC_BG1    = $D022
+VIC_BG2    = $D023
+VIC_IRR    = $D019              ; interrupt request (write 1 to ack)
+VIC_IMR    = $D01A              ; interrupt mask
+VIC_SPR_SPR_COLL = $1E          ; collision latches clear on read
+VIC_SPR_BG_COLL  = $1F
+SID_BASE   = $D400
+
+CINV       = $0314              ; KERNAL IRQ vector
+IRQ_EXIT   = $EA81              ; KERNAL: pull Y/X/A, rti
+
+.segment "BSS"
+
+_shd_vic:       .res SHD_VIC_COUNT
+_shd_vic_dirty: .res SHD_VIC_COUNT
+_shd_sid:       .res SHD_SID_COUNT
+_shd_sid_dirty: .res SHD_SID_COUNT
+_shd_frame:     .res 1          ; bumped once per flush
+old_irq:        .res 2
+flush_line:     .res 1
+
+_shd_split_count: .res 1
+_shd_split_line:  .res SHD_MAX_SPLITS
+_shd_split_d016:  .res SHD_MAX_SPLITS
+_shd_split_d021:  .res SHD_MAX_SPLITS
+_shd_split_d022:  .res SHD_MAX_SPLITS
+_shd_split_d023:  .res SHD_MAX_SPLITS
+split_idx:        .res 1          ; next split this frame
+
+_shd_coll_spr:    .res 1          ; $D01E bits since the game last cleared it
+_shd_coll_bg:     .res 1          ; $D01F bits, likewise
+
+.segment "DATA"
+
+; The hook is the operand of a JMP, so C can store a plain function
+; pointer in shd_hook (no JMP ($xxFF) page-wrap pitfall)
+call_hook:      jmp hook_none
+_shd_hook       = call_hook + 1
+
+.segment "CODE"
+
+; A = raster line for the flush (0-255, pick one in the lower border)
+_shd_install:
+    sei
+    sta flush_line
+    pha
+    lda #0
+    sta split_idx
+    sta _shd_coll_spr
+    sta _shd_coll_bg
+
+    ; Seed the VIC mirror from the chip so RMW on the shadow works.
+    ; The collision latches are skipped (reading clears them). $D012 and
+    ; bit 7 of $D011 read the current raster but write the compare
+    ; line, so the mirror gets the flush line there instead.
+    ldx #SHD_VIC_COUNT - 1
+@seed:
+    lda flush_line
+    cpx #VIC_RASTER - VIC_BASE
+    beq @store
+    lda #0
+    cpx #VIC_SPR_SPR_COLL
+    beq @store
+    cpx #VIC_SPR_BG_COLL
+    beq @store
+    lda VIC_BASE, x
+    cpx #VIC_CTRL1 - VIC_BASE
+    bne @store
+    and #$7F                    ; raster compare bit 8 = 0
+@store:
+    sta _shd_vic, x
+    lda #0
+    sta _shd_vic_dirty, x
+    dex
+    bpl @seed
+
+    ; SID is write-only: start from silence
+    ldx #SHD_SID_COUNT - 1
+    lda #0
+@sid:
+    sta _shd_sid, x
+    sta _shd_sid_dirty, x
+    dex
+    bpl @sid
+
+    ; Chain into the KERNAL vector (only once)
+    lda CINV + 1
+    cmp #>shd_irq
+    bne @hook
+    lda CINV
+    cmp #<shd_irq
+    beq @raster
+@hook:
+    lda CINV
+    sta old_irq
+    lda CINV + 1
+    sta old_irq + 1
+    lda #<shd_irq
+    sta CINV
+    lda #>shd_irq
+    sta CINV + 1
+
+@raster:
+    pla
+    sta VIC_RASTER
+    lda VIC_CTRL1
+    and #$7F                    ; raster compare bit 8 = 0
+    sta VIC_CTRL1
+    lda #$01
+    sta VIC_IRR                 ; drop any stale request
+    ora VIC_IMR
+    sta VIC_IMR                 ; enable raster IRQ
+    cli
+    rts
+
+; Wait until the IRQ has flushed the next frame
+_shd_wait:
+    lda _shd_frame
+@wait:
+    cmp _shd_frame
+    beq @wait
+    rts
+
+shd_irq:
+    lda VIC_IRR
+    and #$01
+    bne @raster
+    jmp (old_irq)               ; CIA timer: let the KERNAL have it
+
+@raster:
+    sta VIC_IRR                 ; ack raster
+    ldx split_idx
+    cpx _shd_split_count
+    bcs @flush
+
+    lda _shd_split_d016, x      ; split: registers for the rows below,
+    sta VIC_CTRL2               ; fine scroll and background first
+    lda _shd_split_d021, x
+    sta VIC_BG0
+    lda _shd_split_d022, x
+    sta VIC_BG1
+    lda _shd_split_d023, x
+    sta VIC_BG2
+    inx
+    stx split_idx
+    lda flush_line              ; then the next split or the flush
+    cpx _shd_split_count
+    bcs @arm
+    lda _shd_split_line, x
+@arm:
+    sta VIC_RASTER
+    jmp IRQ_EXIT
+
+@flush:
+    lda VIC_BASE + VIC_SPR_SPR_COLL ; collisions of the frame just shown
+    ora _shd_coll_spr
+    sta _shd_coll_spr
+    lda VIC_BASE + VIC_SPR_BG_COLL
+    ora _shd_coll_bg
+    sta _shd_coll_bg
+
+    ldx #SHD_VIC_COUNT - 1
+@vic:
+    lda _shd_vic_dirty, x
+    beq @vic_next
+    lda #0
+    sta _shd_vic_dirty, x
+    lda _shd_vic, x
+    sta VIC_BASE, x
+@vic_next:
+    dex
+    bpl @vic
+
+    ldx #SHD_SID_COUNT - 1
+@sid:
+    lda _shd_sid_dirty, x
+    beq @sid_next
+    lda #0
+    sta _shd_sid_dirty, x
+    lda _shd_sid, x
+    sta SID_BASE, x
+@sid_next:
+    dex
+    bpl @sid
+
+    ldx #0                      ; rearm for the first split, if any
+    stx split_idx
+    lda flush_line
+    cpx _shd_split_count
+    bcs @rearm
+    lda _shd_split_line
+@rearm:
+    sta VIC_RASTER
+
+    inc _shd_frame
+    jsr call_hook
+    jmp IRQ_EXIT
+
+hook_none:
+    rts
@@ -0,0 +1,33 @@
+/*
+ * sprmove.h - shared 8.8 fixed-point sprite motion (see sprmove.s)
+ *
+ * Sprite positions live in RAM. Game logic updates them at any time and
+ * calls spr_flush() once per frame, after the logic, to stage them in the
+ * shadow VIC registers (shadow.h); the raster IRQ writes them out in one
+ * burst. spr_x[] holds the full 9-bit hardware X, so sprites can use the
+ * whole 320-pixel screen width. Link with shadow.s.
+ */
+
+#ifndef SPRMOVE_H
+#define SPRMOVE_H
+
+#define SPR_COUNT 8
+
+extern unsigned int  spr_x[SPR_COUNT];   /* hardware X pixel (0-511) */
+extern unsigned char spr_y[SPR_COUNT];   /* hardware Y pixel */
+extern unsigned char spr_xf[SPR_COUNT];  /* X sub-pixel fraction */
+extern unsigned char spr_yf[SPR_COUNT];  /* Y sub-pixel fraction */
+extern int spr_dx[SPR_COUNT];            /* X velocity, signed 8.8 */
+extern int spr_dy[SPR_COUNT];            /* Y velocity, signed 8.8 */
+
+/* Add velocity to position for every sprite whose bit is set in mask */
+void __fastcall__ spr_move(unsigned char mask);
+
+/* Stage all sprite X/Y registers and $D010 for the next flush */
+void spr_flush(void);
+
+/* Put sprite n on a whole pixel (clears the fractions) */
+#define SPR_PLACE(n, x, y) \
+    (spr_x[n] = (x), spr_y[n] = (y), spr_xf[n] = 0, spr_yf[n] = 0)
+
+#endif
@@ -0,0 +1,111 @@
+; sprmove.s - shared 8.8 fixed-point sprite motion for cc65/ca65
+;
+; C entry points (see sprmove.h):
+;   void __fastcall__ spr_move(unsigned char mask);
+;   void spr_flush(void);
+;
+; Every sprite keeps a 16-bit hardware X, an 8-bit Y and one fraction byte
+; per axis in RAM. Velocities are signed 8.8. spr_flush copies all sixteen
+; position registers into the shadow VIC registers (shadow.s) and builds
+; $D010 from the X high bytes in one pass, so game code never
+; read-modify-writes $D010. The raster IRQ writes them to the chip.
+
+.export _spr_x, _spr_y, _spr_xf, _spr_yf, _spr_dx, _spr_dy
+.export _spr_move, _spr_flush
+.import _shd_vic, _shd_vic_dirty
+.importzp tmp1, tmp2
+
+SHD_SPR0_X   = _shd_vic + $00
+SHD_SPR0_Y   = _shd_vic + $01
+SHD_SPR_HI_X = _shd_vic + $10
+
+.segment "BSS"
+
+_spr_x:  .res 16        ; unsigned int[8], lo/hi interleaved like a C array
+_spr_y:  .res 8
+_spr_xf: .res 8
+_spr_yf: .res 8
+_spr_dx: .res 16        ; int[8], signed 8.8
+_spr_dy: .res 16
+
+.segment "CODE"
+
+; A = mask of sprites to advance (bit n = sprite n)
+_spr_move:
+    sta tmp1
+    ldx #0                      ; sprite number
+    ldy #0                      ; word index = sprite * 2
+@loop:
+    lsr tmp1
+    bcc @next
+
+    ; Sign-extend dx into the X high byte
+    lda _spr_dx + 1, y
+    and #$80
+    beq @dx_pos
+    lda #$FF
+@dx_pos:
+    sta tmp2
+
+    ; X: fraction + pixel (16 bit)
+    clc
+    lda _spr_xf, x
+    adc _spr_dx, y
+    sta _spr_xf, x
+    lda _spr_x, y
+    adc _spr_dx + 1, y
+    sta _spr_x, y
+    lda _spr_x + 1, y
+    adc tmp2
+    sta _spr_x + 1, y
+
+    ; Y: fraction + pixel (8 bit, wraps like the hardware)
+    clc
+    lda _spr_yf, x
+    adc _spr_dy, y
+    sta _spr_yf, x
+    lda _spr_y, x
+    adc _spr_dy + 1, y
+    sta _spr_y, x
+
+@next:
+    iny
+    iny
+    inx
+    lda tmp1
+    bne @loop
+    rts
+
+; Stage every sprite X/Y register and $D010 in one burst. IRQs are held
+; off so the flush never sees a half-written frame (X low byte without
+; its $D010 bit).
+_spr_flush:
+    php
+    sei
+    lda #0
+    sta tmp1                    ; $D010 image
+    ldx #7
+    ldy #14
+@loop:
+    lda _spr_x, y
+    sta SHD_SPR0_X, y
+    lda _spr_y, x
+    sta SHD_SPR0_Y, y
+    lda _spr_x + 1, y
+    lsr                         ; X bit 8 -> carry
+    rol tmp1
+    dey
+    dey
+    dex
+    bpl @loop
+    lda tmp1
+    sta SHD_SPR_HI_X
+
+    lda #1                      ; mark $D000-$D010 dirty
+    ldx #$10
+@dirty:
+    sta _shd_vic_dirty, x
+    dex
+    bpl @dirty
+    plp
+    rts
@@ -0,0 +1,16 @@
+/*
+ * unpack.h - decruncher for data packed by pack.py (see unpack.s)
+ *
+ * The packer runs on the host from each project's Makefile and writes a
+ * header with the packed bytes (name_z[]) and the original size
+ * (NAME_Z_SIZE). unpack() writes the original bytes straight to their
+ * final place: screen, colour RAM or a charset.
+ */
+
+#ifndef UNPACK_H
+#define UNPACK_H
+
+/* Decrunch src to dst; returns the end of the unpacked data */
+void * __fastcall__ unpack(void *dst, const unsigned char *src);
+
+#endif
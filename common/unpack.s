@@ -0,0 +1,104 @@
+; unpack.s - decruncher for data packed by pack.py
+;
+; C entry point (see unpack.h):
+;   void * __fastcall__ unpack(void *dst, const unsigned char *src);
+;
+; Stream format (byte aligned LZ77):
+;   $00-$7F   (n + 1) literal bytes follow
+;   $80-$FE   copy (n & $7F) + 3 bytes from dst - offset,
+;             16-bit offset follows (low, high); offset 1 makes a run
+;   $FF       end
+;
+; Copies read back from the destination, so colour RAM works as a
+; target: only the low nibble of what is read back matters.
+
+.export _unpack
+.import popax
+.importzp ptr1, ptr2, ptr3
+
+MIN_MATCH = 3
+END       = $FF
+
+.segment "CODE"
+
+_unpack:
+    sta ptr1                    ; src
+    stx ptr1 + 1
+    jsr popax
+    sta ptr2                    ; dst
+    stx ptr2 + 1
+
+@token:
+    ldy #0
+    lda (ptr1), y
+    inc ptr1
+    bne @kind
+    inc ptr1 + 1
+@kind:
+    cmp #$80
+    bcs @match
+
+    tax                         ; literal run of n + 1
+    inx
+@lit:
+    lda (ptr1), y
+    sta (ptr2), y
+    iny
+    dex
+    bne @lit
+    tya
+    clc
+    adc ptr1
+    sta ptr1
+    bcc @lit_dst
+    inc ptr1 + 1
+@lit_dst:
+    tya
+    clc
+    adc ptr2
+    sta ptr2
+    bcc @token
+    inc ptr2 + 1
+    bcs @token                  ; always (carry still set)
+
+@match:
+    cmp #END
+    beq @done
+    and #$7F                    ; length
+    clc
+    adc #MIN_MATCH
+    tax
+    lda ptr2                    ; ptr3 = dst - offset
+    sec
+    sbc (ptr1), y
+    sta ptr3
+    iny
+    lda ptr2 + 1
+    sbc (ptr1), y
+    sta ptr3 + 1
+    lda ptr1
+    clc
+    adc #2
+    sta ptr1
+    bcc @copy_start
+    inc ptr1 + 1
+@copy_start:
+    ldy #0
+@copy:
+    lda (ptr3), y
+    sta (ptr2), y
+    iny
+    dex
+    bne @copy
+    tya
+    clc
+    adc ptr2
+    sta ptr2
+    bcc @token
+    inc ptr2 + 1
+    jmp @token
+
+@done:
+    lda ptr2
+    ldx ptr2 + 1
+    rts
@@ -4,6 +4,6 @@ set -euo pipefail
 cd "$(dirname "$0")"
 python3 spritegen.py
 python3 bggen.py
-cl65 -t c64 -O -o dreadline.prg dreadline.c fastscroll.s
+cl65 -t c64 -O -I ../common -g -m dreadline.map -Ln dreadline.lbl -Wl --dbgfile,dreadline.dbg -o dreadline.prg dreadline.c fastscroll.s ../common/replay.s ../common/rng.s
 
 echo "Built dreadline.prg ($(stat -c%s dreadline.prg) bytes)"
@@ -2,6 +2,9 @@
 #include <joystick.h>
 #include <stdlib.h>
 
+#include "replay.h"
+#include "rng.h"
+
 #define SCREEN ((unsigned char*)0x4400)
 #define COLOR_RAM ((unsigned char*)0xD800)
 #define SPRITE_PTRS ((unsigned char*)0x47F8)
@@ -62,6 +65,13 @@
 #define SHIP_MIN_Y 62
 #define SHIP_MAX_Y 218
 
+/* Threat histogram: 8-pixel bands of Y, counting only objects ahead of
+ * the demo pilot's station (ship X 68-72) and less than 100 pixels off */
+#define THREAT_X_MIN 70
+#define THREAT_X_MAX 170
+#define THREAT_BANDS 24
+#define NO_BAND 0xFF
+
 static unsigned int ship_x;
 static unsigned char ship_y;
 static unsigned char shields;
@@ -79,6 +89,23 @@ static unsigned char obj_type[MAX_OBJECTS];
 static unsigned int obj_x[MAX_OBJECTS];
 static unsigned char obj_y[MAX_OBJECTS];
 
+/* Live slots sit in obj_live[0..obj_count-1] in no particular order, free
+ * ones on the obj_free stack, so per-frame loops only visit live objects.
+ * A slot keeps its sprite (slot + 2) while it is live. */
+static unsigned char obj_live[MAX_OBJECTS];
+static unsigned char obj_count;
+static unsigned char obj_free[MAX_OBJECTS];
+static unsigned char obj_free_top;
+
+/* band_threat[b + 2] sums the penalties of objects near band b: each one
+ * counted spreads over its band and two either side (about 20 pixels),
+ * -35 for a drone or turret, -8 for a core, and every core counted adds
+ * +5 to all bands through core_bonus. obj_band[] is where a slot's share
+ * sits now (its lowest band), NO_BAND when it has none. */
+static signed char band_threat[THREAT_BANDS];
+static signed char core_bonus;
+static unsigned char obj_band[MAX_OBJECTS];
+
 static unsigned char spawn_timer;
 static unsigned char deck_tick;
 
@@ -164,12 +191,6 @@ static void sid_off(void) {
     SID.v1.ctrl = 0;
 }
 
-static void seed_rng(void) {
-    unsigned int seed;
-    seed = (*(unsigned char*)0xDC04) | ((unsigned int)(*(unsigned char*)0xDC05) << 8);
-    srand(seed);
-}
-
 #include "sprites_mc.h"
 #include "background_mc.h"
 
@@ -311,46 +332,110 @@ static void scroll_deck(void) {
     }
 }
 
+static void band_add(unsigned char lo, signed char worth, signed char bonus) {
+    signed char* band;
+    band = &band_threat[lo];
+    band[0] += worth;
+    band[1] += worth;
+    band[2] += worth;
+    band[3] += worth;
+    band[4] += worth;
+    core_bonus += bonus;
+}
+
+/* Move slot i's share of the histogram to where the object is now; with
+ * live 0 (or outside the window) it just takes the share back */
+static void update_threat(unsigned char i, unsigned char live) {
+    unsigned char lo;
+    signed char worth;
+    signed char bonus;
+
+    lo = NO_BAND;
+    if (live && obj_x[i] > THREAT_X_MIN && obj_x[i] < THREAT_X_MAX) {
+        lo = (unsigned char)((unsigned char)(obj_y[i] - SHIP_MIN_Y) >> 3);
+    }
+    if (lo == obj_band[i]) {
+        return;
+    }
+
+    if (obj_type[i] == OBJ_CORE) {
+        worth = -13;    /* -8 near, and no +5 */
+        bonus = 5;
+    } else {
+        worth = -35;
+        bonus = 0;
+    }
+    if (obj_band[i] != NO_BAND) {
+        band_add(obj_band[i], (signed char)-worth, (signed char)-bonus);
+    }
+    if (lo != NO_BAND) {
+        band_add(lo, worth, bonus);
+    }
+    obj_band[i] = lo;
+}
+
 static void reset_objects(void) {
     unsigned char i;
     for (i = 0; i < MAX_OBJECTS; ++i) {
         obj_type[i] = OBJ_NONE;
-        obj_x[i] = 0;
-        obj_y[i] = 0;
+        obj_band[i] = NO_BAND;
+        obj_free[i] = (unsigned char)(MAX_OBJECTS - 1 - i);  /* slot 0 on top */
+    }
+    obj_free_top = MAX_OBJECTS;
+    obj_count = 0;
+    for (i = 0; i < THREAT_BANDS; ++i) {
+        band_threat[i] = 0;
+    }
+    core_bonus = 0;
+}
+
+static void add_object(unsigned char type, unsigned int x, unsigned char y) {
+    unsigned char i;
+
+    if (obj_free_top == 0) {
+        return;
     }
+    i = obj_free[--obj_free_top];
+    obj_live[obj_count++] = i;
+    obj_type[i] = type;
+    obj_x[i] = x;
+    obj_y[i] = y;
+    update_threat(i, 1);
+}
+
+/* Retire the n-th live object; the last live one takes its place */
+static void remove_object(unsigned char n) {
+    unsigned char i;
+
+    i = obj_live[n];
+    update_threat(i, 0);
+    obj_type[i] = OBJ_NONE;
+    obj_live[n] = obj_live[--obj_count];
+    obj_free[obj_free_top++] = i;
 }
 
 static void seed_demo_objects(void) {
-    obj_type[0] = OBJ_DRONE;
-    obj_x[0] = 260;
-    obj_y[0] = 82;
-    obj_type[1] = OBJ_TURRET;
-    obj_x[1] = 300;
-    obj_y[1] = 154;
-    obj_type[2] = OBJ_CORE;
-    obj_x[2] = 340;
-    obj_y[2] = 114;
+    add_object(OBJ_DRONE, 260, 82);
+    add_object(OBJ_TURRET, 300, 154);
+    add_object(OBJ_CORE, 340, 114);
 }
 
 static void spawn_object(void) {
-    unsigned char i;
     unsigned char roll;
+    unsigned char type;
 
-    for (i = 0; i < MAX_OBJECTS; ++i) {
-        if (obj_type[i] == OBJ_NONE) {
-            roll = (unsigned char)(rand() % 100);
-            if (roll < 45) {
-                obj_type[i] = OBJ_DRONE;
-            } else if (roll < 82) {
-                obj_type[i] = OBJ_TURRET;
-            } else {
-                obj_type[i] = OBJ_CORE;
-            }
-            obj_x[i] = 336;
-            obj_y[i] = (unsigned char)(SHIP_MIN_Y + (rand() % (SHIP_MAX_Y - SHIP_MIN_Y - 10)));
-            return;
-        }
+    if (obj_free_top == 0) {
+        return;
     }
+    roll = rng_next();
+    if (roll < RNG_PCT(45)) {
+        type = OBJ_DRONE;
+    } else if (roll < RNG_PCT(82)) {
+        type = OBJ_TURRET;
+    } else {
+        type = OBJ_CORE;
+    }
+    add_object(type, 336, (unsigned char)(SHIP_MIN_Y + rng_below(SHIP_MAX_Y - SHIP_MIN_Y - 10)));
 }
 
 static unsigned char abs_diff_u8(unsigned char a, unsigned char b) {
@@ -362,6 +447,7 @@ static unsigned int abs_diff_u16(unsigned int a, unsigned int b) {
 }
 
 static void update_object_sprites(void) {
+    unsigned char n;
     unsigned char i;
     unsigned char spr;
     unsigned char enabled;
@@ -373,12 +459,9 @@ static void update_object_sprites(void) {
         enabled |= 2;
     }
 
-    for (i = 0; i < MAX_OBJECTS; ++i) {
+    for (n = 0; n < obj_count; ++n) {
+        i = obj_live[n];
         spr = (unsigned char)(i + 2);
-        if (obj_type[i] == OBJ_NONE) {
-            hide_sprite(spr);
-            continue;
-        }
         if (obj_type[i] == OBJ_DRONE) {
             SPRITE_PTRS[spr] = frame ? SPR_BLOCK_DRONE1 : SPR_BLOCK_DRONE0;
             SPR_COL(spr) = LTRED;
@@ -422,7 +505,7 @@ static void fire_beam(void) {
 
 static void move_player_human(void) {
     unsigned char joy;
-    joy = joy_read(JOY_2);
+    joy = rp_joy(JOY_2);
 
     if ((joy & JOY_LEFT_MASK) != 0 && ship_x > SHIP_MIN_X) {
         ship_x -= 2;
@@ -441,35 +524,27 @@ static void move_player_human(void) {
     }
 }
 
-static signed char lane_score(unsigned char y) {
-    unsigned char i;
-    signed char value;
+#define LANE_PROBE 8     /* one band: nearer probes read the ship's own */
 
-    value = 0;
-    for (i = 0; i < MAX_OBJECTS; ++i) {
-        if (obj_type[i] == OBJ_NONE) {
-            continue;
-        }
-        if (obj_x[i] > ship_x && obj_x[i] < ship_x + 100) {
-            if (abs_diff_u8(obj_y[i], y) < 20) {
-                value -= (obj_type[i] == OBJ_CORE) ? 8 : 35;
-            } else if (obj_type[i] == OBJ_CORE) {
-                value += 5;
-            }
-        }
+static signed char lane_score(unsigned char y) {
+    if (y < SHIP_MIN_Y) {
+        y = SHIP_MIN_Y;     /* the probe above the top row */
+    } else if (y > SHIP_MAX_Y) {
+        y = SHIP_MAX_Y;     /* and below the bottom one */
     }
-    return value;
+    return (signed char)(band_threat[((unsigned char)(y - SHIP_MIN_Y) >> 3) + 2] + core_bonus);
 }
 
 static void move_player_demo(void) {
     signed char up_score;
     signed char here_score;
     signed char down_score;
+    unsigned char n;
     unsigned char i;
 
     here_score = lane_score(ship_y);
-    up_score = (ship_y > SHIP_MIN_Y + 2) ? lane_score((unsigned char)(ship_y - 3)) : -100;
-    down_score = (ship_y < SHIP_MAX_Y - 2) ? lane_score((unsigned char)(ship_y + 3)) : -100;
+    up_score = (ship_y > SHIP_MIN_Y + 2) ? lane_score((unsigned char)(ship_y - LANE_PROBE)) : -100;
+    down_score = (ship_y < SHIP_MAX_Y - 2) ? lane_score((unsigned char)(ship_y + LANE_PROBE)) : -100;
 
     if (up_score > here_score && up_score >= down_score) {
         ship_y -= 2;
@@ -483,8 +558,9 @@ static void move_player_demo(void) {
         ++ship_x;
     }
 
-    for (i = 0; i < MAX_OBJECTS; ++i) {
-        if (obj_type[i] != OBJ_NONE && obj_x[i] > ship_x && obj_x[i] < 250 && abs_diff_u8(obj_y[i], ship_y) < 16) {
+    for (n = 0; n < obj_count; ++n) {
+        i = obj_live[n];
+        if (obj_x[i] > ship_x && obj_x[i] < 250 && abs_diff_u8(obj_y[i], ship_y) < 16) {
             fire_beam();
             return;
         }
@@ -507,6 +583,7 @@ static void add_score(unsigned char points) {
 }
 
 static void step_beam(void) {
+    unsigned char n;
     unsigned char i;
 
     if (!beam_active) {
@@ -518,17 +595,15 @@ static void step_beam(void) {
         return;
     }
 
-    for (i = 0; i < MAX_OBJECTS; ++i) {
-        if (obj_type[i] == OBJ_NONE) {
-            continue;
-        }
+    for (n = 0; n < obj_count; ++n) {
+        i = obj_live[n];
         if (abs_diff_u16(obj_x[i], beam_x) < 16 && abs_diff_u8(obj_y[i], beam_y) < 14) {
             if (obj_type[i] == OBJ_CORE) {
                 add_score(35);
             } else {
                 add_score(15);
             }
-            obj_type[i] = OBJ_NONE;
+            remove_object(n);
             beam_active = 0;
             sid_beep(0x0800, 0x40);
             return;
@@ -537,19 +612,18 @@ static void step_beam(void) {
 }
 
 static void step_objects(void) {
+    unsigned char n;
     unsigned char i;
     unsigned char drift;
 
     drift = (unsigned char)(2 + (speed / 3));
-    for (i = 0; i < MAX_OBJECTS; ++i) {
-        if (obj_type[i] == OBJ_NONE) {
-            continue;
-        }
-
+    n = 0;
+    while (n < obj_count) {
+        i = obj_live[n];
         if (obj_x[i] > drift) {
             obj_x[i] -= drift;
         } else {
-            obj_type[i] = OBJ_NONE;
+            remove_object(n);
             continue;
         }
 
@@ -560,14 +634,17 @@ static void step_objects(void) {
                 --obj_y[i];
             }
         }
+        update_threat(i, 1);
 
         if (abs_diff_u16(obj_x[i], ship_x) < 18 && abs_diff_u8(obj_y[i], ship_y) < 16) {
-            obj_type[i] = OBJ_NONE;
+            remove_object(n);
             if (shields > 0) {
                 --shields;
             }
             sid_beep(0x0500, 0x40);
+            continue;
         }
+        ++n;
     }
 
     if (shields == 0) {
@@ -596,7 +673,7 @@ static void title_screen(void) {
     wait_count = 0;
     do {
         wait_frame();
-        if ((joy_read(JOY_2) & JOY_FIRE_MASK) != 0) {
+        if (rp_start()) {
             demo_mode = 0;
             fire_detected = 1;
         }
@@ -626,7 +703,7 @@ static void game_over_screen(void) {
     }
 
     put_text(8, 15, "FIRE TO RETURN MENU", CYAN);
-    while ((joy_read(JOY_2) & JOY_FIRE_MASK) == 0) {
+    while (!rp_start()) {
         wait_frame();
     }
     while ((joy_read(JOY_2) & JOY_FIRE_MASK) != 0) {
@@ -663,15 +740,18 @@ static void init_game(void) {
 
 int main(void) {
     joy_install(joy_static_stddrv);
-    seed_rng();
     demo_mode = 1;
 
     while (1) {
         title_screen();
+        /* seed, then log (or play back) this run; demos are not logged */
+        demo_mode = rp_begin(demo_mode ? RP_DEMO : 0) & RP_DEMO;
+        rng_seed((unsigned char)rand());
         init_game();
 
         while (!game_over) {
             wait_frame();
+            rp_frame();
             ++tick;
 
             if ((tick & 1) == 0) {
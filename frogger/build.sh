@@ -2,7 +2,7 @@
 # Build Frogger using cc65
 cd "$(dirname "$0")"
 
-cl65 -t c64 -C frogger.cfg -O -o frogger.prg frogger.c
+cl65 -t c64 -C frogger.cfg -O -I ../common -g -m frogger.map -Ln frogger.lbl -Wl --dbgfile,frogger.dbg -o frogger.prg frogger.c ../common/shadow.s ../common/sfx.s
 
 if [[ -f frogger.prg ]]; then
     echo "Built frogger.prg ($(stat -c%s frogger.prg) bytes)"
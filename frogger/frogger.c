@@ -1,7 +1,7 @@
 /*
  * FROGGER for Commodore 64 — cc65
- * Multicolor Bitmap Mode (MCM) for improved visual quality
- * VIC bank 0: screen@$0400 (colour data), bitmap@$2000, sprite@$3F40
+ * Multicolour character mode with a charset generated at start-up
+ * VIC bank 0: screen@$0400, charset@$3800, sprite@$3F40
  * AI Toolchain Project 2026
  */
 
@@ -10,21 +10,25 @@
 #include <string.h>
 #include <stdlib.h>
 
+#include "shadow.h"
+#include "sfx.h"
+
 /* ═══════════════════════════════════════════════════════════
  *  HARDWARE
  * ═══════════════════════════════════════════════════════════ */
 #define SCR_W   40
 #define SCR_H   25
 
-/* In MCM bitmap mode SCREEN holds colour nibbles, not char codes */
 #define SCREEN      ((unsigned char*)0x0400)
-#define BITMAP      ((unsigned char*)0x2000)   /* 8000 bytes, $2000-$3F3F */
 #define COLRAM      ((unsigned char*)0xD800)
 
+/* Playfield charset; only the first CH_COUNT chars are generated */
+#define CHARSET     ((unsigned char*)0x3800)
+
 /* Sprite pointers: last 8 bytes of $0400 page */
 #define SPRITE_PTRS ((unsigned char*)0x07F8)
 
-/* Sprite data just after bitmap ($3F40-$3F7F); block 253 = $3F40/64 */
+/* Sprite data in the unused tail of the charset; block 253 = $3F40/64 */
 #define SPRITE_DATA  0x3F40
 #define SPR_FROG     0
 #define BLK_FROG     253
@@ -32,7 +36,6 @@
 #define VIC_D011    (*(unsigned char*)0xD011)
 #define VIC_D016    (*(unsigned char*)0xD016)
 #define VIC_D018    (*(unsigned char*)0xD018)
-#define VIC_SPR_ENA    (*(unsigned char*)0xD015)
 #define VIC_SPR_HI_X   (*(unsigned char*)0xD010)
 #define VIC_SPR_MCOLOR (*(unsigned char*)0xD01C)
 #define VIC_SPR_DBL_X  (*(unsigned char*)0xD01D)
@@ -46,24 +49,6 @@
 #define SPR_Y(n)   (*(unsigned char*)(0xD001+(n)*2))
 #define SPR_COL(n) (*(unsigned char*)(0xD027+(n)))
 
-/* SID */
-#define SID_V1_FLO (*(unsigned char*)0xD400)
-#define SID_V1_FHI (*(unsigned char*)0xD401)
-#define SID_V1_CTL (*(unsigned char*)0xD404)
-#define SID_V1_AD  (*(unsigned char*)0xD405)
-#define SID_V1_SR  (*(unsigned char*)0xD406)
-#define SID_V2_FLO (*(unsigned char*)0xD407)
-#define SID_V2_FHI (*(unsigned char*)0xD408)
-#define SID_V2_CTL (*(unsigned char*)0xD40B)
-#define SID_V2_AD  (*(unsigned char*)0xD40C)
-#define SID_V2_SR  (*(unsigned char*)0xD40D)
-#define SID_V3_FLO (*(unsigned char*)0xD40E)
-#define SID_V3_FHI (*(unsigned char*)0xD40F)
-#define SID_V3_CTL (*(unsigned char*)0xD412)
-#define SID_V3_AD  (*(unsigned char*)0xD413)
-#define SID_V3_SR  (*(unsigned char*)0xD414)
-#define SID_VOL    (*(unsigned char*)0xD418)
-
 /* C64 palette */
 #define BLACK    0
 #define WHITE    1
@@ -119,14 +104,51 @@
  * ═══════════════════════════════════════════════════════════ */
 #define NUM_HOME_PADS   5
 #define NUM_LIVES_START 3
-#define MAX_OBJECTS     24
 #define TIME_START      60
 
-#define OBJ_NONE   0
-#define OBJ_CAR    1
-#define OBJ_TRUCK  2
-#define OBJ_LOG    3
-#define OBJ_TURTLE 4
+/* Lanes 0-4 are the river rows, 5-9 the road rows */
+#define NUM_RIVER   5
+#define NUM_LANES   10
+#define LANE_LEN    SCR_W   /* ring length: one screen width */
+#define MAX_EDGES   12
+#define LANE_NONE   0xFF
+#define LANE_SLOW   2       /* pixels per frame */
+#define LANE_FAST   4
+
+#define TURTLE_UP     12    /* frames surfaced, then the same under */
+#define TURTLE_CYCLE  24
+
+/* Cell descriptors */
+#define CD_ROAD    0
+#define CD_DASH    1        /* road with the centre line */
+#define CD_WATER   2
+#define CD_RED     3
+#define CD_ORANGE  4
+#define CD_BROWN   5
+#define CD_TURTLE  6        /* green, water while diving */
+#define CD_COUNT   7
+
+/* Generated chars. Multicolour pixels: "00"=$D021, "01"=$D022,
+ * "10"=$D023 (set per row by the raster splits), "11"=colour RAM 0-7 */
+#define CH_BG      0        /* solid "00" */
+#define CH_MC1     1        /* solid "01" */
+#define CH_MC2     2        /* solid "10" */
+#define CH_SOLID   3        /* solid "11" */
+#define CH_WATER   4
+#define CH_DASH    5
+#define CH_PAD     6        /* hollow pad in "01" */
+#define CH_PAD_C   7        /* hollow pad in "11" */
+#define CH_GLYPH   8        /* 18 HUD glyphs in "11" */
+#define CH_GLYPH1  26       /* the same in "01" */
+#define CH_COUNT   44
+
+#define MC(col)    (0x08 | (col))   /* colour RAM: multicolour cell */
+
+/* $D016 in play: multicolour, 38 columns to hide the scroll seam */
+#define D016_PLAY   0x10
+/* One split per row from the HUD down to the start zone; the last
+ * one also covers the lower safe zone */
+#define NUM_SPLITS  (ROW_START + 1)
 
 #define GS_TITLE  0
 #define GS_PLAY   1
@@ -163,8 +185,9 @@ static const unsigned char frog_sprite[63] = {
 };
 
 /* ═══════════════════════════════════════════════════════════
- *  MCM BITMAP FONT  (18 glyphs × 8 bytes)
- *  2 bits/pixel: "01"=fg(scr_hi nibble), "00"=black($D021)
+ *  HUD FONT  (18 glyphs × 8 bytes, multicolour)
+ *  2 bits/pixel: "01"=fg, "00"=black($D021); build_charset() also
+ *  makes a "11" copy so a glyph can take any colour RAM colour
  *  Glyphs: 0-9, S(10),C(11),H(12),I(13),L(14),V(15),:(16),space(17)
  * ═══════════════════════════════════════════════════════════ */
 static const unsigned char hud_font[18 * 8] = {
@@ -190,9 +213,16 @@ static const unsigned char hud_font[18 * 8] = {
 
 /* Water wave pattern (alternating rows) */
 static const unsigned char water_pat[8] = {
-    0x69,0x96,0x69,0x96,0x69,0x96,0x69,0x96
+    0x3C,0xC3,0x3C,0xC3,0x3C,0xC3,0x3C,0xC3
+};
+/* $3C=00 11 11 00 (LTBLUE $D021/BLUE colour RAM), $C3=11 00 00 11 */
+
+/* Road cell with a dash of the centre line. Lane backgrounds repeat
+ * every cell, so the fine scroll never shows a seam when it wraps. */
+static const unsigned char dash_pat[8] = {
+    0x00,0x00,0x00,0xF0,0xF0,0x00,0x00,0x00
 };
-/* $69=01 10 10 01 (LTBLUE/BLUE), $96=10 01 01 10 */
+/* $F0=11 11 00 00: YELLOW dash (colour RAM) on GREY1 road ($D021) */
 
 /* Hollow pad pattern for empty home spots */
 static const unsigned char pad_pat[8] = {
@@ -200,24 +230,78 @@ static const unsigned char pad_pat[8] = {
 };
 /* top+bottom full, sides only */
 
+/* Descriptor → char and colour RAM. ORANGE and BROWN are $D022/$D023
+ * on both the river and the road rows */
+static const unsigned char cd_chr[CD_COUNT] = {
+    CH_BG, CH_DASH, CH_WATER, CH_SOLID, CH_MC1, CH_MC2, CH_SOLID
+};
+static const unsigned char cd_col[CD_COUNT] = {
+    MC(BLACK), MC(YELLOW), MC(BLUE), MC(RED),
+    MC(BLACK), MC(BLACK), MC(GREEN)
+};
+
+/* Per-row $D021/$D022/$D023 (rows 0-14; row 14 holds to the bottom)
+ *
+ * Palette against the MCM bitmap build, cell by cell:
+ *   empty pad    CYAN frame cells (colour RAM), LTBLUE middle ($D022
+ *                of row 2), black inside: as the bitmap drew them
+ *   filled pad   LTGREEN ($D023 of row 2) / WHITE / LTGREEN
+ *   cars         RED; the bitmap's LTRED body only showed on cars
+ *                longer than two cells, and every car is two long
+ *   trucks, logs ORANGE/BROWN from $D022/$D023 of their rows
+ * No colour of the bitmap build is lost. */
+static const unsigned char row_bg[NUM_SPLITS] = {
+    BLACK, BLACK, BLACK,
+    LTBLUE, LTBLUE, LTBLUE, LTBLUE, LTBLUE,
+    BLACK,
+    GREY1, GREY1, GREY1, GREY1, GREY1,
+    BLACK
+};
+static const unsigned char row_mc1[NUM_SPLITS] = {
+    LTGREEN, LTGREEN, LTBLUE,
+    ORANGE, ORANGE, ORANGE, ORANGE, ORANGE,
+    LTGREEN,
+    ORANGE, ORANGE, ORANGE, ORANGE, ORANGE,
+    LTGREEN
+};
+static const unsigned char row_mc2[NUM_SPLITS] = {
+    LTGREEN, LTGREEN, LTGREEN,
+    BROWN, BROWN, BROWN, BROWN, BROWN,
+    LTGREEN,
+    BROWN, BROWN, BROWN, BROWN, BROWN,
+    LTGREEN
+};
+
+/* Screen offset of each row */
+static const unsigned int row_ofs[SCR_H] = {
+      0,  40,  80, 120, 160, 200, 240, 280, 320, 360,
+    400, 440, 480, 520, 560, 600, 640, 680, 720, 760,
+    800, 840, 880, 920, 960
+};
+
 /* ═══════════════════════════════════════════════════════════
- *  OBJECT TABLE
+ *  LANE TABLE
+ *  Each lane is a ring of cell descriptors; lane_off is the ring
+ *  index shown in column 0. lane_edge lists the ring indices whose
+ *  descriptor differs from the one before: those are the only cells
+ *  that change when the lane steps a whole cell.
  * ═══════════════════════════════════════════════════════════ */
-static unsigned char obj_type [MAX_OBJECTS];
-static signed char   obj_cx   [MAX_OBJECTS];
-static unsigned char obj_cy   [MAX_OBJECTS];
-static unsigned char obj_len  [MAX_OBJECTS];
-static unsigned char obj_speed[MAX_OBJECTS];
-static unsigned char obj_dir  [MAX_OBJECTS];
-static unsigned char obj_anim [MAX_OBJECTS];
-static unsigned char obj_tick [MAX_OBJECTS];
-static unsigned char num_objs;
+static unsigned char lane_ring [NUM_LANES][LANE_LEN];
+static unsigned char lane_edge [NUM_LANES][MAX_EDGES];
+static unsigned char lane_nedge[NUM_LANES];
+static unsigned char lane_row  [NUM_LANES];
+static unsigned char lane_off  [NUM_LANES];
+static unsigned char lane_fine [NUM_LANES];   /* $D016 fine scroll 0-7 */
+static unsigned char lane_vel  [NUM_LANES];   /* pixels per frame */
+static unsigned char lane_dir  [NUM_LANES];   /* 1 = right */
+static unsigned char turtle_anim;
 
 /* ═══════════════════════════════════════════════════════════
  *  FROG + GAME STATE
  * ═══════════════════════════════════════════════════════════ */
 static unsigned char frog_cx, frog_cy;
-static unsigned char frog_on_log;
+static unsigned char frog_ring;   /* ring index under the frog (river) */
+static unsigned char frog_px;     /* fine scroll of the lane it rides */
 
 static unsigned int  score;
 static unsigned int  high_score;
@@ -231,66 +315,73 @@ static unsigned char homes_filled;
 static unsigned char die_timer;
 static unsigned char home_timer;
 static unsigned char level_timer;
-static unsigned char snd_hop_timer;
-static unsigned char snd_sfx_timer;
 static unsigned char prev_joy;
 static unsigned char hop_lock;
 
 /* ═══════════════════════════════════════════════════════════
- *  BITMAP DRAWING PRIMITIVES
- *  In MCM bitmap mode:
- *   pixel "00" → $D021 (BLACK, global bg)
- *   pixel "01" → scr_byte bits 7-4
- *   pixel "10" → scr_byte bits 3-0
- *   pixel "11" → colram bits 3-0
+ *  CHARSET + CELL PRIMITIVES
+ *  Every cell is one screen code and one colour RAM byte.
  * ═══════════════════════════════════════════════════════════ */
 
-/* Solid colour fill (all "11" pixels) */
-static void bmp_solid(unsigned char cx, unsigned char cy, unsigned char col) {
-    unsigned int bofs = ((unsigned int)cy * 40 + cx) * 8;
-    unsigned char p;
-    for (p = 0; p < 8; ++p) BITMAP[bofs + p] = 0xFF;
-    SCREEN[cy * 40 + cx] = 0;
-    COLRAM[cy * 40 + cx] = col;
+static void build_charset(void) {
+    unsigned char *dst = CHARSET;
+    unsigned char p, b;
+    unsigned int i;
+    for (p = 0; p < 8; ++p) {
+        dst[CH_BG * 8 + p]    = 0x00;
+        dst[CH_MC1 * 8 + p]   = 0x55;
+        dst[CH_MC2 * 8 + p]   = 0xAA;
+        dst[CH_SOLID * 8 + p] = 0xFF;
+        dst[CH_WATER * 8 + p] = water_pat[p];
+        dst[CH_DASH * 8 + p]  = dash_pat[p];
+        b = pad_pat[p];
+        dst[CH_PAD * 8 + p]   = b;
+        dst[CH_PAD_C * 8 + p] = b | (b << 1);     /* "01" → "11" */
+    }
+    for (i = 0; i < 18 * 8; ++i) {
+        b = hud_font[i];
+        dst[CH_GLYPH * 8 + i]  = b | (b << 1);
+        dst[CH_GLYPH1 * 8 + i] = b;
+    }
+}
+
+static void put_chr(unsigned char cx, unsigned char cy,
+                    unsigned char ch, unsigned char col) {
+    unsigned int ofs = row_ofs[cy] + cx;
+    SCREEN[ofs] = ch;
+    COLRAM[ofs] = col;
 }
 
-/* Water wave cell */
-static void bmp_water(unsigned char cx, unsigned char cy) {
-    unsigned int bofs = ((unsigned int)cy * 40 + cx) * 8;
-    unsigned char p;
-    for (p = 0; p < 8; ++p) BITMAP[bofs + p] = water_pat[p];
-    /* "01"=LTBLUE(14)  "10"=BLUE(6) */
-    SCREEN[cy * 40 + cx] = (14 << 4) | 6;
-    COLRAM[cy * 40 + cx] = 0;
+/* Row palette index: rows below the splits keep the last one */
+static unsigned char row_split(unsigned char cy) {
+    return cy < NUM_SPLITS ? cy : NUM_SPLITS - 1;
 }
 
-/* Custom 8-byte pattern cell — pattern uses only "01"/"00" pixels */
-static void bmp_custom(unsigned char cx, unsigned char cy,
-                        const unsigned char *pat8,
-                        unsigned char fg_col) {
-    unsigned int bofs = ((unsigned int)cy * 40 + cx) * 8;
-    unsigned char p;
-    for (p = 0; p < 8; ++p) BITMAP[bofs + p] = pat8[p];
-    SCREEN[cy * 40 + cx] = (unsigned char)(fg_col << 4);
-    COLRAM[cy * 40 + cx] = 0;
+/* Solid colour cell: colour RAM for 0-7, else the row's $D021-$D023 */
+static void put_solid(unsigned char cx, unsigned char cy, unsigned char col) {
+    unsigned char r = row_split(cy);
+    if (col < 8)                        put_chr(cx, cy, CH_SOLID, MC(col));
+    else if (col == shd_split_d022[r])  put_chr(cx, cy, CH_MC1, MC(BLACK));
+    else if (col == shd_split_d023[r])  put_chr(cx, cy, CH_MC2, MC(BLACK));
+    else                                put_chr(cx, cy, CH_BG, MC(BLACK));
 }
 
-/* HUD font cell */
-static void bmp_glyph(unsigned char cx, unsigned char cy,
-                       unsigned char fi, unsigned char fg_col) {
-    bmp_custom(cx, cy, hud_font + (unsigned int)fi * 8, fg_col);
+/* HUD font cell: "11" glyph for colours 0-7, "01" glyph for $D022 */
+static void put_glyph(unsigned char cx, unsigned char cy,
+                      unsigned char fi, unsigned char fg_col) {
+    if (fg_col < 8) put_chr(cx, cy, CH_GLYPH + fi, MC(fg_col));
+    else            put_chr(cx, cy, CH_GLYPH1 + fi, MC(BLACK));
 }
 
-/* Fill entire row with solid colour */
-static void bmp_fill_solid(unsigned char cy, unsigned char col) {
-    unsigned char cx;
-    for (cx = 0; cx < SCR_W; ++cx) bmp_solid(cx, cy, col);
+/* Lane cell from its descriptor */
+static void put_cell(unsigned char cx, unsigned char cy, unsigned char cd) {
+    put_chr(cx, cy, cd_chr[cd], cd_col[cd]);
 }
 
-/* Fill entire row with water pattern */
-static void bmp_fill_water(unsigned char cy) {
+/* Fill entire row with solid colour */
+static void fill_solid(unsigned char cy, unsigned char col) {
     unsigned char cx;
-    for (cx = 0; cx < SCR_W; ++cx) bmp_water(cx, cy);
+    for (cx = 0; cx < SCR_W; ++cx) put_solid(cx, cy, col);
 }
 
 /* Map ASCII → font index */
@@ -305,18 +396,18 @@ static unsigned char font_idx(char c) {
     }
 }
 
-static void bmp_puts(unsigned char cx, unsigned char cy,
-                      const char *s, unsigned char fg) {
+static void put_str(unsigned char cx, unsigned char cy,
+                    const char *s, unsigned char fg) {
     while (*s && cx < SCR_W) {
-        bmp_glyph(cx, cy, font_idx(*s), fg);
+        put_glyph(cx, cy, font_idx(*s), fg);
         ++cx; ++s;
     }
 }
 
 /* Write unsigned value, right-justified to 'width' cells */
-static void bmp_putuint(unsigned char cx, unsigned char cy,
-                         unsigned int v, unsigned char width,
-                         unsigned char fg) {
+static void put_uint(unsigned char cx, unsigned char cy,
+                     unsigned int v, unsigned char width,
+                     unsigned char fg) {
     /* build string right-to-left */
     char buf[6];
     unsigned char i = 5;
@@ -327,27 +418,36 @@ static void bmp_putuint(unsigned char cx, unsigned char cy,
     } while (v && i > 0);
     /* pad with zeros */
     while (i > (unsigned char)(5 - width)) buf[--i] = '0';
-    bmp_puts(cx, cy, buf + i, fg);
+    put_str(cx, cy, buf + i, fg);
 }
 
 /* ═══════════════════════════════════════════════════════════
- *  BITMAP MODE ENTER / EXIT
+ *  CHARSET MODE ENTER / EXIT
  * ═══════════════════════════════════════════════════════════ */
-static void setup_bitmap_mode(void) {
-    /* $D021 = BLACK ("00" pixels), $D022/$D023 = shared colours (unused here) */
-    VIC_BG  = BLACK;
-    VIC_MC1 = LTBLUE;
-    VIC_MC2 = GREEN;
-    /* Screen at $0400 (bank offset $0400), bitmap at $2000 (bank offset $2000) */
-    VIC_D018 = 0x18;
-    /* Enable bitmap + multicolour */
-    VIC_D011 |= 0x20;
-    VIC_D016 |= 0x10;
-}
-
-static void exit_bitmap_mode(void) {
-    VIC_D011 &= ~0x20;
-    VIC_D016 &= ~0x10;
+
+/* Row colours and fine scroll for every split, then switch them on */
+static void init_splits(void) {
+    unsigned char i;
+    for (i = 0; i < NUM_SPLITS; ++i) {
+        shd_split_line[i] = SHD_ROW_LINE(i);
+        shd_split_d016[i] = D016_PLAY;
+        shd_split_d021[i] = row_bg[i];
+        shd_split_d022[i] = row_mc1[i];
+        shd_split_d023[i] = row_mc2[i];
+    }
+    shd_split_count = NUM_SPLITS;
+}
+
+static void setup_char_mode(void) {
+    VIC_BG = BLACK;
+    /* Screen at $0400 (bank offset $0400), charset at $3800 */
+    VIC_D018 = 0x1E;
+    VIC_D016 = D016_PLAY;
+}
+
+static void exit_char_mode(void) {
+    shd_split_count = 0;
+    VIC_D016 = 0xC8;
     /* Restore default: screen at $0400, charset at $1000 ($D018=$17) */
     VIC_D018 = 0x17;
     VIC_BG   = BLACK;
@@ -368,35 +468,27 @@ static unsigned char read_joy(void) {
 /* ═══════════════════════════════════════════════════════════
  *  SOUND
  * ═══════════════════════════════════════════════════════════ */
-static void snd_init(void) {
-    unsigned char i;
-    for (i = 0; i < 25; ++i) *(unsigned char*)(0xD400+i) = 0;
-    SID_VOL = 15;
-}
-static void snd_hop(void) {
-    SID_V1_AD=0x01; SID_V1_SR=0x00;
-    SID_V1_FHI=0x10; SID_V1_FLO=0x00;
-    SID_V1_CTL=0x21; snd_hop_timer=4;
-}
-static void snd_squash(void) {
-    SID_V2_AD=0x08; SID_V2_SR=0x00;
-    SID_V2_FHI=0x03; SID_V2_FLO=0x00;
-    SID_V2_CTL=0x81; snd_sfx_timer=12;
-}
-static void snd_splash(void) {
-    SID_V2_AD=0x04; SID_V2_SR=0x00;
-    SID_V2_FHI=0x06; SID_V2_FLO=0x00;
-    SID_V2_CTL=0x81; snd_sfx_timer=10;
-}
-static void snd_home(void) {
-    SID_V3_AD=0x01; SID_V3_SR=0x88;
-    SID_V3_FHI=0x1A; SID_V3_FLO=0x00;
-    SID_V3_CTL=0x11; snd_sfx_timer=16;
-}
-static void snd_update(void) {
-    if (snd_hop_timer && !--snd_hop_timer) SID_V1_CTL=0x20;
-    if (snd_sfx_timer && !--snd_sfx_timer) { SID_V2_CTL=0x80; SID_V3_CTL=0x10; }
-}
+/* Effects for the IRQ player (see sfx.h) */
+static const unsigned char fx_hop[] = {
+    SFX_V1, 1, 0x01, 0x00,
+    SFX_STEP(4, 0x21, 0x1000, 0, 0x08), SFX_END
+};
+static const unsigned char fx_squash[] = {
+    SFX_V2, 2, 0x08, 0x00,
+    SFX_STEP(12, 0x81, 0x0300, 0, 0x08), SFX_END
+};
+static const unsigned char fx_splash[] = {
+    SFX_V2, 2, 0x04, 0x00,
+    SFX_STEP(10, 0x81, 0x0600, 0, 0x08), SFX_END
+};
+static const unsigned char fx_home[] = {
+    SFX_V3, 2, 0x01, 0x88,
+    SFX_STEP(16, 0x11, 0x1A00, 0, 0x08), SFX_END
+};
+static void snd_hop(void)    { sfx_play(fx_hop); }
+static void snd_squash(void) { sfx_play(fx_squash); }
+static void snd_splash(void) { sfx_play(fx_splash); }
+static void snd_home(void)   { sfx_play(fx_home); }
 
 /* ═══════════════════════════════════════════════════════════
  *  SPRITE SETUP
@@ -407,7 +499,7 @@ static void setup_sprite(void) {
     for (i = 0; i < 63; ++i) dst[i] = frog_sprite[i];
     SPRITE_PTRS[SPR_FROG] = BLK_FROG;
     SPR_COL(SPR_FROG)  = GREEN;
-    VIC_SPR_ENA    = 0x01;
+    SHD_VIC(SHD_SPR_ENA, 0x01);
     VIC_SPR_HI_X   = 0x00;
     VIC_SPR_MCOLOR = 0x00;
     VIC_SPR_DBL_X  = 0x00;
@@ -415,41 +507,31 @@ static void setup_sprite(void) {
 }
 
 /* ═══════════════════════════════════════════════════════════
- *  BACKGROUND DRAWING (bitmap mode)
+ *  BACKGROUND DRAWING
  * ═══════════════════════════════════════════════════════════ */
 static void draw_fixed_bg(void) {
-    unsigned char cy, cx;
+    unsigned char cy;
 
     /* Row 0: HUD — black bar, text drawn by draw_hud() */
-    bmp_fill_solid(ROW_HUD, BLACK);
+    fill_solid(ROW_HUD, BLACK);
 
     /* Row 1: top green bank */
-    bmp_fill_solid(ROW_HOME, GREEN);
+    fill_solid(ROW_HOME, GREEN);
 
     /* Row 2: home pad row — green + 5 empty pads drawn by draw_home_pads() */
-    bmp_fill_solid(ROW_PADS, GREEN);
+    fill_solid(ROW_PADS, GREEN);
 
-    /* Rows 3-7: river (water wave pattern) */
-    for (cy = ROW_RIVER_TOP; cy <= ROW_RIVER_BOT; ++cy)
-        bmp_fill_water(cy);
+    /* Rows 3-7 (river) and 9-13 (road) are drawn by init_lanes() */
 
     /* Row 8: median strip — lighter green */
-    bmp_fill_solid(ROW_MEDIAN, LTGREEN);
-
-    /* Rows 9-13: road — dark grey */
-    for (cy = ROW_ROAD_TOP; cy <= ROW_ROAD_BOT; ++cy)
-        bmp_fill_solid(cy, GREY1);
-
-    /* Row 11: centre dashes — alternating YELLOW cells */
-    for (cx = 1; cx < SCR_W; cx += 2)
-        bmp_solid(cx, 11, YELLOW);
+    fill_solid(ROW_MEDIAN, LTGREEN);
 
     /* Row 14: start safe zone */
-    bmp_fill_solid(ROW_START, GREEN);
+    fill_solid(ROW_START, GREEN);
 
     /* Rows 15-24: lower safe zone (slightly different shade) */
     for (cy = ROW_START + 1; cy < SCR_H; ++cy)
-        bmp_fill_solid(cy, LTGREEN);
+        fill_solid(cy, LTGREEN);
 }
 
 static void draw_home_pads(void) {
@@ -458,91 +540,71 @@ static void draw_home_pads(void) {
         px = 2 + p * 7;
         if (homes_filled & (1 << p)) {
             /* Filled pad: solid bright green */
-            bmp_solid(px,   ROW_PADS, LTGREEN);
-            bmp_solid(px+1, ROW_PADS, WHITE);
-            bmp_solid(px+2, ROW_PADS, LTGREEN);
+            put_solid(px,   ROW_PADS, LTGREEN);
+            put_solid(px+1, ROW_PADS, WHITE);
+            put_solid(px+2, ROW_PADS, LTGREEN);
         } else {
-            /* Empty pad: hollow cyan frame */
-            bmp_custom(px,   ROW_PADS, pad_pat, CYAN);
-            bmp_custom(px+1, ROW_PADS, pad_pat, LTBLUE);
-            bmp_custom(px+2, ROW_PADS, pad_pat, CYAN);
+            /* Empty pad: hollow cyan frame, LTBLUE middle (the
+             * row's $D022), as in the bitmap build */
+            put_chr(px,   ROW_PADS, CH_PAD_C, MC(CYAN));
+            put_chr(px+1, ROW_PADS, CH_PAD,   MC(BLACK));
+            put_chr(px+2, ROW_PADS, CH_PAD_C, MC(CYAN));
         }
     }
 }
 
 static void draw_hud(void) {
     /* HUD background already black from draw_fixed_bg */
-    bmp_puts(1,  ROW_HUD, "SC:", WHITE);
-    bmp_putuint(4,  ROW_HUD, score,      5, YELLOW);
-    bmp_puts(12, ROW_HUD, "HI:", WHITE);
-    bmp_putuint(15, ROW_HUD, high_score, 5, YELLOW);
-    bmp_puts(27, ROW_HUD, "LIV:", WHITE);
-    bmp_putuint(31, ROW_HUD, (unsigned int)lives, 1, LTGREEN);
+    put_str(1,  ROW_HUD, "SC:", WHITE);
+    put_uint(4,  ROW_HUD, score,      5, YELLOW);
+    put_str(12, ROW_HUD, "HI:", WHITE);
+    put_uint(15, ROW_HUD, high_score, 5, YELLOW);
+    put_str(27, ROW_HUD, "LIV:", WHITE);
+    put_uint(31, ROW_HUD, (unsigned int)lives, 1, LTGREEN);
     /* Timer colour: green→yellow→red */
     {
         unsigned char tc = (time_left > 30) ? GREEN :
                            (time_left > 10) ? YELLOW : RED;
-        bmp_putuint(36, ROW_HUD, (unsigned int)time_left, 2, tc);
+        put_uint(36, ROW_HUD, (unsigned int)time_left, 2, tc);
     }
 }
 
 /* ═══════════════════════════════════════════════════════════
- *  OBJECT DRAW / ERASE
+ *  LANES
+ *  A raster split loads each lane's fine scroll into $D016, so
+ *  traffic moves a pixel at a time with no drawing at all. When the
+ *  fine scroll wraps, the lane steps one cell in its ring and only the
+ *  cells on its edge list are redrawn (a vehicle's entry and exit
+ *  cells); every other cell already shows the right descriptor.
  * ═══════════════════════════════════════════════════════════ */
 
-/* Restore background under object */
-static void erase_obj(unsigned char i) {
-    unsigned char cy = obj_cy[i];
-    signed char   sx;
-    unsigned char k;
-    for (k = 0; k < obj_len[i]; ++k) {
-        sx = obj_cx[i] + (signed char)k;
-        if (sx < 0 || sx >= SCR_W) continue;
-        if (cy >= ROW_RIVER_TOP && cy <= ROW_RIVER_BOT)
-            bmp_water((unsigned char)sx, cy);
-        else
-            bmp_solid((unsigned char)sx, cy, GREY1);
-    }
-    /* Restore yellow dashes on road centre line */
-    if (cy == 11) {
-        unsigned char cx;
-        for (cx = 1; cx < SCR_W; cx += 2)
-            bmp_solid(cx, 11, YELLOW);
-    }
+static unsigned char row_lane(unsigned char cy) {
+    if (cy >= ROW_RIVER_TOP && cy <= ROW_RIVER_BOT)
+        return (unsigned char)(cy - ROW_RIVER_TOP);
+    if (cy >= ROW_ROAD_TOP && cy <= ROW_ROAD_BOT)
+        return (unsigned char)(cy - ROW_ROAD_TOP + NUM_RIVER);
+    return LANE_NONE;
 }
 
-static void draw_obj(unsigned char i) {
-    unsigned char cy  = obj_cy[i];
-    unsigned char len = obj_len[i];
-    signed char   sx;
-    unsigned char k, col;
-
-    for (k = 0; k < len; ++k) {
-        sx = obj_cx[i] + (signed char)k;
-        if (sx < 0 || sx >= SCR_W) continue;
-        switch (obj_type[i]) {
-        case OBJ_CAR:
-            col = (k == 0 || k == len-1) ? RED : LTRED;
-            bmp_solid((unsigned char)sx, cy, col);
-            break;
-        case OBJ_TRUCK:
-            col = (k == 0 || k == len-1) ? ORANGE : BROWN;
-            bmp_solid((unsigned char)sx, cy, col);
-            break;
-        case OBJ_LOG:
-            col = (k == 0 || k == len-1) ? BROWN : ORANGE;
-            bmp_solid((unsigned char)sx, cy, col);
-            break;
-        case OBJ_TURTLE:
-            if (obj_anim[i] < 6)
-                bmp_solid((unsigned char)sx, cy, GREEN);
-            else
-                bmp_water((unsigned char)sx, cy);
-            break;
-        default:
-            break;
-        }
-    }
+/* Descriptor on screen at column cx (diving turtles show as water) */
+static unsigned char lane_cell(unsigned char l, unsigned char cx) {
+    unsigned char i = lane_off[l] + cx;
+    if (i >= LANE_LEN) i -= LANE_LEN;
+    i = lane_ring[l][i];
+    if (i == CD_TURTLE && turtle_anim >= TURTLE_UP) i = CD_WATER;
+    return i;
+}
+
+static void draw_lane_cell(unsigned char l, unsigned char cx) {
+    put_cell(cx, lane_row[l], lane_cell(l, cx));
+}
+
+/* Put an object of len cells at ring index at, end cells in end_cd */
+static void lane_put(unsigned char l, unsigned char at, unsigned char len,
+                     unsigned char end_cd, unsigned char body_cd) {
+    unsigned char k;
+    for (k = 0; k < len; ++k)
+        lane_ring[l][at + k] = (k == 0 || k == len-1) ? end_cd : body_cd;
 }
 
 /* Lane parameters */
@@ -550,111 +612,151 @@ static const unsigned char lane_speed[5] = {2,1,2,1,2};
 static const unsigned char road_dir[5]   = {1,0,1,0,1};
 static const unsigned char river_dir[5]  = {0,1,0,1,0};
 
-static void init_objects(void) {
-    unsigned char lane, row, oi, d, sp;
-    oi = 0;
-    for (lane = 0; lane < 5; ++lane) {
-        row = ROW_ROAD_TOP + lane;
-        d   = road_dir[lane];
-        sp  = lane_speed[lane];
-        if (level >= 3 && sp > 1) sp = 1;
-        if (oi < MAX_OBJECTS) {
-            obj_type[oi]=OBJ_CAR;   obj_cy[oi]=row; obj_cx[oi]=0;
-            obj_len[oi]=2; obj_dir[oi]=d; obj_speed[oi]=sp;
-            obj_anim[oi]=0; obj_tick[oi]=0; ++oi;
-        }
-        if (oi < MAX_OBJECTS) {
-            obj_type[oi]=(lane&1)?OBJ_TRUCK:OBJ_CAR; obj_cy[oi]=row;
-            obj_cx[oi]=14; obj_len[oi]=(lane&1)?3:2;
-            obj_dir[oi]=d; obj_speed[oi]=sp;
-            obj_anim[oi]=0; obj_tick[oi]=0; ++oi;
+static void init_lanes(void) {
+    unsigned char l, lane, sp, i, prev, n, cx;
+    turtle_anim = 0;
+    for (l = 0; l < NUM_LANES; ++l) {
+        sp = lane_speed[l < NUM_RIVER ? l : l - NUM_RIVER];
+        if (l < NUM_RIVER) {
+            lane = l;
+            lane_row[l] = ROW_RIVER_TOP + lane;
+            lane_dir[l] = river_dir[lane];
+            if (level >= 2 && sp > 1) sp = 1;
+            memset(lane_ring[l], CD_WATER, LANE_LEN);
+            if (lane & 1) {
+                lane_put(l, 0,  2, CD_TURTLE, CD_TURTLE);
+                lane_put(l, 20, 2, CD_TURTLE, CD_TURTLE);
+            } else {
+                lane_put(l, 0,  4, CD_BROWN, CD_ORANGE);
+                lane_put(l, 20, 5, CD_BROWN, CD_ORANGE);
+            }
+        } else {
+            lane = l - NUM_RIVER;
+            lane_row[l] = ROW_ROAD_TOP + lane;
+            lane_dir[l] = road_dir[lane];
+            if (level >= 3 && sp > 1) sp = 1;
+            memset(lane_ring[l], lane == 2 ? CD_DASH : CD_ROAD, LANE_LEN);
+            lane_put(l, 0, 2, CD_RED, CD_RED);
+            if (lane & 1) lane_put(l, 14, 3, CD_ORANGE, CD_BROWN);
+            else          lane_put(l, 14, 2, CD_RED, CD_RED);
+            lane_put(l, 28, 2, CD_RED, CD_RED);
         }
-        if (oi < MAX_OBJECTS) {
-            obj_type[oi]=OBJ_CAR; obj_cy[oi]=row; obj_cx[oi]=28;
-            obj_len[oi]=2; obj_dir[oi]=d; obj_speed[oi]=sp;
-            obj_anim[oi]=0; obj_tick[oi]=0; ++oi;
+        lane_vel[l]  = (sp > 1) ? LANE_SLOW : LANE_FAST;
+        lane_off[l]  = 0;
+        lane_fine[l] = 0;
+
+        /* Edge list: ring cells that differ from their left neighbour */
+        n = 0;
+        prev = lane_ring[l][LANE_LEN-1];
+        for (i = 0; i < LANE_LEN; ++i) {
+            if (lane_ring[l][i] != prev && n < MAX_EDGES)
+                lane_edge[l][n++] = i;
+            prev = lane_ring[l][i];
         }
+        lane_nedge[l] = n;
+
+        for (cx = 0; cx < SCR_W; ++cx) draw_lane_cell(l, cx);
     }
-    for (lane = 0; lane < 5; ++lane) {
-        row = ROW_RIVER_TOP + lane;
-        d   = river_dir[lane];
-        sp  = lane_speed[lane];
-        if (level >= 2 && sp > 1) sp = 1;
-        if (oi < MAX_OBJECTS) {
-            obj_type[oi]=(lane&1)?OBJ_TURTLE:OBJ_LOG; obj_cy[oi]=row;
-            obj_cx[oi]=0; obj_len[oi]=(lane&1)?2:4;
-            obj_dir[oi]=d; obj_speed[oi]=sp;
-            obj_anim[oi]=0; obj_tick[oi]=0; ++oi;
-        }
-        if (oi < MAX_OBJECTS) {
-            obj_type[oi]=(lane&1)?OBJ_TURTLE:OBJ_LOG; obj_cy[oi]=row;
-            obj_cx[oi]=20; obj_len[oi]=(lane&1)?2:5;
-            obj_dir[oi]=d; obj_speed[oi]=sp;
-            obj_anim[oi]=0; obj_tick[oi]=0; ++oi;
+}
+
+/* Advance one lane by its speed; redraw only the edge cells on a wrap */
+static void step_lane(unsigned char l) {
+    unsigned char f = lane_fine[l], v = lane_vel[l];
+    unsigned char k, c, coarse = 0;
+    if (lane_dir[l]) {
+        f += v;
+        if (f >= 8) {
+            f -= 8; coarse = 1;
+            lane_off[l] = (lane_off[l] ? lane_off[l] : LANE_LEN) - 1;
         }
+    } else if (f >= v) {
+        f -= v;
+    } else {
+        f += 8 - v; coarse = 1;
+        if (++lane_off[l] == LANE_LEN) lane_off[l] = 0;
+    }
+    lane_fine[l] = f;
+    shd_split_d016[lane_row[l]] = D016_PLAY | f;
+    if (!coarse) return;
+
+    /* Column c shows ring[off + c]: a cell changed where its new
+     * descriptor differs from the one it had before the step */
+    for (k = 0; k < lane_nedge[l]; ++k) {
+        c = lane_edge[l][k] + LANE_LEN - lane_off[l];
+        if (c >= LANE_LEN) c -= LANE_LEN;
+        if (lane_dir[l]) c = (c ? c : LANE_LEN) - 1;
+        draw_lane_cell(l, c);
     }
-    num_objs = oi;
 }
 
-static void update_objects(void) {
-    unsigned char i;
-    for (i = 0; i < num_objs; ++i) {
-        if (obj_type[i] == OBJ_TURTLE) {
-            ++obj_anim[i]; if (obj_anim[i] >= 12) obj_anim[i] = 0;
-        }
-        if (++obj_tick[i] < obj_speed[i]) continue;
-        obj_tick[i] = 0;
-        erase_obj(i);
-        if (obj_dir[i]) {
-            ++obj_cx[i];
-            if (obj_cx[i] >= SCR_W) obj_cx[i] = -(signed char)obj_len[i];
-        } else {
-            --obj_cx[i];
-            if (obj_cx[i] < -(signed char)obj_len[i]) obj_cx[i] = SCR_W-1;
-        }
-        draw_obj(i);
+/* Redraw the turtle cells of a lane after they surface or dive */
+static void redraw_turtles(unsigned char l) {
+    unsigned char cx, i = lane_off[l];
+    for (cx = 0; cx < SCR_W; ++cx) {
+        if (lane_ring[l][i] == CD_TURTLE) draw_lane_cell(l, cx);
+        if (++i == LANE_LEN) i = 0;
     }
 }
 
+static void update_lanes(void) {
+    unsigned char l;
+    for (l = 0; l < NUM_LANES; ++l) step_lane(l);
+    if (++turtle_anim == TURTLE_CYCLE) turtle_anim = 0;
+    if (turtle_anim == 0 || turtle_anim == TURTLE_UP)
+        for (l = 1; l < NUM_RIVER; l += 2) redraw_turtles(l);
+}
+
 /* ═══════════════════════════════════════════════════════════
  *  FROG PLACEMENT
  * ═══════════════════════════════════════════════════════════ */
 static void place_frog_sprite(void) {
-    unsigned int sx = C2SX(frog_cx);
+    unsigned int sx = C2SX(frog_cx) + frog_px;
     if (sx >= 256) { VIC_SPR_HI_X |= 0x01; SPR_X(SPR_FROG) = (unsigned char)(sx-256); }
     else           { VIC_SPR_HI_X &= 0xFE; SPR_X(SPR_FROG) = (unsigned char)sx; }
     SPR_Y(SPR_FROG) = C2SY(frog_cy);
 }
 
+/* Tie the frog to the river cell under it after a hop or respawn */
+static void frog_attach(void) {
+    unsigned char l = row_lane(frog_cy), i;
+    frog_px = 0;
+    if (l >= NUM_RIVER) return;
+    frog_px = lane_fine[l];
+    /* Past half a cell the one to the left is under most of the frog */
+    if (frog_px >= 4 && frog_cx) --frog_cx;
+    i = lane_off[l] + frog_cx;
+    if (i >= LANE_LEN) i -= LANE_LEN;
+    frog_ring = i;
+}
+
+/* Carry the frog with its river lane; 0 if it left the screen */
+static unsigned char frog_ride(void) {
+    unsigned char l = frog_cy - ROW_RIVER_TOP;
+    unsigned char c = frog_ring + LANE_LEN - lane_off[l];
+    if (c >= LANE_LEN) c -= LANE_LEN;
+    /* A column that went backwards wrapped round the ring */
+    if (lane_dir[l] ? c < frog_cx : c > frog_cx) return 0;
+    frog_cx = c;
+    frog_px = lane_fine[l];
+    place_frog_sprite();
+    return 1;
+}
+
 /* ═══════════════════════════════════════════════════════════
  *  COLLISION DETECTION
  * ═══════════════════════════════════════════════════════════ */
 static unsigned char check_river(void) {
-    unsigned char i, cy = frog_cy, cx = frog_cx;
-    if (cy < ROW_RIVER_TOP || cy > ROW_RIVER_BOT) return 0;
-    for (i = 0; i < num_objs; ++i) {
-        if (obj_cy[i] != cy) continue;
-        if (obj_type[i] != OBJ_LOG && obj_type[i] != OBJ_TURTLE) continue;
-        if (obj_type[i] == OBJ_TURTLE && obj_anim[i] >= 6) continue;
-        if (cx >= (unsigned char)obj_cx[i] &&
-            cx <  (unsigned char)(obj_cx[i]+(signed char)obj_len[i])) {
-            frog_on_log = i+1; return 1;
-        }
-    }
-    frog_on_log = 0; return 0;
+    unsigned char cd = lane_ring[frog_cy - ROW_RIVER_TOP][frog_ring];
+    if (cd == CD_TURTLE) return turtle_anim < TURTLE_UP;
+    return cd != CD_WATER;
 }
 
 static unsigned char check_road(void) {
-    unsigned char i, cy = frog_cy, cx = frog_cx;
-    if (cy < ROW_ROAD_TOP || cy > ROW_ROAD_BOT) return 0;
-    for (i = 0; i < num_objs; ++i) {
-        if (obj_cy[i] != cy) continue;
-        if (obj_type[i] != OBJ_CAR && obj_type[i] != OBJ_TRUCK) continue;
-        if (cx >= (unsigned char)obj_cx[i] &&
-            cx <  (unsigned char)(obj_cx[i]+(signed char)obj_len[i]))
-            return 1;
-    }
-    return 0;
+    unsigned char l  = frog_cy - ROW_ROAD_TOP + NUM_RIVER;
+    unsigned char cx = frog_cx, cd;
+    if (lane_fine[l] >= 4) cx = (cx ? cx : LANE_LEN) - 1;
+    cd = lane_cell(l, cx);
+    return cd != CD_ROAD && cd != CD_DASH;
 }
 
 static unsigned char check_home(void) {
@@ -675,22 +777,23 @@ static unsigned char check_home(void) {
  * ═══════════════════════════════════════════════════════════ */
 static void show_death(unsigned char is_splash) {
     if (is_splash) {
-        bmp_solid(frog_cx, frog_cy, CYAN);
+        put_solid(frog_cx, frog_cy, CYAN);
         snd_splash();
     } else {
-        bmp_solid(frog_cx, frog_cy, RED);
+        put_solid(frog_cx, frog_cy, RED);
         snd_squash();
     }
     die_timer = 30; game_state = GS_DYING;
-    VIC_SPR_ENA &= ~0x01;
+    SHD_SPR_HIDE(0x01);
 }
 
 static void reset_frog(void) {
     frog_cx = FROG_START_CX; frog_cy = FROG_START_CY;
-    frog_on_log = 0; time_left = TIME_START;
+    time_left = TIME_START;
     timer_frames = 0; prev_joy = 0; hop_lock = 0;
+    frog_attach();
     place_frog_sprite();
-    VIC_SPR_ENA |= 0x01;
+    SHD_SPR_SHOW(0x01);
 }
 
 /* ═══════════════════════════════════════════════════════════
@@ -718,6 +821,7 @@ static void handle_input(void) {
         frog_cx = (unsigned char)nx;
         frog_cy = (unsigned char)ny;
     }
+    frog_attach();
     place_frog_sprite();
     snd_hop(); hop_lock = 6;
 }
@@ -726,13 +830,11 @@ static void handle_input(void) {
  *  LEVEL INIT
  * ═══════════════════════════════════════════════════════════ */
 static void init_level(void) {
-    unsigned char i;
-    for (i = 0; i < MAX_OBJECTS; ++i) obj_tick[i] = 0;
     homes_filled = 0;
+    init_splits();
     draw_fixed_bg();
     draw_home_pads();
-    init_objects();
-    for (i = 0; i < num_objs; ++i) draw_obj(i);
+    init_lanes();
     reset_frog();
     draw_hud();
 }
@@ -760,7 +862,9 @@ static void show_title(void) {
 int main(void) {
     clrscr();
     VIC_BG = BLACK; VIC_BORDER = BLACK;
-    snd_init();
+    shd_install(SHD_LINE);
+    sfx_init();
+    build_charset();
     setup_sprite();
 
     score = 0; high_score = 0;
@@ -770,9 +874,8 @@ int main(void) {
     show_title();
 
     while (1) {
-        waitvsync();
+        shd_wait();
         ++frame_count;
-        snd_update();
 
         /* ── TITLE (text mode) ──────────────────────── */
         if (game_state == GS_TITLE) {
@@ -780,7 +883,7 @@ int main(void) {
             if ((read_joy() & FJOY_FIRE) || frame_count >= 250) {
                 score = 0; lives = NUM_LIVES_START; level = 1;
                 frame_count = 0;
-                setup_bitmap_mode();
+                setup_char_mode();
                 init_level();
                 game_state = GS_PLAY;
             }
@@ -798,25 +901,12 @@ int main(void) {
                 }
             }
             handle_input();
-            if (frame_count & 1) {
-                update_objects();
-                if (frog_on_log) {
-                    unsigned char li = frog_on_log - 1;
-                    if (obj_tick[li] == 0) {
-                        signed char nx;
-                        if (obj_dir[li]) nx = (signed char)frog_cx + 1;
-                        else             nx = (signed char)frog_cx - 1;
-                        if (nx < 0 || nx >= SCR_W) { show_death(1); continue; }
-                        frog_cx = (unsigned char)nx;
-                        place_frog_sprite();
-                    }
-                }
-            }
+            update_lanes();
             {
                 unsigned char cy = frog_cy;
                 if (cy >= ROW_RIVER_TOP && cy <= ROW_RIVER_BOT) {
-                    if (!check_river()) { show_death(1); continue; }
-                } else { frog_on_log = 0; }
+                    if (!frog_ride() || !check_river()) { show_death(1); continue; }
+                }
                 if (cy >= ROW_ROAD_TOP && cy <= ROW_ROAD_BOT)
                     if (check_road()) { show_death(0); continue; }
                 if (cy == ROW_PADS) {
@@ -840,20 +930,12 @@ int main(void) {
         if (game_state == GS_DYING) {
             if (die_timer) { --die_timer; continue; }
             {
-                unsigned char cy = frog_cy, col;
-                if      (cy >= ROW_RIVER_TOP && cy <= ROW_RIVER_BOT)  col = BLUE;
-                else if (cy >= ROW_ROAD_TOP  && cy <= ROW_ROAD_BOT)   col = GREY1;
-                else                                                    col = GREEN;
-                if (cy >= ROW_RIVER_TOP && cy <= ROW_RIVER_BOT)
-                    bmp_water(frog_cx, cy);
-                else
-                    bmp_solid(frog_cx, cy, col);
-                /* restore dash if needed */
-                if (cy == 11 && (frog_cx & 1) == 1)
-                    bmp_solid(frog_cx, 11, YELLOW);
+                unsigned char l = row_lane(frog_cy);
+                if (l != LANE_NONE) draw_lane_cell(l, frog_cx);
+                else                put_solid(frog_cx, frog_cy, GREEN);
             }
             --lives; draw_hud();
-            if (lives == 0) { game_state = GS_OVER; VIC_SPR_ENA &= ~0x01; }
+            if (lives == 0) { game_state = GS_OVER; SHD_SPR_HIDE(0x01); }
             else            { reset_frog(); game_state = GS_PLAY; }
             continue;
         }
@@ -868,20 +950,20 @@ int main(void) {
         /* ── LEVEL CLEAR ────────────────────────────── */
         if (game_state == GS_LEVEL) {
             if (level_timer == 80) {
-                /* Draw "LEVEL X CLEAR" in HUD area via bitmap font */
-                bmp_fill_solid(12, PURPLE);
-                bmp_puts(11, 12, "LV", YELLOW);
-                bmp_putuint(13, 12, (unsigned int)level, 1, WHITE);
-                bmp_puts(14, 12, "CLEAR", LTGREEN);
+                /* "LV X CLEAR" on a black road row; init_level()
+                 * puts the road colours back */
+                shd_split_d021[12] = BLACK;
+                shd_split_d022[12] = LTGREEN;
+                fill_solid(12, PURPLE);
+                put_str(11, 12, "LV", YELLOW);
+                put_uint(13, 12, (unsigned int)level, 1, WHITE);
+                put_str(14, 12, "CLEAR", LTGREEN);
                 score += (unsigned int)level * 200;
                 if (score > high_score) high_score = score;
                 draw_hud();
             }
             if (level_timer) { --level_timer; continue; }
             ++level;
-            /* Clear level clear row */
-            bmp_fill_solid(12, GREY1);
-            /* Restore centre dashes (row 11 already done in draw_fixed_bg) */
             init_level();
             game_state = GS_PLAY;
             continue;
@@ -889,7 +971,7 @@ int main(void) {
 
         /* ── GAME OVER ──────────────────────────────── */
         if (game_state == GS_OVER) {
-            exit_bitmap_mode();
+            exit_char_mode();
             clrscr();
             textcolor(RED);    gotoxy(13,11); cputs("GAME OVER");
             textcolor(WHITE);  gotoxy(10,13); cprintf("SCORE: %05u", score);
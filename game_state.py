@@ -0,0 +1,393 @@
+#!/usr/bin/env python3
+"""
+game_state.py - Symbolic game state straight from C64 RAM, no VLM
+
+For the games whose state lives in known variables, reads those
+variables by name and returns the same JSON fields as
+vlm_look.py --json, in milliseconds:
+
+    pacman     pac_x/pac_y, ghost_x/ghost_y[4], score, lives, level, ...
+    tetris_v1  board[20][10], current/next piece, score, lines, level
+    tetris_v2  board[20][10], current/next piece, score, lines
+    snake      head, apple, direction, score
+    snake2     head, apple, direction, score, high score
+    invaders   aliens[5][11], swarm, ship, bullet, score, lives, wave
+
+Addresses come from the symbol files every build writes (.dbg, .lbl,
+.map; see symbols.py), so a field is named as in the source: C
+variables as _name. A snapshot is one monitor save of all 64K, so every
+field comes from the same moment.
+
+Fields the RAM does not hold (visual glitches, what a sprite looks
+like) stay empty: that is what vlm_look.py is still for.
+
+Usage:
+    python3 game_state.py pacman                # JSON from the running game
+    python3 game_state.py invaders --field score --field lives
+    python3 game_state.py tetris_v1 --snapshot ram.bin   # offline
+    python3 game_state.py pong --save-snapshot ram.bin
+    python3 game_state.py --list
+
+Requirements:
+    - VICE running with -remotemonitor (port 6510), or a snapshot file
+    - The game built (build_all.py), which writes its symbol files
+
+Author: C64AIToolChain Project
+"""
+
+import argparse
+import json
+import os
+import socket
+import sys
+import tempfile
+import time
+from datetime import datetime
+from pathlib import Path
+
+from symbols import SymbolDB
+
+ROOT = Path(__file__).resolve().parent
+VICE_PORT = 6510
+
+COLOR_NAMES = ['black', 'white', 'red', 'cyan', 'purple', 'green', 'blue',
+               'yellow', 'orange', 'brown', 'light red', 'dark grey', 'grey',
+               'light green', 'light blue', 'light grey']
+
+# =============================================================================
+# SCHEMAS - Which variables make up each game's state
+# =============================================================================
+#
+# Field kinds:
+#   ('u8', sym)              one byte
+#   ('u16', sym)             little-endian word (C unsigned int)
+#   ('u16lh', lo, hi)        word split over two variables
+#   ('array', sym, n)        n bytes
+#   ('grid', sym, rows, cols)
+#   ('enum', sym, names)     one byte shown by name
+#   ('bool', sym)
+#
+# 'state' maps the fields to look_json's state (running, game_over,
+# title_screen, demo, ...); 'score' names the field shown as score.
+
+def _by_flags(v):
+    if v.get('game_over'):
+        return 'game_over'
+    return 'demo' if v.get('demo_mode') else 'running'
+
+
+DIRS_RLUD = ['right', 'left', 'up', 'down']
+DIRS_NSWE = ['north', 'south', 'west', 'east']
+TETRIS = {
+    'fields': {
+        'board': ('grid', 'board', 20, 10),
+        'piece': ('enum', 'cur_piece', ['I', 'O', 'T', 'S', 'Z', 'J', 'L']),
+        'rotation': ('u8', 'cur_rot'),
+        'piece_x': ('u8', 'cur_x'),
+        'piece_y': ('u8', 'cur_y'),
+        'next_piece': ('enum', 'next_piece', ['I', 'O', 'T', 'S', 'Z', 'J', 'L']),
+        'score': ('u16lh', 'score_lo', 'score_hi'),
+        'lines': ('u8', 'lines_cleared'),
+        'level': ('u8', 'level'),
+        'game_over': ('bool', 'game_over'),
+        'demo_mode': ('bool', 'demo_mode'),
+    },
+    'state': _by_flags,
+    'score': 'score',
+}
+
+# tetris_v2 keeps a plain 16-bit score and a line count; it restarts
+# straight from its game_over code, so there is no flag to read
+TETRIS_V2 = {
+    'fields': {
+        **{k: TETRIS['fields'][k] for k in
+           ('board', 'piece', 'rotation', 'piece_x', 'piece_y', 'next_piece')},
+        'score': ('u16', 'score'),
+        'lines': ('u8', 'lines'),
+    },
+    'state': lambda v: 'running',
+    'score': 'score',
+}
+
+SCHEMAS = {
+    'pacman': {
+        'fields': {
+            'pac_x': ('u8', 'pac_x'),
+            'pac_y': ('u8', 'pac_y'),
+            'pac_dir': ('enum', 'pac_dir', DIRS_RLUD),
+            'ghost_x': ('array', 'ghost_x', 4),
+            'ghost_y': ('array', 'ghost_y', 4),
+            'ghost_mode': ('array', 'ghost_mode', 4),
+            'score': ('u16lh', 'score_lo', 'score_hi'),
+            'lives': ('u8', 'lives'),
+            'level': ('u8', 'level'),
+            'dots_left': ('u8', 'dots_left'),
+            'power_timer': ('u8', 'power_timer'),
+            'frightened': ('bool', 'fright_mode'),
+            'game_state': ('enum', 'game_state', ['title', 'play', 'dying', 'won']),
+            'demo_mode': ('bool', 'demo_mode'),
+        },
+        'state': lambda v: ('title_screen' if v['game_state'] == 'title' else
+                            'demo' if v['demo_mode'] else 'running'),
+        'score': 'score',
+    },
+    'tetris_v1': TETRIS,
+    'tetris_v2': TETRIS_V2,
+    'snake': {
+        'fields': {
+            'head_x': ('u8', 'head_x'),
+            'head_y': ('u8', 'head_y'),
+            'dir': ('enum', 'dir', DIRS_NSWE),
+            'apple_x': ('u8', 'apple_x'),
+            'apple_y': ('u8', 'apple_y'),
+            'score': ('u8', 'score'),
+        },
+        'state': lambda v: 'running',
+        'score': 'score',
+    },
+    'snake2': {
+        'fields': {
+            'head_x': ('u16', 'head_x'),
+            'head_y': ('u8', 'head_y'),
+            'dir': ('enum', 'dir', DIRS_NSWE),
+            'apple_x': ('u16', 'apple_x'),
+            'apple_y': ('u8', 'apple_y'),
+            'score': ('u16lh', 'score_lo', 'score_hi'),
+            'hiscore': ('u16lh', 'hiscore_lo', 'hiscore_hi'),
+            'speed': ('u8', 'speed'),
+            'game_over': ('bool', 'game_over'),
+            'demo_mode': ('bool', 'demo_mode'),
+        },
+        'state': _by_flags,
+        'score': 'score',
+    },
+    'invaders': {
+        'fields': {
+            'aliens': ('grid', '_aliens', 5, 11),
+            'aliens_left': ('u8', '_aliens_left'),
+            'swarm_x': ('u8', '_swarm_x'),
+            'swarm_y': ('u8', '_swarm_y'),
+            'ship_x': ('u8', '_ship_x'),
+            'bullet_active': ('bool', '_bullet_active'),
+            'bullet_x': ('u8', '_bullet_x'),
+            'bullet_y': ('u8', '_bullet_y'),
+            'ufo_active': ('bool', '_ufo_active'),
+            'score': ('u16', '_score'),
+            'lives': ('u8', '_lives'),
+            'wave': ('u8', '_wave'),
+            'game_state': ('enum', '_game_state',
+                           ['title', 'play', 'dying', 'won', 'lost', 'next']),
+            'demo_mode': ('bool', '_demo_mode'),
+        },
+        'state': lambda v: ('title_screen' if v['game_state'] == 'title' else
+                            'game_over' if v['game_state'] == 'lost' else
+                            'demo' if v['demo_mode'] else 'running'),
+        'score': 'score',
+    },
+}
+
+
+# =============================================================================
+# SNAPSHOT - All of RAM through the monitor
+# =============================================================================
+
+def read_snapshot(host='localhost', port=VICE_PORT, timeout=3.0):
+    """64K memory image, as the CPU sees it, in one monitor save."""
+    fd, path = tempfile.mkstemp(suffix='.bin')
+    os.close(fd)
+    os.unlink(path)
+    try:
+        s = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+        s.settimeout(timeout)
+        s.connect((host, port))
+        s.sendall(f's "{path}" 0 0000 ffff\nx\n'.encode())
+        deadline = time.time() + timeout
+        data = b''
+        while time.time() < deadline:
+            if os.path.exists(path):
+                with open(path, 'rb') as f:
+                    data = f.read()
+                if len(data) >= 0x10002:
+                    break
+            time.sleep(0.01)
+        s.close()
+        return data[2:0x10002] if len(data) >= 0x10002 else None
+    except OSError as e:
+        print(f"Error reading memory from VICE: {e}", file=sys.stderr)
+        return None
+    finally:
+        if os.path.exists(path):
+            os.unlink(path)
+
+
+# =============================================================================
+# EXTRACTION
+# =============================================================================
+
+def read_field(ram, labels, spec):
+    """One schema field from RAM; KeyError names a missing symbol."""
+    kind = spec[0]
+    addr = labels[spec[1]]
+    if kind == 'u8':
+        return ram[addr]
+    if kind == 'u16':
+        return ram[addr] | ram[addr + 1] << 8
+    if kind == 'u16lh':
+        return ram[addr] | ram[labels[spec[2]]] << 8
+    if kind == 'array':
+        return list(ram[addr:addr + spec[2]])
+    if kind == 'grid':
+        rows, cols = spec[2], spec[3]
+        return [list(ram[addr + r * cols:addr + (r + 1) * cols]) for r in range(rows)]
+    if kind == 'enum':
+        v = ram[addr]
+        return spec[2][v] if v < len(spec[2]) else v
+    if kind == 'bool':
+        return bool(ram[addr])
+    raise ValueError(f"unknown field kind {kind}")
+
+
+def screen_text(ram):
+    """Non-blank lines of the text screen (found through $DD00/$D018)."""
+    base = (3 - (ram[0xDD00] & 3)) * 0x4000 + (ram[0xD018] >> 4) * 0x400
+    lines = []
+    for row in range(25):
+        line = ''
+        for c in ram[base + row * 40:base + row * 40 + 40]:
+            c &= 0x7F
+            line += (chr(c + 64) if 1 <= c <= 26 else
+                     chr(c) if 32 <= c < 64 else ' ')
+        line = ' '.join(line.split())
+        if line:
+            lines.append(line)
+    return lines
+
+
+def sprites(ram):
+    """Enabled sprites with look_json's coarse positions."""
+    out = []
+    for i in range(8):
+        if not ram[0xD015] >> i & 1:
+            continue
+        x = ram[0xD000 + i * 2] | (ram[0xD010] >> i & 1) << 8
+        y = ram[0xD001 + i * 2]
+        out.append({
+            'color': COLOR_NAMES[ram[0xD027 + i] & 0x0F],
+            'position': {
+                'x': 'left' if x < 130 else 'right' if x >= 237 else 'center',
+                'y': 'top' if y < 117 else 'bottom' if y >= 183 else 'middle'},
+            'description': f"sprite {i} at ({x},{y})",
+            'x': x, 'y': y,
+        })
+    return out
+
+
+def extract(project, ram, labels):
+    """
+    Game state as look_json() fields, plus 'game' with the raw values.
+
+    Fields whose symbol is missing from the labels are left out and
+    listed in _meta.missing.
+    """
+    schema = SCHEMAS[project]
+    values, missing = {}, []
+    for name, spec in schema['fields'].items():
+        try:
+            values[name] = read_field(ram, labels, spec)
+        except KeyError as e:
+            missing.append(str(e).strip("'"))
+    try:
+        state = schema['state'](values)
+    except KeyError:
+        state = 'running'
+    score = values.get(schema.get('score'))
+    return {
+        'screen_type': 'title' if state == 'title_screen' else 'game',
+        'state': state,
+        'text_content': screen_text(ram),
+        'sprites': sprites(ram),
+        'background': {
+            'color': COLOR_NAMES[ram[0xD021] & 0x0F],
+            'border_color': COLOR_NAMES[ram[0xD020] & 0x0F],
+        },
+        'score_display': None if score is None else str(score),
+        'visual_issues': [],
+        'additional_observations': "Read from RAM by symbol; use vlm_look.py "
+                                   "for visual checks.",
+        'game': values,
+        '_meta': {'game': project, 'source': 'ram', 'missing': missing},
+    }
+
+
+def look_state(project, ram=None, labels_path=None, host='localhost',
+               port=VICE_PORT):
+    """
+    Symbolic replacement for vlm_look.look_json() on supported games.
+
+    Returns:
+        Dictionary with the look_json fields, or {'error': ...}
+    """
+    start = time.time()
+    if project not in SCHEMAS:
+        return {'error': f"No state schema for {project}; "
+                         f"have: {', '.join(sorted(SCHEMAS))}"}
+    labels = (SymbolDB.load(labels_path) if labels_path
+              else SymbolDB.for_project(project))
+    if labels is None:
+        return {'error': f"No symbol files in {project}/: build it first"}
+    if ram is None:
+        ram = read_snapshot(host, port)
+        if ram is None:
+            return {'error': 'Could not read C64 memory. Is VICE running '
+                             'with -remotemonitor?'}
+    result = extract(project, ram, labels)
+    result['_meta'].update({
+        'timestamp': datetime.now().isoformat(),
+        'labels': [os.path.relpath(p, ROOT) for p in labels.sources],
+        'elapsed_ms': round((time.time() - start) * 1000, 1),
+    })
+    return result
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Symbolic game state from C64 RAM (no VLM)')
+    parser.add_argument('project', nargs='?', help='Game directory, e.g. pacman')
+    parser.add_argument('--labels', help='Symbol file (.dbg, .lbl or .map)')
+    parser.add_argument('--snapshot', metavar='FILE',
+                        help='Read a saved 64K RAM image instead of VICE')
+    parser.add_argument('--save-snapshot', metavar='FILE',
+                        help='Save the 64K RAM image read from VICE')
+    parser.add_argument('--field', action='append',
+                        help='Print only this game field (repeatable)')
+    parser.add_argument('--list', action='store_true',
+                        help='List games with a schema and their fields')
+    args = parser.parse_args()
+
+    if args.list or not args.project:
+        for name, schema in SCHEMAS.items():
+            print(f"{name:10s} {', '.join(schema['fields'])}")
+        return 0
+
+    ram = None
+    if args.snapshot:
+        ram = Path(args.snapshot).read_bytes()
+        if len(ram) < 0x10000:
+            print(f"{args.snapshot}: not a 64K RAM image")
+            return 1
+    elif args.save_snapshot:
+        ram = read_snapshot()
+        if ram is None:
+            print("Could not read C64 memory")
+            return 1
+        Path(args.save_snapshot).write_bytes(ram)
+
+    result = look_state(args.project, ram, args.labels)
+    if 'error' not in result and args.field:
+        result = {f: result['game'].get(f) for f in args.field}
+    print(json.dumps(result, indent=2))
+    return 0 if 'error' not in result else 1
+
+
+if __name__ == '__main__':
+    sys.exit(main())
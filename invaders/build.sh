@@ -2,7 +2,7 @@
 # Build Space Invaders using cc65
 cd "$(dirname "$0")"
 
-cl65 -t c64 -O -o invaders.prg invaders.c
+cl65 -t c64 -C invaders.cfg -O -I ../common -g -m invaders.map -Ln invaders.lbl -Wl --dbgfile,invaders.dbg -o invaders.prg invaders.c ../common/shadow.s ../common/sfx.s ../common/replay.s
 
 if [[ -f invaders.prg ]]; then
     echo "Built invaders.prg ($(stat -c%s invaders.prg) bytes)"
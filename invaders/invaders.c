@@ -21,6 +21,10 @@
 #include <stdlib.h>
 #include <joystick.h>
 
+#include "shadow.h"
+#include "sfx.h"
+#include "replay.h"
+
 /* ═══════════════════════════════════════════════════════════
  *  HARDWARE DEFINES
  * ═══════════════════════════════════════════════════════════ */
@@ -66,39 +70,14 @@
 #define CHAR_EXPLODE_R  113
 
 /* ── VIC-II ─────────────────────────────────────────────── */
-#define VIC_SPR_ENA     (*(unsigned char*)0xD015)
-#define VIC_SPR_HI_X    (*(unsigned char*)0xD010)
 #define VIC_SPR_MCOLOR  (*(unsigned char*)0xD01C)
 #define VIC_SPR_DBL_X   (*(unsigned char*)0xD01D)
 #define VIC_SPR_DBL_Y   (*(unsigned char*)0xD017)
 #define VIC_SPR_PRIO    (*(unsigned char*)0xD01B)
 
-/* Sprite pos/color registers – addressed by index */
-#define SPR_X(n) (*(unsigned char*)(0xD000 + (n)*2))
-#define SPR_Y(n) (*(unsigned char*)(0xD001 + (n)*2))
+/* Sprite color registers – addressed by index (positions: SHD_SPR_X/Y) */
 #define SPR_COL(n) (*(unsigned char*)(0xD027 + (n)))
 
-/* ── SID ────────────────────────────────────────────────── */
-#define SID_V1_FLO (*(unsigned char*)0xD400)
-#define SID_V1_FHI (*(unsigned char*)0xD401)
-#define SID_V1_CTL (*(unsigned char*)0xD404)
-#define SID_V1_AD  (*(unsigned char*)0xD405)
-#define SID_V1_SR  (*(unsigned char*)0xD406)
-
-#define SID_V2_FLO (*(unsigned char*)0xD407)
-#define SID_V2_FHI (*(unsigned char*)0xD408)
-#define SID_V2_CTL (*(unsigned char*)0xD40B)
-#define SID_V2_AD  (*(unsigned char*)0xD40C)
-#define SID_V2_SR  (*(unsigned char*)0xD40D)
-
-#define SID_V3_FLO (*(unsigned char*)0xD40E)
-#define SID_V3_FHI (*(unsigned char*)0xD40F)
-#define SID_V3_CTL (*(unsigned char*)0xD412)
-#define SID_V3_AD  (*(unsigned char*)0xD413)
-#define SID_V3_SR  (*(unsigned char*)0xD414)
-
-#define SID_VOL    (*(unsigned char*)0xD418)
-
 /* ── Colors ─────────────────────────────────────────────── */
 #define BLACK    0
 #define WHITE    1
@@ -208,7 +187,6 @@ static unsigned char wave;
 static unsigned char game_state;
 static unsigned char demo_mode;
 static unsigned char frame_count;
-static unsigned char snd_timer1, snd_timer2;
 
 /* Shields: 4 bunkers, each 4 chars wide × 3 rows (stored as screen data) */
 /* We just draw them and let bullets/bombs erase chars on contact */
@@ -426,11 +404,11 @@ static void setup_sprites(void) {
     SPRITE_PTRS[SPR_BOMB2]  = BLK_BOMB;
     SPRITE_PTRS[SPR_UFO]    = BLK_UFO;
 
-    VIC_SPR_ENA    = 0;    /* enable individually later */
+    SHD_VIC(SHD_SPR_ENA, 0);    /* enable individually later */
     VIC_SPR_DBL_X  = 0;
     VIC_SPR_DBL_Y  = 0;
     VIC_SPR_MCOLOR = 0;
-    VIC_SPR_HI_X   = 0;
+    SHD_VIC(SHD_SPR_HI_X, 0);
     VIC_SPR_PRIO   = 0;
 
     SPR_COL(SPR_SHIP)   = GREEN;
@@ -445,64 +423,65 @@ static void setup_sprites(void) {
  *  SOUND
  * ═══════════════════════════════════════════════════════════ */
 
-static void snd_init(void) {
-    SID_VOL    = 15;
-    SID_V1_AD  = 0x00;
-    SID_V1_SR  = 0xA0;
-    SID_V2_AD  = 0x08;
-    SID_V2_SR  = 0x00;
-    SID_V3_AD  = 0x00;
-    SID_V3_SR  = 0x90;
-}
+/* Effects for the IRQ player (see sfx.h) */
 
 /* Shoot: short high noise burst */
-static void snd_shoot(void) {
-    SID_V1_FHI = 0x28;
-    SID_V1_CTL = 0x81;  /* noise gate on */
-    snd_timer1 = 4;
-}
+static const unsigned char fx_shoot[] = {
+    SFX_V1, 1, 0x00, 0xA0,
+    SFX_STEP(4, 0x81, 0x2800, 0, 0x08),
+    SFX_END
+};
 
 /* Alien explode: medium crash */
-static void snd_explode(void) {
-    SID_V2_FHI = 0x20;
-    SID_V2_CTL = 0x81;  /* noise gate on */
-    snd_timer2 = 6;
-}
+static const unsigned char fx_explode[] = {
+    SFX_V2, 2, 0x08, 0x00,
+    SFX_STEP(6, 0x81, 0x2000, 0, 0x08),
+    SFX_END
+};
+
+/* March: bass thump, pitch patched per step from march_notes */
+static unsigned char fx_march[] = {
+    SFX_V3, 1, 0x00, 0x90,
+    SFX_STEP(8, 0x21, 0x1C00, 0, 0x08),
+    SFX_END
+};
+
+/* UFO whine: rising pulse, loops while the UFO is on screen */
+static const unsigned char fx_ufo[] = {
+    SFX_V2 | SFX_KEEP, 1, 0x08, 0x00,
+    SFX_STEP(8, 0x41, 0x3000, 1, 0x08),
+    SFX_LOOP
+};
+
+/* Player death: descending wail */
+#define FX_DEATH_FRAMES 30
+static const unsigned char fx_death[] = {
+    SFX_V1, 3, 0x00, 0xA0,
+    SFX_STEP(FX_DEATH_FRAMES, 0x21, 0x4000, -2, 0x08),
+    SFX_END
+};
+
+static void snd_shoot(void)   { sfx_play(fx_shoot); }
+static void snd_explode(void) { sfx_play(fx_explode); }
+static void snd_ufo(void)     { sfx_play(fx_ufo); }
 
-/* March: bass thump (4-note cycle) */
 static void snd_march(void) {
-    SID_V3_FHI = march_notes[march_note_idx];
-    SID_V3_FLO = 0x00;
-    SID_V3_CTL = 0x21;  /* sawtooth gate on */
+    fx_march[SFX_PITCH] = march_notes[march_note_idx];
+    sfx_play(fx_march);
     march_note_idx = (march_note_idx + 1) & 3;
 }
 
-/* UFO whine */
-static void snd_ufo(void) {
-    SID_V2_FHI = 0x30 + (frame_count & 7);
-    SID_V2_CTL = 0x41;  /* pulse gate on */
-}
-
-/* Player death: descending wail */
+/* The game freezes while the death wail plays */
 static void snd_death(void) {
     unsigned char i;
-    for (i = 0x40; i > 0x05; i -= 2) {
-        SID_V1_FHI = i;
-        SID_V1_CTL = 0x21;
-        waitvsync();
-    }
-    SID_V1_CTL = 0x20;
+    sfx_play(fx_death);
+    for (i = 0; i < FX_DEATH_FRAMES; ++i) waitvsync();
 }
 
 static void snd_off(void) {
-    SID_V1_CTL = 0x00;
-    SID_V2_CTL = 0x00;
-    SID_V3_CTL = 0x00;
-}
-
-static void snd_tick(void) {
-    if (snd_timer1 > 0) { --snd_timer1; if (!snd_timer1) SID_V1_CTL = 0x00; }
-    if (snd_timer2 > 0) { --snd_timer2; if (!snd_timer2) SID_V2_CTL = 0x00; }
+    sfx_stop(SFX_V1);
+    sfx_stop(SFX_V2);
+    sfx_stop(SFX_V3);
 }
 
 /* ═══════════════════════════════════════════════════════════
@@ -699,15 +678,15 @@ static void move_bullet(void) {
     /* Move up */
     if (bullet_y <= BULLET_TOP + 4) {
         bullet_active = 0;
-        VIC_SPR_ENA &= ~(1 << SPR_BULLET);
+        SHD_SPR_HIDE(1 << SPR_BULLET);
         return;
     }
     bullet_y -= 4;  /* fast bullet */
 
     /* Update sprite */
-    SPR_X(SPR_BULLET) = bullet_x;
-    SPR_Y(SPR_BULLET) = bullet_y;
-    VIC_SPR_ENA |= (1 << SPR_BULLET);
+    SHD_SPR_X(SPR_BULLET, bullet_x);
+    SHD_SPR_Y(SPR_BULLET, bullet_y);
+    SHD_SPR_SHOW(1 << SPR_BULLET);
 
     /* Convert to char coords */
     cx = (bullet_x - SPR_XOFS) >> 3;
@@ -718,11 +697,11 @@ static void move_bullet(void) {
         if (bullet_x >= ufo_x - 8 && bullet_x <= ufo_x + 16) {
             /* UFO destroyed */
             ufo_active = 0;
-            VIC_SPR_ENA &= ~(1 << SPR_UFO);
+            SHD_SPR_HIDE(1 << SPR_UFO);
             score += 100 + (rand() & 0x7F); /* 100-227 points */
             snd_explode();
             bullet_active = 0;
-            VIC_SPR_ENA &= ~(1 << SPR_BULLET);
+            SHD_SPR_HIDE(1 << SPR_BULLET);
             return;
         }
     }
@@ -732,7 +711,7 @@ static void move_bullet(void) {
     if (ch == 0xA0) { /* shield block */
         draw_char(cx, cy, 32, BLACK);
         bullet_active = 0;
-        VIC_SPR_ENA &= ~(1 << SPR_BULLET);
+        SHD_SPR_HIDE(1 << SPR_BULLET);
         return;
     }
 
@@ -760,7 +739,7 @@ static void move_bullet(void) {
                 }
 
                 bullet_active = 0;
-                VIC_SPR_ENA &= ~(1 << SPR_BULLET);
+                SHD_SPR_HIDE(1 << SPR_BULLET);
 
                 if (aliens_left == 0) game_state = GS_WON;
                 return;
@@ -807,14 +786,14 @@ static void move_bombs(void) {
         /* Off bottom? */
         if (bomb_y[i] >= BOMB_BOTTOM) {
             bomb_active[i] = 0;
-            VIC_SPR_ENA &= ~(1 << (SPR_BOMB0 + i));
+            SHD_SPR_HIDE(1 << (SPR_BOMB0 + i));
             continue;
         }
 
         /* Update sprite */
-        SPR_X(SPR_BOMB0 + i) = bomb_x[i];
-        SPR_Y(SPR_BOMB0 + i) = bomb_y[i];
-        VIC_SPR_ENA |= (1 << (SPR_BOMB0 + i));
+        SHD_SPR_X(SPR_BOMB0 + i, bomb_x[i]);
+        SHD_SPR_Y(SPR_BOMB0 + i, bomb_y[i]);
+        SHD_SPR_SHOW(1 << (SPR_BOMB0 + i));
 
         /* Convert to char */
         cx = (bomb_x[i] - SPR_XOFS) >> 3;
@@ -825,7 +804,7 @@ static void move_bombs(void) {
         if (ch == 0xA0) {
             draw_char(cx, cy, 32, BLACK);
             bomb_active[i] = 0;
-            VIC_SPR_ENA &= ~(1 << (SPR_BOMB0 + i));
+            SHD_SPR_HIDE(1 << (SPR_BOMB0 + i));
             continue;
         }
 
@@ -833,7 +812,7 @@ static void move_bombs(void) {
         if (bomb_y[i] >= SHIP_Y_SPR - 2 && bomb_y[i] <= SHIP_Y_SPR + 8) {
             if (bomb_x[i] >= ship_x - 4 && bomb_x[i] <= ship_x + 12) {
                 bomb_active[i] = 0;
-                VIC_SPR_ENA &= ~(1 << (SPR_BOMB0 + i));
+                SHD_SPR_HIDE(1 << (SPR_BOMB0 + i));
                 game_state = GS_DYING;
                 return;
             }
@@ -856,22 +835,22 @@ static void update_ufo(void) {
                 ufo_x = C2SX(37);
                 ufo_dx = -1;
             }
-            SPR_Y(SPR_UFO) = C2SY(1);
+            SHD_SPR_Y(SPR_UFO, C2SY(1));
         }
         return;
     }
 
     /* Move UFO */
     ufo_x = (unsigned char)((signed char)ufo_x + ufo_dx);
-    SPR_X(SPR_UFO) = ufo_x;
-    VIC_SPR_ENA |= (1 << SPR_UFO);
+    SHD_SPR_X(SPR_UFO, ufo_x);
+    SHD_SPR_SHOW(1 << SPR_UFO);
     snd_ufo();
 
     /* Off screen? */
     if (ufo_x <= C2SX(0) || ufo_x >= C2SX(38)) {
         ufo_active = 0;
-        VIC_SPR_ENA &= ~(1 << SPR_UFO);
-        SID_V2_CTL = 0x00;
+        SHD_SPR_HIDE(1 << SPR_UFO);
+        sfx_stop(SFX_V2);
     }
 }
 
@@ -879,15 +858,16 @@ static void update_ufo(void) {
  *  INPUT
  * ═══════════════════════════════════════════════════════════ */
 
+/* In game: this frame's input from rp_frame(), recorded or played back */
 static unsigned char joy_dir(void) {
-    unsigned char j = joy_read(JOY_2);
+    unsigned char j = rp_joy(JOY_2);
     if (JOY_LEFT(j))  return 1;
     if (JOY_RIGHT(j)) return 2;
     return 0;
 }
 
 static unsigned char joy_fire(void) {
-    return JOY_FIRE(joy_read(JOY_2));
+    return JOY_FIRE(rp_joy(JOY_2));
 }
 
 /* Demo AI: track lowest alien column and shoot */
@@ -971,9 +951,9 @@ static void init_wave(void) {
     draw_shields();
 
     /* Position ship sprite */
-    SPR_Y(SPR_SHIP) = SHIP_Y_SPR;
-    SPR_X(SPR_SHIP) = ship_x;
-    VIC_SPR_ENA = (1 << SPR_SHIP);  /* only ship visible initially */
+    SHD_SPR_Y(SPR_SHIP, SHIP_Y_SPR);
+    SHD_SPR_X(SPR_SHIP, ship_x);
+    SHD_VIC(SHD_SPR_ENA, 1 << SPR_SHIP);  /* only ship visible initially */
 }
 
 /* ═══════════════════════════════════════════════════════════
@@ -1054,8 +1034,8 @@ static void game_loop(void) {
 
     while (1) {
         waitvsync();
+        rp_frame();
         ++frame_count;
-        snd_tick();
 
         /* ── PLAY ────────────────────────────────────── */
         if (game_state == GS_PLAY) {
@@ -1073,7 +1053,7 @@ static void game_loop(void) {
             }
 
             /* Update ship sprite */
-            SPR_X(SPR_SHIP) = ship_x;
+            SHD_SPR_X(SPR_SHIP, ship_x);
 
             /* Alien march */
             move_swarm();
@@ -1110,16 +1090,16 @@ static void game_loop(void) {
             } else {
                 /* Reset player position, keep aliens */
                 ship_x = C2SX(19);
-                SPR_X(SPR_SHIP) = ship_x;
+                SHD_SPR_X(SPR_SHIP, ship_x);
                 bullet_active = 0;
                 {
                     unsigned char i;
                     for (i = 0; i < MAX_BOMBS; ++i) {
                         bomb_active[i] = 0;
-                        VIC_SPR_ENA &= ~(1 << (SPR_BOMB0 + i));
+                        SHD_SPR_HIDE(1 << (SPR_BOMB0 + i));
                     }
                 }
-                VIC_SPR_ENA &= ~(1 << SPR_BULLET);
+                SHD_SPR_HIDE(1 << SPR_BULLET);
                 game_state = GS_PLAY;
             }
             continue;
@@ -1170,7 +1150,8 @@ int main(void) {
     bgcolor(BLACK);
     bordercolor(BLACK);
 
-    snd_init();
+    shd_install(SHD_LINE);
+    sfx_init();
     init_sprite_data();
     init_custom_charset();
     setup_sprites();
@@ -1181,7 +1162,7 @@ title_screen:
     snd_off();
 
     title_timer = 0;
-    while (!joy_fire() && title_timer < 350) {
+    while (!rp_start() && title_timer < 350) {
         waitvsync();
         ++title_timer;
     }
@@ -1191,10 +1172,12 @@ title_screen:
     lives = 3;
     wave  = 1;
     frame_count = 0;
-    snd_timer1 = 0;
-    snd_timer2 = 0;
 
-    demo_mode = joy_fire() ? 0 : 1;
+    demo_mode = rp_start() ? 0 : 1;
+
+    /* Seed and start logging (or play back) this run; demos are not
+     * logged, so the last game's log stays there to be saved */
+    demo_mode = rp_begin(demo_mode ? RP_DEMO : 0) & RP_DEMO;
 
     init_wave();
     game_state = GS_PLAY;
@@ -0,0 +1,84 @@
+/* Packed by common/pack.py from kanji-charset.h: 2048 -> 1582 bytes */
+#define KANJI_Z_SIZE 2048
+const unsigned char kanji_z[] = {
+    46, 60, 102, 110, 110, 96, 98, 60, 0, 24, 60, 102, 126, 102, 102, 102, 0, 124, 102, 102,
+    124, 102, 102, 124, 0, 60, 102, 96, 96, 96, 102, 60, 0, 120, 108, 102, 102, 102, 108, 120,
+    0, 126, 96, 96, 120, 96, 96, 126, 132, 8, 0, 11, 96, 0, 60, 102, 96, 110, 102, 102,
+    60, 0, 102, 102, 131, 56, 0, 24, 60, 24, 24, 24, 24, 24, 60, 0, 30, 12, 12, 12,
+    12, 108, 56, 0, 102, 108, 120, 112, 120, 108, 102, 0, 96, 130, 1, 0, 14, 126, 0, 99,
+    119, 127, 107, 99, 99, 99, 0, 102, 118, 126, 126, 110, 129, 48, 0, 128, 53, 0, 128, 64,
+    0, 130, 112, 0, 130, 80, 0, 130, 15, 0, 0, 14, 130, 16, 0, 129, 56, 0, 8, 60,
+    102, 96, 60, 6, 102, 60, 0, 126, 130, 88, 0, 2, 24, 0, 102, 132, 48, 0, 131, 7,
+    0, 9, 24, 0, 99, 99, 99, 107, 127, 119, 99, 0, 129, 13, 0, 128, 60, 0, 129, 24,
+    0, 129, 131, 0, 35, 0, 126, 6, 12, 24, 48, 96, 126, 0, 60, 48, 48, 48, 48, 48,
+    60, 0, 12, 18, 48, 124, 48, 98, 252, 0, 60, 12, 12, 12, 12, 12, 60, 0, 0, 24,
+    60, 130, 83, 0, 7, 0, 16, 48, 127, 127, 48, 16, 0, 133, 1, 0, 130, 20, 0, 0,
+    0, 130, 104, 0, 130, 16, 0, 34, 102, 102, 255, 102, 255, 102, 102, 0, 24, 62, 96, 60,
+    6, 124, 24, 0, 98, 102, 12, 24, 48, 102, 70, 0, 60, 102, 60, 56, 103, 102, 63, 0,
+    6, 12, 24, 130, 40, 0, 21, 12, 24, 48, 48, 48, 24, 12, 0, 48, 24, 12, 12, 12,
+    24, 48, 0, 0, 102, 60, 255, 60, 102, 130, 81, 0, 128, 104, 0, 134, 93, 0, 4, 48,
+    0, 0, 0, 126, 136, 109, 0, 2, 0, 0, 3, 130, 169, 0, 83, 0, 64, 252, 64, 124,
+    230, 194, 198, 112, 124, 0, 124, 14, 6, 14, 124, 0, 12, 24, 48, 112, 96, 48, 24, 12,
+    24, 62, 108, 12, 24, 60, 103, 195, 255, 24, 24, 126, 24, 60, 102, 195, 32, 56, 32, 104,
+    71, 208, 143, 128, 64, 224, 76, 82, 97, 193, 66, 76, 12, 28, 56, 112, 254, 195, 129, 129,
+    64, 255, 64, 124, 102, 2, 134, 124, 68, 119, 68, 68, 68, 100, 70, 129, 0, 0, 24, 130,
+    3, 0, 131, 8, 0, 8, 24, 48, 14, 24, 48, 96, 48, 24, 14, 129, 127, 0, 130, 129,
+    0, 12, 112, 24, 12, 6, 12, 24, 112, 0, 60, 102, 6, 12, 24, 131, 41, 0, 13, 255,
+    255, 0, 0, 0, 8, 28, 62, 127, 127, 28, 62, 0, 24, 132, 1, 0, 132, 24, 0, 141,
+    7, 0, 134, 11, 0, 0, 48, 132, 1, 0, 0, 12, 132, 1, 0, 12, 0, 0, 0, 224,
+    240, 56, 24, 24, 24, 24, 28, 15, 7, 130, 227, 0, 6, 56, 240, 224, 0, 0, 0, 192,
+    130, 1, 0, 19, 255, 255, 192, 224, 112, 56, 28, 14, 7, 3, 3, 7, 14, 28, 56, 112,
+    224, 192, 255, 255, 133, 26, 0, 0, 3, 130, 1, 0, 6, 0, 60, 126, 126, 126, 126, 60,
+    134, 97, 0, 6, 54, 127, 127, 127, 62, 28, 8, 132, 64, 2, 34, 96, 96, 0, 0, 0,
+    7, 15, 28, 24, 24, 195, 231, 126, 60, 60, 126, 231, 195, 0, 60, 126, 102, 102, 126, 60,
+    0, 24, 24, 102, 102, 24, 24, 60, 0, 6, 132, 1, 0, 128, 200, 0, 130, 56, 0, 11,
+    24, 24, 24, 255, 255, 24, 24, 24, 192, 192, 48, 48, 129, 4, 0, 135, 216, 0, 13, 3,
+    62, 118, 54, 54, 0, 255, 127, 63, 31, 15, 7, 3, 1, 133, 212, 0, 0, 240, 132, 1,
+    0, 131, 127, 0, 3, 255, 255, 255, 0, 138, 1, 0, 132, 174, 0, 10, 192, 192, 204, 204,
+    51, 51, 204, 204, 51, 51, 3, 132, 1, 0, 129, 29, 0, 129, 16, 0, 7, 255, 254, 252,
+    248, 240, 224, 192, 128, 133, 24, 0, 4, 24, 24, 24, 31, 31, 131, 72, 1, 4, 0, 15,
+    15, 15, 15, 130, 16, 0, 131, 76, 0, 1, 248, 248, 129, 24, 0, 135, 85, 1, 130, 40,
+    0, 130, 176, 0, 133, 21, 0, 131, 16, 0, 130, 40, 0, 133, 120, 0, 0, 224, 132, 1,
+    0, 0, 7, 132, 1, 0, 135, 45, 0, 0, 255, 136, 166, 0, 133, 78, 1, 1, 255, 255,
+    133, 212, 0, 129, 124, 0, 129, 224, 2, 130, 80, 0, 132, 20, 0, 137, 28, 0, 46, 195,
+    153, 145, 145, 159, 153, 195, 255, 231, 195, 153, 129, 153, 153, 153, 255, 131, 153, 153, 131, 153,
+    153, 131, 255, 195, 153, 159, 159, 159, 153, 195, 255, 135, 147, 153, 153, 153, 147, 135, 255, 129,
+    159, 159, 135, 159, 159, 129, 132, 8, 0, 11, 159, 255, 195, 153, 159, 145, 153, 153, 195, 255,
+    153, 153, 131, 56, 0, 24, 195, 231, 231, 231, 231, 231, 195, 255, 225, 243, 243, 243, 243, 147,
+    199, 255, 153, 147, 135, 143, 135, 147, 153, 255, 159, 130, 1, 0, 14, 129, 255, 156, 136, 128,
+    148, 156, 156, 156, 255, 153, 137, 129, 129, 145, 129, 48, 0, 128, 53, 0, 128, 64, 0, 130,
+    112, 0, 130, 80, 0, 130, 15, 0, 0, 241, 130, 16, 0, 129, 56, 0, 8, 195, 153, 159,
+    195, 249, 153, 195, 255, 129, 130, 88, 0, 2, 231, 255, 153, 132, 48, 0, 131, 7, 0, 9,
+    231, 255, 156, 156, 156, 148, 128, 136, 156, 255, 129, 13, 0, 128, 60, 0, 129, 24, 0, 129,
+    131, 0, 35, 255, 129, 249, 243, 231, 207, 159, 129, 255, 195, 207, 207, 207, 207, 207, 195, 255,
+    243, 237, 207, 131, 207, 157, 3, 255, 195, 243, 243, 243, 243, 243, 195, 255, 255, 231, 195, 130,
+    83, 0, 7, 255, 239, 207, 128, 128, 207, 239, 255, 133, 1, 0, 130, 20, 0, 0, 255, 130,
+    104, 0, 130, 16, 0, 34, 153, 153, 0, 153, 0, 153, 153, 255, 231, 193, 159, 195, 249, 131,
+    231, 255, 157, 153, 243, 231, 207, 153, 185, 255, 195, 153, 195, 199, 152, 153, 192, 255, 249, 243,
+    231, 130, 40, 0, 21, 243, 231, 207, 207, 207, 231, 243, 255, 207, 231, 243, 243, 243, 231, 207,
+    255, 255, 153, 195, 0, 195, 153, 130, 81, 0, 128, 104, 0, 134, 93, 0, 4, 207, 255, 255,
+    255, 129, 136, 109, 0, 2, 255, 255, 252, 130, 169, 0, 20, 255, 195, 153, 145, 137, 153, 153,
+    195, 255, 231, 231, 199, 231, 231, 231, 129, 255, 195, 153, 249, 243, 130, 192, 0, 33, 153, 249,
+    227, 249, 153, 195, 255, 249, 241, 225, 153, 128, 249, 249, 255, 129, 159, 131, 249, 249, 153, 195,
+    255, 195, 153, 159, 131, 153, 153, 195, 255, 129, 153, 243, 129, 179, 0, 129, 56, 1, 129, 3,
+    0, 129, 8, 0, 6, 193, 249, 153, 195, 255, 255, 255, 130, 199, 0, 132, 8, 0, 8, 231,
+    207, 241, 231, 207, 159, 207, 231, 241, 129, 127, 0, 130, 129, 0, 6, 143, 231, 243, 249, 243,
+    231, 143, 130, 104, 0, 0, 231, 131, 41, 0, 130, 56, 2, 8, 247, 227, 193, 128, 128, 227,
+    193, 255, 231, 132, 1, 0, 132, 24, 0, 141, 7, 0, 134, 11, 0, 0, 207, 132, 1, 0,
+    0, 243, 132, 1, 0, 12, 255, 255, 255, 31, 15, 199, 231, 231, 231, 231, 227, 240, 248, 130,
+    227, 0, 6, 199, 15, 31, 255, 255, 255, 63, 130, 1, 0, 19, 0, 0, 63, 31, 143, 199,
+    227, 241, 248, 252, 252, 248, 241, 227, 199, 143, 31, 63, 0, 0, 133, 26, 0, 0, 252, 130,
+    1, 0, 6, 255, 195, 129, 129, 129, 129, 195, 134, 97, 0, 6, 201, 128, 128, 128, 193, 227,
+    247, 132, 64, 2, 34, 159, 159, 255, 255, 255, 248, 240, 227, 231, 231, 60, 24, 129, 195, 195,
+    129, 24, 60, 255, 195, 129, 153, 153, 129, 195, 255, 231, 231, 153, 153, 231, 231, 195, 255, 249,
+    132, 1, 0, 128, 200, 0, 130, 56, 0, 11, 231, 231, 231, 0, 0, 231, 231, 231, 63, 63,
+    207, 207, 129, 4, 0, 135, 216, 0, 13, 252, 193, 137, 201, 201, 255, 0, 128, 192, 224, 240,
+    248, 252, 254, 133, 212, 0, 0, 15, 132, 1, 0, 134, 251, 3, 0, 255, 138, 1, 0, 1,
+    0, 63, 132, 1, 0, 131, 254, 3, 2, 204, 204, 252, 132, 1, 0, 129, 29, 0, 129, 16,
+    0, 7, 0, 1, 3, 7, 15, 31, 63, 127, 133, 24, 0, 5, 231, 231, 231, 224, 224, 231,
+    131, 2, 2, 129, 108, 3, 130, 16, 0, 131, 76, 0, 1, 7, 7, 129, 24, 0, 135, 85,
+    1, 130, 40, 0, 130, 176, 0, 133, 21, 0, 131, 16, 0, 130, 40, 0, 133, 120, 0, 0,
+    31, 132, 1, 0, 0, 248, 132, 1, 0, 135, 45, 0, 0, 0, 136, 166, 0, 133, 78, 1,
+    1, 0, 0, 133, 212, 0, 129, 124, 0, 129, 224, 2, 130, 80, 0, 132, 20, 0, 137, 28,
+    0, 255
+};
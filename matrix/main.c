@@ -4,6 +4,7 @@
  * 
  * This program creates a "Matrix" style digital rain effect on the Commodore 64.
  * Optimized for performance using direct memory pointers and pre-calculated buffers.
+ * The rain itself runs in rain.s, which keeps per-column pointers between frames.
  */
 #include <stdlib.h>
 #include <string.h>
@@ -42,38 +43,29 @@
 #define PEEK(addr)      (*(unsigned char*)(addr))
 #endif
 
-/* Kanji charset for matrix characters */
-#include "kanji-charset.h"
+/* Kanji charset for matrix characters, packed from kanji-charset.h */
+#include "kanji_z.h"
+#include "unpack.h"
 
-/* Column state for rain effect */
-static unsigned char col_active[SCREEN_WIDTH];
-static unsigned char col_pos[SCREEN_WIDTH];
-static unsigned char col_len[SCREEN_WIDTH];
+/* Rain engine (rain.s): per-column drop state, colour-RAM-only trails */
+#define RAIN_GLYPHS 64
+#define RAIN_FADE   4
+extern unsigned char rain_glyph[RAIN_GLYPHS];  /* screen codes to draw */
+extern unsigned char rain_fade[RAIN_FADE];     /* head, -1, -2, -4 rows */
+extern unsigned char rain_bg;                  /* colour behind the tail */
+extern unsigned char rain_seed;                /* LFSR state, not 0 */
+extern unsigned char rain_density;             /* spawn above this */
+extern unsigned char rain_max;                 /* drops at once */
+extern unsigned char rain_len_min;             /* trail length = min + */
+extern unsigned char rain_len_mask;            /*   (random & mask) */
+extern void rain_init(void);
+extern void rain_step(void);
 
 /* Original VIC memory setup value (saved at startup) */
 static unsigned char original_memsetup;
 
 /* Adjustable effect parameters */
 static unsigned char speed;      /* 1=fast, 5=slow */
-static unsigned char density;    /* threshold: higher = more sparse */
-
-/* Pre-calculated random buffer for speed */
-#define RAND_BUFFER_SIZE 256
-static unsigned char rand_buffer[RAND_BUFFER_SIZE];
-static unsigned char rand_idx = 0;
-
-/* Fast pseudo-random using pre-filled buffer */
-static unsigned char fast_rand(void) {
-    return rand_buffer[++rand_idx];
-}
-
-/* Fill random buffer once */
-static void init_rand_buffer(void) {
-    unsigned int i;
-    for (i = 0; i < RAND_BUFFER_SIZE; ++i) {
-        rand_buffer[i] = (unsigned char)rand();
-    }
-}
 
 /* Fast screen clear using memset */
 static void clear_screen(void) {
@@ -99,168 +91,39 @@ static void wait_frame(void) {
 }
 
 /**
- * Matrix Effect 1 - Single column rain
- * Optimized with direct pointers and fast_rand
- * Enhanced with glow effect and character mutation
+ * Set up the rain engine: glyphs are first..first+count-1, repeated
+ * to fill the table so the engine can pick one with a mask
  */
-void matrix1(void) {
-    unsigned char col, row, k;
-    unsigned int offset;
-    unsigned char counter = 0;
-    unsigned char *scr, *clr;
-    
-    init_vic();
-    clear_screen();
-    init_rand_buffer();
+static void init_rain(unsigned char first, unsigned char count) {
+    unsigned char i;
     
-    /* Adjustable parameters */
-    speed = 1;
-    density = 230;  /* Not used much in this mode */
-    
-    for (;;) {
-        /* Pick random column */
-        col = fast_rand() % SCREEN_WIDTH;
-        
-        for (row = 0; row < SCREEN_HEIGHT; ++row) {
-            offset = (unsigned int)row * SCREEN_WIDTH + col;
-            scr = SCREEN_RAM + offset;
-            clr = COLOR_RAM + offset;
-            
-            /* Random chance to stop */
-            if ((fast_rand() & 7) == 0) {
-                *clr = COL_WHITE;  /* Flash white before stopping */
-                break;
-            }
-            
-            /* Draw character - bright white head */
-            *scr = (fast_rand() % 64) + 64;
-            *clr = COL_WHITE;
-            
-            /* Fade previous positions - gradient effect */
-            if (row > 0) {
-                *(clr - SCREEN_WIDTH) = COL_LGREEN;
-                /* Mutate character in trail */
-                if ((fast_rand() & 3) == 0) {
-                    *(scr - SCREEN_WIDTH) = (fast_rand() % 64) + 64;
-                }
-            }
-            if (row > 1) {
-                *(clr - SCREEN_WIDTH * 2) = COL_GREEN;
-            }
-            if (row > 3) {
-                *(clr - SCREEN_WIDTH * 4) = COL_DGREEN;
-            }
-            
-            /* Wait based on speed setting */
-            for (k = 0; k < speed; ++k) {
-                wait_frame();
-            }
-            
-            /* Check keyboard for controls */
-            if (kbhit()) {
-                char key = cgetc();
-                switch (key) {
-                    case '+':
-                        if (speed > 1) speed--;
-                        break;
-                    case '-':
-                        if (speed < 5) speed++;
-                        break;
-                    case ' ':
-                    case 'q':
-                    case 'Q':
-                        return;
-                }
-            }
-        }
-        
-        /* Periodic clear */
-        if (++counter > 32) {
-            clear_screen();
-            counter = 0;
-        }
+    for (i = 0; i < RAIN_GLYPHS; ++i) {
+        rain_glyph[i] = first + i % count;
     }
+    rain_fade[0] = COL_WHITE;    /* Head glows */
+    rain_fade[1] = COL_LGREEN;
+    rain_fade[2] = COL_GREEN;
+    rain_fade[3] = COL_DGREEN;
+    rain_bg = COL_BLACK;
+    rain_seed = (unsigned char)rand() | 1;
+    rain_max = SCREEN_WIDTH;
+    
+    /* Trails fade to the background colour, so the screen stays clear */
+    clear_screen();
+    fill_color(COL_BLACK);
+    rain_init();
 }
 
 /**
- * Matrix Effect 2 - Multiple simultaneous columns
- * Optimized with state arrays and batch updates
- * Enhanced with glow gradient and character mutation
+ * Run the rain until Q or SPACE. With density_keys, 1-9 set the density
  */
-void matrix2(void) {
+static void run_rain(unsigned char density_keys) {
     unsigned char k;
-    unsigned int offset;
-    unsigned char *scr, *clr;
     
-    init_vic();
-    clear_screen();
-    init_rand_buffer();
-    
-    /* Initialize column states */
-    memset(col_active, 0, SCREEN_WIDTH);
-    memset(col_pos, 0, SCREEN_WIDTH);
-    
-    /* Adjustable parameters */
     speed = 1;
-    density = 240;
     
     for (;;) {
-        /* Activate random columns based on density */
-        for (k = 0; k < SCREEN_WIDTH; ++k) {
-            if (!col_active[k] && (fast_rand() > density)) {
-                col_active[k] = 1;
-                col_pos[k] = 0;
-                col_len[k] = (fast_rand() % 15) + 5;  /* Random length 5-20 */
-            }
-        }
-        
-        /* Update active columns */
-        for (k = 0; k < SCREEN_WIDTH; ++k) {
-            if (col_active[k]) {
-                /* Only draw if within screen bounds */
-                if (col_pos[k] < SCREEN_HEIGHT) {
-                    offset = (unsigned int)col_pos[k] * SCREEN_WIDTH + k;
-                    scr = SCREEN_RAM + offset;
-                    clr = COLOR_RAM + offset;
-                    
-                    /* Draw current position - WHITE head for glow */
-                    *scr = (fast_rand() % 64) + 64;
-                    *clr = COL_WHITE;
-                    
-                    /* Gradient fade for trail */
-                    if (col_pos[k] > 0) {
-                        *(clr - SCREEN_WIDTH) = COL_LGREEN;
-                        /* Random character mutation in trail */
-                        if ((fast_rand() & 7) == 0) {
-                            *(scr - SCREEN_WIDTH) = (fast_rand() % 64) + 64;
-                        }
-                    }
-                    if (col_pos[k] > 1) {
-                        *(clr - SCREEN_WIDTH * 2) = COL_GREEN;
-                    }
-                    if (col_pos[k] > 3) {
-                        *(clr - SCREEN_WIDTH * 4) = COL_DGREEN;
-                    }
-                }
-                
-                /* Erase tail - only if within screen */
-                if (col_pos[k] >= col_len[k]) {
-                    unsigned char tail_pos = col_pos[k] - col_len[k];
-                    if (tail_pos < SCREEN_HEIGHT) {
-                        offset = (unsigned int)tail_pos * SCREEN_WIDTH + k;
-                        *(SCREEN_RAM + offset) = 32;
-                    }
-                }
-                
-                /* Move down */
-                col_pos[k]++;
-                
-                /* Deactivate when fully off screen */
-                if (col_pos[k] >= SCREEN_HEIGHT + col_len[k]) {
-                    col_active[k] = 0;
-                }
-            }
-        }
+        rain_step();
         
         /* Wait based on speed setting */
         for (k = 0; k < speed; ++k) {
@@ -271,17 +134,20 @@ void matrix2(void) {
         if (kbhit()) {
             char key = cgetc();
             switch (key) {
-                case '+':
+                case '+':  /* Faster */
                     if (speed > 1) speed--;
                     break;
-                case '-':
+                case '-':  /* Slower */
                     if (speed < 5) speed++;
                     break;
                 case '1': case '2': case '3': case '4': case '5':
                 case '6': case '7': case '8': case '9':
-                    density = 255 - ((key - '1') * 25);
+                    /* Density: 1=sparse, 9=dense */
+                    if (density_keys) {
+                        rain_density = 255 - ((key - '1') * 25);
+                    }
                     break;
-                case ' ':
+                case ' ':  /* Exit */
                 case 'q':
                 case 'Q':
                     return;
@@ -290,26 +156,49 @@ void matrix2(void) {
     }
 }
 
+/**
+ * Matrix Effect 1 - Single column rain
+ * One drop at a time; its trail fades out in colour RAM, so the
+ * screen no longer needs a periodic clear
+ */
+void matrix1(void) {
+    init_vic();
+    init_rain(64, 64);
+    
+    rain_max = 1;
+    rain_density = 0;
+    rain_len_min = 4;
+    rain_len_mask = 15;     /* Random length 4-19 */
+    
+    run_rain(0);
+}
+
+/**
+ * Matrix Effect 2 - Multiple simultaneous columns
+ * Every column can run a drop each frame
+ */
+void matrix2(void) {
+    init_vic();
+    init_rain(64, 64);
+    
+    rain_density = 240;
+    rain_len_min = 5;
+    rain_len_mask = 15;     /* Random length 5-20 */
+    
+    run_rain(1);
+}
+
 /**
  * Matrix Effect 3 - Kanji characters with custom charset
  * Uses charset at $2000 (8192)
  */
 void matrix3(void) {
-    unsigned char k;
-    unsigned int i, offset;
-    unsigned char *scr, *clr;
     unsigned char *custom_charset = (unsigned char*)0x2000;
-    unsigned char old_memsetup;
     
     init_vic();
     
-    /* Save current VIC memory setup */
-    old_memsetup = PEEK(VIC_MEMSETUP);
-    
-    /* Load full kanji charset (256 chars * 8 bytes = 2048 bytes) to $2000 */
-    for (i = 0; i < 2048; ++i) {
-        custom_charset[i] = charmap[i];
-    }
+    /* Unpack full kanji charset (256 chars * 8 bytes = 2048 bytes) to $2000 */
+    unpack(custom_charset, kanji_z);
     
     /* 
      * Set VIC to use charset at $2000:
@@ -319,103 +208,16 @@ void matrix3(void) {
      */
     POKE(VIC_MEMSETUP, (PEEK(VIC_MEMSETUP) & 0xF0) | 0x08);
     
-    clear_screen();
-    fill_color(COL_GREEN);
-    init_rand_buffer();
+    init_rain(48, 10);      /* Kanji glyphs live at codes 48-57 */
     
-    /* Initialize column states */
-    memset(col_active, 0, SCREEN_WIDTH);
-    memset(col_pos, 0, SCREEN_WIDTH);
+    rain_density = 200;     /* threshold: lower = more dense */
+    rain_len_min = 4;
+    rain_len_mask = 15;     /* Random length 4-19 */
     
-    /* Adjustable parameters */
-    speed = 1;           /* 1=fast, 2=medium, 3=slow */
-    density = 200;       /* threshold: lower = more dense */
+    run_rain(1);
     
-    for (;;) {
-        /* Activate random columns based on density */
-        for (k = 0; k < SCREEN_WIDTH; ++k) {
-            if (!col_active[k] && (fast_rand() > density)) {
-                col_active[k] = 1;
-                col_pos[k] = 0;
-                col_len[k] = (fast_rand() % 12) + 4;
-            }
-        }
-        
-        /* Update active columns */
-        for (k = 0; k < SCREEN_WIDTH; ++k) {
-            if (col_active[k]) {
-                /* Only draw if within screen bounds */
-                if (col_pos[k] < SCREEN_HEIGHT) {
-                    offset = (unsigned int)col_pos[k] * SCREEN_WIDTH + k;
-                    scr = SCREEN_RAM + offset;
-                    clr = COLOR_RAM + offset;
-                    
-                    /* Draw kanji character - WHITE head for glow */
-                    *scr = (fast_rand() % 10) + 48;
-                    *clr = COL_WHITE;
-                    
-                    /* Gradient fade for trail */
-                    if (col_pos[k] > 0) {
-                        *(clr - SCREEN_WIDTH) = COL_LGREEN;
-                        /* Mutate kanji in trail */
-                        if ((fast_rand() & 7) == 0) {
-                            *(scr - SCREEN_WIDTH) = (fast_rand() % 10) + 48;
-                        }
-                    }
-                    if (col_pos[k] > 1) {
-                        *(clr - SCREEN_WIDTH * 2) = COL_GREEN;
-                    }
-                    if (col_pos[k] > 3) {
-                        *(clr - SCREEN_WIDTH * 4) = COL_DGREEN;
-                    }
-                }
-                
-                /* Erase tail - only if within screen */
-                if (col_pos[k] >= col_len[k]) {
-                    unsigned char tail_pos = col_pos[k] - col_len[k];
-                    if (tail_pos < SCREEN_HEIGHT) {
-                        offset = (unsigned int)tail_pos * SCREEN_WIDTH + k;
-                        *(SCREEN_RAM + offset) = 32;
-                    }
-                }
-                
-                col_pos[k]++;
-                
-                if (col_pos[k] >= SCREEN_HEIGHT + col_len[k]) {
-                    col_active[k] = 0;
-                }
-            }
-        }
-        
-        /* Wait based on speed setting */
-        for (k = 0; k < speed; ++k) {
-            wait_frame();
-        }
-        
-        /* Check keyboard for controls */
-        if (kbhit()) {
-            char key = cgetc();
-            switch (key) {
-                case '+':  /* Faster */
-                    if (speed > 1) speed--;
-                    break;
-                case '-':  /* Slower */
-                    if (speed < 5) speed++;
-                    break;
-                case '1': case '2': case '3': case '4': case '5':
-                case '6': case '7': case '8': case '9':
-                    /* Density: 1=sparse, 9=dense */
-                    density = 255 - ((key - '1') * 25);
-                    break;
-                case ' ':  /* Exit */
-                case 'q':
-                case 'Q':
-                    /* Restore default charset (screen $0400, charset ROM) */
-                    POKE(VIC_MEMSETUP, 0x15);
-                    return;
-            }
-        }
-    }
+    /* Restore default charset (screen $0400, charset ROM) */
+    POKE(VIC_MEMSETUP, 0x15);
 }
 
 /**
@@ -0,0 +1,236 @@
+; rain.s - column-state matrix rain engine for cc65/ca65
+;
+; C entry points:
+;   void rain_init(void);
+;   void rain_step(void);
+;
+; Every column keeps its drop between frames: the head row, a screen
+; pointer LEAD rows above the head and a colour RAM pointer at the tail.
+; A step adds 40 to both pointers, so no row * 40 is computed. The head
+; gets a new glyph and the trail ages in colour RAM only: the cells
+; behind the head are recoloured from rain_fade[] and the tail cell is
+; set to rain_bg. Glyphs behind the tail stay in screen RAM, invisible,
+; until the next drop overwrites them, so the screen is never cleared.
+;
+; Glyphs come from rain_glyph[] indexed by an 8-bit LFSR, so there is
+; no modulo. All 40 columns are updated in one call, well inside a frame.
+; The scan starts at a random column and wraps, so with rain_max below
+; 40 the free drops do not always go to the first idle column found.
+
+.export _rain_init, _rain_step
+.export _rain_glyph, _rain_fade, _rain_bg, _rain_seed
+.export _rain_density, _rain_max, _rain_len_min, _rain_len_mask
+.importzp ptr1, ptr2, ptr3
+
+SCR_W     = 40
+SCR_H     = 25
+SCREEN    = $0400
+COLRAM    = $D800
+COL_DELTA = >(COLRAM - SCREEN)  ; colour pointer high byte offset
+
+LEAD      = 4                   ; head is LEAD rows below the drop pointer
+GLYPHS    = 64
+RAIN_FADE = 4                   ; colours at 0, 1, 2 and 4 rows behind
+
+.segment "DATA"
+
+_rain_seed:     .byte 1         ; LFSR state, never 0
+
+.segment "BSS"
+
+_rain_glyph:    .res GLYPHS     ; screen codes to draw
+_rain_fade:     .res RAIN_FADE  ; head, then trail colours
+_rain_bg:       .res 1          ; colour behind the tail
+_rain_density:  .res 1          ; spawn when random byte is above this
+_rain_max:      .res 1          ; most drops falling at once
+_rain_len_min:  .res 1          ; trail length = min + (random & mask)
+_rain_len_mask: .res 1
+
+c_on:   .res SCR_W              ; drop falling in this column
+c_row:  .res SCR_W              ; head row, may be below the screen
+c_len:  .res SCR_W
+c_lo:   .res SCR_W              ; screen address of row (head - LEAD)
+c_hi:   .res SCR_W
+t_lo:   .res SCR_W              ; colour RAM address of the tail
+t_hi:   .res SCR_W
+count:  .res 1
+start:  .res 1                  ; column this step's scan began at
+
+.segment "CODE"
+
+; Recolour the cell dist rows behind the head, if it is on screen
+; (anonymous label, so the @locals of the caller stay in scope)
+.macro FADE dist, colour
+    lda c_row, x
+    sec
+    sbc #dist
+    cmp #SCR_H                  ; negative rows wrap high
+    bcs :+
+    ldy #(LEAD - dist) * SCR_W
+    lda colour
+    sta (ptr2), y
+:
+.endmacro
+
+; 8-bit Galois LFSR, period 255; keeps X
+rnd:
+    lda _rain_seed
+    asl
+    bcc @done
+    eor #$1D
+@done:
+    sta _rain_seed
+    rts
+
+_rain_init:
+    lda #0
+    sta count
+    ldx #SCR_W - 1
+@clear:
+    sta c_on, x
+    dex
+    bpl @clear
+    lda _rain_seed
+    bne @seeded
+    inc _rain_seed
+@seeded:
+    rts
+
+; Start a drop at the top of column X
+spawn:
+    lda #1
+    sta c_on, x
+    inc count
+    lda #0
+    sta c_row, x
+    jsr rnd
+    and _rain_len_mask
+    clc
+    adc _rain_len_min
+    sta c_len, x
+    txa
+    clc
+    adc #<(SCREEN - LEAD * SCR_W)
+    sta c_lo, x
+    lda #>(SCREEN - LEAD * SCR_W)
+    adc #0
+    sta c_hi, x
+    txa
+    clc
+    adc #<COLRAM
+    sta t_lo, x
+    lda #>COLRAM
+    adc #0
+    sta t_hi, x
+    rts
+
+_rain_step:
+    jsr rnd                     ; random start column, 0-39
+    and #63
+    cmp #SCR_W
+    bcs _rain_step
+    sta start
+    tax
+@column:
+    lda c_on, x
+    bne @live
+    lda count
+    cmp _rain_max
+    bcs @idle
+    jsr rnd
+    cmp _rain_density
+    beq @idle
+    bcs @spawn
+@idle:
+    jmp @next
+@spawn:
+    jsr spawn
+
+@live:
+    lda c_lo, x
+    sta ptr1
+    sta ptr2
+    lda c_hi, x
+    sta ptr1 + 1
+    clc
+    adc #COL_DELTA
+    sta ptr2 + 1
+
+    lda c_row, x                ; head: new glyph
+    cmp #SCR_H
+    bcs @trail
+    jsr rnd
+    and #GLYPHS - 1
+    tay
+    lda _rain_glyph, y
+    ldy #LEAD * SCR_W
+    sta (ptr1), y
+    lda _rain_fade
+    sta (ptr2), y
+
+@trail:
+    lda c_row, x                ; one behind: fade and sometimes mutate
+    sec
+    sbc #1
+    cmp #SCR_H
+    bcs @fade
+    ldy #(LEAD - 1) * SCR_W
+    lda _rain_fade + 1
+    sta (ptr2), y
+    jsr rnd
+    and #7
+    bne @fade
+    jsr rnd
+    and #GLYPHS - 1
+    tay
+    lda _rain_glyph, y
+    ldy #(LEAD - 1) * SCR_W
+    sta (ptr1), y
+@fade:
+    FADE 2, _rain_fade + 2
+    FADE LEAD, _rain_fade + 3
+
+    lda c_row, x                ; tail: back to the background colour
+    cmp c_len, x
+    bcc @advance
+    lda t_lo, x
+    sta ptr3
+    lda t_hi, x
+    sta ptr3 + 1
+    ldy #0
+    lda _rain_bg
+    sta (ptr3), y
+    lda t_lo, x
+    clc
+    adc #SCR_W
+    sta t_lo, x
+    bcc @advance
+    inc t_hi, x
+
+@advance:
+    lda c_lo, x
+    clc
+    adc #SCR_W
+    sta c_lo, x
+    bcc @row
+    inc c_hi, x
+@row:
+    inc c_row, x
+    lda c_len, x                ; gone once the tail leaves the screen
+    clc
+    adc #SCR_H
+    cmp c_row, x
+    bne @next
+    lda #0
+    sta c_on, x
+    dec count
+@next:
+    dex
+    bpl @wrap
+    ldx #SCR_W - 1
+@wrap:
+    cpx start
+    beq @done
+    jmp @column
+@done:
+    rts
@@ -0,0 +1,502 @@
+#!/usr/bin/env python3
+"""
+memmap.py - Memory-map budget analyzer for the C64 projects
+
+Puts what the linker placed (segments from the ld65 map file) next to
+what the game writes at fixed addresses at run time (sprite data,
+charsets, screens, tables: REGIONS below) and what the machine keeps
+for itself (CPU stack, KERNAL work area, I/O, the C stack, the replay
+log), and reports:
+
+    overlaps     code/data/BSS running into a runtime region, or two
+                 regions on top of each other
+    VIC problems a screen, charset, bitmap or sprite outside the VIC
+                 bank in use, on the character ROM shadow ($1000-$1FFF
+                 and $9000-$9FFF in banks 0 and 2), or misaligned
+    budget       per linker memory area: bytes used and how many more
+                 the code can grow before it hits something
+    free gaps    RAM nobody uses, for new assets
+
+With --suggest it also packs the movable VIC regions (charsets, sprites,
+bitmaps) at the top of the VIC bank, which leaves the code the longest
+run upward from $0801, and prints the new addresses.
+
+Region addresses are read from the sources by macro name (#define
+SPRITE_DATA 0x3000, SPRITE_BASE = $2000), so the table only carries
+what the source does not say: sizes and kinds. Without a map file (not
+built since the build scripts write one) the .prg image is used, with
+long runs of zero fill left out, and BSS is unknown.
+
+build_all.py runs the overlap checks after every link.
+
+Usage:
+    python3 memmap.py                   # Every project
+    python3 memmap.py meteor dreadline  # Some
+    python3 memmap.py -q                # Problems and budgets only
+    python3 memmap.py pong --suggest    # Packed layout proposal
+
+Author: C64AIToolChain Project
+"""
+
+import argparse
+import re
+import sys
+from pathlib import Path
+
+from build_all import ROOT, all_projects, read_recipe
+from symbols import SymbolDB
+
+# =============================================================================
+# REGIONS - What each game writes at fixed addresses at run time
+# =============================================================================
+#
+#   (kind, where)          where: source macro or address
+#   (kind, where, size)    size in bytes (default from KIND_SIZE)
+#
+# Kinds the VIC-II reads (screen, charset, bitmap, sprites) must sit in
+# the game's VIC bank, which is the bank of its screen.
+
+KIND_SIZE = {'screen': 0x400, 'charset': 0x800, 'bitmap': 0x2000,
+             'sprites': 64}
+KIND_ALIGN = {'screen': 0x400, 'charset': 0x800, 'bitmap': 0x2000,
+              'sprites': 64, 'data': 1}
+VIC_KINDS = ('screen', 'charset', 'bitmap', 'sprites')
+MOVABLE = ('charset', 'bitmap', 'sprites')   # the text screen stays put
+
+TEXT_SCREEN = ('screen', 0x0400)
+
+REGIONS = {
+    'arkanoid':         [TEXT_SCREEN, ('sprites', 'SPRITE_DATA', 2 * 64)],
+    'bounce':           [TEXT_SCREEN, ('sprites', 'SPRITE_DATA', 1 * 64)],
+    'breakout':         [TEXT_SCREEN, ('sprites', 'SPRITE_DATA', 2 * 64)],
+    'christmas':        [TEXT_SCREEN, ('charset', 0x3000)],
+    'dreadline':        [('screen', 'SCREEN'), ('charset', 'CHARSET_RAM'),
+                         ('sprites', 'SPRITE_DATA', 9 * 64)],
+    'fire':             [('screen', 'SCREEN')],
+    # chars 0-231 only: the frog sprite sits on chars 232-239
+    'frogger':          [('screen', 'SCREEN'), ('charset', 'CHARSET', 232 * 8),
+                         ('sprites', 'SPRITE_DATA', 1 * 64)],
+    'invaders':         [('screen', 'SCREEN'), ('sprites', 'SPRITE_DATA', 4 * 64),
+                         ('charset', 'CHARSET_RAM')],
+    # matrix3 unpacks its kanji charset to $2000
+    'matrix':           [('screen', 'SCREEN_RAM'), ('charset', 'CHARSET_RAM'),
+                         ('charset', 0x2000)],
+    'meteor':           [('screen', 'SCREEN'), ('sprites', 'SPRITE_DATA', 4 * 64),
+                         ('charset', 'CHARSET_RAM')],
+    'newyear':          [TEXT_SCREEN],
+    'newyear_petascii': [TEXT_SCREEN],
+    'pacman':           [('screen', 'SCREEN_RAM'), ('sprites', 'SPRITE_BASE', 7 * 64)],
+    'pacman_c':         [TEXT_SCREEN, ('sprites', 'SPRITE_DATA', 6 * 64)],
+    'plasma':           [('screen', 'SCREEN')],
+    'pong':             [TEXT_SCREEN, ('sprites', 'SPRITE_DATA', 2 * 64)],
+    'rasterbars':       [('screen', 'SCREEN')],
+    'scroller':         [('screen', 'SCREEN')],
+    'sky_miner':        [('screen', 'SCREEN'), ('sprites', 'SPRITE_DATA', 4 * 64)],
+    'snake':            [('screen', 'SCREEN_RAM')],
+    'snake2':           [('screen', 'SCREEN_RAM'), ('sprites', 'SPRITE_BASE', 3 * 64)],
+    # PROJ: STAR_Z (64) projection rows of 128 bytes
+    'starfield':        [('screen', 'SCREEN'), ('charset', 'CHARSET_RAM'),
+                         ('data', 'PROJ', 64 * 128)],
+    'tetris_v1':        [('screen', 'SCREEN_RAM')],
+    'tetris_v2':        [('screen', 'SCREEN_RAM')],
+}
+
+# Always taken, whatever the game
+SYSTEM = [('CPU stack', 0x0100, 0x0100),
+          ('KERNAL work area', 0x0200, 0x0200),
+          ('I/O', 0xD000, 0x1000)]
+
+DEFAULT_HIMEM = 0xD000          # cc65 c64.cfg __HIMEM__
+DEFAULT_STACKSIZE = 0x0800      # cc65 c64.cfg __STACKSIZE__
+REPLAY_LOG = ('replay log', 0xC000, 0x0800)    # common/replay.s
+FILL_RUN = 256                  # zero bytes taken as fill in a .prg image
+MIN_GAP = 64                    # smaller free gaps are not listed
+
+# Segments that are not in C64 memory, or live in zero page
+SKIP_SEGMENTS = ('LOADADDR', 'ZEROPAGE', 'ZP', 'EXTZP')
+
+
+class Span:
+    """An address range with an owner: segment, region or system."""
+
+    def __init__(self, name, start, size, kind, source=None):
+        self.name = name
+        self.start = start
+        self.size = size
+        self.kind = kind
+        self.source = source        # macro the address comes from
+
+    @property
+    def end(self):
+        return self.start + self.size
+
+    def overlaps(self, other):
+        return self.start < other.end and other.start < self.end
+
+    def __str__(self):
+        return f"${self.start:04X}-${self.end - 1:04X} {self.size:6d}  {self.name}"
+
+
+# =============================================================================
+# INPUTS - Linker config, map file, sources
+# =============================================================================
+
+def _eval(expr, names):
+    """Value of a linker config expression ($hex, symbols, + - * /)."""
+    expr = re.sub(r'\$([0-9A-Fa-f]+)', lambda m: str(int(m.group(1), 16)), expr)
+    expr = expr.replace('%S', str(0x0801))
+    if not re.fullmatch(r'[\w\s+\-*/()]+', expr):
+        raise ValueError(expr)
+    return int(eval(expr, {'__builtins__': {}}, names))
+
+
+def parse_cfg(path):
+    """Memory areas {name: (start, size)} and SYMBOLS values of an ld65 config."""
+    text = re.sub(r'#.*', '', Path(path).read_text())
+    names = {}
+    m = re.search(r'SYMBOLS\s*\{(.*?)\}', text, re.S)
+    for name, value in re.findall(r'(\w+)\s*:[^;]*?value\s*=\s*([^,;]+)',
+                                  m.group(1) if m else ''):
+        try:
+            names[name] = _eval(value, names)
+        except (ValueError, SyntaxError, NameError):
+            pass
+    areas = {}
+    m = re.search(r'MEMORY\s*\{(.*?)\}', text, re.S)
+    for name, attrs in re.findall(r'(\w+)\s*:([^;]*);', m.group(1) if m else ''):
+        fields = dict(re.findall(r'(\w+)\s*=\s*([^,]+)', attrs))
+        try:
+            start = _eval(fields['start'], names)
+            size = _eval(fields['size'], names)
+        except (KeyError, ValueError, SyntaxError, NameError):
+            continue
+        names[f"__{name}_START__"] = start
+        areas[name] = (start, size)
+    return areas, names
+
+
+def source_address(pdir, macro):
+    """Address a project's sources give a macro or assembler constant."""
+    pattern = re.compile(
+        rf'^\s*(?:#define\s+{macro}\b[^\n]*?0x([0-9A-Fa-f]+)'
+        rf'|{macro}\s*=\s*\$([0-9A-Fa-f]+))', re.M)
+    for path in sorted(pdir.iterdir()):
+        if path.suffix not in ('.c', '.h', '.s', '.inc'):
+            continue
+        m = pattern.search(path.read_text(errors='replace'))
+        if m:
+            return int(m.group(1) or m.group(2), 16), path.name
+    return None, None
+
+
+def image_segments(prg):
+    """Spans of a .prg image, split at long runs of zero fill."""
+    data = Path(prg).read_bytes()
+    load, body = data[0] | data[1] << 8, data[2:]
+    spans, start, zeros = [], 0, 0
+    for i, b in enumerate(body + bytes(FILL_RUN)):
+        zeros = zeros + 1 if b == 0 else 0
+        if zeros == FILL_RUN:
+            end = i - FILL_RUN + 1
+            if end > start:
+                spans.append(Span('image', load + start, end - start, 'segment'))
+            start = None
+        elif b and start is None:
+            start = i
+    return spans
+
+
+class Layout:
+    """Everything placed in memory for one project."""
+
+    def __init__(self, name):
+        self.name = name
+        self.dir = ROOT / name
+        self.segments = []
+        self.regions = []
+        self.system = [Span(n, a, s, 'system') for n, a, s in SYSTEM]
+        self.areas = {}
+        self.cfg = None
+        self.map = None
+        self.errors = []            # problems found while reading
+
+    @property
+    def bank(self):
+        screens = [r for r in self.regions if r.kind == 'screen']
+        return screens[0].start // 0x4000 if screens else 0
+
+    def spans(self):
+        return self.segments + self.regions + self.system
+
+
+def load_layout(name):
+    """Layout of a project from its build recipe, map file and sources."""
+    layout = Layout(name)
+    recipe = read_recipe(name)
+    is_c = any(src.endswith('.c') for src in recipe.sources)
+    link = dict(zip(recipe.link, recipe.link[1:]))
+
+    names = {}
+    if '-C' in link:
+        layout.cfg = Path(link['-C']).name
+        layout.areas, names = parse_cfg(layout.dir / link['-C'])
+        layout.areas = {n: a for n, a in layout.areas.items()
+                        if n not in SKIP_SEGMENTS and a[0] >= 0x0200}
+    else:
+        layout.areas = {'MAIN': (0x0801, DEFAULT_HIMEM - 0x0801)}
+    if is_c:
+        himem = names.get('__HIMEM__', DEFAULT_HIMEM)
+        stack = names.get('__STACKSIZE__', DEFAULT_STACKSIZE)
+        layout.system.append(Span('C stack', himem - stack, stack, 'system'))
+    if any(src.endswith('replay.s') for src in recipe.sources):
+        layout.system.append(Span(*REPLAY_LOG, 'system'))
+
+    map_path = layout.dir / link.get('-m', f"{name}.map")
+    prg = layout.dir / (recipe.output or f"{name}.prg")
+    if map_path.exists():
+        layout.map = map_path.name
+        db = SymbolDB.load(map_path)
+        for seg, (start, size) in sorted(db.segments.items(), key=lambda s: s[1]):
+            if seg not in SKIP_SEGMENTS and size:
+                layout.segments.append(Span(seg, start, size, 'segment'))
+    elif prg.exists():
+        layout.map = f"{prg.name} (no map: image only, BSS unknown)"
+        cuts = sorted(start for start, _ in layout.areas.values())
+        for span in image_segments(prg):
+            for cut in cuts + [span.end]:
+                if span.start < cut < span.end or cut == span.end:
+                    layout.segments.append(Span('image', span.start,
+                                                cut - span.start, 'segment'))
+                    span = Span('image', cut, span.end - cut, 'segment')
+                    if not span.size:
+                        break
+    else:
+        layout.errors.append("not built: no map file and no .prg")
+
+    for entry in REGIONS.get(name, []):
+        kind, where = entry[0], entry[1]
+        size = entry[2] if len(entry) > 2 else KIND_SIZE[kind]
+        if isinstance(where, str):
+            addr, found_in = source_address(layout.dir, where)
+            if addr is None:
+                layout.errors.append(f"{where} ({kind}) not found in the sources")
+                continue
+            layout.regions.append(Span(where, addr, size, kind, found_in))
+        else:
+            layout.regions.append(Span(f"{kind} ${where:04X}", where, size, kind))
+    return layout
+
+
+# =============================================================================
+# CHECKS
+# =============================================================================
+
+def vic_problems(layout, regions=None):
+    """VIC-II visibility and alignment problems of the VIC regions."""
+    bank = layout.bank
+    base = bank * 0x4000
+    problems = []
+    for r in regions if regions is not None else layout.regions:
+        if r.kind not in VIC_KINDS:
+            continue
+        if r.start // 0x4000 != bank or (r.end - 1) // 0x4000 != bank:
+            problems.append(f"{r.name} ${r.start:04X}: outside VIC bank {bank} "
+                            f"(${base:04X}-${base + 0x3FFF:04X})")
+        elif bank in (0, 2) and r.overlaps(Span('', base + 0x1000, 0x1000, '')):
+            problems.append(f"{r.name} ${r.start:04X}: the VIC sees character "
+                            f"ROM at ${base + 0x1000:04X}-${base + 0x1FFF:04X}")
+        if r.start % KIND_ALIGN[r.kind]:
+            problems.append(f"{r.name} ${r.start:04X}: {r.kind} must be "
+                            f"aligned to ${KIND_ALIGN[r.kind]:X}")
+    return problems
+
+
+def overlaps(layout):
+    """Every pair of spans that share bytes (segments among themselves excepted)."""
+    found = []
+    spans = layout.spans()
+    for i, a in enumerate(spans):
+        for b in spans[i + 1:]:
+            if a.kind == b.kind and a.kind in ('segment', 'system'):
+                continue
+            if a.overlaps(b):
+                lo, hi = max(a.start, b.start), min(a.end, b.end)
+                found.append(f"{a.name} ${a.start:04X}-${a.end - 1:04X} overlaps "
+                             f"{b.name} ${b.start:04X}-${b.end - 1:04X} "
+                             f"({hi - lo} bytes at ${lo:04X})")
+    return found
+
+
+def problems(name):
+    """Overlap and VIC problems of a project, for build_all.py."""
+    layout = load_layout(name)
+    return layout.errors + overlaps(layout) + vic_problems(layout)
+
+
+def budgets(layout, regions=None):
+    """
+    Per memory area: (name, start, end, used, headroom, limit).
+
+    used is the byte count of its segments; headroom how far the highest
+    of them can grow before the area ends or the first span above its
+    lowest segment begins (negative: by how much it already runs into it).
+    """
+    regions = layout.regions if regions is None else regions
+    others = regions + layout.system
+    result = []
+    for area, (start, size) in layout.areas.items():
+        end = start + size
+        inside = [s for s in layout.segments if start <= s.start < end]
+        if not inside:
+            continue
+        low = min(s.start for s in inside)
+        top = max(s.end for s in inside)
+        limit, what = end, 'end of area'
+        for o in others:
+            if o.end > low and o.start < limit:
+                limit, what = o.start, o.name
+        result.append((area, start, end, sum(s.size for s in inside),
+                       limit - top, what))
+    return result
+
+
+def free_gaps(layout, lo=0x0800, hi=0xD000):
+    """Unused RAM between lo and hi as (start, end), at least MIN_GAP bytes."""
+    taken = sorted((s.start, s.end) for s in layout.spans() if s.end > lo)
+    gaps, pos = [], lo
+    for start, end in taken:
+        if start > pos and min(start, hi) - pos >= MIN_GAP:
+            gaps.append((pos, min(start, hi)))
+        pos = max(pos, end)
+        if pos >= hi:
+            break
+    if hi - pos >= MIN_GAP:
+        gaps.append((pos, hi))
+    return gaps
+
+
+def suggest(layout):
+    """
+    Movable VIC regions packed at the top of the VIC bank.
+
+    Returns a list of (region, new_start), or None when they do not fit.
+    Largest alignment first; each goes to the highest free address in
+    the bank that keeps clear of segments, fixed spans, the character
+    ROM shadow and the regions already placed.
+    """
+    bank = layout.bank
+    base = bank * 0x4000
+    movable = [r for r in layout.regions if r.kind in MOVABLE]
+    blocked = [s for s in layout.spans() if s not in movable]
+    if bank in (0, 2):
+        blocked.append(Span('character ROM', base + 0x1000, 0x1000, 'system'))
+    placed = []
+    for r in sorted(movable, key=lambda r: (-KIND_ALIGN[r.kind], -r.size)):
+        align = KIND_ALIGN[r.kind]
+        addr = (base + 0x4000 - r.size) // align * align
+        while addr >= base:
+            trial = Span(r.name, addr, r.size, r.kind)
+            if not any(trial.overlaps(b) for b in blocked):
+                break
+            addr -= align
+        if addr < base:
+            return None
+        placed.append((r, addr))
+        blocked.append(Span(r.name, addr, r.size, r.kind))
+    return placed
+
+
+# =============================================================================
+# REPORT
+# =============================================================================
+
+def vic_hint(kind, addr):
+    """How the game selects a region: sprite pointer or $D018 bits."""
+    offset = addr % 0x4000
+    if kind == 'sprites':
+        return f"sprite blocks {offset // 64}-"
+    if kind == 'charset':
+        return f"$D018 bits 3-1 = %{offset // 0x800:03b}"
+    if kind == 'bitmap':
+        return f"$D018 bit 3 = {offset // 0x2000}"
+    return ''
+
+
+def report(name, quiet=False, want_suggestion=False):
+    """Print one project's layout; returns the number of problems."""
+    layout = load_layout(name)
+    found = layout.errors + overlaps(layout) + vic_problems(layout)
+    base = layout.bank * 0x4000
+    print(f"{'✗' if found else '✓'} {name}  ({layout.cfg or 'c64.cfg'}; "
+          f"{layout.map or 'no map'}; VIC bank {layout.bank} "
+          f"${base:04X}-${base + 0x3FFF:04X})")
+
+    if not quiet:
+        for span in sorted(layout.spans(), key=lambda s: s.start):
+            tag = f" ({span.kind}" + (f", {span.source}" if span.source else '') + ")"
+            print(f"    {span}{tag if span.kind != 'segment' else ''}")
+    for p in found:
+        print(f"    ✗ {p}")
+    for area, start, end, used, headroom, limit in budgets(layout):
+        if headroom < 0:
+            print(f"    {area}: {used} bytes used, {-headroom} over into {limit}")
+        else:
+            print(f"    {area}: {used} bytes used, {headroom} free before {limit}")
+    if not quiet:
+        gaps = free_gaps(layout)
+        if gaps:
+            print("    free: " + ', '.join(f"${a:04X}-${b - 1:04X} ({b - a})"
+                                           for a, b in gaps))
+
+    if want_suggestion:
+        placed = suggest(layout)
+        if placed is None:
+            print(f"    suggestion: the movable regions do not fit in VIC bank "
+                  f"{layout.bank}; move the code up (a HIGH memory area, as in "
+                  f"meteor.cfg) or the game to another bank")
+        elif not placed:
+            print("    suggestion: nothing to move")
+        else:
+            before = {b[0]: b[4] for b in budgets(layout)}
+            moved = {id(r): a for r, a in placed}
+            regions = [Span(r.name, moved.get(id(r), r.start), r.size, r.kind)
+                       for r in layout.regions]
+            after = {b[0]: b[4] for b in budgets(layout, regions)}
+            print("    suggestion (packed at the top of the VIC bank):")
+            for r, addr in sorted(placed, key=lambda p: p[1]):
+                hint = vic_hint(r.kind, addr)
+                if r.kind == 'sprites':
+                    hint += str((addr % 0x4000 + r.size - 1) // 64)
+                change = (f"${r.start:04X} -> ${addr:04X}" if addr != r.start
+                          else f"${addr:04X} (stays)")
+                print(f"      {r.name:12s} {change}  {hint}")
+            for area in before:
+                if after.get(area) != before[area]:
+                    print(f"      {area}: {before[area]} -> {after[area]} bytes free")
+    return len(found)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Memory-map budget analyzer for the C64 projects')
+    parser.add_argument('projects', nargs='*', help='Projects (default: all)')
+    parser.add_argument('-q', '--quiet', action='store_true',
+                        help='Problems and budgets only')
+    parser.add_argument('--suggest', action='store_true',
+                        help='Propose a packed layout of the VIC regions')
+    args = parser.parse_args()
+
+    names = args.projects or all_projects()
+    failed = 0
+    for name in names:
+        if not (ROOT / name).is_dir():
+            print(f"✗ {name}: no such project")
+            return 1
+        failed += report(name, args.quiet, args.suggest) > 0
+    if len(names) > 1:
+        print(f"{len(names) - failed}/{len(names)} projects without problems")
+    return 1 if failed else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -2,7 +2,7 @@
 # Build Meteor Storm using cc65
 cd "$(dirname "$0")"
 
-cl65 -t c64 -C meteor.cfg -O -o meteor.prg meteor.c
+cl65 -t c64 -C meteor.cfg -O -I ../common -g -m meteor.map -Ln meteor.lbl -Wl --dbgfile,meteor.dbg -o meteor.prg meteor.c ../common/shadow.s ../common/sfx.s ../common/replay.s
 
 if [[ -f meteor.prg ]]; then
     echo "Built meteor.prg ($(stat -c%s meteor.prg) bytes)"
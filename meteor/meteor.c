@@ -20,6 +20,10 @@
 #include <stdlib.h>
 #include <joystick.h>
 
+#include "shadow.h"
+#include "sfx.h"
+#include "replay.h"
+
 /* ═══════════════════════════════════════════════════════════
  *  HARDWARE DEFINES
  * ═══════════════════════════════════════════════════════════ */
@@ -64,40 +68,13 @@
 #define FIRST_CUSTOM_CHAR 100
 
 /* ── VIC-II ─────────────────────────────────────────────── */
-#define VIC_SPR_ENA     (*(unsigned char*)0xD015)
-#define VIC_SPR_HI_X    (*(unsigned char*)0xD010)
 #define VIC_SPR_MCOLOR  (*(unsigned char*)0xD01C)
 #define VIC_SPR_DBL_X   (*(unsigned char*)0xD01D)
 #define VIC_SPR_DBL_Y   (*(unsigned char*)0xD017)
 #define VIC_SPR_PRIO    (*(unsigned char*)0xD01B)
 
-#define SPR_X(n) (*(unsigned char*)(0xD000 + (n)*2))
-#define SPR_Y(n) (*(unsigned char*)(0xD001 + (n)*2))
 #define SPR_COL(n) (*(unsigned char*)(0xD027 + (n)))
 
-/* ── SID ────────────────────────────────────────────────── */
-#define SID_V1_FLO (*(unsigned char*)0xD400)
-#define SID_V1_FHI (*(unsigned char*)0xD401)
-#define SID_V1_PWL (*(unsigned char*)0xD402)
-#define SID_V1_PWH (*(unsigned char*)0xD403)
-#define SID_V1_CTL (*(unsigned char*)0xD404)
-#define SID_V1_AD  (*(unsigned char*)0xD405)
-#define SID_V1_SR  (*(unsigned char*)0xD406)
-
-#define SID_V2_FLO (*(unsigned char*)0xD407)
-#define SID_V2_FHI (*(unsigned char*)0xD408)
-#define SID_V2_CTL (*(unsigned char*)0xD40B)
-#define SID_V2_AD  (*(unsigned char*)0xD40C)
-#define SID_V2_SR  (*(unsigned char*)0xD40D)
-
-#define SID_V3_FLO (*(unsigned char*)0xD40E)
-#define SID_V3_FHI (*(unsigned char*)0xD40F)
-#define SID_V3_CTL (*(unsigned char*)0xD412)
-#define SID_V3_AD  (*(unsigned char*)0xD413)
-#define SID_V3_SR  (*(unsigned char*)0xD414)
-
-#define SID_VOL    (*(unsigned char*)0xD418)
-
 /* ── Colors ─────────────────────────────────────────────── */
 #define BLACK    0
 #define WHITE    1
@@ -216,7 +193,6 @@ static unsigned char game_state;
 static unsigned char demo_mode;
 static unsigned char frame_count;
 static unsigned char spawn_timer;
-static unsigned char snd_timer1, snd_timer2, snd_timer3;
 static unsigned char anim_frame;
 
 /* Combo system */
@@ -457,11 +433,11 @@ static void setup_sprites(void) {
     SPRITE_PTRS[SPR_PWRUP]  = BLK_PWRUP;
     SPRITE_PTRS[SPR_UFO]    = BLK_UFO;
 
-    VIC_SPR_ENA    = 0;
+    SHD_VIC(SHD_SPR_ENA, 0);
     VIC_SPR_DBL_X  = 0;
     VIC_SPR_DBL_Y  = 0;
     VIC_SPR_MCOLOR = 0;
-    VIC_SPR_HI_X   = 0;
+    SHD_VIC(SHD_SPR_HI_X, 0);
     VIC_SPR_PRIO   = 0;
 
     SPR_COL(SPR_SHIP)   = LTGREEN;
@@ -474,98 +450,101 @@ static void setup_sprites(void) {
  *  SOUND
  * ═══════════════════════════════════════════════════════════ */
 
-static void snd_init(void) {
-    SID_VOL    = 15;
-    SID_V1_AD  = 0x00;
-    SID_V1_SR  = 0xA0;
-    SID_V2_AD  = 0x08;
-    SID_V2_SR  = 0x00;
-    SID_V3_AD  = 0x00;
-    SID_V3_SR  = 0x90;
-}
+/* Effects for the IRQ player (see sfx.h) */
 
-static void snd_shoot(void) {
-    SID_V1_FHI = 0x28;
-    SID_V1_FLO = 0x00;
-    SID_V1_CTL = 0x81;   /* noise, gate on */
-    snd_timer1 = 3;
-}
+static const unsigned char fx_shoot[] = {
+    SFX_V1, 1, 0x00, 0xA0,
+    SFX_STEP(3, 0x81, 0x2800, 0, 0x08),     /* noise */
+    SFX_END
+};
 
-static void snd_explode_small(void) {
-    SID_V2_FHI = 0x15;
-    SID_V2_FLO = 0x00;
-    SID_V2_CTL = 0x81;   /* noise, gate on */
-    snd_timer2 = 5;
-}
+static const unsigned char fx_explode_small[] = {
+    SFX_V2, 1, 0x08, 0x00,
+    SFX_STEP(5, 0x81, 0x1500, 0, 0x08),     /* noise */
+    SFX_END
+};
 
-static void snd_explode_large(void) {
-    SID_V2_FHI = 0x0A;
-    SID_V2_FLO = 0x00;
-    SID_V2_CTL = 0x81;   /* deep noise */
-    snd_timer2 = 8;
-}
+static const unsigned char fx_explode_large[] = {
+    SFX_V2, 2, 0x08, 0x00,
+    SFX_STEP(8, 0x81, 0x0A00, 0, 0x08),     /* deep noise */
+    SFX_END
+};
 
-static void snd_split(void) {
-    /* Quick high-low chirp for meteor split */
-    SID_V3_FHI = 0x30;
-    SID_V3_FLO = 0x00;
-    SID_V3_CTL = 0x21;   /* sawtooth, gate on */
-    snd_timer3 = 4;
-}
+/* Quick high-low chirp for meteor split */
+static const unsigned char fx_split[] = {
+    SFX_V3, 1, 0x00, 0x90,
+    SFX_STEP(4, 0x21, 0x3000, -4, 0x08),    /* sawtooth */
+    SFX_END
+};
 
-static void snd_powerup(void) {
-    SID_V3_FHI = 0x20;
-    SID_V3_FLO = 0x00;
-    SID_V3_CTL = 0x11;   /* triangle, gate on */
-    snd_timer3 = 8;
-}
+static const unsigned char fx_powerup[] = {
+    SFX_V3, 2, 0x00, 0x90,
+    SFX_STEP(8, 0x11, 0x2000, 0, 0x08),     /* triangle */
+    SFX_END
+};
 
-static void snd_bomb(void) {
-    /* Dramatic sweep */
-    unsigned char i;
-    for (i = 0x30; i > 0x02; i -= 3) {
-        SID_V1_FHI = i;
-        SID_V1_CTL = 0x81;
-        SID_V2_FHI = 0x40 - i;
-        SID_V2_CTL = 0x21;
-        waitvsync();
-    }
-    SID_V1_CTL = 0x00;
-    SID_V2_CTL = 0x00;
-}
+/* Dramatic sweep: noise falls on voice 1 while a saw rises on voice 2 */
+static const unsigned char fx_bomb_low[] = {
+    SFX_V1, 3, 0x00, 0xA0,
+    SFX_STEP(16, 0x81, 0x3000, -3, 0x08),
+    SFX_END
+};
 
-static void snd_ufo_tick(void) {
-    SID_V3_FHI = 0x30 + (frame_count & 0x07);
-    SID_V3_CTL = 0x41;   /* pulse, gate on */
+static const unsigned char fx_bomb_high[] = {
+    SFX_V2, 3, 0x08, 0x00,
+    SFX_STEP(16, 0x21, 0x1000, 3, 0x08),
+    SFX_END
+};
+
+/* UFO whine, loops while the UFO is on screen */
+static const unsigned char fx_ufo[] = {
+    SFX_V3 | SFX_KEEP, 0, 0x00, 0x90,
+    SFX_STEP(8, 0x41, 0x3000, 1, 0x08),     /* pulse */
+    SFX_LOOP
+};
+
+#define FX_DEATH_FRAMES 30
+static const unsigned char fx_death[] = {
+    SFX_V1, 3, 0x00, 0xA0,
+    SFX_STEP(FX_DEATH_FRAMES, 0x21, 0x4000, -2, 0x08),
+    SFX_END
+};
+
+/* Rising arpeggio for combos: pitch patched from combo_count */
+static unsigned char fx_combo[] = {
+    SFX_V3, 1, 0x00, 0x90,
+    SFX_STEP(3, 0x11, 0x1800, 0, 0x08),
+    SFX_END
+};
+
+static void snd_shoot(void)         { sfx_play(fx_shoot); }
+static void snd_explode_small(void) { sfx_play(fx_explode_small); }
+static void snd_explode_large(void) { sfx_play(fx_explode_large); }
+static void snd_split(void)         { sfx_play(fx_split); }
+static void snd_powerup(void)       { sfx_play(fx_powerup); }
+static void snd_ufo_tick(void)      { sfx_play(fx_ufo); }
+
+static void snd_bomb(void) {
+    sfx_play(fx_bomb_low);
+    sfx_play(fx_bomb_high);
 }
 
+/* The game freezes while the death sound plays */
 static void snd_death(void) {
     unsigned char i;
-    for (i = 0x40; i > 0x04; i -= 2) {
-        SID_V1_FHI = i;
-        SID_V1_CTL = 0x21;
-        waitvsync();
-    }
-    SID_V1_CTL = 0x20;
+    sfx_play(fx_death);
+    for (i = 0; i < FX_DEATH_FRAMES; ++i) waitvsync();
 }
 
 static void snd_combo(void) {
-    /* Rising arpeggio for combos */
-    SID_V3_FHI = 0x18 + combo_count * 4;
-    SID_V3_CTL = 0x11;
-    snd_timer3 = 3;
+    fx_combo[SFX_PITCH] = 0x18 + combo_count * 4;
+    sfx_play(fx_combo);
 }
 
 static void snd_off(void) {
-    SID_V1_CTL = 0x00;
-    SID_V2_CTL = 0x00;
-    SID_V3_CTL = 0x00;
-}
-
-static void snd_tick(void) {
-    if (snd_timer1 > 0) { --snd_timer1; if (!snd_timer1) SID_V1_CTL = 0x00; }
-    if (snd_timer2 > 0) { --snd_timer2; if (!snd_timer2) SID_V2_CTL = 0x00; }
-    if (snd_timer3 > 0) { --snd_timer3; if (!snd_timer3) SID_V3_CTL = 0x00; }
+    sfx_stop(SFX_V1);
+    sfx_stop(SFX_V2);
+    sfx_stop(SFX_V3);
 }
 
 /* ═══════════════════════════════════════════════════════════
@@ -968,7 +947,7 @@ static unsigned char check_bullet_hit(unsigned char bx, unsigned char by) {
     if (ufo_active && cy <= 2) {
         if (bx >= ufo_x - 8 && bx <= ufo_x + 16) {
             ufo_active = 0;
-            VIC_SPR_ENA &= ~(1 << SPR_UFO);
+            SHD_SPR_HIDE(1 << SPR_UFO);
             score += 100 + (rand() & 0x7F);
             snd_explode_large();
 
@@ -1055,16 +1034,16 @@ static void move_bullet(void) {
     if (bullet_active) {
         if (bullet_y <= BULLET_TOP + 4) {
             bullet_active = 0;
-            VIC_SPR_ENA &= ~(1 << SPR_BULLET);
+            SHD_SPR_HIDE(1 << SPR_BULLET);
         } else {
             bullet_y -= BULLET_SPEED;
-            SPR_X(SPR_BULLET) = bullet_x;
-            SPR_Y(SPR_BULLET) = bullet_y;
-            VIC_SPR_ENA |= (1 << SPR_BULLET);
+            SHD_SPR_X(SPR_BULLET, bullet_x);
+            SHD_SPR_Y(SPR_BULLET, bullet_y);
+            SHD_SPR_SHOW(1 << SPR_BULLET);
 
             if (check_bullet_hit(bullet_x, bullet_y)) {
                 bullet_active = 0;
-                VIC_SPR_ENA &= ~(1 << SPR_BULLET);
+                SHD_SPR_HIDE(1 << SPR_BULLET);
             }
         }
     }
@@ -1113,21 +1092,21 @@ static void update_powerup(void) {
     /* Off screen? */
     if (pwrup_y >= C2SY(23)) {
         pwrup_active = 0;
-        VIC_SPR_ENA &= ~(1 << SPR_PWRUP);
+        SHD_SPR_HIDE(1 << SPR_PWRUP);
         return;
     }
 
     /* Update sprite */
-    SPR_X(SPR_PWRUP) = pwrup_x;
-    SPR_Y(SPR_PWRUP) = pwrup_y;
-    VIC_SPR_ENA |= (1 << SPR_PWRUP);
+    SHD_SPR_X(SPR_PWRUP, pwrup_x);
+    SHD_SPR_Y(SPR_PWRUP, pwrup_y);
+    SHD_SPR_SHOW(1 << SPR_PWRUP);
 
     /* Player collision */
     if (pwrup_y >= SHIP_Y_SPR - 8 && pwrup_y <= SHIP_Y_SPR + 8) {
         if (pwrup_x >= ship_x - 8 && pwrup_x <= ship_x + 16) {
             /* Collected! */
             pwrup_active = 0;
-            VIC_SPR_ENA &= ~(1 << SPR_PWRUP);
+            SHD_SPR_HIDE(1 << SPR_PWRUP);
 
             switch (pwrup_type) {
                 case PWRUP_SHIELD:
@@ -1176,20 +1155,20 @@ static void update_ufo(void) {
                 ufo_x = C2SX(37);
                 ufo_dx = -1;
             }
-            SPR_Y(SPR_UFO) = C2SY(1);
+            SHD_SPR_Y(SPR_UFO, C2SY(1));
         }
         return;
     }
 
     ufo_x = (unsigned char)((signed char)ufo_x + ufo_dx);
-    SPR_X(SPR_UFO) = ufo_x;
-    VIC_SPR_ENA |= (1 << SPR_UFO);
+    SHD_SPR_X(SPR_UFO, ufo_x);
+    SHD_SPR_SHOW(1 << SPR_UFO);
     snd_ufo_tick();
 
     if (ufo_x <= C2SX(0) || ufo_x >= C2SX(38)) {
         ufo_active = 0;
-        VIC_SPR_ENA &= ~(1 << SPR_UFO);
-        SID_V3_CTL = 0x00;
+        SHD_SPR_HIDE(1 << SPR_UFO);
+        sfx_stop(SFX_V3);
     }
 }
 
@@ -1253,15 +1232,16 @@ static void draw_hud(void) {
  *  INPUT
  * ═══════════════════════════════════════════════════════════ */
 
+/* In game: this frame's input from rp_frame(), recorded or played back */
 static unsigned char joy_dir(void) {
-    unsigned char j = joy_read(JOY_2);
+    unsigned char j = rp_joy(JOY_2);
     if (JOY_LEFT(j))  return 1;
     if (JOY_RIGHT(j)) return 2;
     return 0;
 }
 
 static unsigned char joy_fire(void) {
-    return JOY_FIRE(joy_read(JOY_2));
+    return JOY_FIRE(rp_joy(JOY_2));
 }
 
 /* ═══════════════════════════════════════════════════════════
@@ -1329,7 +1309,7 @@ static void init_wave_state(void) {
     combo_timer = 0;
     exp_count = 0;
 
-    VIC_SPR_ENA = (1 << SPR_SHIP);
+    SHD_VIC(SHD_SPR_ENA, 1 << SPR_SHIP);
 }
 
 /* ═══════════════════════════════════════════════════════════
@@ -1425,8 +1405,8 @@ static void game_loop(void) {
 
     while (1) {
         waitvsync();
+        rp_frame();
         ++frame_count;
-        snd_tick();
 
         /* Animation frame toggle every 8 frames */
         if ((frame_count & 7) == 0) ++anim_frame;
@@ -1462,7 +1442,7 @@ static void game_loop(void) {
             }
 
             /* Update ship sprite */
-            SPR_X(SPR_SHIP) = ship_x;
+            SHD_SPR_X(SPR_SHIP, ship_x);
 
             /* Spawn meteors */
             spawn_interval = 40;
@@ -1520,10 +1500,10 @@ static void game_loop(void) {
             } else {
                 /* Reset ship position */
                 ship_x = C2SX(19);
-                SPR_X(SPR_SHIP) = ship_x;
+                SHD_SPR_X(SPR_SHIP, ship_x);
                 bullet_active = 0;
                 bullet2_active = 0;
-                VIC_SPR_ENA &= ~(1 << SPR_BULLET);
+                SHD_SPR_HIDE(1 << SPR_BULLET);
                 game_state = GS_PLAY;
             }
             continue;
@@ -1600,7 +1580,8 @@ int main(void) {
     bgcolor(BLACK);
     bordercolor(BLACK);
 
-    snd_init();
+    shd_install(SHD_LINE);
+    sfx_init();
     init_sprite_data();
     init_custom_charset();
     setup_sprites();
@@ -1611,7 +1592,7 @@ title_screen:
     snd_off();
 
     title_timer = 0;
-    while (!joy_fire() && title_timer < 350) {
+    while (!rp_start() && title_timer < 350) {
         waitvsync();
         ++title_timer;
     }
@@ -1622,13 +1603,14 @@ title_screen:
     wave  = 1;
     frame_count = 0;
     anim_frame = 0;
-    snd_timer1 = 0;
-    snd_timer2 = 0;
-    snd_timer3 = 0;
     double_shot = 0;
     double_timer = 0;
 
-    demo_mode = joy_fire() ? 0 : 1;
+    demo_mode = rp_start() ? 0 : 1;
+
+    /* Seed and start logging (or play back) this run; demos are not
+     * logged, so the last game's log stays there to be saved */
+    demo_mode = rp_begin(demo_mode ? RP_DEMO : 0) & RP_DEMO;
 
     /* Initial screen */
     clrscr();
@@ -1640,9 +1622,9 @@ title_screen:
     init_wave_state();
 
     ship_x = C2SX(19);
-    SPR_X(SPR_SHIP) = ship_x;
-    SPR_Y(SPR_SHIP) = SHIP_Y_SPR;
-    VIC_SPR_ENA = (1 << SPR_SHIP);
+    SHD_SPR_X(SPR_SHIP, ship_x);
+    SHD_SPR_Y(SPR_SHIP, SHIP_Y_SPR);
+    SHD_VIC(SHD_SPR_ENA, 1 << SPR_SHIP);
 
     game_state = GS_PLAY;
 
@@ -0,0 +1,52 @@
+/* Packed by common/pack.py from charmap.h: 2048 -> 954 bytes */
+#define CHARMAP_Z_SIZE 2048
+const unsigned char charmap_z[] = {
+    0, 0, 135, 1, 0, 16, 15, 15, 15, 15, 15, 0, 0, 0, 192, 192, 192, 192, 192, 0,
+    0, 0, 126, 129, 1, 0, 130, 26, 0, 10, 1, 1, 1, 0, 0, 0, 254, 255, 255, 255,
+    255, 131, 43, 0, 9, 128, 128, 0, 0, 0, 127, 127, 127, 127, 126, 132, 24, 0, 49, 31,
+    0, 0, 0, 3, 3, 131, 195, 195, 0, 0, 0, 255, 255, 255, 255, 240, 0, 0, 0, 240,
+    248, 252, 254, 254, 0, 0, 0, 126, 127, 63, 31, 31, 0, 0, 0, 1, 3, 3, 135, 207,
+    0, 0, 0, 252, 248, 240, 240, 224, 15, 132, 1, 0, 128, 107, 0, 129, 48, 0, 32, 192,
+    126, 126, 126, 254, 254, 254, 254, 126, 3, 3, 3, 7, 7, 15, 15, 15, 255, 239, 231, 231,
+    199, 195, 195, 255, 128, 192, 192, 224, 224, 224, 240, 240, 129, 140, 0, 129, 113, 0, 50, 15,
+    7, 15, 31, 255, 255, 255, 254, 227, 227, 227, 195, 195, 131, 3, 3, 240, 240, 240, 240, 255,
+    255, 255, 255, 127, 63, 127, 254, 254, 252, 248, 240, 15, 7, 7, 3, 1, 1, 0, 0, 207,
+    255, 255, 255, 255, 254, 252, 252, 192, 192, 128, 135, 221, 0, 3, 15, 15, 0, 192, 131, 1,
+    0, 131, 221, 0, 10, 126, 126, 0, 31, 31, 31, 63, 63, 126, 126, 0, 133, 219, 0, 8,
+    240, 248, 248, 252, 252, 252, 126, 0, 3, 131, 1, 0, 1, 0, 240, 131, 1, 0, 1, 0,
+    252, 131, 1, 0, 132, 43, 1, 130, 16, 1, 129, 203, 0, 0, 254, 131, 8, 0, 1, 7,
+    7, 131, 8, 0, 1, 195, 195, 131, 8, 0, 133, 40, 1, 1, 248, 248, 132, 8, 0, 131,
+    57, 0, 128, 110, 0, 132, 64, 1, 0, 193, 131, 8, 0, 0, 3, 132, 56, 0, 1, 251,
+    243, 132, 16, 0, 0, 3, 132, 88, 0, 1, 252, 1, 132, 1, 0, 130, 117, 1, 11, 255,
+    255, 251, 7, 7, 7, 135, 135, 199, 199, 231, 195, 132, 1, 0, 1, 255, 255, 131, 250, 0,
+    131, 98, 0, 129, 181, 0, 50, 124, 126, 126, 126, 62, 63, 31, 31, 63, 63, 63, 61, 61,
+    125, 193, 193, 193, 227, 227, 227, 227, 247, 248, 248, 240, 240, 240, 240, 224, 224, 126, 63, 63,
+    31, 15, 15, 7, 3, 7, 15, 159, 159, 255, 255, 254, 254, 227, 227, 195, 131, 131, 129, 109,
+    1, 130, 110, 1, 9, 31, 31, 252, 254, 254, 254, 191, 159, 159, 31, 131, 118, 0, 19, 129,
+    129, 255, 255, 248, 248, 248, 248, 248, 255, 254, 254, 255, 63, 63, 62, 254, 252, 251, 249, 130,
+    16, 0, 19, 248, 247, 247, 255, 255, 127, 127, 63, 63, 63, 63, 31, 31, 31, 31, 31, 15,
+    121, 120, 120, 130, 98, 0, 0, 247, 131, 25, 0, 9, 127, 224, 224, 192, 192, 192, 192, 128,
+    128, 3, 132, 192, 0, 1, 252, 248, 131, 1, 0, 132, 80, 1, 27, 3, 63, 63, 63, 127,
+    127, 255, 252, 252, 15, 15, 255, 255, 255, 255, 3, 3, 129, 193, 193, 193, 225, 225, 241, 241,
+    255, 255, 255, 131, 98, 0, 128, 53, 2, 129, 172, 0, 132, 105, 1, 2, 128, 1, 1, 133,
+    74, 1, 133, 66, 1, 147, 106, 1, 130, 186, 2, 4, 0, 0, 0, 224, 224, 131, 8, 0,
+    1, 127, 63, 133, 170, 2, 139, 90, 1, 1, 249, 249, 132, 16, 0, 132, 88, 0, 1, 241,
+    249, 132, 88, 0, 132, 64, 0, 128, 250, 2, 137, 1, 0, 1, 7, 0, 132, 103, 0, 132,
+    8, 0, 134, 1, 2, 132, 8, 0, 1, 224, 0, 132, 111, 0, 132, 8, 0, 19, 248, 63,
+    127, 127, 127, 127, 124, 112, 96, 255, 255, 255, 255, 143, 3, 3, 1, 224, 248, 252, 129, 91,
+    1, 130, 64, 0, 6, 1, 1, 3, 3, 31, 63, 127, 130, 152, 2, 129, 32, 0, 12, 31,
+    15, 7, 7, 0, 192, 224, 224, 240, 248, 248, 248, 15, 130, 79, 1, 6, 28, 24, 255, 255,
+    255, 255, 227, 129, 73, 0, 131, 249, 1, 130, 88, 0, 7, 128, 128, 128, 192, 1, 7, 15,
+    31, 130, 59, 1, 12, 255, 255, 255, 248, 192, 128, 128, 252, 252, 252, 252, 124, 12, 130, 155,
+    3, 13, 1, 3, 3, 7, 15, 255, 255, 254, 254, 254, 252, 252, 248, 7, 132, 1, 0, 1,
+    252, 252, 132, 78, 1, 135, 185, 2, 130, 131, 3, 129, 159, 0, 129, 26, 3, 129, 164, 1,
+    4, 129, 1, 1, 1, 255, 132, 1, 0, 128, 195, 0, 132, 123, 0, 0, 192, 130, 184, 3,
+    130, 45, 0, 129, 116, 0, 129, 23, 0, 130, 178, 3, 131, 73, 3, 131, 94, 0, 1, 3,
+    3, 133, 92, 0, 1, 3, 3, 131, 69, 2, 131, 102, 0, 129, 166, 1, 137, 58, 0, 129,
+    146, 0, 128, 58, 0, 131, 67, 4, 132, 176, 1, 131, 216, 0, 0, 129, 130, 153, 1, 2,
+    128, 128, 127, 131, 1, 0, 1, 0, 224, 133, 135, 0, 132, 8, 0, 7, 254, 255, 255, 127,
+    63, 31, 7, 0, 130, 238, 3, 5, 255, 252, 0, 248, 240, 224, 130, 72, 0, 130, 39, 1,
+    3, 31, 31, 0, 248, 133, 48, 0, 132, 208, 3, 9, 127, 63, 63, 31, 15, 7, 1, 0,
+    129, 227, 131, 64, 0, 130, 13, 1, 2, 224, 128, 0, 151, 1, 0, 254, 1, 0, 254, 1,
+    0, 254, 1, 0, 254, 1, 0, 254, 1, 0, 254, 1, 0, 255
+};
@@ -0,0 +1,10 @@
+/* Packed by common/pack.py from clrs.h: 1000 -> 117 bytes */
+#define CLRS_Z_SIZE 1000
+const unsigned char clrs_z[] = {
+    0, 0, 248, 1, 0, 254, 1, 0, 6, 7, 7, 7, 7, 7, 8, 7, 132, 1, 0, 156,
+    40, 0, 0, 7, 166, 40, 0, 128, 8, 0, 128, 12, 0, 188, 156, 0, 1, 12, 3, 133,
+    1, 0, 0, 0, 132, 8, 0, 128, 18, 0, 198, 40, 0, 133, 43, 0, 152, 40, 0, 2,
+    12, 0, 12, 135, 41, 0, 188, 204, 0, 12, 10, 11, 0, 8, 10, 0, 11, 10, 8, 0,
+    0, 10, 8, 151, 40, 0, 0, 10, 138, 1, 0, 0, 0, 157, 41, 0, 132, 7, 0, 161,
+    80, 0, 3, 11, 10, 10, 10, 165, 120, 0, 209, 151, 2, 254, 1, 0, 255
+};
@@ -0,0 +1,17 @@
+/* Packed by common/pack.py from img.h: 1000 -> 255 bytes */
+#define IMG_Z_SIZE 1000
+const unsigned char img_z[] = {
+    0, 0, 248, 1, 0, 254, 1, 0, 13, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11,
+    12, 13, 14, 151, 40, 0, 13, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27,
+    28, 151, 40, 0, 12, 29, 30, 31, 32, 33, 34, 31, 0, 35, 36, 0, 0, 37, 188, 156,
+    0, 20, 38, 39, 40, 41, 42, 43, 44, 45, 46, 43, 0, 39, 47, 48, 42, 43, 49, 50,
+    38, 42, 44, 144, 40, 0, 20, 51, 52, 53, 54, 55, 56, 57, 58, 59, 60, 0, 61, 62,
+    63, 55, 56, 64, 65, 66, 67, 68, 145, 40, 0, 20, 69, 70, 54, 55, 56, 71, 72, 73,
+    74, 0, 75, 76, 77, 55, 56, 78, 79, 80, 81, 82, 83, 143, 40, 0, 21, 84, 85, 86,
+    87, 88, 85, 89, 90, 91, 92, 0, 84, 85, 93, 88, 94, 85, 95, 96, 85, 97, 98, 187,
+    204, 0, 13, 99, 100, 83, 0, 99, 101, 0, 102, 100, 103, 0, 0, 104, 105, 151, 40, 0,
+    13, 106, 107, 108, 109, 110, 111, 112, 113, 114, 115, 116, 117, 118, 119, 152, 81, 0, 12, 120,
+    121, 122, 123, 77, 124, 0, 125, 126, 127, 128, 129, 130, 151, 39, 0, 13, 131, 132, 133, 134,
+    135, 136, 137, 138, 139, 140, 141, 142, 143, 128, 151, 40, 0, 13, 144, 145, 146, 84, 147, 148,
+    149, 150, 151, 146, 152, 153, 154, 155, 209, 151, 2, 254, 1, 0, 255
+};
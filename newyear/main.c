@@ -13,6 +13,9 @@
 #include <string.h>
 #include <conio.h>
 
+#include "particles.h"
+#include "unpack.h"
+
 #define POKE(addr, val) (*(unsigned char *)(addr) = (val))
 #define PEEK(addr) (*(unsigned char *)(addr))
 #define SCREEN(x, y) (1024 + (x) + (y) * 40)
@@ -51,31 +54,22 @@
 #define LBLUE   14
 #define LGRAY   15
 
-/* Include image data */
-#include "img.h"
-#include "charmap.h"
-#include "clrs.h"
+/* Image data, packed from img.h, clrs.h and charmap.h by the Makefile */
+#include "img_z.h"
+#include "charmap_z.h"
+#include "clrs_z.h"
+
+/* Unpacked background, restored under rockets and particles */
+static unsigned char img[IMG_Z_SIZE];
+static unsigned char clrs[CLRS_Z_SIZE];
 
-/* Firework particle structure */
-#define MAX_PARTICLES 60
+/* Fireworks (particles live in the shared engine, see particles.h) */
 #define MAX_ROCKETS 6
 
 /* Particle character for fireworks */
 #define PARTICLE_CHAR 255
 #define ROCKET_CHAR 81  /* Ball character in PETSCII */
 
-typedef struct {
-    int x;          /* Position (fixed point 8.8) */
-    int y;
-    int vx;         /* Velocity */
-    int vy;
-    unsigned char color;
-    unsigned char life;
-    unsigned char active;
-    unsigned char prev_x;   /* Previous screen position */
-    unsigned char prev_y;
-} Particle;
-
 typedef struct {
     int x;
     int y;
@@ -86,7 +80,6 @@ typedef struct {
     unsigned char prev_y;
 } Rocket;
 
-static Particle particles[MAX_PARTICLES];
 static Rocket rockets[MAX_ROCKETS];
 
 /* Firework colors */
@@ -144,26 +137,21 @@ static void restore_bg(unsigned char x, unsigned char y) {
 
 /* Initialize a particle */
 static void spawn_particle(int x, int y, unsigned char color) {
-    unsigned char i;
-    signed char vx, vy;
+    unsigned char i = pt_alloc();
     
-    for (i = 0; i < MAX_PARTICLES; i++) {
-        if (!particles[i].active) {
-            vx = (signed char)((sid_random() & 0x3F) - 32);
-            vy = (signed char)((sid_random() & 0x3F) - 32);
-            
-            particles[i].x = x;
-            particles[i].y = y;
-            particles[i].vx = vx * 8;
-            particles[i].vy = vy * 8;
-            particles[i].color = color;
-            particles[i].life = 15 + (sid_random() & 0x0F);
-            particles[i].active = 1;
-            particles[i].prev_x = 255;
-            particles[i].prev_y = 255;
-            return;
-        }
+    if (i == PT_NONE) {
+        return;
     }
+    pt_x[i] = (unsigned char)(x >> 8);
+    pt_xf[i] = (unsigned char)x;
+    pt_y[i] = (unsigned char)(y >> 8);
+    pt_yf[i] = (unsigned char)y;
+    /* Up to one cell per frame in any direction */
+    pt_vx[i] = (signed char)sid_random();
+    pt_vy[i] = (signed char)sid_random();
+    pt_col[i] = color;
+    pt_chr[i] = PARTICLE_CHAR;
+    pt_life[i] = 15 + (sid_random() & 0x0F);
 }
 
 /* Create firework explosion */
@@ -199,54 +187,6 @@ static void launch_rocket(void) {
     }
 }
 
-/* Update particles */
-static void update_particles(void) {
-    register unsigned char i;
-    register unsigned char sx, sy;
-    register Particle *p;
-    
-    for (i = 0; i < MAX_PARTICLES; i++) {
-        p = &particles[i];
-        if (p->active) {
-            /* Restore background at previous position */
-            if (p->prev_x < 40 && p->prev_y < 25) {
-                restore_bg(p->prev_x, p->prev_y);
-            }
-            
-            /* Apply physics */
-            p->x += p->vx;
-            p->y += p->vy;
-            p->vy += 12;  /* Gravity */
-            p->vx = (p->vx * 14) >> 4;  /* Drag */
-            p->vy = (p->vy * 14) >> 4;
-            
-            /* Get screen position */
-            sx = (p->x >> 8);
-            sy = (p->y >> 8);
-            
-            /* Decrease life */
-            p->life--;
-            
-            /* Check if dead or out of bounds */
-            if (p->life == 0 || sy >= 25 || sy <= 0 || sx >= 40) {
-                p->active = 0;
-                continue;
-            }
-            
-            /* Draw particle */
-            if (sx < 40 && sy < 25 && sy > 0) {
-                POKE(SCREEN(sx, sy), PARTICLE_CHAR);
-                POKE(COLOR(sx, sy), p->color);
-                p->prev_x = sx;
-                p->prev_y = sy;
-            } else {
-                p->prev_x = 255;
-                p->prev_y = 255;
-            }
-        }
-    }
-}
-
 /* Update rockets */
 static void update_rockets(void) {
     register unsigned char i;
@@ -293,16 +233,15 @@ static void update_rockets(void) {
 int main(void) {
     unsigned char frame = 0;
     unsigned char launch_timer = 0;
-    unsigned int i;
     unsigned char j;
     
     /* Initialize SID random */
     init_sid_random();
     
-    /* Clear particles and rockets */
-    for (j = 0; j < MAX_PARTICLES; j++) {
-        particles[j].active = 0;
-    }
+    /* Particles restore the background image; clear the rockets */
+    pt_bg_chr = img;
+    pt_bg_col = clrs;
+    pt_init();
     for (j = 0; j < MAX_ROCKETS; j++) {
         rockets[j].active = 0;
     }
@@ -314,21 +253,19 @@ int main(void) {
     /* Set character memory to $3000 (12288) */
     POKE(53272, (PEEK(53272) & 0xF0) | 0x0C);
     
-    /* Copy custom character set */
-    for (i = 0; i < 2048; i++) {
-        POKE(12288 + i, charmap[i]);
-    }
+    /* Unpack the custom character set */
+    unpack((void *)12288, charmap_z);
     
     /* Define particle character at index 255 */
     for (j = 0; j < 8; j++) {
         POKE(12288 + PARTICLE_CHAR * 8 + j, particle_pattern[j]);
     }
     
-    /* Draw the background image */
-    for (i = 0; i < 1000; i++) {
-        POKE(1024 + i, img[i]);
-        POKE(55296 + i, clrs[i]);
-    }
+    /* Draw the background image, keeping a copy to restore from */
+    unpack(img, img_z);
+    unpack(clrs, clrs_z);
+    memcpy((void *)1024, img, 1000);
+    memcpy((void *)55296, clrs, 1000);
     
     /* Main loop */
     while (1) {
@@ -341,9 +278,9 @@ int main(void) {
             launch_timer = 0;
         }
         
-        /* Update animation */
+        /* Update animation (rockets drawn last, on top) */
+        pt_update();
         update_rockets();
-        update_particles();
         
         /* Turn off sound gate */
         if ((frame & 0x0F) == 0) {
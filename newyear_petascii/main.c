@@ -14,6 +14,8 @@
 #include <string.h>
 #include <conio.h>
 
+#include "particles.h"
+
 #define POKE(addr, val) (*(unsigned char *)(addr) = (val))
 #define PEEK(addr) (*(unsigned char *)(addr))
 #define SCREEN(x, y) (1024 + (x) + (y) * 40)
@@ -58,21 +60,9 @@
 #define CHAR_PLUS       43   /* + */
 #define CHAR_BLOCK      160  /* solid block */
 
-/* Firework particle structure */
-#define MAX_PARTICLES 50
+/* Fireworks (particles live in the shared engine, see particles.h) */
 #define MAX_ROCKETS 6
 
-typedef struct {
-    int x;          /* Position (fixed point 8.8) */
-    int y;
-    int vx;         /* Velocity */
-    int vy;
-    unsigned char color;
-    unsigned char life;
-    unsigned char active;
-    unsigned char shape;  /* PETASCII character to use */
-} Particle;
-
 typedef struct {
     int x;
     int y;
@@ -81,9 +71,12 @@ typedef struct {
     unsigned char fuse;     /* Time until explosion */
 } Rocket;
 
-static Particle particles[MAX_PARTICLES];
 static Rocket rockets[MAX_ROCKETS];
 
+/* Screen as drawn before the fireworks, restored under particles */
+static unsigned char bg_chr[1000];
+static unsigned char bg_col[1000];
+
 /* Firework colors - bright and festive */
 static const unsigned char fw_colors[] = {
     WHITE, YELLOW, LRED, LGREEN, LBLUE, CYAN, ORANGE, PURPLE
@@ -172,25 +165,28 @@ static void draw_title(unsigned char color_offset) {
 
 /* Initialize a particle for explosion */
 static void spawn_particle(int x, int y, unsigned char color) {
-    unsigned char i;
-    signed char vx, vy;
+    unsigned char i = pt_alloc();
     
-    for (i = 0; i < MAX_PARTICLES; i++) {
-        if (!particles[i].active) {
-            /* Random velocity in all directions */
-            vx = (signed char)((sid_random() & 0x3F) - 32);
-            vy = (signed char)((sid_random() & 0x3F) - 32);
-            
-            particles[i].x = x;
-            particles[i].y = y;
-            particles[i].vx = vx * 10;  /* Scale for fixed point */
-            particles[i].vy = vy * 10;
-            particles[i].color = color;
-            particles[i].life = 20 + (sid_random() & 0x0F);
-            particles[i].active = 1;
-            particles[i].shape = petascii_shapes[sid_random() % NUM_SHAPES];
-            return;
-        }
+    if (i == PT_NONE) {
+        return;
+    }
+    pt_x[i] = (unsigned char)(x >> 8);
+    pt_xf[i] = (unsigned char)x;
+    pt_y[i] = (unsigned char)(y >> 8);
+    pt_yf[i] = (unsigned char)y;
+    /* Random velocity in all directions, up to one cell per frame */
+    pt_vx[i] = (signed char)sid_random();
+    pt_vy[i] = (signed char)sid_random();
+    pt_col[i] = color;
+    pt_life[i] = 20 + (sid_random() & 0x0F);
+    pt_chr[i] = petascii_shapes[sid_random() % NUM_SHAPES];
+}
+
+/* Shapes shrink to + and then . as particles burn out */
+static void init_fade(void) {
+    unsigned char i;
+    for (i = 0; i < PT_FADE; i++) {
+        pt_fade[i] = (i < 5) ? CHAR_DOT : (i < 10) ? CHAR_PLUS : 0;
     }
 }
 
@@ -227,71 +223,6 @@ static void launch_rocket(void) {
     }
 }
 
-/* Update and draw particles */
-static void update_particles(void) {
-    register unsigned char i;
-    register unsigned char sx, sy;
-    unsigned char prev_x, prev_y;
-    register Particle *p;
-    unsigned char ch;
-    
-    for (i = 0; i < MAX_PARTICLES; i++) {
-        p = &particles[i];
-        if (p->active) {
-            /* Store old position */
-            prev_x = (p->x >> 8);
-            prev_y = (p->y >> 8);
-            
-            /* Apply velocity */
-            p->x += p->vx;
-            p->y += p->vy;
-            
-            /* Apply gravity */
-            p->vy += 12;
-            
-            /* Apply drag (simplified) */
-            p->vx = (p->vx * 14) >> 4;
-            p->vy = (p->vy * 14) >> 4;
-            
-            /* Get new screen position */
-            sx = (p->x >> 8);
-            sy = (p->y >> 8);
-            
-            /* Decrease life */
-            p->life--;
-            
-            /* Check if dead */
-            if (p->life == 0 || sy >= 25 || sy <= 0 || sx >= 40) {
-                /* Erase before deactivating */
-                if (prev_x < 40 && prev_y < 25 && prev_y > 0) {
-                    POKE(SCREEN(prev_x, prev_y), 32);
-                }
-                p->active = 0;
-                continue;
-            }
-            
-            /* Erase old position if moved */
-            if ((sx != prev_x || sy != prev_y) && prev_x < 40 && prev_y < 25 && prev_y > 0) {
-                POKE(SCREEN(prev_x, prev_y), 32);
-            }
-            
-            /* Draw particle with simple graphics */
-            if (sx < 40 && sy < 25 && sy > 0) {
-                /* Use particle's assigned shape, change to dot when life is low */
-                if (p->life < 5) {
-                    ch = CHAR_DOT;
-                } else if (p->life < 10) {
-                    ch = CHAR_PLUS;
-                } else {
-                    ch = p->shape;
-                }
-                POKE(SCREEN(sx, sy), ch);
-                POKE(COLOR(sx, sy), p->color);
-            }
-        }
-    }
-}
-
 /* Update rockets */
 static void update_rockets(void) {
     register unsigned char i;
@@ -356,10 +287,7 @@ int main(void) {
     /* Initialize */
     init_sid_random();
     
-    /* Clear all particles and rockets */
-    for (i = 0; i < MAX_PARTICLES; i++) {
-        particles[i].active = 0;
-    }
+    /* Clear all rockets */
     for (i = 0; i < MAX_ROCKETS; i++) {
         rockets[i].active = 0;
     }
@@ -374,6 +302,14 @@ int main(void) {
     /* Draw ground */
     draw_ground();
     
+    /* Particles restore this screen as they move */
+    memcpy(bg_chr, (void *)1024, 1000);
+    memcpy(bg_col, (void *)55296, 1000);
+    pt_bg_chr = bg_chr;
+    pt_bg_col = bg_col;
+    pt_init();
+    init_fade();
+    
     /* Main loop */
     while (1) {
         /* No delay - run at full speed */
@@ -394,9 +330,9 @@ int main(void) {
             launch_timer = 0;
         }
         
-        /* Update game objects */
+        /* Update game objects (rockets drawn last, on top) */
+        pt_update();
         update_rockets();
-        update_particles();
         
         /* Turn off sound gate after some time */
         if ((frame & 0x0F) == 0) {
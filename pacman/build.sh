@@ -6,6 +6,8 @@ SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
 
 cl65 -t c64 \
 	-C "$SCRIPT_DIR/pacman.cfg" \
+	-g -m "$SCRIPT_DIR/pacman.map" -Ln "$SCRIPT_DIR/pacman.lbl" \
+	-Wl --dbgfile,"$SCRIPT_DIR/pacman.dbg" \
 	-o "$SCRIPT_DIR/pacman.prg" \
 	"$SCRIPT_DIR/pacman.s"
 
@@ -3,7 +3,7 @@
 cd "$(dirname "$0")"
 
 # Compile and link
-cl65 -t c64 -O -o pacman.prg pacman.c
+cl65 -t c64 -O -I ../common -g -m pacman.map -Ln pacman.lbl -Wl --dbgfile,pacman.dbg -o pacman.prg pacman.c ../common/sprmove.s ../common/shadow.s ../common/sfx.s
 
 if [[ -f pacman.prg ]]; then
     echo "Built pacman.prg ($(stat -c%s pacman.prg) bytes)"
@@ -9,6 +9,10 @@
 #include <stdlib.h>
 #include <joystick.h>
 
+#include "sprmove.h"
+#include "shadow.h"
+#include "sfx.h"
+
 // Screen dimensions
 #define SCREEN_WIDTH  40
 #define SCREEN_HEIGHT 25
@@ -27,17 +31,9 @@
 #define VIC_SPR_DBL_X  (*(unsigned char*)0xD01D)
 #define VIC_SPR_DBL_Y  (*(unsigned char*)0xD017)
 
-// Sprite positions
-#define SPR0_X (*(unsigned char*)0xD000)
-#define SPR0_Y (*(unsigned char*)0xD001)
-#define SPR1_X (*(unsigned char*)0xD002)
-#define SPR1_Y (*(unsigned char*)0xD003)
-#define SPR2_X (*(unsigned char*)0xD004)
-#define SPR2_Y (*(unsigned char*)0xD005)
-#define SPR3_X (*(unsigned char*)0xD006)
-#define SPR3_Y (*(unsigned char*)0xD007)
-#define SPR4_X (*(unsigned char*)0xD008)
-#define SPR4_Y (*(unsigned char*)0xD009)
+// Sprite numbers (ghost n uses sprite SPR_GHOST + n)
+#define SPR_PACMAN 0
+#define SPR_GHOST  1
 
 // Sprite colors
 #define SPR0_COL (*(unsigned char*)0xD027)
@@ -46,6 +42,12 @@
 #define SPR3_COL (*(unsigned char*)0xD02A)
 #define SPR4_COL (*(unsigned char*)0xD02B)
 
+// Shadow offsets of the ghost colors (changed every frame in game_loop)
+#define SHD_SPR1_COL 0x28
+#define SHD_SPR2_COL 0x29
+#define SHD_SPR3_COL 0x2A
+#define SHD_SPR4_COL 0x2B
+
 // Colors
 #define BLACK   0
 #define WHITE   1
@@ -83,16 +85,6 @@
 #define STATE_WON    3
 #define STATE_LOST   4
 
-// SID registers for sound
-#define SID_FREQ_LO    (*(unsigned char*)0xD400)
-#define SID_FREQ_HI    (*(unsigned char*)0xD401)
-#define SID_PW_LO      (*(unsigned char*)0xD402)
-#define SID_PW_HI      (*(unsigned char*)0xD403)
-#define SID_CTRL       (*(unsigned char*)0xD404)
-#define SID_AD         (*(unsigned char*)0xD405)
-#define SID_SR         (*(unsigned char*)0xD406)
-#define SID_VOLUME     (*(unsigned char*)0xD418)
-
 // Sprite data location - use $3000 (block 192) which is safe for cc65
 #define SPRITE_DATA 0x3000
 #define SPRITE_BLOCK_PACMAN_OPEN_R 192   // $3000 / 64 = 192
@@ -239,48 +231,29 @@ static const unsigned char ghost_sprite[] = {
     0x00, 0x00, 0x00
 };
 
-// Wait for vertical blank (smooth animation)
-void wait_vblank(void) {
-    while (VIC.rasterline != 255) ;
-}
+// Sound effects, played from the raster IRQ (see sfx.h)
 
-// Initialize SID for sound effects
-void init_sound(void) {
-    SID_VOLUME = 15;    // Max volume
-    SID_AD = 0x00;      // Fast attack, no decay
-    SID_SR = 0xF0;      // Max sustain, fast release
-}
-
-// Play eat dot sound (short blip)
-void sound_eat(void) {
-    SID_FREQ_LO = 0x00;
-    SID_FREQ_HI = 0x20;   // Medium pitch
-    SID_CTRL = 0x21;      // Sawtooth, gate on
-    // Sound will be turned off next frame
-}
-
-// Play power pellet sound (lower tone)
-void sound_power(void) {
-    SID_FREQ_LO = 0x00;
-    SID_FREQ_HI = 0x10;   // Low pitch
-    SID_CTRL = 0x11;      // Triangle, gate on
-}
+// Eat dot (short blip, sawtooth)
+static const unsigned char fx_eat[] = {
+    SFX_V1, 1, 0x00, 0xF0,
+    SFX_STEP(2, 0x21, 0x2000, 0, 0x08),
+    SFX_END
+};
 
-// Play death sound (descending)
-void sound_die(void) {
-    unsigned char i;
-    for (i = 0x30; i > 0x05; i -= 2) {
-        SID_FREQ_HI = i;
-        SID_CTRL = 0x21;  // Sawtooth
-        wait_vblank();
-    }
-    SID_CTRL = 0x20;      // Gate off
-}
+// Power pellet (lower tone, triangle)
+static const unsigned char fx_power[] = {
+    SFX_V1, 2, 0x00, 0xF0,
+    SFX_STEP(4, 0x11, 0x1000, 0, 0x08),
+    SFX_END
+};
 
-// Turn off sound
-void sound_off(void) {
-    SID_CTRL = 0x20;      // Gate off
-}
+// Death (descending sawtooth)
+#define FX_DIE_FRAMES 22
+static const unsigned char fx_die[] = {
+    SFX_V1, 3, 0x00, 0xF0,
+    SFX_STEP(FX_DIE_FRAMES, 0x21, 0x3000, -2, 0x08),
+    SFX_END
+};
 
 // Copy sprite data to sprite memory
 void init_sprites(void) {
@@ -410,24 +383,24 @@ void init_positions(void) {
     ghost_dir[3] = DIR_LEFT;
 }
 
-// Update sprite positions on screen
+// Update sprite positions and stage them for the raster IRQ flush
 void update_sprites(void) {
+    unsigned char i;
+
     // Pac-Man (sprite 0) - game coords are already screen coords
-    SPR0_X = pacman_x;
-    SPR0_Y = pacman_y;
+    spr_x[SPR_PACMAN] = pacman_x;
+    spr_y[SPR_PACMAN] = pacman_y;
     
     // Ghosts (sprites 1-4)
-    SPR1_X = ghost_x[0];
-    SPR1_Y = ghost_y[0];
-    SPR2_X = ghost_x[1];
-    SPR2_Y = ghost_y[1];
-    SPR3_X = ghost_x[2];
-    SPR3_Y = ghost_y[2];
-    SPR4_X = ghost_x[3];
-    SPR4_Y = ghost_y[3];
+    for (i = 0; i < 4; i++) {
+        spr_x[SPR_GHOST + i] = ghost_x[i];
+        spr_y[SPR_GHOST + i] = ghost_y[i];
+    }
     
     // Ensure sprite 0 is still enabled (debugging)
-    VIC_SPR_ENA |= 0x01;
+    SHD_VIC(SHD_SPR_ENA, shd_vic[SHD_SPR_ENA] | 0x01);
+
+    spr_flush();
 }
 
 static unsigned char is_near_grid(unsigned char coord, unsigned char base, unsigned char tol) {
@@ -613,13 +586,13 @@ void eat_dot(void) {
         screen[screen_pos] = CHAR_SPACE;
         score += 10;
         dots_left--;
-        sound_eat();
+        sfx_play(fx_eat);
     } else if (screen[screen_pos] == CHAR_POWER) {
         screen[screen_pos] = CHAR_SPACE;
         score += 50;
         dots_left--;
         power_timer = 200;
-        sound_power();
+        sfx_play(fx_power);
     }
     
     // Check win condition
@@ -656,7 +629,13 @@ void check_ghost_collision(void) {
 
 // Handle Pac-Man death
 void handle_death(void) {
-    sound_die();
+    unsigned char i;
+
+    // Freeze while the death sound plays
+    sfx_play(fx_die);
+    for (i = 0; i < FX_DIE_FRAMES; i++) {
+        shd_wait();
+    }
     lives--;
     
     if (lives == 0) {
@@ -834,36 +813,31 @@ unsigned char check_fire(void) {
 // Main game loop
 void game_loop(void) {
     while (1) {
-        wait_vblank();
+        shd_wait();
         frame_count++;
         
-        // Turn off sound after short duration
-        if ((frame_count & 3) == 0) {
-            sound_off();
-        }
-        
         // Update power timer
         if (power_timer > 0) {
             power_timer--;
             // Flash ghost colors when power is running out
             if (power_timer < 60 && (frame_count & 4)) {
-                SPR1_COL = WHITE;
-                SPR2_COL = WHITE;
-                SPR3_COL = WHITE;
-                SPR4_COL = WHITE;
+                SHD_VIC(SHD_SPR1_COL, WHITE);
+                SHD_VIC(SHD_SPR2_COL, WHITE);
+                SHD_VIC(SHD_SPR3_COL, WHITE);
+                SHD_VIC(SHD_SPR4_COL, WHITE);
             } else if (power_timer > 0) {
                 // Ghosts are blue (vulnerable)
-                SPR1_COL = BLUE;
-                SPR2_COL = BLUE;
-                SPR3_COL = BLUE;
-                SPR4_COL = BLUE;
+                SHD_VIC(SHD_SPR1_COL, BLUE);
+                SHD_VIC(SHD_SPR2_COL, BLUE);
+                SHD_VIC(SHD_SPR3_COL, BLUE);
+                SHD_VIC(SHD_SPR4_COL, BLUE);
             }
         } else {
             // Normal ghost colors
-            SPR1_COL = RED;
-            SPR2_COL = PURPLE;
-            SPR3_COL = CYAN;
-            SPR4_COL = ORANGE;
+            SHD_VIC(SHD_SPR1_COL, RED);
+            SHD_VIC(SHD_SPR2_COL, PURPLE);
+            SHD_VIC(SHD_SPR3_COL, CYAN);
+            SHD_VIC(SHD_SPR4_COL, ORANGE);
         }
         
         if (game_state == STATE_PLAY) {
@@ -923,8 +897,9 @@ int main(void) {
     bordercolor(BLUE);
     
     // Initialize
-    init_sound();
     init_sprites();
+    shd_install(SHD_LINE);
+    sfx_init();
     
     // Install joystick driver
     joy_install(joy_static_stddrv);
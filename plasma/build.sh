@@ -1,7 +1,7 @@
 #!/bin/bash
 cd "$(dirname "$0")"
 NAME=$(basename "$PWD")
-cl65 -t c64 -O -o ${NAME}.prg ${NAME}.c
+cl65 -t c64 -O -g -m ${NAME}.map -Ln ${NAME}.lbl -Wl --dbgfile,${NAME}.dbg -o ${NAME}.prg ${NAME}.c
 if [[ -f ${NAME}.prg ]]; then
     echo "Built ${NAME}.prg ($(stat -c%s ${NAME}.prg) bytes)"
 else
@@ -3,7 +3,7 @@
 cd "$(dirname "$0")"
 
 # Compile and link
-cl65 -t c64 -O -o pong.prg pong.c
+cl65 -t c64 -O -I ../common -g -m pong.map -Ln pong.lbl -Wl --dbgfile,pong.dbg -o pong.prg pong.c ../common/sprmove.s ../common/ball.s ../common/shadow.s ../common/sfx.s ../common/replay.s
 
 if [[ -f pong.prg ]]; then
     echo "Built pong.prg ($(stat -c%s pong.prg) bytes)"
@@ -9,6 +9,12 @@
 #include <stdlib.h>
 #include <joystick.h>
 
+#include "sprmove.h"
+#include "ball.h"
+#include "shadow.h"
+#include "sfx.h"
+#include "replay.h"
+
 // Screen dimensions
 #define SCREEN_WIDTH  40
 #define SCREEN_HEIGHT 25
@@ -23,13 +29,10 @@
 #define VIC_SPR_DBL_X  (*(unsigned char*)0xD01D)
 #define VIC_SPR_DBL_Y  (*(unsigned char*)0xD017)
 
-// Sprite positions
-#define SPR0_X (*(unsigned char*)0xD000)
-#define SPR0_Y (*(unsigned char*)0xD001)
-#define SPR1_X (*(unsigned char*)0xD002)
-#define SPR1_Y (*(unsigned char*)0xD003)
-#define SPR2_X (*(unsigned char*)0xD004)
-#define SPR2_Y (*(unsigned char*)0xD005)
+// Sprite numbers
+#define SPR_PADDLE1 0
+#define SPR_PADDLE2 1
+#define SPR_BALL    2
 
 // Sprite colors
 #define SPR0_COL (*(unsigned char*)0xD027)
@@ -60,16 +63,6 @@
 #define STATE_SCORE  2
 #define STATE_WON    3
 
-// SID registers for sound
-#define SID_FREQ_LO    (*(unsigned char*)0xD400)
-#define SID_FREQ_HI    (*(unsigned char*)0xD401)
-#define SID_PW_LO      (*(unsigned char*)0xD402)
-#define SID_PW_HI      (*(unsigned char*)0xD403)
-#define SID_CTRL       (*(unsigned char*)0xD404)
-#define SID_AD         (*(unsigned char*)0xD405)
-#define SID_SR         (*(unsigned char*)0xD406)
-#define SID_VOLUME     (*(unsigned char*)0xD418)
-
 // Sprite data location - use $3000 (block 192) which is safe for cc65
 #define SPRITE_DATA 0x3000
 #define SPRITE_BLOCK_PADDLE 192   // $3000 / 64 = 192
@@ -79,23 +72,30 @@
 #define FIELD_TOP     58    // Top boundary (below score area)
 #define FIELD_BOTTOM  242   // Bottom boundary
 #define FIELD_LEFT    24    // Left boundary
-#define FIELD_RIGHT   320   // Right boundary (need MSB for > 255)
+#define FIELD_RIGHT   320   // Right boundary (spr_x carries the MSB)
 
 // Paddle positions (X coordinates in sprite coords)
 #define PADDLE1_X     32    // Left paddle X position
 #define PADDLE2_X     240   // Right paddle X position (fits in 8 bits)
 
-// Ball speed
-#define BALL_SPEED    2
+// Ball start: midway between the paddles (the ball's pixels and the
+// paddles' sit at the same offset inside their sprites)
+#define BALL_START_X  ((PADDLE1_X + PADDLE2_X) / 2)
+#define BALL_START_Y  150
+
+// Ball speed (8.8 fixed point, along its direction): each paddle hit
+// adds BALL_SPEED_UP up to BALL_SPEED_MAX; a point resets it
+#define BALL_SPEED     0x02C0
+#define BALL_SPEED_UP  0x0010
+#define BALL_SPEED_MAX 0x0500
+#define BALL_SERVE_DIR 10       // 43 degrees (see ball.h)
+
+// Ball Y against a paddle's Y where a hit is dead centre
+#define PADDLE_HIT_MID 6
 
 // Game variables
 static unsigned char paddle1_y;      // Left paddle Y (player 1)
 static unsigned char paddle2_y;      // Right paddle Y (player 2 / CPU)
-static unsigned char ball_x;         // Ball X position (low byte)
-static unsigned char ball_x_msb;     // Ball X position MSB (for > 255)
-static unsigned char ball_y;         // Ball Y position
-static signed char ball_dx;          // Ball X velocity
-static signed char ball_dy;          // Ball Y velocity
 static unsigned char score1;         // Player 1 score
 static unsigned char score2;         // Player 2 score
 static unsigned char game_state;
@@ -103,6 +103,7 @@ static unsigned char frame_count;
 static unsigned char serve_delay;    // Delay before serving ball
 static unsigned char two_player;     // 0 = vs CPU, 1 = two players
 static unsigned char winning_score;  // Score to win (default 11)
+static unsigned char cpu_target;     // Ball Y at the CPU paddle (predict_ball)
 
 // Paddle sprite data - tall vertical bar (24 pixels high)
 static const unsigned char paddle_sprite[63] = {
@@ -155,43 +156,28 @@ static const unsigned char ball_sprite[63] = {
     0x00, 0x00, 0x00   // Row 20
 };
 
-// Wait for vertical blank (smooth animation)
-void wait_vblank(void) {
-    while (VIC.rasterline != 255) ;
-}
-
-// Initialize SID for sound effects
-void init_sound(void) {
-    SID_VOLUME = 15;    // Max volume
-    SID_AD = 0x00;      // Fast attack, no decay
-    SID_SR = 0xF0;      // Max sustain, fast release
-}
-
-// Play paddle hit sound (high blip)
-void sound_paddle(void) {
-    SID_FREQ_LO = 0x00;
-    SID_FREQ_HI = 0x30;   // High pitch
-    SID_CTRL = 0x21;      // Sawtooth, gate on
-}
+// Sound effects, played from the raster IRQ (see sfx.h)
 
-// Play wall hit sound (medium blip)
-void sound_wall(void) {
-    SID_FREQ_LO = 0x00;
-    SID_FREQ_HI = 0x20;   // Medium pitch
-    SID_CTRL = 0x11;      // Triangle, gate on
-}
+// Paddle hit (high blip, sawtooth)
+static const unsigned char fx_paddle[] = {
+    SFX_V1, 1, 0x00, 0xF0,
+    SFX_STEP(4, 0x21, 0x3000, 0, 0x08),
+    SFX_END
+};
 
-// Play score sound (low tone)
-void sound_score(void) {
-    SID_FREQ_LO = 0x00;
-    SID_FREQ_HI = 0x10;   // Low pitch
-    SID_CTRL = 0x21;      // Sawtooth, gate on
-}
+// Wall hit (medium blip, triangle)
+static const unsigned char fx_wall[] = {
+    SFX_V1, 1, 0x00, 0xF0,
+    SFX_STEP(4, 0x11, 0x2000, 0, 0x08),
+    SFX_END
+};
 
-// Turn off sound
-void sound_off(void) {
-    SID_CTRL = 0x20;      // Gate off
-}
+// Score (low tone, sawtooth)
+static const unsigned char fx_score[] = {
+    SFX_V1, 2, 0x00, 0xF0,
+    SFX_STEP(8, 0x21, 0x1000, 0, 0x08),
+    SFX_END
+};
 
 // Copy sprite data to sprite memory
 void init_sprites(void) {
@@ -256,44 +242,63 @@ void draw_field(void) {
     }
 }
 
-// Initialize game positions
-void init_positions(void) {
+// Where the CPU paddle has to be: the ball's Y when it reaches the
+// paddle, with its bounces off the top and bottom folded in the way
+// ball_step() makes them. Worked out once per rebound, not per frame.
+void predict_ball(void) {
+    long pos, span;
+    unsigned long dist;
+    int dx = spr_dx[SPR_BALL];
+
+    if (dx <= 0 || spr_x[SPR_BALL] >= PADDLE2_X - 4) {
+        cpu_target = (FIELD_TOP + FIELD_BOTTOM - 8) / 2;  // wait in the middle
+        return;
+    }
+
+    // 8.8 distance to the paddle, then frames to get there
+    dist = ((unsigned long)(PADDLE2_X - 4) << 8)
+         - (((unsigned long)spr_x[SPR_BALL] << 8) | spr_xf[SPR_BALL]);
+    pos = (((long)(spr_y[SPR_BALL] - FIELD_TOP) << 8) | spr_yf[SPR_BALL])
+        + (long)(dist / dx) * spr_dy[SPR_BALL];
+
+    // Unfold the bounces: the path repeats every two field heights
+    span = (long)(FIELD_BOTTOM - 8 - FIELD_TOP) << 8;
+    pos %= 2 * span;
+    if (pos < 0) pos += 2 * span;
+    if (pos > span) pos = 2 * span - pos;
+
+    // Aim a little off the paddle's centre, so rallies vary
+    cpu_target = FIELD_TOP + (unsigned char)(pos >> 8) + (rand() & 15) - 8;
+}
+
+// Initialize game positions; serve is 0 (towards player 2) or
+// BALL_ALONG_NEG (towards player 1)
+void init_positions(unsigned char serve) {
     // Paddles start in center vertically
     paddle1_y = 130;  // Center Y
     paddle2_y = 130;
 
-    // Ball starts in center
-    ball_x = 160;
-    ball_x_msb = 0;
-    ball_y = 150;
-
-    // Random initial direction
-    ball_dx = (rand() & 1) ? BALL_SPEED : -BALL_SPEED;
-    ball_dy = (rand() & 1) ? BALL_SPEED : -BALL_SPEED;
+    // Ball starts in center, at serving speed, up or down at random
+    SPR_PLACE(SPR_BALL, BALL_START_X, BALL_START_Y);
+    ball_speed = BALL_SPEED;
+    ball_aim(BALL_SERVE_DIR | serve | ((rand() & 1) ? BALL_ACROSS_NEG : 0));
+    predict_ball();
 
     serve_delay = 60;  // 1 second delay before ball moves
 }
 
-// Update sprite positions on screen
+// Update paddle positions (the ball lives in spr_x/spr_y already)
+// and stage all sprites for the raster IRQ flush
 void update_sprites(void) {
     // Paddle 1 (left)
-    SPR0_X = PADDLE1_X;
-    SPR0_Y = paddle1_y;
+    spr_x[SPR_PADDLE1] = PADDLE1_X;
+    spr_y[SPR_PADDLE1] = paddle1_y;
 
     // Paddle 2 (right)
-    SPR1_X = PADDLE2_X;
-    SPR1_Y = paddle2_y;
-
-    // Ball
-    SPR2_X = ball_x;
-    SPR2_Y = ball_y;
+    spr_x[SPR_PADDLE2] = PADDLE2_X;
+    spr_y[SPR_PADDLE2] = paddle2_y;
 
-    // Handle X MSB for ball if needed
-    if (ball_x_msb) {
-        VIC_SPR_HI_X |= 0x04;   // Set bit 2 for sprite 2
-    } else {
-        VIC_SPR_HI_X &= ~0x04;  // Clear bit 2
-    }
+    spr_flush();
 }
 
 // Draw score display
@@ -317,7 +322,7 @@ void draw_score(void) {
 void read_input_p1(void) {
     unsigned char joy;
 
-    joy = joy_read(JOY_2);
+    joy = rp_joy(JOY_2);
 
     if (JOY_UP(joy)) {
         if (paddle1_y > FIELD_TOP + 10) {
@@ -335,7 +340,7 @@ void read_input_p1(void) {
 void read_input_p2(void) {
     unsigned char joy;
 
-    joy = joy_read(JOY_1);
+    joy = rp_joy(JOY_1);
 
     if (JOY_UP(joy)) {
         if (paddle2_y > FIELD_TOP + 10) {
@@ -349,33 +354,40 @@ void read_input_p2(void) {
     }
 }
 
-// Simple AI for CPU paddle
+// CPU paddle: heads for the Y predict_ball() worked out at the last
+// rebound
 void cpu_ai(void) {
     signed char diff;
-    unsigned char target_y;
-
-    // AI tracks ball Y position
-    target_y = ball_y;
 
-    // Move every frame for faster reaction
-    // Move towards ball
-    diff = (signed char)(target_y - paddle2_y - 10);  // -10 to center on paddle
+    diff = (signed char)(cpu_target - paddle2_y - PADDLE_HIT_MID);
 
     if (diff > 2) {
         if (paddle2_y < FIELD_BOTTOM - 21) {
-            paddle2_y += 3;  // Faster movement
+            paddle2_y += 3;
         }
     } else if (diff < -2) {
         if (paddle2_y > FIELD_TOP + 10) {
-            paddle2_y -= 3;  // Faster movement
+            paddle2_y -= 3;
         }
     }
 }
 
+// Paddle rebound: a little faster, in the direction the hit offset
+// picks from the ball.s table
+void bounce(unsigned char dir) {
+    if (ball_speed < BALL_SPEED_MAX) {
+        ball_speed += BALL_SPEED_UP;
+    }
+    ball_aim(dir);
+    predict_ball();
+    sfx_play(fx_paddle);
+}
+
 // Move ball and handle collisions
 void move_ball(void) {
-    unsigned char new_y;
-    int full_x;
+    int x, old_x;
+    unsigned char y;
+    signed char offset;
 
     // Wait during serve delay
     if (serve_delay > 0) {
@@ -383,77 +395,51 @@ void move_ball(void) {
         return;
     }
 
-    // Calculate new position
-    full_x = (int)ball_x + (ball_x_msb ? 256 : 0) + ball_dx;
-    new_y = ball_y + ball_dy;
-
-    // Wall collision (top/bottom)
-    if (new_y <= FIELD_TOP || new_y >= FIELD_BOTTOM - 8) {
-        ball_dy = -ball_dy;
-        new_y = ball_y + ball_dy;
-        sound_wall();
+    // Move; ball_step() bounces it off the top and bottom walls
+    old_x = (int)spr_x[SPR_BALL];
+    if (ball_step()) {
+        sfx_play(fx_wall);
     }
+    x = (int)spr_x[SPR_BALL];
+    y = spr_y[SPR_BALL];
+
+    // Paddle collisions test the path the ball took this frame
+    // (old_x to x), so a fast ball cannot jump over a paddle
 
     // Paddle 1 collision (left paddle)
-    if (full_x <= PADDLE1_X + 8 && full_x >= PADDLE1_X - 4) {
-        if (ball_y >= paddle1_y - 8 && ball_y <= paddle1_y + 21) {
-            ball_dx = BALL_SPEED;  // Bounce right
-            // Add spin based on paddle hit position
-            if (ball_y < paddle1_y + 5) {
-                ball_dy = -BALL_SPEED;
-            } else if (ball_y > paddle1_y + 16) {
-                ball_dy = BALL_SPEED;
-            }
-            full_x = PADDLE1_X + 9;
-            sound_paddle();
+    if (x <= PADDLE1_X + 8 && old_x >= PADDLE1_X - 4 && spr_dx[SPR_BALL] < 0) {
+        if (y >= paddle1_y - 8 && y <= paddle1_y + 21) {
+            offset = (signed char)(y - paddle1_y - PADDLE_HIT_MID);
+            x = PADDLE1_X + 9;              // Out of the paddle first, so
+            spr_x[SPR_BALL] = x;            // the prediction starts there
+            bounce(BALL_DIR(offset, 0));
         }
     }
 
     // Paddle 2 collision (right paddle)
-    if (full_x >= PADDLE2_X - 4 && full_x <= PADDLE2_X + 8) {
-        if (ball_y >= paddle2_y - 8 && ball_y <= paddle2_y + 21) {
-            ball_dx = -BALL_SPEED;  // Bounce left
-            // Add spin based on paddle hit position
-            if (ball_y < paddle2_y + 5) {
-                ball_dy = -BALL_SPEED;
-            } else if (ball_y > paddle2_y + 16) {
-                ball_dy = BALL_SPEED;
-            }
-            full_x = PADDLE2_X - 5;
-            sound_paddle();
+    if (x >= PADDLE2_X - 4 && old_x <= PADDLE2_X + 8 && spr_dx[SPR_BALL] > 0) {
+        if (y >= paddle2_y - 8 && y <= paddle2_y + 21) {
+            offset = (signed char)(y - paddle2_y - PADDLE_HIT_MID);
+            x = PADDLE2_X - 5;
+            spr_x[SPR_BALL] = x;
+            bounce(BALL_DIR(offset, 0) | BALL_ALONG_NEG);
         }
     }
 
     // Scoring - ball goes off left side
-    if (full_x < FIELD_LEFT) {
+    if (x < FIELD_LEFT) {
         score2++;
-        sound_score();
-        init_positions();
-        ball_dx = BALL_SPEED;  // Serve towards player 2
+        sfx_play(fx_score);
+        init_positions(0);                  // Serve towards player 2
         return;
     }
 
     // Scoring - ball goes off right side
-    if (full_x > 310) {
+    if (x > FIELD_RIGHT + 10) {
         score1++;
-        sound_score();
-        init_positions();
-        ball_dx = -BALL_SPEED;  // Serve towards player 1
-        return;
+        sfx_play(fx_score);
+        init_positions(BALL_ALONG_NEG);     // Serve towards player 1
     }
-
-    // Update ball position
-    if (full_x >= 256) {
-        ball_x = (unsigned char)(full_x - 256);
-        ball_x_msb = 1;
-    } else if (full_x < 0) {
-        ball_x = 0;
-        ball_x_msb = 0;
-    } else {
-        ball_x = (unsigned char)full_x;
-        ball_x_msb = 0;
-    }
-    ball_y = new_y;
 }
 
 // Check for winner
@@ -512,9 +498,9 @@ unsigned char check_key(void) {
     return 0;
 }
 
-// Check for fire button
+// Check for fire button (this frame's recorded input)
 unsigned char check_fire(void) {
-    unsigned char joy = joy_read(JOY_2);
+    unsigned char joy = rp_joy(JOY_2);
     return JOY_FIRE(joy);
 }
 
@@ -542,14 +528,10 @@ void game_loop(void) {
     unsigned char winner;
 
     while (1) {
-        wait_vblank();
+        shd_wait();
+        rp_frame();
         frame_count++;
 
-        // Turn off sound after short duration
-        if ((frame_count & 7) == 0) {
-            sound_off();
-        }
-
         if (game_state == STATE_PLAY) {
             // Read player 1 input
             read_input_p1();
@@ -592,8 +574,17 @@ int main(void) {
     bgcolor(BLACK);
     bordercolor(BLUE);
 
-    init_sound();
     init_sprites();
+    shd_install(SHD_LINE);
+
+    // Ball physics: main axis X, bouncing off the top and bottom only
+    ball_spr = SPR_BALL;
+    ball_vertical = 0;
+    ball_top = FIELD_TOP;
+    ball_bottom = FIELD_BOTTOM - 8;
+    ball_left = BALL_NO_LEFT;
+    ball_right = BALL_NO_RIGHT;
+    sfx_init();
 
     // Install joystick driver
     joy_install(joy_static_stddrv);
@@ -603,7 +594,7 @@ int main(void) {
 
 title_screen:
     // Show title screen
-    VIC_SPR_ENA = 0;  // Hide sprites on title
+    SHD_VIC(SHD_SPR_ENA, 0);  // Hide sprites on title
     draw_title();
 
     // Wait for mode selection
@@ -619,23 +610,25 @@ title_screen:
             two_player = 1;
             break;
         }
-        // Also accept fire button for 1 player
-        if (check_fire()) {
+        // Also accept fire button for 1 player (or start a replay)
+        if (rp_start()) {
             two_player = 0;
             break;
         }
     }
 
-    // Game setup
+    // Game setup: seed and start logging (or play back) this run; a
+    // playback restores the recorded number of players
+    two_player = (rp_begin(two_player ? RP_2P : 0) & RP_2P) != 0;
     score1 = 0;
     score2 = 0;
     game_state = STATE_PLAY;
 
     // Enable sprites
-    VIC_SPR_ENA = 0x07;
+    SHD_VIC(SHD_SPR_ENA, 0x07);
 
     draw_field();
-    init_positions();
+    init_positions((rand() & 1) ? BALL_ALONG_NEG : 0);
     update_sprites();
 
     // Run game
@@ -0,0 +1,293 @@
+#!/usr/bin/env python3
+"""
+regress.py - Golden-frame regression runner for the C64 projects
+
+Builds each project with build_all.py, runs it in its own headless VICE
+(warp mode, private remote monitor port) with a recorded input log from
+common/replay.s, and at chosen frames compares screen RAM, colour RAM
+and the VIC-II registers against stored golden snapshots.
+
+The replay log holds the game at each chosen frame (header field "hold")
+so snapshots are taken at exact frame boundaries, independent of host
+speed. Projects run in parallel, one VICE per CPU core by default.
+
+Layout:
+    golden/<project>/spec.json       {"prg": "pong.prg", "frames": [100, 400],
+                                      "screen": "0400"}
+    golden/<project>/input.rpl       from ai_toolchain.py --save-replay
+    golden/<project>/frame_00100.json snapshot at frame 100
+
+Usage:
+    python3 regress.py                        # Check every golden project
+    python3 regress.py pong arkanoid          # Check some
+    python3 regress.py -j 4                   # At most 4 emulators
+    python3 regress.py --update pong          # Re-record pong's snapshots
+    python3 regress.py --update pong --replay pong.rpl --frames 100,400
+                                              # Start a new golden set
+
+Requirements:
+    - cc65 (cl65) and VICE (x64sc) on PATH
+    - Games linked with common/replay.s
+
+Author: C64AIToolChain Project
+"""
+
+import argparse
+import json
+import os
+import shutil
+import subprocess
+import sys
+import time
+from concurrent.futures import ThreadPoolExecutor
+from pathlib import Path
+
+from ai_toolchain import (MEM_LINE, REPLAY_BASE, connect_vice, load_replay,
+                          monitor_batch, write_memory)
+from build_all import build_many
+
+ROOT = Path(__file__).resolve().parent
+GOLDEN = ROOT / 'golden'
+
+BASE_PORT = 6520
+VICE = 'x64sc'
+FRAME_TIMEOUT = 30.0     # seconds of warp-mode emulation per snapshot
+
+# Replay header fields used to stop the game at a frame (common/replay.s)
+RP_FRAMES = REPLAY_BASE + 10
+RP_HOLD = REPLAY_BASE + 12
+RP_HELD = REPLAY_BASE + 14
+
+# VIC-II registers compared: positions, control, memory setup, colours.
+# Raster ($D011 bit 7, $D012), IRQ latch ($D019) and the collision
+# latches ($D01E/$D01F) change on their own and are masked out.
+VIC_START, VIC_END = 0xD000, 0xD02E
+VIC_MASK = bytes(
+    0x00 if r in (0xD012, 0xD019, 0xD01E, 0xD01F) else
+    0x7F if r == 0xD011 else
+    0x0F if r >= 0xD020 else 0xFF
+    for r in range(VIC_START, VIC_END + 1))
+
+
+def sys_address(prg):
+    """Start address from the BASIC SYS line of a .prg file."""
+    data = Path(prg).read_bytes()
+    i = data.index(0x9E, 2) + 1
+    digits = ''
+    while i < len(data) and chr(data[i]) in ' 0123456789':
+        digits += chr(data[i])
+        i += 1
+    return int(digits)
+
+
+def read_spans(s, spans):
+    """
+    Bytes of every (start, end) span, all read in one batch that waits
+    for each command's prompt, so no reply is left to be mistaken for a
+    later one. Raises RuntimeError when a byte does not come back.
+    """
+    reply = monitor_batch(s, [f"m {a:04x} {e:04x}" for a, e in spans],
+                          timeout=FRAME_TIMEOUT)
+    mem = {}
+    for line in reply.splitlines():
+        m = MEM_LINE.search(line)
+        if m:
+            addr = int(m.group(1), 16)
+            for i, p in enumerate(m.group(2).split()):
+                mem[addr + i] = int(p, 16)
+    try:
+        return [bytes(mem[a] for a in range(start, end + 1)) for start, end in spans]
+    except KeyError as e:
+        raise RuntimeError(f"monitor did not return ${e.args[0]:04X}") from None
+
+
+def snapshot(s, screen):
+    """Screen, colour RAM and masked VIC registers, as hex rows."""
+    chars, colors, vic = read_spans(s, [(screen, screen + 999), (0xD800, 0xDBE7),
+                                        (VIC_START, VIC_END)])
+    return {
+        'screen': [chars[r * 40:r * 40 + 40].hex() for r in range(25)],
+        'color': [''.join(f"{c & 0x0F:x}" for c in colors[r * 40:r * 40 + 40])
+                  for r in range(25)],
+        'vic': bytes(v & m for v, m in zip(vic, VIC_MASK)).hex(),
+    }
+
+
+def compare(expected, got):
+    """List of human readable differences (empty when equal)."""
+    diffs = []
+    for key, width in (('screen', 2), ('color', 1)):
+        for row, (a, b) in enumerate(zip(expected[key], got[key])):
+            for col in range(40):
+                ea = a[col * width:(col + 1) * width]
+                gb = b[col * width:(col + 1) * width]
+                if ea != gb:
+                    diffs.append(f"{key} ({col},{row}): {ea} -> {gb}")
+    ev, gv = bytes.fromhex(expected['vic']), bytes.fromhex(got['vic'])
+    for i, (a, b) in enumerate(zip(ev, gv)):
+        if a != b:
+            diffs.append(f"vic ${VIC_START + i:04X}: {a:02X} -> {b:02X}")
+    return diffs
+
+
+def resume(s, command):
+    """
+    Send a command that leaves the monitor ("g", "x") and drop whatever
+    the monitor still prints for it or for an earlier, cut-short batch,
+    so the next monitor_batch() counts only its own prompts.
+    """
+    s.sendall(f"{command}\n".encode())
+    blocking = s.gettimeout()
+    s.settimeout(0.05)
+    try:
+        while s.recv(65536):
+            pass
+    except OSError:
+        pass                    # quiet for 50 ms: nothing left to drop
+    finally:
+        s.settimeout(blocking)
+
+
+def wait_held(s, frame):
+    """Resume until the game sits in its hold at frame; False on timeout."""
+    deadline = time.time() + FRAME_TIMEOUT
+    while time.time() < deadline:
+        resume(s, "x")
+        try:
+            h, = read_spans(s, [(RP_FRAMES, RP_HELD)])
+        except RuntimeError:
+            continue
+        if h[4] and (h[0] | h[1] << 8) == frame:
+            return True
+    return False
+
+
+def run_project(name, spec, port, update):
+    """Run one project in its own VICE; returns (name, ok, messages)."""
+    project = ROOT / name
+    golden = GOLDEN / name
+    prg = project / spec['prg']
+    screen = int(spec.get('screen', '0400'), 16)
+    frames = sorted(spec['frames'])
+    messages = []
+
+    vice = subprocess.Popen(
+        [VICE, '-console', '-warp', '-sounddev', 'dummy',
+         '-remotemonitor', '-remotemonitoraddress', f'ip4://127.0.0.1:{port}'],
+        cwd=project, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+    try:
+        s = None
+        for _ in range(50):
+            time.sleep(0.1)
+            s = connect_vice('127.0.0.1', port)
+            if s:
+                break
+        if not s:
+            return name, False, ["VICE did not open its monitor"]
+
+        # Let the KERNAL finish its reset, then load, preload the log, run
+        time.sleep(1.0)
+        monitor_batch(s, [f'l "{prg}" 0'], timeout=FRAME_TIMEOUT)
+        addr, log = load_replay(golden / 'input.rpl')
+        write_memory(s, addr, log)
+        write_memory(s, RP_HOLD, bytes((frames[0] & 0xFF, frames[0] >> 8, 0)))
+        resume(s, f"g {sys_address(prg):04x}")
+
+        ok = True
+        for i, frame in enumerate(frames):
+            if not wait_held(s, frame):
+                return name, False, messages + [f"frame {frame}: never reached"]
+            try:
+                snap = snapshot(s, screen)
+            except RuntimeError as e:
+                return name, False, messages + [f"frame {frame}: {e}"]
+            path = golden / f"frame_{frame:05d}.json"
+            if update:
+                path.write_text(json.dumps(snap, indent=1) + '\n')
+                messages.append(f"frame {frame}: recorded")
+            elif not path.exists():
+                ok = False
+                messages.append(f"frame {frame}: no golden file")
+            else:
+                diffs = compare(json.loads(path.read_text()), snap)
+                if diffs:
+                    ok = False
+                    messages.append(f"frame {frame}: {len(diffs)} differences")
+                    messages.extend('  ' + d for d in diffs[:8])
+            nxt = frames[i + 1] if i + 1 < len(frames) else 0
+            write_memory(s, RP_HOLD, bytes((nxt & 0xFF, nxt >> 8)))
+        s.sendall(b"quit\n")
+        s.close()
+        return name, ok, messages
+    finally:
+        try:
+            vice.wait(timeout=2)
+        except subprocess.TimeoutExpired:
+            vice.kill()
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Golden-frame regression runner')
+    parser.add_argument('projects', nargs='*', help='Projects (default: all golden)')
+    parser.add_argument('-j', '--jobs', type=int, default=os.cpu_count() or 1,
+                        help='Emulators in parallel')
+    parser.add_argument('--update', action='store_true',
+                        help='Record snapshots instead of comparing')
+    parser.add_argument('--replay', metavar='FILE',
+                        help='With --update: input log for a new golden set')
+    parser.add_argument('--frames', help='With --update: frames, e.g. 100,400')
+    parser.add_argument('--no-build', action='store_true', help='Skip the build')
+    args = parser.parse_args()
+
+    if args.replay or args.frames:
+        if not (args.update and args.replay and args.frames
+                and len(args.projects) == 1):
+            parser.error('--replay and --frames start one project with --update')
+        name = args.projects[0]
+        golden = GOLDEN / name
+        golden.mkdir(parents=True, exist_ok=True)
+        shutil.copyfile(args.replay, golden / 'input.rpl')
+        prg = sorted(p.name for p in (ROOT / name).glob('*.prg'))
+        spec = {'prg': prg[0] if prg else f'{name}.prg',
+                'frames': [int(f) for f in args.frames.split(',')]}
+        (golden / 'spec.json').write_text(json.dumps(spec, indent=1) + '\n')
+
+    names = args.projects or sorted(
+        p.parent.name for p in GOLDEN.glob('*/spec.json'))
+    if not names:
+        print("No golden sets. Start one with:")
+        print("  python3 regress.py --update <project> --replay run.rpl --frames 100,400")
+        return 1
+
+    specs = {}
+    for name in names:
+        spec_path = GOLDEN / name / 'spec.json'
+        if not spec_path.exists():
+            print(f"✗ {name}: no {spec_path.relative_to(ROOT)}")
+            return 1
+        specs[name] = json.loads(spec_path.read_text())
+
+    if not args.no_build and not build_many(names, args.jobs, quiet=True):
+        return 1
+
+    start = time.time()
+    with ThreadPoolExecutor(max_workers=max(1, args.jobs)) as pool:
+        jobs = [pool.submit(run_project, name, specs[name], BASE_PORT + i,
+                            args.update)
+                for i, name in enumerate(names)]
+        results = [job.result() for job in jobs]
+
+    failed = 0
+    for name, ok, messages in results:
+        print(f"{'✓' if ok else '✗'} {name}")
+        for m in messages:
+            print(f"    {m}")
+        failed += not ok
+    print(f"{len(results) - failed}/{len(results)} passed "
+          f"in {time.time() - start:.1f}s")
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
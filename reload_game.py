@@ -11,6 +11,19 @@ Usage:
     python3 reload_game.py tetris_v1    # Reload tetris_v1/tetris_v1.prg
     python3 reload_game.py path/to/game.prg  # Reload specific file
     python3 reload_game.py --start 080d snake  # Override start address (hex)
+    python3 reload_game.py --patch tetris_v1   # Write only changed bytes, restart
+    python3 reload_game.py --keep pong         # Write only changed bytes, keep
+                                               # running (zero page, BSS, state)
+
+Patch mode compares the new .prg with the copy saved at the last reload
+(.buildcache/reload/) and with what is in C64 memory right now (one
+monitor "save" to a temp file), then writes just the changed byte ranges
+with ">" commands, batched into one socket write, with warp on. Bytes the
+game changed itself (initialised data) are left alone with --keep and
+restored to their initial values otherwise. --keep falls back to a
+restart when the memory layout moved (image size or .map segments
+changed); a full load is used when nothing was reloaded before or the
+memory no longer holds the last image (e.g. after a VICE reset).
 
 Requirements:
     - VICE running with -remotemonitor flag (port 6510)
@@ -18,16 +31,31 @@ Requirements:
 Author: C64AIToolChain Project
 """
 
+import hashlib
+import os
+import re
+import shutil
 import socket
-import time
 import sys
-import os
+import tempfile
+import time
+
+from ai_toolchain import monitor_batch
 
 
 # Default machine-code entrypoint address after the embedded BASIC SYS stub.
 # Most programs in this repo end up starting at $0810.
 DEFAULT_START_ADDR = 0x0810
 
+# Copies of the last image reloaded, to diff the next build against
+RELOAD_CACHE = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                            '.buildcache', 'reload')
+
+PATCH_GAP = 8          # merge changed ranges closer than this
+PATCH_CHUNK = 32       # bytes per '>' command
+MAX_DRIFT = 0.25       # memory differing more than this from the last
+                       # image means something else is loaded
+
 
 def connect_vice(host='localhost', port=6510, timeout=3.0):
     """
@@ -91,6 +119,158 @@ def send_command(s, cmd, timeout=1.0):
         return ""
 
 
+def read_image(s, start, length):
+    """
+    Read C64 memory with one monitor save to a temp file.
+
+    Returns:
+        bytes, or None if VICE did not write the file
+    """
+    fd, path = tempfile.mkstemp(suffix='.prg')
+    os.close(fd)
+    try:
+        monitor_batch(s, f's "{path}" 0 {start:04x} {start + length - 1:04x}')
+        with open(path, 'rb') as f:
+            data = f.read()[2:]
+        return data if len(data) == length else None
+    finally:
+        os.unlink(path)
+
+
+def diff_ranges(old, new, gap=PATCH_GAP):
+    """
+    Changed byte ranges between two images of the same load address.
+
+    Returns:
+        List of (offset, bytes) with ranges closer than gap merged
+    """
+    ranges = []
+    start = end = None
+    for i, b in enumerate(new):
+        if i < len(old) and old[i] == b:
+            continue
+        if start is not None and i - end <= gap:
+            end = i + 1
+        else:
+            if start is not None:
+                ranges.append((start, new[start:end]))
+            start, end = i, i + 1
+    if start is not None:
+        ranges.append((start, new[start:end]))
+    return ranges
+
+
+def map_segments(map_path):
+    """Segment list of an ld65 map file (None without one)."""
+    try:
+        with open(map_path) as f:
+            text = f.read()
+    except OSError:
+        return None
+    m = re.search(r'Segment list:\n-+\n(.*?)\n\n', text, re.S)
+    return m.group(1) if m else None
+
+
+def cached_copy(prg_path):
+    """Path of the saved copy of the last reload of prg_path."""
+    tag = hashlib.sha1(prg_path.encode()).hexdigest()[:8]
+    name = os.path.splitext(os.path.basename(prg_path))[0]
+    return os.path.join(RELOAD_CACHE, f"{name}-{tag}.prg")
+
+
+def remember(prg_path):
+    """Save the image (and its .map) just loaded for the next patch."""
+    os.makedirs(RELOAD_CACHE, exist_ok=True)
+    copy = cached_copy(prg_path)
+    shutil.copyfile(prg_path, copy)
+    map_path = os.path.splitext(prg_path)[0] + '.map'
+    if os.path.exists(map_path):
+        shutil.copyfile(map_path, os.path.splitext(copy)[0] + '.map')
+
+
+def patch_game(prg_path, host='localhost', port=6510,
+               start_addr=DEFAULT_START_ADDR, keep_state=False):
+    """
+    Reload a .prg by writing only what changed since the last reload.
+
+    Args:
+        prg_path: Absolute path to the .prg file
+        host: VICE host
+        port: VICE monitor port
+        start_addr: Entry point used when the game restarts
+        keep_state: Resume where the game was instead of restarting
+
+    Returns:
+        True on success, False on failure
+    """
+    t0 = time.time()
+    with open(prg_path, 'rb') as f:
+        new = f.read()
+    copy = cached_copy(prg_path)
+    old = None
+    if os.path.exists(copy):
+        with open(copy, 'rb') as f:
+            old = f.read()
+    if not old or old[:2] != new[:2]:
+        print("No earlier reload of this image: full load")
+        return reload_game(prg_path, host, port, start_addr)
+
+    s = connect_vice(host, port)
+    if not s:
+        return False
+    try:
+        load = new[0] | new[1] << 8
+        old, new = old[2:], new[2:]
+        mem = read_image(s, load, len(new))
+        if mem is None:
+            print("Could not read C64 memory: full load")
+            s.close()
+            return reload_game(prg_path, host, port, start_addr)
+        common = min(len(old), len(mem))
+        drift = sum(a != b for a, b in zip(old[:common], mem[:common]))
+        if drift > MAX_DRIFT * max(common, 1):
+            print("Memory no longer holds the last image: full load")
+            s.close()
+            return reload_game(prg_path, host, port, start_addr)
+
+        if keep_state:
+            old_map = map_segments(os.path.splitext(copy)[0] + '.map')
+            new_map = map_segments(os.path.splitext(prg_path)[0] + '.map')
+            if len(old) != len(new) or old_map != new_map:
+                print("Memory layout changed: restarting instead of keeping state")
+                keep_state = False
+
+        # Keeping state: only what the build changed. Restarting: also
+        # bytes the game changed at run time, as a fresh load would.
+        ranges = diff_ranges(old if keep_state else mem, new)
+        commands = ['warp on']
+        for offset, data in ranges:
+            for i in range(0, len(data), PATCH_CHUNK):
+                values = ' '.join(f"{b:02x}" for b in data[i:i + PATCH_CHUNK])
+                commands.append(f"> {load + offset + i:04x} {values}")
+        commands.append('warp off')
+        if not monitor_batch(s, commands):
+            print("Patch error: no reply from VICE")
+            return False
+        s.sendall(b"x\n" if keep_state else f"g {start_addr:04x}\n".encode())
+        remember(prg_path)
+
+        size = sum(len(d) for _, d in ranges)
+        how = "state kept" if keep_state else "restarted"
+        print(f"✓ Patched {size} bytes in {len(ranges)} ranges, {how} "
+              f"({(time.time() - t0) * 1000:.0f} ms)")
+        return True
+
+    except Exception as e:
+        print(f"Error during patch: {e}")
+        return False
+    finally:
+        try:
+            s.close()
+        except:
+            pass
+
+
 def resolve_prg_path(game_arg):
     """
     Resolve the .prg file path from the argument.
@@ -147,14 +327,14 @@ def reload_game(prg_path, host='localhost', port=6510, start_addr=DEFAULT_START_
     try:
         print(f"Loading: {prg_path}")
         
-        # Load program to memory (device 0 = computer memory)
-        response = send_command(s, f'l "{prg_path}" 0', timeout=2.0)
+        # Load program to memory (device 0 = computer memory), in warp
+        monitor_batch(s, 'warp on')
+        response = monitor_batch(s, f'l "{prg_path}" 0')
+        monitor_batch(s, 'warp off')
         if "Error" in response or "error" in response:
             print(f"Load error: {response}")
             return False
-        
-        # Small delay to ensure load completes
-        time.sleep(0.2)
+        remember(prg_path)
         
         # Start execution at $0810 by default.
         # Most programs in this repo embed a small BASIC stub that does SYS 2061/2064,
@@ -181,6 +361,10 @@ def main():
     start_addr = DEFAULT_START_ADDR
     args = sys.argv[1:]
 
+    keep_state = '--keep' in args
+    patch = keep_state or '--patch' in args
+    args = [a for a in args if a not in ('--keep', '--patch')]
+
     # Optional: allow overriding start address (hex), e.g. --start 080d
     if '--start' in args:
         try:
@@ -209,7 +393,11 @@ def main():
         return 1
     
     # Reload
-    success = reload_game(prg_path, start_addr=start_addr)
+    if patch:
+        success = patch_game(prg_path, start_addr=start_addr,
+                             keep_state=keep_state)
+    else:
+        success = reload_game(prg_path, start_addr=start_addr)
     return 0 if success else 1
 
 
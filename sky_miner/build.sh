@@ -2,6 +2,6 @@
 set -euo pipefail
 
 cd "$(dirname "$0")"
-cl65 -t c64 -O -o sky_miner.prg sky_miner.c
+cl65 -t c64 -O -I ../common -g -m sky_miner.map -Ln sky_miner.lbl -Wl --dbgfile,sky_miner.dbg -o sky_miner.prg sky_miner.c ../common/replay.s ../common/rng.s
 
 echo "Built sky_miner.prg ($(stat -c%s sky_miner.prg) bytes)"
@@ -2,6 +2,9 @@
 #include <joystick.h>
 #include <stdlib.h>
 
+#include "replay.h"
+#include "rng.h"
+
 #define PLAY_X 4
 #define PLAY_Y 4
 #define PLAY_W 32
@@ -55,6 +58,20 @@ static unsigned char obj_x[MAX_OBJECTS];
 static unsigned char obj_y[MAX_OBJECTS];
 static unsigned char obj_type[MAX_OBJECTS];
 
+/* Live slots sit in obj_live[0..obj_count-1] in no particular order, free
+ * ones on the obj_free stack, so per-frame loops only visit live objects.
+ * A slot keeps its sprite (slot + 1) while it is live. */
+static unsigned char obj_live[MAX_OBJECTS];
+static unsigned char obj_count;
+static unsigned char obj_free[MAX_OBJECTS];
+static unsigned char obj_free_top;
+
+/* Threat histogram: lane_value[lane + 1] is what the live objects over
+ * that lane and its two neighbours are worth to the ship. Objects add
+ * their share when they spawn, adjust it as they fall and take it back
+ * when they go, so the demo pilot reads a lane instead of scanning. */
+static signed char lane_value[PLAY_W + 2];
+
 static unsigned char player_x;
 static unsigned char lives;
 static unsigned int score;
@@ -147,12 +164,6 @@ static void sid_off(void) {
     SID.v1.ctrl = 0;
 }
 
-static void seed_rng(void) {
-    unsigned int seed;
-    seed = (*(unsigned char*)0xDC04) | ((unsigned int)(*(unsigned char*)0xDC05) << 8);
-    srand(seed);
-}
-
 static void sprite_copy(unsigned char block, const unsigned char* data) {
     unsigned char* dest;
     unsigned char i;
@@ -298,66 +309,98 @@ static void draw_hud(void) {
     put_uint(25, 1, combo, 1, PURPLE);
 }
 
+static signed char object_worth(unsigned char i) {
+    if (obj_type[i] == TYPE_METEOR) {
+        return (obj_y[i] >= PLAY_H - 6) ? -45 : -10;
+    }
+    if (obj_type[i] == TYPE_CRYSTAL) {
+        return (signed char)(10 + obj_y[i]);
+    }
+    return (signed char)(6 + obj_y[i]);
+}
+
+static void lane_add(unsigned char i, signed char worth) {
+    signed char* lane;
+    lane = &lane_value[obj_x[i]];
+    lane[0] += worth;
+    lane[1] += worth;
+    lane[2] += worth;
+}
+
 static void reset_objects(void) {
     unsigned char i;
     for (i = 0; i < MAX_OBJECTS; ++i) {
         obj_type[i] = TYPE_NONE;
-        obj_x[i] = 0;
-        obj_y[i] = 0;
+        obj_free[i] = (unsigned char)(MAX_OBJECTS - 1 - i);  /* slot 0 on top */
+    }
+    obj_free_top = MAX_OBJECTS;
+    obj_count = 0;
+    for (i = 0; i < PLAY_W + 2; ++i) {
+        lane_value[i] = 0;
+    }
+}
+
+static void add_object(unsigned char type, unsigned char x, unsigned char y) {
+    unsigned char i;
+
+    if (obj_free_top == 0) {
+        return;
     }
+    i = obj_free[--obj_free_top];
+    obj_live[obj_count++] = i;
+    obj_type[i] = type;
+    obj_x[i] = x;
+    obj_y[i] = y;
+    lane_add(i, object_worth(i));
+}
+
+/* Retire the n-th live object; the last live one takes its place */
+static void remove_object(unsigned char n) {
+    unsigned char i;
+
+    i = obj_live[n];
+    lane_add(i, (signed char)-object_worth(i));
+    obj_type[i] = TYPE_NONE;
+    obj_live[n] = obj_live[--obj_count];
+    obj_free[obj_free_top++] = i;
 }
 
 static void seed_demo_objects(void) {
-    obj_type[0] = TYPE_CRYSTAL;
-    obj_x[0] = 8;
-    obj_y[0] = 3;
-    obj_type[1] = TYPE_METEOR;
-    obj_x[1] = 16;
-    obj_y[1] = 5;
-    obj_type[2] = TYPE_CRYSTAL;
-    obj_x[2] = 24;
-    obj_y[2] = 2;
-    obj_type[3] = TYPE_REPAIR;
-    obj_x[3] = 28;
-    obj_y[3] = 8;
-    obj_type[4] = TYPE_METEOR;
-    obj_x[4] = 5;
-    obj_y[4] = 9;
+    add_object(TYPE_CRYSTAL, 8, 3);
+    add_object(TYPE_METEOR, 16, 5);
+    add_object(TYPE_CRYSTAL, 24, 2);
+    add_object(TYPE_REPAIR, 28, 8);
+    add_object(TYPE_METEOR, 5, 9);
 }
 
 static void spawn_object(void) {
-    unsigned char i;
     unsigned char roll;
+    unsigned char type;
 
-    for (i = 0; i < MAX_OBJECTS; ++i) {
-        if (obj_type[i] == TYPE_NONE) {
-            roll = (unsigned char)(rand() % 100);
-            if (roll < 8) {
-                obj_type[i] = TYPE_REPAIR;
-            } else if (roll < 45) {
-                obj_type[i] = TYPE_CRYSTAL;
-            } else {
-                obj_type[i] = TYPE_METEOR;
-            }
-            obj_x[i] = (unsigned char)(rand() % PLAY_W);
-            obj_y[i] = 0;
-            return;
-        }
+    if (obj_free_top == 0) {
+        return;
+    }
+    roll = rng_next();
+    if (roll < RNG_PCT(8)) {
+        type = TYPE_REPAIR;
+    } else if (roll < RNG_PCT(45)) {
+        type = TYPE_CRYSTAL;
+    } else {
+        type = TYPE_METEOR;
     }
+    add_object(type, rng_below(PLAY_W), 0);
 }
 
 static void update_object_sprites(void) {
+    unsigned char n;
     unsigned char i;
     unsigned char spr;
     unsigned char enabled;
 
     enabled = 1;
-    for (i = 0; i < MAX_OBJECTS; ++i) {
+    for (n = 0; n < obj_count; ++n) {
+        i = obj_live[n];
         spr = (unsigned char)(i + 1);
-        if (obj_type[i] == TYPE_NONE) {
-            continue;
-        }
-
         if (obj_type[i] == TYPE_CRYSTAL) {
             SPRITE_PTRS[spr] = SPR_BLOCK_CRYSTAL;
             SPR_COL(spr) = YELLOW;
@@ -383,7 +426,7 @@ static void update_player_sprite(void) {
 
 static void move_player_human(void) {
     unsigned char joy;
-    joy = joy_read(JOY_2);
+    joy = rp_joy(JOY_2);
 
     if ((joy & JOY_LEFT_MASK) != 0 && player_x > 1) {
         --player_x;
@@ -393,39 +436,18 @@ static void move_player_human(void) {
     }
 }
 
-static signed char lane_score(unsigned char lane) {
-    unsigned char i;
-    signed char value;
-
-    value = 0;
-    for (i = 0; i < MAX_OBJECTS; ++i) {
-        if (obj_type[i] == TYPE_NONE) {
-            continue;
-        }
-        if (obj_x[i] == lane || obj_x[i] + 1 == lane || (obj_x[i] > 0 && obj_x[i] - 1 == lane)) {
-            if (obj_type[i] == TYPE_METEOR) {
-                value -= (obj_y[i] >= PLAY_H - 6) ? 45 : 10;
-            } else if (obj_type[i] == TYPE_CRYSTAL) {
-                value += (signed char)(10 + obj_y[i]);
-            } else {
-                value += (signed char)(6 + obj_y[i]);
-            }
-        }
-    }
-    if (lane == 0 || lane == PLAY_W - 1) {
-        value -= 2;
-    }
-    return value;
-}
+/* The ship stays in lanes 1..PLAY_W-2, so every lane it weighs is inside
+ * the histogram */
+#define LANE_SCORE(lane) (lane_value[(lane) + 1])
 
 static void move_player_demo(void) {
     signed char left_score;
     signed char here_score;
     signed char right_score;
 
-    here_score = lane_score(player_x);
-    left_score = (player_x > 1) ? lane_score(player_x - 1) : -100;
-    right_score = (player_x < PLAY_W - 2) ? lane_score(player_x + 1) : -100;
+    here_score = LANE_SCORE(player_x);
+    left_score = (player_x > 1) ? LANE_SCORE(player_x - 1) : -100;
+    right_score = (player_x < PLAY_W - 2) ? LANE_SCORE(player_x + 1) : -100;
 
     if (left_score > here_score && left_score >= right_score) {
         --player_x;
@@ -460,19 +482,20 @@ static void add_score(unsigned char amount) {
 }
 
 static void step_objects(void) {
+    unsigned char n;
     unsigned char i;
+    signed char worth;
 
-    for (i = 0; i < MAX_OBJECTS; ++i) {
-        if (obj_type[i] == TYPE_NONE) {
-            continue;
-        }
-
-        if (obj_y[i] < PLAY_H - 3) {
-            ++obj_y[i];
-        } else {
-            obj_type[i] = TYPE_NONE;
+    n = 0;
+    while (n < obj_count) {
+        i = obj_live[n];
+        if (obj_y[i] >= PLAY_H - 3) {
+            remove_object(n);
             continue;
         }
+        worth = object_worth(i);
+        ++obj_y[i];
+        lane_add(i, (signed char)(object_worth(i) - worth));
 
         if (obj_y[i] >= PLAY_H - 4 && obj_x[i] >= player_x - 1 && obj_x[i] <= player_x + 1) {
             if (obj_type[i] == TYPE_CRYSTAL) {
@@ -492,8 +515,10 @@ static void step_objects(void) {
                 }
                 sid_beep(0x0500, 0x40);
             }
-            obj_type[i] = TYPE_NONE;
+            remove_object(n);
+            continue;
         }
+        ++n;
     }
 
     if (combo_timer > 0) {
@@ -527,7 +552,7 @@ static void title_screen(void) {
     wait_count = 0;
     do {
         wait_frame();
-        if ((joy_read(JOY_2) & JOY_FIRE_MASK) != 0) {
+        if (rp_start()) {
             demo_mode = 0;
             fire_detected = 1;
         }
@@ -558,7 +583,7 @@ static void game_over_screen(void) {
     }
 
     put_text(8, 15, "FIRE TO RETURN MENU", CYAN);
-    while ((joy_read(JOY_2) & JOY_FIRE_MASK) == 0) {
+    while (!rp_start()) {
         wait_frame();
     }
     while ((joy_read(JOY_2) & JOY_FIRE_MASK) != 0) {
@@ -594,11 +619,13 @@ static void init_game(void) {
 
 int main(void) {
     joy_install(joy_static_stddrv);
-    seed_rng();
     demo_mode = 1;
 
     while (1) {
         title_screen();
+        /* seed, then log (or play back) this run; demos are not logged */
+        demo_mode = rp_begin(demo_mode ? RP_DEMO : 0) & RP_DEMO;
+        rng_seed((unsigned char)rand());
         init_game();
 
         while (!game_over) {
@@ -606,6 +633,7 @@ int main(void) {
             unsigned char spawn_rate;
 
             wait_frame();
+            rp_frame();
             ++tick;
             move_player();
 
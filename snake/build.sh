@@ -1,2 +1,2 @@
 #!/bin/bash
-cl65 -C snake.cfg -m snake.map -o snake.prg snake.s
+cl65 -C snake.cfg -g -m snake.map -Ln snake.lbl -Wl --dbgfile,snake.dbg -o snake.prg snake.s
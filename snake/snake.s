@@ -31,14 +31,18 @@ apple_y:    .res 1
 score:      .res 1
 grow:       .res 1   ; Flag to grow snake
 tick:       .res 1   ; Free running counter for RNG
-tmp_lo:     .res 1   ; Temp for math
-tmp_hi:     .res 1
+cell_x:     .res 1   ; Cell argument for occupancy/plot routines
+cell_y:     .res 1
+occ_mask:   .res 1   ; Bit mask of the cell being tested/updated
+scan_cnt:   .res 1   ; Loop counter for bounded scans
 
 ; --- BSS Segment (Uninitialized Data) ---
 ; The linker places these in RAM after the code
 .segment "BSS"
 tail_x_buf: .res 256
 tail_y_buf: .res 256
+occ_map:    .res 125 ; Occupancy bitmap: 25 rows x 5 bytes (1 bit per cell)
+row_free:   .res 25  ; Number of free cells left in each row
 
 ; --- BASIC Header ---
 .segment "HEADER"
@@ -202,13 +206,28 @@ init_vars:
     lda #4      
     sta head_idx
 
-    ; Initialize snake body in buffer to avoid clearing garbage (and potentially code!)
+    jsr init_occupancy
+
+    ; Initialize snake body in buffer as a real 4-cell body (17-20,12),
+    ; the head last, so every ring buffer entry maps to exactly one
+    ; occupied cell and the body joins the head
     ldx #0
 init_body_loop:
-    lda #20
+    txa
+    clc
+    adc #17
     sta tail_x_buf, x
+    sta cell_x
     lda #12
     sta tail_y_buf, x
+    sta cell_y
+    txa
+    pha
+    jsr occ_set
+    lda #CHAR_SNAKE
+    jsr plot_cell
+    pla
+    tax
     inx
     cpx #4
     bne init_body_loop
@@ -297,18 +316,24 @@ move_right:
     rts
 
 check_collision:
-    ; Calculate pointer to new head position
-    jsr calc_screen_pos
+    ; O(1) lookup in the occupancy bitmap (walls, trees and body)
+    lda head_x
+    sta cell_x
+    lda head_y
+    sta cell_y
+    jsr occ_test
+    bne game_over
     
-    ldy #0
-    lda (ptr_lo), y
+    ; Claim the cell now so spawn_apple can't pick the head position
+    jsr occ_set
     
-    cmp #CHAR_APPLE
+    lda head_x
+    cmp apple_x
+    bne no_apple
+    lda head_y
+    cmp apple_y
     beq eat_apple
-    
-    cmp #CHAR_SPACE
-    bne game_over
-    
+no_apple:
     rts
 
 eat_apple:
@@ -324,48 +349,37 @@ game_over:
     jmp start
 
 update_screen:
+    ; Only the head and tail cells change: draw the new head, erase the
+    ; oldest ring buffer entry. head_x/head_y are never clobbered.
     ldx head_idx
     lda head_x
     sta tail_x_buf, x
+    sta cell_x
     lda head_y
     sta tail_y_buf, x
-    
-    jsr calc_screen_pos
-    ldy #0
+    sta cell_y
     lda #CHAR_SNAKE
-    sta (ptr_lo), y
+    jsr plot_cell
+    inc head_idx
     
     ; Check if growing
     lda grow
     beq do_tail
     dec grow
-    jmp skip_tail ; Don't clear tail, don't inc tail_idx -> snake grows
+    jmp draw_score ; Don't clear tail, don't inc tail_idx -> snake grows
     
 do_tail:
     ldx tail_idx
     lda tail_x_buf, x
-    sta head_x     
+    sta cell_x
     lda tail_y_buf, x
-    sta head_y
-    
-    jsr calc_screen_pos
-    ldy #0
+    sta cell_y
+    jsr occ_clear
     lda #CHAR_SPACE
-    sta (ptr_lo), y
-    
+    jsr plot_cell
     inc tail_idx
 
-skip_tail:
-    inc head_idx
-    
-    ; Restore actual head pos
-    ldx head_idx
-    dex
-    lda tail_x_buf, x
-    sta head_x
-    lda tail_y_buf, x
-    sta head_y
-    
+draw_score:
     ; Draw Score (simple hex at center top)
     lda score
     and #$0F ; Lower nibble
@@ -394,115 +408,182 @@ store_digit_2:
     
     rts
 
-calc_screen_pos:
-    ; Calculate y * 40 = y * 32 + y * 8
-    lda #0
-    sta ptr_hi
-    lda head_y
-    sta ptr_lo
-    
-    ; * 2
-    asl ptr_lo
-    rol ptr_hi
-    ; * 4
-    asl ptr_lo
-    rol ptr_hi
-    ; * 8
-    asl ptr_lo
-    rol ptr_hi
-    
-    ; Save y*8
-    lda ptr_lo
-    sta tmp_lo
-    lda ptr_hi
-    sta tmp_hi
-    
-    ; * 16
-    asl ptr_lo
-    rol ptr_hi
-    ; * 32
-    asl ptr_lo
-    rol ptr_hi
-    
-    ; Add y*8 to y*32
-    lda ptr_lo
+; --- Screen addressing ---
+
+cell_ptr:
+    ; A = x, Y = y -> ptr_lo/ptr_hi = SCREEN_RAM + y*40 + x
     clc
-    adc tmp_lo
+    adc row_lo, y
     sta ptr_lo
-    lda ptr_hi
-    adc tmp_hi
-    sta ptr_hi
-    
-    ; Add Screen Base
-    lda ptr_hi
-    clc
-    adc #>SCREEN_RAM
+    lda row_hi, y
+    adc #0
     sta ptr_hi
-    
-    ; Add X pos
-    lda ptr_lo
+    rts
+
+plot_cell:
+    ; Write char in A to (cell_x, cell_y)
+    pha
+    lda cell_x
+    ldy cell_y
+    jsr cell_ptr
+    pla
+    ldy #0
+    sta (ptr_lo), y
+    rts
+
+; --- Occupancy bitmap ---
+; One bit per screen cell, 5 bytes per row. Walls, trees and the snake
+; body are set; the apple is not. row_free keeps a per-row count of clear
+; bits so spawn_apple can find a free cell without random retries.
+
+init_occupancy:
+    ldy #24
+occ_init_row:
+    ldx occ_row, y
+    lda #$01        ; x = 0 (left wall)
+    sta occ_map, x
+    lda #0
+    sta occ_map + 1, x
+    sta occ_map + 2, x
+    sta occ_map + 3, x
+    lda #$80        ; x = 39 (right wall)
+    sta occ_map + 4, x
+    lda #38
+    sta row_free, y
+    dey
+    bpl occ_init_row
+    
+    ; Top and bottom walls are fully occupied
+    lda #$FF
+    ldx #4
+occ_init_tb:
+    sta occ_map, x          ; Row 0
+    sta occ_map + 120, x    ; Row 24
+    dex
+    bpl occ_init_tb
+    lda #0
+    sta row_free
+    sta row_free + 24
+    rts
+
+occ_locate:
+    ; (cell_x, cell_y) -> X = byte offset in occ_map, A = bit mask
+    lda cell_x
+    lsr
+    lsr
+    lsr
+    ldy cell_y
     clc
-    adc head_x
-    sta ptr_lo
-    bcc done_calc
-    inc ptr_hi
-done_calc:
+    adc occ_row, y
+    tax
+    lda cell_x
+    and #7
+    tay
+    lda bit_mask, y
+    rts
+
+occ_test:
+    ; Z = 1 if (cell_x, cell_y) is free
+    jsr occ_locate
+    and occ_map, x
+    rts
+
+occ_set:
+    jsr occ_locate
+    sta occ_mask
+    and occ_map, x
+    bne occ_done    ; Already occupied, keep row_free exact
+    lda occ_mask
+    ora occ_map, x
+    sta occ_map, x
+    ldy cell_y
+    dec row_free, y
+occ_done:
+    rts
+
+occ_clear:
+    jsr occ_locate
+    sta occ_mask
+    and occ_map, x
+    beq occ_done    ; Already free
+    lda occ_mask
+    eor #$FF
+    and occ_map, x
+    sta occ_map, x
+    ldy cell_y
+    inc row_free, y
     rts
 
 spawn_apple:
-    ; Improved random using CIA Timer A (1MHz)
+    ; Random starting row 0-24 (folded, no retry)
     lda $DC04   ; CIA1 Timer A Lo (changes very fast)
     eor tick    ; Mix with frame counter
     adc $D012   ; Mix with raster
     and #$1F    ; 0-31
     cmp #25
-    bcs spawn_apple ; Retry if >= 25
-    sta apple_y
+    bcc apple_row_ok
+    sbc #25     ; 25-31 -> 0-6
+apple_row_ok:
+    sta cell_y
+    
+    ; Walk rows (wrapping) to the first one with a free cell: max 25 steps
+    lda #25
+    sta scan_cnt
+apple_find_row:
+    ldy cell_y
+    lda row_free, y
+    bne apple_pick_col
+    iny
+    cpy #25
+    bcc apple_next_row
+    ldy #0
+apple_next_row:
+    sty cell_y
+    dec scan_cnt
+    bne apple_find_row
     
+    ; Board full: no apple
+    lda #$FF
+    sta apple_x
+    sta apple_y
+    rts
+
+apple_pick_col:
+    ; Random starting column 0-39 (folded, no retry)
     lda $DC04
     adc tick
     eor $D012
     ror
     and #$3F ; 0-63
     cmp #40
-    bcs spawn_apple ; Retry if >= 40
+    bcc apple_col_ok
+    sbc #40  ; 40-63 -> 0-23
+apple_col_ok:
+    sta cell_x
+    
+    ; row_free > 0, so this finds a free cell within 40 steps
+apple_find_col:
+    jsr occ_test
+    beq apple_place
+    inc cell_x
+    lda cell_x
+    cmp #40
+    bcc apple_find_col
+    lda #0
+    sta cell_x
+    beq apple_find_col ; Always taken
+
+apple_place:
+    lda cell_x
     sta apple_x
-    
-    ; Save head pos
-    lda head_x
-    pha
-    lda head_y
-    pha
-    
-    lda apple_x
-    sta head_x
-    lda apple_y
-    sta head_y
-    
-    jsr calc_screen_pos
-    ldy #0
-    lda (ptr_lo), y
-    cmp #CHAR_SPACE
-    bne spawn_apple_restore ; If not space, retry
-    
+    lda cell_y
+    sta apple_y
     lda #CHAR_APPLE
-    sta (ptr_lo), y
-    
-    pla
-    sta head_y
-    pla
-    sta head_x
-    rts
-
-spawn_apple_restore:
-    pla
-    sta head_y
-    pla
-    sta head_x
-    jmp spawn_apple
+    jmp plot_cell
 
 spawn_obstacles:
-    ldx #15 ; Number of obstacles
+    lda #15 ; Number of obstacles
+    sta scan_cnt
 obs_loop:
     ; Random Y
     lda $DC04
@@ -511,7 +592,7 @@ obs_loop:
     and #$1F
     cmp #25
     bcs obs_loop
-    sta tmp_lo ; Y
+    sta cell_y
 
     ; Random X
     lda $DC04
@@ -521,35 +602,15 @@ obs_loop:
     and #$3F
     cmp #40
     bcs obs_loop
-    sta tmp_hi ; X
-    
-    ; Save current head
-    lda head_x
-    pha
-    lda head_y
-    pha
-    
-    ; Set head to random pos for calc
-    lda tmp_hi
-    sta head_x
-    lda tmp_lo
-    sta head_y
-    
-    jsr calc_screen_pos
-    
-    ldy #0
-    lda (ptr_lo), y
-    cmp #CHAR_SPACE
-    bne obs_skip
+    sta cell_x
     
     ; Don't spawn too close to center (start pos 20,12)
     ; Simple check: if x is between 15 and 25 AND y is between 10 and 14
-    lda head_x
     cmp #15
     bcc place_obs
     cmp #25
     bcs place_obs
-    lda head_y
+    lda cell_y
     cmp #10
     bcc place_obs
     cmp #14
@@ -557,15 +618,30 @@ obs_loop:
     jmp obs_skip ; Skip if in center safe zone
 
 place_obs:
+    jsr occ_test
+    bne obs_skip
+    jsr occ_set
     lda #CHAR_TREE
-    sta (ptr_lo), y
+    jsr plot_cell
     
 obs_skip:
-    pla
-    sta head_y
-    pla
-    sta head_x
-    
-    dex
+    dec scan_cnt
     bne obs_loop
     rts
+
+; --- Lookup tables ---
+
+row_lo:
+.repeat 25, i
+    .byte <(SCREEN_RAM + i * 40)
+.endrepeat
+row_hi:
+.repeat 25, i
+    .byte >(SCREEN_RAM + i * 40)
+.endrepeat
+occ_row:
+.repeat 25, i
+    .byte i * 5
+.endrepeat
+bit_mask:
+    .byte $01, $02, $04, $08, $10, $20, $40, $80
@@ -1,4 +1,4 @@
 #!/bin/bash
 # Build Snake 2 (Sprite Version)
-cl65 -t c64 -C snake.cfg -o snake.prg snake.s
+cl65 -t c64 -C snake.cfg -g -m snake.map -Ln snake.lbl -Wl --dbgfile,snake.dbg -o snake.prg snake.s
 echo "Built snake.prg"
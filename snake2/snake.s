@@ -63,6 +63,25 @@ MAX_Y       = 229       ; Bottom edge
 ; Movement step (in pixels)
 MOVE_STEP   = 4         ; 4 pixels for tighter snake movement
 
+; AI autopilot grid (see ai_move/ai_think)
+GRID_W      = 25        ; 23 columns + wall on each side
+GRID_H      = 21        ; 19 rows + wall on each side
+GRID_SIZE   = GRID_W * GRID_H
+GRID_X0     = 40        ; head_x of grid column 1
+GRID_Y0     = 68        ; head_y of grid row 1
+CELL_BLOCKED = $80      ; Wall or body
+CELL_APPLE  = $07       ; Apple search: direction toward apple + 1
+CELL_TAIL   = $70       ; Tail search: (direction toward tail + 1) << 4
+CELL_SOURCE = 5         ; Search origin marker (not a direction)
+AI_NODE_BUDGET = 24     ; Grid cells expanded per frame
+
+; AI planner states
+AI_IDLE     = 0
+AI_SETUP    = 1
+AI_APPLE    = 2
+AI_TAIL     = 3
+AI_READY    = 4
+
 ; Character codes for background
 CHAR_SPACE  = 32
 CHAR_WALL   = 160
@@ -94,6 +113,37 @@ speed:      .res 1      ; Game speed (frames between moves)
 temp_count: .res 1      ; Temporary counter for loops
 demo_mode:  .res 1      ; 0 = player mode, 1 = demo mode
 
+; AI autopilot state
+ai_state:   .res 1      ; AI_IDLE .. AI_READY
+ai_col:     .res 1      ; Cell of the last decision
+ai_row:     .res 1
+ai_plan_col:.res 1      ; Cell the pending plan is for
+ai_plan_row:.res 1
+ai_dir:     .res 1      ; Planned direction ($FF = none)
+ai_apple_dir:.res 1     ; First step toward the apple ($FF = unreachable)
+ai_step_col:.res 1      ; Cell entered by ai_apple_dir
+ai_step_row:.res 1
+ai_mark:    .res 1      ; Visit mask of the current search
+ai_mark_ofs:.res 1      ; 0 = apple search, 4 = tail search (dir_mark index)
+q_head:     .res 1      ; BFS queue read index
+q_tail:     .res 1      ; BFS queue write index
+cur_col:    .res 1
+cur_row:    .res 1
+nb_col:     .res 1
+nb_row:     .res 1
+nb_dir:     .res 1
+grid_ptr:   .res 2
+ai_budget:  .res 1
+ai_raster:  .res 1
+ai_frames:  .res 1      ; Frames spent on the pending plan
+
+; AI instrumentation (see ai_move)
+ai_nodes:   .res 1
+ai_lines:   .res 1
+ai_lines_max:.res 1
+ai_plan_frames:.res 1
+ai_misses:  .res 1
+
 ; --- BSS Segment ---
 .segment "BSS"
 ; Trail positions for body segments (using sprites 2-7)
@@ -101,6 +151,11 @@ trail_x_lo: .res 64     ; X low byte history
 trail_x_hi: .res 64     ; X high byte history  
 trail_y:    .res 64     ; Y history
 
+; AI autopilot occupancy grid and BFS queue (8-bit ring, frontier < 256)
+grid:       .res GRID_SIZE
+queue_col:  .res 256
+queue_row:  .res 256
+
 ; --- BASIC Header ---
 .segment "HEADER"
     .word $0801
@@ -615,6 +670,7 @@ init_vars:
     sta tail_idx
     sta game_over
     sta grow
+    sta ai_state                ; AI_IDLE
     
     lda #5                      ; Initial length - very short snake (5 segments)
     sta head_idx
@@ -685,6 +741,20 @@ wait_raster2:
     cmp #250
     beq wait_raster2
     
+    ; Demo autopilot plans in the spare time of every frame
+    lda demo_mode
+    beq wait_speed
+    txa
+    pha
+    tya
+    pha
+    jsr ai_think
+    pla
+    tay
+    pla
+    tax
+    
+wait_speed:
     ; Speed control
     inc frame_cnt
     lda frame_cnt
@@ -695,349 +765,515 @@ wait_raster2:
     rts
 
 ; -----------------------------------------------------------------------------
-; AI MOVEMENT (Demo Mode) - Smarter obstacle-avoiding AI
-; Boundaries: X = 40-223 (safe zone), Y = 66-213 (safe zone)
-; Direction: 0=N, 1=S, 2=W, 3=E
+; AI AUTOPILOT (Demo Mode) - budgeted BFS over a coarse occupancy grid
+;
+; The play area is split into 8x8 pixel cells (two MOVE_STEPs). The snake
+; only turns when the head sits exactly on a cell, so each decision plans
+; the move out of the NEXT cell while the head travels there:
+;   AI_SETUP - copy the wall template and mark the trail_* history as body
+;   AI_APPLE - reverse BFS from the apple cell until it reaches the head
+;   AI_TAIL  - reverse BFS from the tail cell. The apple step is only used
+;              if the cell it enters can still reach the tail; otherwise
+;              the snake follows its own tail.
+; ai_think runs once per frame from wait_frame and expands at most
+; AI_NODE_BUDGET cells, so a search is spread over the idle frames between
+; moves. If no plan is ready in time, ai_fallback keeps the snake inside
+; the walls (the only thing that can kill it).
+;
+; Instrumentation (zero page, readable from the monitor):
+;   ai_nodes       cells expanded by the last ai_think call
+;   ai_lines       raster lines used by the last ai_think call
+;   ai_lines_max   worst ai_think cost since power-on
+;   ai_plan_frames frames the last completed plan took
+;   ai_misses      decisions left to ai_fallback because no plan was ready
+; Assemble with --asm-define AI_RASTER_BARS to show ai_think in the border.
 ; -----------------------------------------------------------------------------
 ai_move:
-    ; Check if there's an obstacle ahead (bush or wall)
-    jsr ai_check_ahead
-    lda tmp_lo                  ; 1 = obstacle ahead
-    beq ai_no_obstacle
-    jmp ai_avoid_obstacle
-
-ai_no_obstacle:
-    ; First check if we're near a wall and need to turn
-
-    ; Check if too close to left wall (X < 40)
-    lda head_x
-    cmp #40
-    bcs ai_not_left_wall
-    ; Near left wall - must not go West
-    lda dir
-    cmp #2                      ; Going West?
-    bne ai_not_left_wall
-    ; Turn based on Y position
-    lda head_y
-    cmp #140
-    bcc @turn_s1
-    jmp ai_turn_north
-@turn_s1:
-    jmp ai_turn_south
-ai_not_left_wall:
-
-    ; Check if too close to right wall (X > 220)
+    ; Only steer when the head is exactly on a grid cell
+    lda head_x + 1
+    bne ai_move_done
     lda head_x
-    cmp #220
-    bcc ai_not_right_wall
-    ; Near right wall - must not go East
-    lda dir
-    cmp #3                      ; Going East?
-    bne ai_not_right_wall
+    and #7
+    cmp #(GRID_X0 & 7)
+    bne ai_move_done
     lda head_y
-    cmp #140
-    bcc @turn_s2
-    jmp ai_turn_north
-@turn_s2:
-    jmp ai_turn_south
-ai_not_right_wall:
-
-    ; Check if too close to top wall (Y < 60)
-    lda head_y
-    cmp #60
-    bcs ai_not_top_wall
-    ; Near top wall - must not go North
-    lda dir
-    cmp #0                      ; Going North?
-    bne ai_not_top_wall
+    and #7
+    cmp #(GRID_Y0 & 7)
+    bne ai_move_done
+    
     lda head_x
-    cmp #140
-    bcc @turn_e1
-    jmp ai_turn_west
-@turn_e1:
-    jmp ai_turn_east
-ai_not_top_wall:
-
-    ; Check if too close to bottom wall (Y > 220)
+    jsr x_to_col
+    bcs ai_move_done            ; Outside the grid, keep going
+    sta ai_col
     lda head_y
-    cmp #220
-    bcc ai_not_bottom_wall
-    ; Near bottom wall - must not go South
-    lda dir
-    cmp #1                      ; Going South?
-    bne ai_not_bottom_wall
-    lda head_x
-    cmp #140
-    bcc @turn_e2
-    jmp ai_turn_west
-@turn_e2:
-    jmp ai_turn_east
-ai_not_bottom_wall:
-
-    ; Safe from walls - now seek the apple
-    ; Compare X positions
-    lda head_x
-    cmp apple_x
-    beq ai_check_y
-    bcs @go_left
-    jmp ai_want_right
-@go_left:
-    ; Want to go left (West) - but check if safe
-    lda head_x
-    cmp #48                     ; Not too close to left wall
-    bcc ai_check_y              ; Too close, try Y instead
-    lda dir
-    cmp #3                      ; Can't reverse if going East
-    beq ai_check_y
-    lda #2
+    jsr y_to_row
+    bcs ai_move_done
+    sta ai_row
+    
+    ; Use the plan if it finished and was made for this cell
+    lda ai_state
+    beq ai_no_plan              ; AI_IDLE: first decision after restart
+    cmp #AI_READY
+    bne ai_plan_missed
+    lda ai_plan_col
+    cmp ai_col
+    bne ai_plan_missed
+    lda ai_plan_row
+    cmp ai_row
+    bne ai_plan_missed
+    lda ai_dir
+    bmi ai_plan_missed          ; $FF = planner found nothing
     sta dir
-    rts
+    jmp ai_start_plan
 
-ai_want_right:
-    ; Check if safe to go right
-    lda head_x
-    cmp #216                    ; Not too close to right wall
-    bcs ai_check_y              ; Too close, try Y instead
-    lda dir
-    cmp #2                      ; Can't reverse if going West
-    beq ai_check_y
-    lda #3
-    sta dir
-    rts
+ai_plan_missed:
+    inc ai_misses
+ai_no_plan:
+    jsr ai_fallback
 
-ai_check_y:
-    lda head_y
-    cmp apple_y
-    beq ai_done
-    bcc ai_want_down
-    
-    ; Want to go up (North) - check if safe
-    lda head_y
-    cmp #80                     ; Not too close to top
-    bcc ai_done
-    lda dir
-    cmp #1                      ; Can't reverse if going South
-    beq ai_done
+ai_start_plan:
+    ; Plan the move out of the next cell while the head travels there
+    ldx dir
+    lda ai_col
+    clc
+    adc dir_dcol, x
+    sta ai_plan_col
+    lda ai_row
+    clc
+    adc dir_drow, x
+    sta ai_plan_row
     lda #0
-    sta dir
+    sta ai_frames
+    lda #AI_SETUP
+    sta ai_state
+ai_move_done:
     rts
 
-ai_want_down:
-    ; Check if safe to go down
-    lda head_y
-    cmp #192                    ; Not too close to bottom
-    bcs ai_done
-    lda dir
-    cmp #0                      ; Can't reverse if going North
-    beq ai_done
-    lda #1
-    sta dir
+; Keep going straight if that stays inside the walls, else turn
+ai_fallback:
+    ldx dir
+    jsr ai_dir_open
+    bcc ai_fallback_done
+    ldy dir
+    ldx turn_a, y
+    jsr ai_dir_open
+    bcc ai_fallback_set
+    ldy dir
+    ldx turn_b, y
+ai_fallback_set:
+    stx dir
+ai_fallback_done:
     rts
-    
-ai_done:
+
+; C clear if the cell next to (ai_col, ai_row) in direction X is inside the walls
+ai_dir_open:
+    lda ai_col
+    clc
+    adc dir_dcol, x
+    beq ai_dir_closed
+    cmp #GRID_W - 1
+    bcs ai_dir_closed
+    lda ai_row
+    clc
+    adc dir_drow, x
+    beq ai_dir_closed
+    cmp #GRID_H - 1             ; C set on the bottom wall
+    rts
+ai_dir_closed:
+    sec
     rts
 
-; AI helper - turn directions
-ai_turn_north:
-    lda dir
-    cmp #1                      ; Can't reverse if going South
-    beq ai_turn_east            ; Try East instead
+; -----------------------------------------------------------------------------
+; AI THINK - one budgeted slice of planning, called once per frame
+; Preserves nothing; wait_frame saves X/Y around the call
+; -----------------------------------------------------------------------------
+ai_think:
+    lda ai_state
+    beq ai_think_done           ; AI_IDLE
+    cmp #AI_READY
+    beq ai_think_done
+.ifdef AI_RASTER_BARS
+    lda BORDER
+    pha
+    lda #1                      ; White border while planning
+    sta BORDER
+.endif
+    lda $D012
+    sta ai_raster
+    inc ai_frames
     lda #0
-    sta dir
+    sta ai_nodes
+    
+    lda ai_state
+    cmp #AI_SETUP
+    bne ai_think_search
+    jsr ai_setup
+    jmp ai_think_measure
+ai_think_search:
+    lda #AI_NODE_BUDGET
+    sta ai_budget
+    jsr ai_search
+
+ai_think_measure:
+    lda $D012
+    sec
+    sbc ai_raster
+    sta ai_lines
+    cmp ai_lines_max
+    bcc ai_think_restore
+    sta ai_lines_max
+ai_think_restore:
+.ifdef AI_RASTER_BARS
+    pla
+    sta BORDER
+.endif
+ai_think_done:
     rts
 
-ai_turn_south:
-    lda dir
-    cmp #0                      ; Can't reverse if going North
-    beq ai_turn_west            ; Try West instead
+; -----------------------------------------------------------------------------
+; AI SETUP - build the occupancy grid and seed the apple search
+; -----------------------------------------------------------------------------
+ai_setup:
+    ; Fresh grid: walls only
+    ldx #0
+ai_copy_grid:
+    lda grid_template, x
+    sta grid, x
+    lda grid_template + 256, x
+    sta grid + 256, x
+    inx
+    bne ai_copy_grid
+    ldx #GRID_SIZE - 512
+ai_copy_grid_end:
+    lda grid_template + 511, x
+    sta grid + 511, x
+    dex
+    bne ai_copy_grid_end
+    
+    ; Body: every live trail entry, oldest to newest
+    ldx tail_idx
+ai_mark_body:
+    cpx head_idx
+    beq ai_mark_head
+    lda trail_x_hi, x
+    bne ai_next_body
+    lda trail_x_lo, x
+    jsr x_to_col
+    bcs ai_next_body
+    sta cur_col
+    lda trail_y, x
+    jsr y_to_row
+    bcs ai_next_body
+    jsr ai_block_cell
+ai_next_body:
+    inx
+    txa
+    and #$3F
+    tax
+    jmp ai_mark_body
+    
+ai_mark_head:
+    ; The decision cell and the cell being planned for are both snake
+    lda ai_col
+    sta cur_col
+    lda ai_row
+    jsr ai_block_cell
+    lda ai_plan_col
+    sta cur_col
+    lda ai_plan_row
+    jsr ai_block_cell
+    
+    lda #$FF
+    sta ai_apple_dir
+    
+    ; Apple search starts at the cell nearest the apple
+    lda apple_x
+    clc
+    adc #4                      ; Round to nearest cell
+    jsr x_to_col
+    bcc ai_goal_x_ok
     lda #1
-    sta dir
+    ldy apple_x
+    cpy #GRID_X0
+    bcc ai_goal_x_ok
+    lda #GRID_W - 2
+ai_goal_x_ok:
+    sta cur_col
+    lda apple_y
+    clc
+    adc #4
+    jsr y_to_row
+    bcc ai_goal_y_ok
+    lda #1
+    ldy apple_y
+    cpy #GRID_Y0
+    bcc ai_goal_y_ok
+    lda #GRID_H - 2
+ai_goal_y_ok:
+    sta cur_row
+    
+    ; Apple is on the planned cell: nothing to search, just check the tail
+    cmp ai_plan_row
+    bne ai_seed_apple
+    lda cur_col
+    cmp ai_plan_col
+    bne ai_seed_apple
+    jmp ai_start_tail
+
+ai_seed_apple:
+    lda #CELL_APPLE
+    sta ai_mark
+    lda #0
+    sta ai_mark_ofs
+    lda #CELL_SOURCE
+    jsr ai_seed
+    lda #AI_APPLE
+    sta ai_state
     rts
 
-ai_turn_east:
-    lda dir
-    cmp #2                      ; Can't reverse if going West
-    beq ai_turn_south_force
-    lda #3
-    sta dir
+; Start the tail search from the oldest trail entry
+ai_start_tail:
+    ldx tail_idx
+    lda trail_x_hi, x
+    bne ai_no_tail
+    lda trail_x_lo, x
+    jsr x_to_col
+    bcs ai_no_tail
+    sta cur_col
+    lda trail_y, x
+    jsr y_to_row
+    bcs ai_no_tail
+    sta cur_row
+    lda #CELL_TAIL
+    sta ai_mark
+    lda #4
+    sta ai_mark_ofs
+    lda #(CELL_SOURCE << 4)
+    jsr ai_seed
+    lda #AI_TAIL
+    sta ai_state
     rts
+ai_no_tail:
+    ; Tail outside the grid: nothing to check against, trust the apple step
+    lda ai_apple_dir
+    jmp ai_plan_done
 
-ai_turn_west:
-    lda dir
-    cmp #3                      ; Can't reverse if going East
-    beq ai_turn_north_force
-    lda #2
-    sta dir
+; Mark cell (cur_col, row A) as blocked. Preserves X.
+ai_block_cell:
+    tay
+    jsr grid_row_ptr
+    ldy cur_col
+    lda #CELL_BLOCKED
+    sta (grid_ptr), y
     rts
 
-ai_turn_north_force:
+; Reset the queue and push (cur_col, cur_row), OR-ing A into its cell
+ai_seed:
+    pha
+    ldy cur_row
+    jsr grid_row_ptr
+    ldy cur_col
+    pla
+    ora (grid_ptr), y
+    sta (grid_ptr), y
     lda #0
-    sta dir
-    rts
-
-ai_turn_south_force:
+    sta q_head
+    lda cur_col
+    sta queue_col
+    lda cur_row
+    sta queue_row
     lda #1
-    sta dir
+    sta q_tail
     rts
 
 ; -----------------------------------------------------------------------------
-; AI CHECK AHEAD - Check if there's a bush or wall 16 pixels ahead
-; Returns: tmp_lo = 1 if obstacle, 0 if clear
+; AI SEARCH - expand up to ai_budget queued cells of the current search
+; Cells store the direction that leads back toward the search origin, so
+; reaching the head cell directly yields the move to make.
 ; -----------------------------------------------------------------------------
-ai_check_ahead:
-    lda #0
-    sta tmp_lo                  ; Default: no obstacle
-
-    ; Calculate position 16 pixels ahead based on direction
-    lda dir
-    cmp #0                      ; North
-    beq ai_check_north
-    cmp #1                      ; South
-    beq ai_check_south
-    cmp #2                      ; West
-    beq ai_check_west
-    ; East
-ai_check_east:
-    lda head_x
+ai_search:
+    lda q_head
+    cmp q_tail
+    bne ai_search_node
+    jmp ai_search_exhausted
+ai_search_node:
+    lda ai_budget
+    bne ai_search_pop
+    rts                         ; Out of budget, resume next frame
+ai_search_pop:
+    dec ai_budget
+    inc ai_nodes
+    ldx q_head
+    lda queue_col, x
+    sta cur_col
+    lda queue_row, x
+    sta cur_row
+    inc q_head
+    
+    lda #3
+    sta nb_dir
+ai_search_nb:
+    ldx nb_dir
+    lda cur_col
     clc
-    adc #16
-    jmp ai_do_check
-
-ai_check_west:
-    lda head_x
-    sec
-    sbc #16
-    jmp ai_do_check
-
-ai_check_north:
-    lda head_x
-    sta tmp_hi                  ; Save X for later
-    lda head_y
+    adc dir_dcol, x
+    sta nb_col
+    lda cur_row
+    clc
+    adc dir_drow, x
+    sta nb_row
+    tay
+    jsr grid_row_ptr
+    ldy nb_col
+    lda (grid_ptr), y
+    bit ai_mark
+    bne ai_search_next          ; Already visited by this search
+    tax
+    
+    ; Reaching the planned head cell: record how to leave it
+    lda nb_col
+    cmp ai_plan_col
+    bne ai_search_free
+    lda nb_row
+    cmp ai_plan_row
+    bne ai_search_free
+    jsr ai_mark_nb
+    lda ai_state
+    cmp #AI_APPLE
+    beq ai_apple_found
+    lda ai_apple_dir
+    bpl ai_search_next          ; Keep looking for the apple step cell
+    ldx nb_dir                  ; No apple step: following the tail is the plan
+    lda dir_opposite, x
+    jmp ai_plan_done
+    
+ai_search_free:
+    txa
+    bmi ai_search_next          ; CELL_BLOCKED
+    jsr ai_mark_nb
+    ldx q_tail
+    lda nb_col
+    sta queue_col, x
+    lda nb_row
+    sta queue_row, x
+    inc q_tail
+    
+    ; Tail search succeeds as soon as the apple step cell is reached
+    lda ai_state
+    cmp #AI_TAIL
+    bne ai_search_next
+    lda nb_col
+    cmp ai_step_col
+    bne ai_search_next
+    lda nb_row
+    cmp ai_step_row
+    bne ai_search_next
+    lda ai_apple_dir
+    jmp ai_plan_done
+    
+ai_search_next:
+    dec nb_dir
+    bpl ai_search_nb
+    jmp ai_search
+
+ai_apple_found:
+    ; First apple step out of the head cell is the reverse of nb_dir
+    ldx nb_dir
+    lda dir_opposite, x
+    sta ai_apple_dir
+    tax
+    lda ai_plan_col
+    clc
+    adc dir_dcol, x
+    sta ai_step_col
+    lda ai_plan_row
+    clc
+    adc dir_drow, x
+    sta ai_step_row
+    jmp ai_start_tail
+
+ai_search_exhausted:
+    lda ai_state
+    cmp #AI_APPLE
+    bne ai_tail_exhausted
+    jmp ai_start_tail           ; Apple unreachable, ai_apple_dir stays $FF
+    
+ai_tail_exhausted:
+    ; Apple step would cut the snake off from its tail: follow the tail
+    ldy ai_plan_row
+    jsr grid_row_ptr
+    ldy ai_plan_col
+    lda (grid_ptr), y
+    lsr
+    lsr
+    lsr
+    lsr
+    and #7
     sec
-    sbc #16
-    pha
-    lda tmp_hi
-    jmp ai_check_y_pos
+    sbc #1
+    cmp #4
+    bcc ai_plan_done
+    lda #$FF                    ; Boxed in: leave it to ai_fallback
+
+; A = planned direction ($FF = none)
+ai_plan_done:
+    sta ai_dir
+    lda ai_frames
+    sta ai_plan_frames
+    lda #AI_READY
+    sta ai_state
+    rts
 
-ai_check_south:
-    lda head_x
-    sta tmp_hi
-    lda head_y
+; Store the "step back toward the origin" mark for (nb_col, nb_row)
+ai_mark_nb:
+    lda nb_dir
     clc
-    adc #16
-    pha
-    lda tmp_hi
-    jmp ai_check_y_pos
+    adc ai_mark_ofs
+    tax
+    ldy nb_col
+    lda dir_mark, x
+    ora (grid_ptr), y
+    sta (grid_ptr), y
+    rts
 
-ai_do_check:
-    ; A has X position to check
-    sta tmp_hi                  ; Save X
-    lda head_y
-    pha                         ; Save Y on stack
-    lda tmp_hi                  ; Restore X
+; Y = grid row -> grid_ptr. Preserves X.
+grid_row_ptr:
+    lda grid_row_lo, y
+    sta grid_ptr
+    lda grid_row_hi, y
+    sta grid_ptr + 1
+    rts
 
-ai_check_y_pos:
-    ; Stack has Y, A has X
-    ; Convert to screen coordinates
+; A = head_x -> A = grid column, C set if outside the play grid
+x_to_col:
     sec
-    sbc #24                     ; Remove sprite offset
+    sbc #GRID_X0
+    bcc grid_coord_out
     lsr
     lsr
     lsr
-    sta tmp_hi                  ; Screen X
+    clc
+    adc #1
+    cmp #GRID_W - 1             ; C set on/after the right wall
+    rts
 
-    pla                         ; Get Y from stack
+; A = head_y -> A = grid row, C set if outside the play grid
+y_to_row:
     sec
-    sbc #50
+    sbc #GRID_Y0
+    bcc grid_coord_out
+    lsr
     lsr
     lsr
-    lsr                         ; Screen Y
-
-    ; Calculate screen position
-    asl                         ; *2
-    asl                         ; *4
-    asl                         ; *8
-    sta ptr_lo
-    asl
-    asl                         ; *32
-    clc
-    adc ptr_lo                  ; *40
-    clc
-    adc tmp_hi                  ; + X
-    sta ptr_lo
-    lda #0
-    adc #0
-    sta ptr_hi
-
-    ; Add screen base
-    lda ptr_lo
     clc
-    adc #<SCREEN_RAM
-    sta ptr_lo
-    lda ptr_hi
-    adc #>SCREEN_RAM
-    sta ptr_hi
-
-    ; Check character
-    ldy #0
-    lda (ptr_lo), y
-    cmp #102                    ; Bush
-    beq ai_found_obstacle
-    cmp #160                    ; Wall
-    beq ai_found_obstacle
+    adc #1
+    cmp #GRID_H - 1             ; C set on/after the bottom wall
     rts
 
-ai_found_obstacle:
-    lda #1
-    sta tmp_lo
+grid_coord_out:
+    sec
     rts
 
-; -----------------------------------------------------------------------------
-; AI AVOID OBSTACLE - Turn to avoid bush/wall ahead
-; -----------------------------------------------------------------------------
-ai_avoid_obstacle:
-    ; Try turning perpendicular to current direction
-    lda dir
-    cmp #0                      ; Going North?
-    beq ai_avoid_n
-    cmp #1                      ; Going South?
-    beq ai_avoid_s
-    cmp #2                      ; Going West?
-    beq ai_avoid_w
-    ; Going East
-ai_avoid_e:
-    ; Try North first, then South
-    lda head_y
-    cmp #100
-    bcs ai_avoid_e_north
-    jmp ai_turn_south           ; Near top, go South
-ai_avoid_e_north:
-    jmp ai_turn_north           ; Else go North
-
-ai_avoid_w:
-    lda head_y
-    cmp #100
-    bcs ai_avoid_w_north
-    jmp ai_turn_south
-ai_avoid_w_north:
-    jmp ai_turn_north
-
-ai_avoid_n:
-    lda head_x
-    cmp #120
-    bcs ai_avoid_n_west
-    jmp ai_turn_east            ; Near left, go East
-ai_avoid_n_west:
-    jmp ai_turn_west            ; Else go West
-
-ai_avoid_s:
-    lda head_x
-    cmp #120
-    bcs ai_avoid_s_west
-    jmp ai_turn_east
-ai_avoid_s_west:
-    jmp ai_turn_west
-
 ; -----------------------------------------------------------------------------
 ; READ JOYSTICK (Player Mode)
 ; Joystick port 2: $DC00
@@ -1768,6 +2004,42 @@ press_text:
     .byte 16, 21, 19, 8, 32, 6, 9, 18, 5, 32, 20, 15, 32, 19, 20, 1, 18, 20, 0
     ; "PUSH FIRE TO START"
 
+; AI direction tables (0=N, 1=S, 2=W, 3=E)
+dir_dcol:
+    .byte 0, 0, $FF, 1
+dir_drow:
+    .byte $FF, 1, 0, 0
+dir_opposite:
+    .byte 1, 0, 3, 2
+turn_a:
+    .byte 2, 2, 0, 0            ; First turn tried by ai_fallback
+turn_b:
+    .byte 3, 3, 1, 1
+dir_mark:
+    .byte 2, 1, 4, 3            ; Apple search: opposite + 1
+    .byte $20, $10, $40, $30    ; Tail search: (opposite + 1) << 4
+
+grid_row_lo:
+.repeat GRID_H, row
+    .byte <(grid + row * GRID_W)
+.endrepeat
+grid_row_hi:
+.repeat GRID_H, row
+    .byte >(grid + row * GRID_W)
+.endrepeat
+
+; Empty play grid with a wall border, copied by ai_setup
+grid_template:
+.repeat GRID_H, row
+.repeat GRID_W, col
+.if row = 0 || row = GRID_H - 1 || col = 0 || col = GRID_W - 1
+    .byte CELL_BLOCKED
+.else
+    .byte 0
+.endif
+.endrepeat
+.endrepeat
+
 ; -----------------------------------------------------------------------------
 ; SPRITE DATA (24x21 pixels = 63 bytes each, padded to 64)
 ; Placed directly at $2000 by linker
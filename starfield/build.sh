@@ -1,6 +1,6 @@
 #!/bin/bash
 cd "$(dirname "$0")"
-cl65 -t c64 -O -o starfield.prg starfield.c
+cl65 -t c64 -O -g -m starfield.map -Ln starfield.lbl -Wl --dbgfile,starfield.dbg -o starfield.prg starfield.c stars.s
 if [[ -f starfield.prg ]]; then
     echo "Built starfield.prg ($(stat -c%s starfield.prg) bytes)"
 else
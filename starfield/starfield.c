@@ -1,6 +1,7 @@
 /*
  * Starfield Demo for C64 - Written in C using cc65
  * 3D starfield flying through space effect
+ * Stars are projected with tables and drawn by stars.s
  */
 
 #include <c64.h>
@@ -19,16 +20,26 @@
 #define GREY    12
 #define DKGREY  11
 
-// Star characters (different sizes for depth)
-#define STAR_FAR    0x2E  // . (period - small/far)
-#define STAR_MED    0x51  // * style
-#define STAR_NEAR   0x58  // Larger star
+// Charset in RAM: ROM copy plus the star glyphs
+#define CHARSET_RAM 0x3800
 
-// Number of stars per layer
-#define STARS_FAR   25
-#define STARS_MED   20
-#define STARS_NEAR  15
-#define TOTAL_STARS (STARS_FAR + STARS_MED + STARS_NEAR)
+// Star glyphs: 3 sizes x 4 quadrants (x half * 2 + y half)
+#define STAR_CHAR   0x70
+#define STAR_SIZES  3
+
+// Star engine (stars.s); see there for the projection scheme
+#define STAR_MAX    255
+#define STAR_Z      64              // depth rows, 0 = nearest
+#define STAR_NEAR   8               // distance of depth row 0
+#define STAR_K      13              // projection scale, half cells
+#define PROJ        ((signed char*)0x4000)  // STAR_Z rows of 128
+#define TOTAL_STARS 96              // fits a 50 Hz frame, +/- to change
+
+extern unsigned char star_count;
+extern unsigned char star_glyph[STAR_Z];
+extern unsigned char star_seed;
+extern void stars_init(void);
+extern void stars_step(void);
 
 // Screen dimensions
 #define SCR_W 40
@@ -36,126 +47,99 @@
 #define CENTER_X 20
 #define CENTER_Y 12
 
-// Star data
-static unsigned char star_x[TOTAL_STARS];
-static unsigned char star_y[TOTAL_STARS];
-static signed char star_dx[TOTAL_STARS];
-static signed char star_dy[TOTAL_STARS];
-static unsigned char star_layer[TOTAL_STARS];  // 0=far, 1=med, 2=near
+// 4x4 dot for each size, one nibble per row: far, mid, near
+static const unsigned char star_dots[STAR_SIZES][4] = {
+    { 0x0, 0x4, 0x0, 0x0 },
+    { 0x0, 0x6, 0x6, 0x0 },
+    { 0x6, 0xF, 0xF, 0x6 }
+};
 
 // Wait for vertical blank
 void wait_vblank(void) {
     while (VIC.rasterline != 255);
 }
 
-// Clear a star from screen
-void clear_star(unsigned char x, unsigned char y) {
-    if (x < SCR_W && y < SCR_H) {
-        SCREEN[y * SCR_W + x] = 0x20;  // Space
-    }
-}
-
-// Draw a star on screen
-void draw_star(unsigned char x, unsigned char y, unsigned char layer) {
-    unsigned int pos;
-    unsigned char chr, col;
-
-    if (x >= SCR_W || y >= SCR_H) return;
-
-    pos = y * SCR_W + x;
-
-    switch (layer) {
-        case 0:  // Far - small, dark
-            chr = STAR_FAR;
-            col = DKGREY;
-            break;
-        case 1:  // Medium
-            chr = STAR_MED;
-            col = GREY;
-            break;
-        case 2:  // Near - large, bright
-            chr = STAR_NEAR;
-            col = WHITE;
-            break;
-        default:
-            chr = STAR_FAR;
-            col = GREY;
+// Copy the ROM charset to RAM and add the quadrant star glyphs
+void init_charset(void) {
+    unsigned char *dst;
+    unsigned int i;
+    unsigned char old_port;
+    unsigned char size, q, r;
+
+    __asm__("sei");
+    old_port = *(unsigned char*)0x01;
+    *(unsigned char*)0x01 = old_port & 0xFB;  // reveal char ROM at $D000
+    memcpy((void*)CHARSET_RAM, (void*)0xD000, 2048);
+    *(unsigned char*)0x01 = old_port;         // restore I/O at $D000
+    __asm__("cli");
+
+    dst = (unsigned char*)(CHARSET_RAM + STAR_CHAR * 8);
+    for (size = 0; size < STAR_SIZES; size++) {
+        for (q = 0; q < 4; q++) {
+            for (r = 0; r < 8; r++) {
+                i = r - ((q & 1) << 2);       // row within the quadrant
+                dst[r] = (i < 4)
+                    ? star_dots[size][i] << ((q & 2) ? 0 : 4)
+                    : 0;
+            }
+            dst += 8;
+        }
     }
 
-    SCREEN[pos] = chr;
-    COLORS[pos] = col;
+    // $D018: screen at $0400, chars at $3800
+    VIC.addr = 0x1E;
 }
 
-// Initialize a single star at center
-void init_star(unsigned char i) {
-    signed char dx, dy;
-
-    // Start near center with small random offset
-    star_x[i] = CENTER_X + (rand() % 5) - 2;
-    star_y[i] = CENTER_Y + (rand() % 3) - 1;
-
-    // Random direction from center
-    do {
-        dx = (rand() % 5) - 2;
-        dy = (rand() % 5) - 2;
-    } while (dx == 0 && dy == 0);  // Ensure movement
-
-    star_dx[i] = dx;
-    star_dy[i] = dy;
-
-    // Assign layer based on index
-    if (i < STARS_FAR) {
-        star_layer[i] = 0;  // Far
-    } else if (i < STARS_FAR + STARS_MED) {
-        star_layer[i] = 1;  // Medium
-    } else {
-        star_layer[i] = 2;  // Near
+// Projection rows: PROJ[z][x + 64] = x * STAR_K / (z + STAR_NEAR),
+// one division per row and additions along it
+void init_projection(void) {
+    signed char *row = PROJ + 64;
+    unsigned int step, acc, p;
+    unsigned char z, x;
+
+    for (z = 0; z < STAR_Z; z++) {
+        step = (STAR_K << 8) / (z + STAR_NEAR);
+        acc = 0x80;                           // round to nearest
+        for (x = 0; x <= 64; x++) {
+            p = acc >> 8;
+            if (p > 127) p = 127;
+            if (x < 64) row[x] = (signed char)p;
+            row[-(signed char)x] = -(signed char)p;
+            acc += step;
+        }
+        row += 128;
     }
-}
-
-// Initialize all stars
-void init_stars(void) {
-    unsigned char i;
 
-    for (i = 0; i < TOTAL_STARS; i++) {
-        init_star(i);
-        // Spread initial positions across screen
-        star_x[i] = rand() % SCR_W;
-        star_y[i] = rand() % SCR_H;
+    // Glyph size by depth
+    for (z = 0; z < STAR_Z; z++) {
+        star_glyph[z] = STAR_CHAR + 4 * (z < 12 ? 2 : z < 40 ? 1 : 0);
     }
 }
 
-// Move stars based on layer speed
-void move_stars(void) {
-    unsigned char i;
-    unsigned char speed;
-    signed int new_x, new_y;
-
-    for (i = 0; i < TOTAL_STARS; i++) {
-        // Clear old position
-        clear_star(star_x[i], star_y[i]);
-
-        // Speed based on layer (far=slow, near=fast)
-        speed = star_layer[i] + 1;
-
-        // Move star
-        new_x = (signed int)star_x[i] + (star_dx[i] * speed) / 2;
-        new_y = (signed int)star_y[i] + (star_dy[i] * speed) / 2;
-
-        // Check if star left screen
-        if (new_x < 0 || new_x >= SCR_W || new_y < 0 || new_y >= SCR_H) {
-            // Respawn at center
-            init_star(i);
-        } else {
-            star_x[i] = (unsigned char)new_x;
-            star_y[i] = (unsigned char)new_y;
+// Colour RAM is painted once: dim in the middle, where stars are far,
+// bright towards the edges, where they are near
+void init_colors(void) {
+    unsigned char x, y, dx, dy, d, col;
+    unsigned char *c = COLORS;
+
+    for (y = 0; y < SCR_H; y++) {
+        dy = y < CENTER_Y ? CENTER_Y - y : y - CENTER_Y;
+        for (x = 0; x < SCR_W; x++) {
+            dx = x < CENTER_X ? CENTER_X - x : x - CENTER_X;
+            d = dx + dy * 2;                  // rows are as tall as 2 cols wide
+            col = d < 6 ? DKGREY : d < 14 ? GREY : d < 22 ? LTGREY : WHITE;
+            *c++ = col;
         }
-
-        // Draw at new position
-        draw_star(star_x[i], star_y[i], star_layer[i]);
     }
 }
 
+// Start (or restart) the engine with n stars on a clear screen
+void init_stars(unsigned char n) {
+    memset(SCREEN, 0x20, SCR_W * SCR_H);
+    star_count = n;
+    stars_init();
+}
+
 // Draw title
 void draw_title(void) {
     gotoxy(14, 0);
@@ -166,6 +150,7 @@ void draw_title(void) {
 // Main
 int main(void) {
     unsigned char frame = 0;
+    char key;
 
     // Setup screen
     clrscr();
@@ -190,7 +175,11 @@ int main(void) {
 
     // Clear and init
     clrscr();
-    init_stars();
+    init_charset();
+    init_projection();
+    init_colors();
+    star_seed = (unsigned char)rand() | 1;
+    init_stars(TOTAL_STARS);
 
     // Main loop
     while (1) {
@@ -198,7 +187,17 @@ int main(void) {
         frame++;
 
         // Move and draw stars
-        move_stars();
+        stars_step();
+
+        // +/- change the star count
+        if (kbhit()) {
+            key = cgetc();
+            if (key == '+' && star_count <= STAR_MAX - 16) {
+                init_stars(star_count + 16);
+            } else if (key == '-' && star_count >= 16) {
+                init_stars(star_count - 16);
+            }
+        }
 
         // Draw title occasionally (every 64 frames to reduce flicker)
         if ((frame & 63) == 0) {
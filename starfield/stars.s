@@ -0,0 +1,195 @@
+; stars.s - perspective starfield engine for cc65/ca65
+;
+; C entry points:
+;   void stars_init(void);
+;   void stars_step(void);
+;
+; A star is a world position (x, y in -64..63, stored +64) and a depth
+; row z that counts down one per frame. Projection is a table lookup:
+; PROJ holds STAR_Z rows of 128 signed bytes, row z giving x * K / d(z)
+; in half-character units, so no multiply or divide runs per frame. The
+; C side builds the table, the glyphs and the colour map at start-up.
+;
+; The low bits of the projected half column and half row pick one of four
+; quadrant glyphs, so stars move at 2x2 sub-cell resolution. The glyph
+; set (size) comes from star_glyph[z]; colour RAM is painted once, so
+; drawing touches screen RAM only. Each star remembers the screen
+; address it was drawn at; pass 1 blanks them all, pass 2 moves and
+; draws, so a star never erases one drawn earlier in the same frame.
+
+.export _stars_init, _stars_step
+.export _star_count, _star_glyph, _star_seed
+.importzp ptr1, ptr2, tmp1, tmp2
+
+STAR_MAX = 255
+STAR_Z   = 64                   ; depth rows, 0 = nearest
+PROJ     = $4000                ; STAR_Z * 128 bytes, see starfield.c
+
+SCR_W    = 40
+SCR_H    = 25
+SCREEN   = $0400
+SPACE    = $20
+
+.segment "DATA"
+
+_star_seed:  .byte 1            ; LFSR state, never 0
+
+.segment "BSS"
+
+st_x:        .res STAR_MAX      ; world x + 64 (0..127)
+st_y:        .res STAR_MAX
+st_z:        .res STAR_MAX      ; depth row
+st_lo:       .res STAR_MAX      ; screen address drawn at
+st_hi:       .res STAR_MAX      ; 0: not drawn
+
+_star_count: .res 1
+_star_glyph: .res STAR_Z        ; first of 4 quadrant glyphs, by depth
+
+.segment "RODATA"
+
+row_lo:
+.repeat SCR_H, R
+    .byte <(SCREEN + R * SCR_W)
+.endrepeat
+row_hi:
+.repeat SCR_H, R
+    .byte >(SCREEN + R * SCR_W)
+.endrepeat
+proj_lo:
+.repeat STAR_Z, Z
+    .byte <(PROJ + Z * 128)
+.endrepeat
+proj_hi:
+.repeat STAR_Z, Z
+    .byte >(PROJ + Z * 128)
+.endrepeat
+
+.segment "CODE"
+
+; 8-bit Galois LFSR, period 255; keeps X
+rnd:
+    lda _star_seed
+    asl
+    bcc @done
+    eor #$1D
+@done:
+    sta _star_seed
+    rts
+
+; New star X on the far plane
+spawn:
+    jsr rnd
+    and #$7F
+    sta st_x, x
+    jsr rnd
+    and #$7F
+    sta st_y, x
+    lda #STAR_Z - 1
+    sta st_z, x
+    rts
+
+; Spawn every star at a random depth so they do not arrive together
+_stars_init:
+    lda _star_seed
+    bne @seeded
+    inc _star_seed
+@seeded:
+    ldx _star_count
+    beq @done
+@star:
+    dex
+    jsr spawn
+    jsr rnd
+    and #STAR_Z - 1
+    sta st_z, x
+    lda #0
+    sta st_hi, x
+    txa
+    bne @star
+@done:
+    rts
+
+_stars_step:
+    ldx _star_count
+    bne @erase_all
+    rts
+
+    ; Pass 1: blank every star where it was drawn
+@erase_all:
+    ldy #0
+@erase:
+    dex
+    lda st_hi, x
+    beq @erase_next
+    sta ptr1 + 1
+    lda st_lo, x
+    sta ptr1
+    lda #SPACE
+    sta (ptr1), y
+@erase_next:
+    txa
+    bne @erase
+
+    ; Pass 2: fly towards the viewer, project and draw
+    ldx _star_count
+@star:
+    dex
+    dec st_z, x
+    bpl @project
+    jsr spawn                   ; passed the viewer
+@project:
+    ldy st_z, x
+    lda proj_lo, y
+    sta ptr2
+    lda proj_hi, y
+    sta ptr2 + 1
+
+    ldy st_x, x                 ; half column, centred
+    lda (ptr2), y
+    clc
+    adc #SCR_W
+    cmp #SCR_W * 2
+    bcs @gone
+    lsr
+    sta tmp1                    ; column
+    lda #0
+    rol
+    sta tmp2                    ; quadrant: x half
+
+    ldy st_y, x                 ; half row, centred
+    lda (ptr2), y
+    clc
+    adc #SCR_H
+    cmp #SCR_H * 2
+    bcs @gone
+    lsr
+    tay
+    rol tmp2                    ; quadrant: x half * 2 + y half
+
+    lda row_lo, y
+    clc
+    adc tmp1
+    sta ptr1
+    sta st_lo, x
+    lda row_hi, y
+    adc #0
+    sta ptr1 + 1
+    sta st_hi, x
+
+    ldy st_z, x
+    lda _star_glyph, y
+    ora tmp2
+    ldy #0
+    sta (ptr1), y
+@next:
+    txa
+    beq @done
+    jmp @star
+@done:
+    rts
+
+@gone:
+    jsr spawn                   ; left the screen: back to the far plane
+    lda #0
+    sta st_hi, x
+    beq @next                   ; always
@@ -0,0 +1,259 @@
+#!/usr/bin/env python3
+"""
+symbols.py - Symbol database from the files every build writes
+
+Every project is linked with
+
+    cl65 -g -m <name>.map -Ln <name>.lbl -Wl --dbgfile,<name>.dbg
+
+and this module reads those three files back into one table:
+
+    .lbl   VICE labels ("al 000810 .start"): every label, C names as _name
+    .map   segment list (start, size) and the exports list
+    .dbg   ld65 debug info: symbol sizes, segments, and C variables
+           (csym lines) by their C name, including static locals
+
+so the monitor tools can say "score" instead of "$0A3C". Names are
+looked up as given, then with the C underscore ("score" -> "_score");
+"name+3" and "name[3]" address single bytes, "$0a3c" passes through.
+
+Usage:
+    python3 symbols.py pacman               # All symbols with address, size
+    python3 symbols.py pacman lives ghost_x # Look some up
+    python3 symbols.py pacman --segments    # Segment table
+    python3 symbols.py                      # Last root build (snake.*)
+
+Author: C64AIToolChain Project
+"""
+
+import argparse
+import re
+import sys
+from pathlib import Path
+
+ROOT = Path(__file__).resolve().parent
+SUFFIXES = ('.dbg', '.lbl', '.map')
+
+DBG_FIELD = re.compile(r'(\w+)=("(?:[^"\\]|\\.)*"|[^,]*)')
+NAME_EXPR = re.compile(r'^([\w.@]+)\s*(?:\+\s*(\w+)|\[\s*(\w+)\s*\])?$')
+
+
+def _number(text):
+    """Decimal, 0x.. or $.. as an int."""
+    text = text.strip()
+    if text.startswith('$'):
+        return int(text[1:], 16)
+    return int(text, 0)
+
+
+class SymbolDB:
+    """Symbol name -> (address, size) plus the segment table of one build."""
+
+    def __init__(self):
+        self.symbols = {}       # name -> address
+        self.sizes = {}         # name -> bytes, where the build knows it
+        self.segments = {}      # name -> (start, size)
+        self.sources = []       # files loaded, in order
+        self.loading = set()    # names the file being loaded has set
+
+    # -------------------------------------------------------------------------
+    # Loading
+    # -------------------------------------------------------------------------
+
+    @classmethod
+    def load(cls, *paths):
+        """Database from any mix of .lbl, .map and .dbg files."""
+        db = cls()
+        for path in paths:
+            path = Path(path)
+            loader = {'.lbl': db.load_lbl, '.map': db.load_map,
+                      '.dbg': db.load_dbg}.get(path.suffix)
+            if loader is None:
+                raise ValueError(f"{path}: not a .lbl, .map or .dbg file")
+            db.loading = set()
+            loader(path)
+            db.sources.append(str(path))
+        return db
+
+    @classmethod
+    def for_project(cls, project=None):
+        """
+        Symbols of a project's last build, or None when it has none.
+
+        Uses the newest of the project's .dbg/.lbl/.map files and the
+        other two with the same name. Without a project, the root-level
+        snake.* copies build.sh leaves of the last build.
+        """
+        if project is None:
+            stem = ROOT / 'snake'
+        else:
+            pdir = Path(project)
+            if not pdir.is_absolute() and not pdir.exists():
+                pdir = ROOT / project
+            files = [p for suffix in SUFFIXES for p in pdir.glob(f'*{suffix}')]
+            if not files:
+                return None
+            stem = max(files, key=lambda p: p.stat().st_mtime).with_suffix('')
+        # Map first, labels over it, debug info (sizes, C names) last:
+        # a later file's address for a name replaces an earlier one's
+        paths = [stem.with_suffix(s) for s in ('.map', '.lbl', '.dbg')]
+        paths = [p for p in paths if p.exists()]
+        return cls.load(*paths) if paths else None
+
+    def add(self, name, addr, size=None):
+        """Set a symbol; within one file the first address found wins."""
+        if name in self.loading:
+            return
+        self.loading.add(name)
+        self.symbols[name] = addr
+        if size:
+            self.sizes[name] = size
+
+    def load_lbl(self, path):
+        text = Path(path).read_text(errors='replace')
+        for m in re.finditer(r'^al\s+(?:C:)?([0-9A-Fa-f]+)\s+\.(\S+)', text, re.M):
+            self.add(m.group(2), int(m.group(1), 16))
+
+    def load_map(self, path):
+        text = Path(path).read_text(errors='replace')
+        m = re.search(r'Segment list:\n-+\n.*?\n-+\n(.*?)\n\n', text, re.S)
+        for name, start, _end, size in re.findall(
+                r'^(\S+)\s+([0-9A-F]{6})\s+([0-9A-F]{6})\s+([0-9A-F]{6})',
+                m.group(1) if m else '', re.M):
+            self.segments[name] = (int(start, 16), int(size, 16))
+        m = re.search(r'Exports list by name:\n-+\n(.*?)\n\n', text, re.S)
+        for name, addr in re.findall(r'(\S+)\s+([0-9A-F]{6})\s+R\w*',
+                                     m.group(1) if m else ''):
+            self.add(name, int(addr, 16))
+
+    def load_dbg(self, path):
+        records = {}
+        for line in Path(path).read_text(errors='replace').splitlines():
+            kind, _, rest = line.partition('\t')
+            if kind in ('seg', 'sym', 'csym', 'scope'):
+                fields = {k: v.strip('"') for k, v in DBG_FIELD.findall(rest)}
+                records.setdefault(kind, {})[fields.get('id')] = fields
+
+        for seg in records.get('seg', {}).values():
+            if 'start' in seg and 'size' in seg:
+                self.segments[seg['name']] = (_number(seg['start']),
+                                              _number(seg['size']))
+
+        syms = records.get('sym', {})
+        for sym in syms.values():
+            # Imports carry no value; equates are constants, not storage
+            if 'val' not in sym or sym.get('type') != 'lab':
+                continue
+            size = _number(sym['size']) if 'size' in sym else None
+            self.add(sym['name'], _number(sym['val']), size)
+
+        # C variables: the asm symbol behind each static, under its C name;
+        # function statics as function.name
+        scopes = records.get('scope', {})
+        for csym in records.get('csym', {}).values():
+            if csym.get('sc') not in ('static', 'ext') or 'sym' not in csym:
+                continue
+            sym = syms.get(csym['sym'])
+            if not sym or 'val' not in sym:
+                continue
+            name = csym['name']
+            scope = scopes.get(csym.get('scope'), {}).get('name', '')
+            if scope and 'parent' in scopes.get(csym.get('scope'), {}):
+                name = f"{scope.lstrip('_')}.{name}"
+            size = _number(sym['size']) if 'size' in sym else None
+            self.add(name, _number(sym['val']), size)
+
+    # -------------------------------------------------------------------------
+    # Lookup
+    # -------------------------------------------------------------------------
+
+    def __contains__(self, name):
+        return name in self.symbols or f"_{name}" in self.symbols
+
+    def __getitem__(self, name):
+        """Address of a symbol (C names with or without '_'); KeyError if unknown."""
+        if name in self.symbols:
+            return self.symbols[name]
+        if f"_{name}" in self.symbols:
+            return self.symbols[f"_{name}"]
+        raise KeyError(name)
+
+    def size_of(self, name):
+        """
+        Bytes behind a symbol: from the debug info, else up to the next
+        symbol when that is within a page, else 1.
+        """
+        key = name if name in self.symbols else f"_{name}"
+        if key in self.sizes:
+            return self.sizes[key]
+        addr = self.symbols[key]
+        gap = min((a for a in self.symbols.values() if a > addr),
+                  default=addr + 1) - addr
+        return gap if gap <= 256 else 1
+
+    def resolve(self, expr):
+        """
+        (address, size) for "name", "_name", "name+N", "name[N]" or "$addr".
+
+        Raises:
+            KeyError: unknown symbol
+        """
+        expr = expr.strip()
+        if expr.startswith('$'):
+            return _number(expr), 1
+        m = NAME_EXPR.match(expr)
+        if not m:
+            raise KeyError(expr)
+        addr = self[m.group(1)]
+        index = m.group(2) or m.group(3)
+        if index is not None:
+            return addr + _number(index), 1
+        return addr, self.size_of(m.group(1))
+
+    def name_at(self, addr):
+        """Closest symbol at or below addr, as "name" or "name+N"."""
+        best = None
+        for name, a in self.symbols.items():
+            if a <= addr and (best is None or a > best[1]):
+                best = (name, a)
+        if best is None:
+            return f"${addr:04X}"
+        return best[0] if best[1] == addr else f"{best[0]}+{addr - best[1]}"
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Symbols of a C64 build (.lbl/.map/.dbg)')
+    parser.add_argument('project', nargs='?',
+                        help='Project directory (default: root snake.*)')
+    parser.add_argument('names', nargs='*', help='Symbols to look up')
+    parser.add_argument('--segments', action='store_true',
+                        help='Print the segment table')
+    args = parser.parse_args()
+
+    db = SymbolDB.for_project(args.project)
+    if db is None:
+        where = f"{args.project}/" if args.project else 'the repository root'
+        print(f"✗ No .dbg/.lbl/.map in {where}: build first")
+        return 1
+
+    if args.segments:
+        for name, (start, size) in sorted(db.segments.items(),
+                                          key=lambda kv: kv[1]):
+            print(f"{name:12s} ${start:04X}-${start + size - 1:04X} {size:6d} bytes")
+        return 0
+
+    missing = 0
+    for name in args.names or sorted(db.symbols, key=db.symbols.get):
+        try:
+            addr, size = db.resolve(name)
+        except KeyError:
+            print(f"✗ {name}: not found")
+            missing += 1
+            continue
+        print(f"${addr:04X} {size:4d}  {name}")
+    return 1 if missing else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
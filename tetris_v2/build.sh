@@ -1,2 +1,2 @@
 #!/bin/bash
-cl65 -C tetris.cfg -m tetris.map -o tetris.prg tetris.s
+cl65 -C tetris.cfg -g -m tetris.map -Ln tetris.lbl -Wl --dbgfile,tetris.dbg -o tetris.prg tetris.s
@@ -20,10 +20,18 @@ Requirements:
 Usage:
     python3 vlm_look.py                    # Analyze current screen
     python3 vlm_look.py --json             # Structured JSON output
+    python3 vlm_look.py --state pacman     # Same fields from RAM, no VLM
     python3 vlm_look.py --existing img.png # Analyze existing image
     python3 vlm_look.py --compare a.png --with b.png  # Compare two screenshots
     python3 vlm_look.py --prompt "..."     # Custom analysis prompt
     python3 vlm_look.py --motion 3         # Multi-frame motion analysis
+    python3 vlm_look.py --watch 20         # Watch; unchanged frames cost nothing
+    python3 vlm_look.py --cache-stats      # Response cache hits and misses
+
+Responses are cached on disk, keyed by a hash of the decoded screen
+pixels plus model and prompt, so looking at an unchanged screen again
+returns in milliseconds. --near N also accepts a cached answer for a
+screen whose perceptual hash is within N bits; --no-cache turns it off.
 
 Author: C64AIToolChain Project
 Date: December 2024
@@ -35,9 +43,13 @@ import sys
 import os
 import json
 import argparse
+import hashlib
+import struct
 from pathlib import Path
 from datetime import datetime
 
+from ai_toolchain import monitor_batch
+
 try:
     from ollama import Client
     HAS_OLLAMA = True
@@ -62,6 +74,11 @@ VICE_PORT = 6510
 HISTORY_FILE = '/tmp/vlm_look_history.json'
 MAX_HISTORY = 10
 
+# Response cache (see RESPONSE CACHE below); VLM_CACHE=0 disables it
+CACHE_DIR = os.environ.get('VLM_CACHE_DIR', '/tmp/vlm_look_cache')
+CACHE_ENABLED = os.environ.get('VLM_CACHE', '1') != '0'
+CACHE_NEAR = 0          # perceptual hash distance accepted as a hit (bits)
+
 # =============================================================================
 # PROMPTS - General C64 Screen Analysis
 # =============================================================================
@@ -258,6 +275,158 @@ def clear_history():
         pass
 
 
+# =============================================================================
+# RESPONSE CACHE - Same screen, same model, same prompt: same answer
+# =============================================================================
+#
+# CACHE_DIR/<key>.json holds one response. The key hashes the decoded
+# pixels of each image (not the PNG file, so encoder metadata does not
+# matter), the model and the prompt. index.json lists every entry with a
+# 64-bit difference hash per image for --near lookups, and stats.json
+# counts hits and misses.
+
+def image_pixels(image_path: str) -> bytes:
+    """Decoded RGB pixels of an image; PNG pixel chunks without Pillow."""
+    if HAS_PIL:
+        with Image.open(image_path) as img:
+            img = img.convert('RGB')
+            return struct.pack('>II', *img.size) + img.tobytes()
+    with open(image_path, 'rb') as f:
+        data = f.read()
+    if not data.startswith(b'\x89PNG'):
+        return data
+    # Without Pillow: IHDR + IDAT only, so tIME/tEXt chunks do not count
+    chunks, pos = [], 8
+    while pos + 8 <= len(data):
+        length, kind = struct.unpack('>I4s', data[pos:pos + 8])
+        if kind in (b'IHDR', b'PLTE', b'IDAT'):
+            chunks.append(data[pos + 8:pos + 8 + length])
+        pos += 12 + length
+    return b''.join(chunks)
+
+
+def perceptual_hash(image_path: str):
+    """64-bit difference hash (9x8 greyscale), or None without Pillow."""
+    if not HAS_PIL:
+        return None
+    with Image.open(image_path) as img:
+        grey = list(img.convert('L').resize((9, 8)).getdata())
+    bits = 0
+    for y in range(8):
+        for x in range(8):
+            bits = bits << 1 | (grey[y * 9 + x] > grey[y * 9 + x + 1])
+    return bits
+
+
+def _cache_file(name: str) -> str:
+    return os.path.join(CACHE_DIR, name)
+
+
+def _load_json(name: str, default):
+    try:
+        with open(_cache_file(name)) as f:
+            return json.load(f)
+    except (OSError, ValueError):
+        return default
+
+
+def _save_json(name: str, data):
+    os.makedirs(CACHE_DIR, exist_ok=True)
+    tmp = _cache_file(f"{name}.{os.getpid()}")
+    with open(tmp, 'w') as f:
+        json.dump(data, f)
+    os.replace(tmp, _cache_file(name))
+
+
+def _count(stat: str):
+    stats = _load_json('stats.json', {})
+    stats[stat] = stats.get(stat, 0) + 1
+    _save_json('stats.json', stats)
+
+
+def cache_key(image_paths: list, prompt: str, model: str) -> str:
+    """Content key: decoded pixels of each image, model and prompt."""
+    h = hashlib.sha256()
+    for part in [image_pixels(p) for p in image_paths] + [model, prompt]:
+        part = part if isinstance(part, bytes) else part.encode()
+        h.update(struct.pack('>I', len(part)) + part)
+    return h.hexdigest()
+
+
+def cached_call(image_paths: list, prompt: str, model: str,
+                call, verbose: bool = False) -> str:
+    """
+    Return call()'s response for these images, from the cache if possible.
+
+    Exact hits match the decoded pixels; with CACHE_NEAR > 0 an entry for
+    the same model and prompt whose images are all within CACHE_NEAR
+    bits of perceptual hash distance is also used. Error responses are
+    not stored.
+    """
+    if not CACHE_ENABLED:
+        return call()
+    start = time.time()
+    key = cache_key(image_paths, prompt, model)
+    entry = _load_json(f"{key}.json", None)
+    kind = 'hits'
+
+    if entry is None and CACHE_NEAR > 0 and HAS_PIL:
+        want = [perceptual_hash(p) for p in image_paths]
+        ask = hashlib.sha256(f"{model}\0{prompt}".encode()).hexdigest()
+        best = None
+        for other, info in _load_json('index.json', {}).items():
+            if info['ask'] != ask or len(info['phash']) != len(want):
+                continue
+            dist = max(bin(a ^ b).count('1') for a, b in zip(want, info['phash']))
+            if dist <= CACHE_NEAR and (best is None or dist < best[0]):
+                best = (dist, other)
+        if best:
+            entry = _load_json(f"{best[1]}.json", None)
+            kind = 'near_hits'
+
+    if entry is not None:
+        _count(kind)
+        if verbose:
+            label = 'near match' if kind == 'near_hits' else 'hit'
+            print(f"Cache {label} ({(time.time() - start) * 1000:.0f} ms)")
+        return entry['response']
+
+    _count('misses')
+    response = call()
+    if response.startswith('Error'):
+        return response
+    _save_json(f"{key}.json", {'model': model, 'prompt': prompt,
+                               'time': datetime.now().isoformat(),
+                               'response': response})
+    if HAS_PIL:
+        index = _load_json('index.json', {})
+        index[key] = {
+            'ask': hashlib.sha256(f"{model}\0{prompt}".encode()).hexdigest(),
+            'phash': [perceptual_hash(p) for p in image_paths]}
+        _save_json('index.json', index)
+    return response
+
+
+def cache_stats() -> dict:
+    """Hit/miss counters and the number of cached responses."""
+    stats = _load_json('stats.json', {})
+    stats.setdefault('hits', 0)
+    stats.setdefault('near_hits', 0)
+    stats.setdefault('misses', 0)
+    try:
+        stats['entries'] = sum(1 for n in os.listdir(CACHE_DIR)
+                               if len(n) == 69 and n.endswith('.json'))
+    except OSError:
+        stats['entries'] = 0
+    return stats
+
+
+def clear_cache():
+    """Delete every cached response and the counters."""
+    import shutil
+    shutil.rmtree(CACHE_DIR, ignore_errors=True)
+
+
 # =============================================================================
 # VLM ANALYSIS FUNCTIONS
 # =============================================================================
@@ -287,34 +456,37 @@ def analyze_with_ollama(image_path: str, prompt: str,
     if not os.path.exists(image_path):
         return f"Error: Image not found: {image_path}"
     
-    try:
-        client = get_ollama_client(host)
-        
-        if verbose:
-            print(f"Sending to {model} at {host or OLLAMA_HOST} for analysis...")
-        
-        # Use chat with image - ollama library handles base64 encoding
-        response = client.chat(
-            model=model,
-            messages=[
-                {
-                    'role': 'user',
-                    'content': prompt,
-                    'images': [image_path]  # ollama lib accepts file paths directly
-                }
-            ]
-        )
-        
-        return response['message']['content']
-        
-    except Exception as e:
-        error_msg = str(e)
-        if "connection" in error_msg.lower() or "refused" in error_msg.lower():
-            return f"Error: Cannot connect to Ollama at {host or OLLAMA_HOST}. Is Ollama running?"
-        elif "not found" in error_msg.lower():
-            return f"Error: Model '{model}' not found. Try: ollama pull {model}"
-        else:
-            return f"Error calling Ollama: {e}"
+    def call():
+        try:
+            client = get_ollama_client(host)
+            
+            if verbose:
+                print(f"Sending to {model} at {host or OLLAMA_HOST} for analysis...")
+            
+            # Use chat with image - ollama library handles base64 encoding
+            response = client.chat(
+                model=model,
+                messages=[
+                    {
+                        'role': 'user',
+                        'content': prompt,
+                        'images': [image_path]  # ollama lib accepts file paths directly
+                    }
+                ]
+            )
+            
+            return response['message']['content']
+            
+        except Exception as e:
+            error_msg = str(e)
+            if "connection" in error_msg.lower() or "refused" in error_msg.lower():
+                return f"Error: Cannot connect to Ollama at {host or OLLAMA_HOST}. Is Ollama running?"
+            elif "not found" in error_msg.lower():
+                return f"Error: Model '{model}' not found. Try: ollama pull {model}"
+            else:
+                return f"Error calling Ollama: {e}"
+    
+    return cached_call([image_path], prompt, model, call, verbose)
 
 
 def analyze_motion_with_ollama(image_paths: list, prompt: str,
@@ -342,35 +514,38 @@ def analyze_motion_with_ollama(image_paths: list, prompt: str,
         if not os.path.exists(path):
             return f"Error: Image not found: {path}"
     
-    try:
-        client = get_ollama_client(host)
-        
-        if verbose:
-            print(f"Analyzing {len(image_paths)} images with {model}...")
-            print(f"Images: {', '.join([os.path.basename(p) for p in image_paths])}")
-        
-        # Send multiple images in one request
-        response = client.chat(
-            model=model,
-            messages=[
-                {
-                    'role': 'user',
-                    'content': prompt,
-                    'images': image_paths  # Multiple images for motion analysis
-                }
-            ]
-        )
-        
-        return response['message']['content']
-        
-    except Exception as e:
-        error_msg = str(e)
-        if "connection" in error_msg.lower() or "refused" in error_msg.lower():
-            return f"Error: Cannot connect to Ollama at {host or OLLAMA_HOST}"
-        elif "not found" in error_msg.lower():
-            return f"Error: Model '{model}' not found. Try: ollama pull {model}"
-        else:
-            return f"Error calling Ollama: {e}"
+    def call():
+        try:
+            client = get_ollama_client(host)
+            
+            if verbose:
+                print(f"Analyzing {len(image_paths)} images with {model}...")
+                print(f"Images: {', '.join([os.path.basename(p) for p in image_paths])}")
+            
+            # Send multiple images in one request
+            response = client.chat(
+                model=model,
+                messages=[
+                    {
+                        'role': 'user',
+                        'content': prompt,
+                        'images': image_paths  # Multiple images for motion analysis
+                    }
+                ]
+            )
+            
+            return response['message']['content']
+            
+        except Exception as e:
+            error_msg = str(e)
+            if "connection" in error_msg.lower() or "refused" in error_msg.lower():
+                return f"Error: Cannot connect to Ollama at {host or OLLAMA_HOST}"
+            elif "not found" in error_msg.lower():
+                return f"Error: Model '{model}' not found. Try: ollama pull {model}"
+            else:
+                return f"Error calling Ollama: {e}"
+    
+    return cached_call(image_paths, prompt, model, call, verbose)
 
 
 def list_ollama_models(host: str = None) -> list:
@@ -611,26 +786,31 @@ def compare_screenshots(image1: str, image2: str = None,
     if not HAS_OLLAMA:
         return "Error: ollama library required"
     
+    model = model or DEFAULT_MODEL
+    
+    def call():
+        try:
+            client = get_ollama_client(host)
+            
+            # Send both images for comparison
+            response = client.chat(
+                model=model,
+                messages=[
+                    {
+                        'role': 'user',
+                        'content': COMPARE_PROMPT,
+                        'images': [image1, image2]
+                    }
+                ]
+            )
+            
+            return response['message']['content']
+            
+        except Exception as e:
+            return f"Error comparing images: {e}"
+    
     try:
-        client = get_ollama_client(host)
-        model = model or DEFAULT_MODEL
-        
-        # Send both images for comparison
-        response = client.chat(
-            model=model,
-            messages=[
-                {
-                    'role': 'user',
-                    'content': COMPARE_PROMPT,
-                    'images': [image1, image2]
-                }
-            ]
-        )
-        
-        return response['message']['content']
-        
-    except Exception as e:
-        return f"Error comparing images: {e}"
+        return cached_call([image1, image2], COMPARE_PROMPT, model, call)
     finally:
         if temp_file:
             try:
@@ -639,20 +819,306 @@ def compare_screenshots(image1: str, image2: str = None,
                 pass
 
 
+# =============================================================================
+# CHANGE DETECTION - Decide whether a frame is worth a model call
+# =============================================================================
+#
+# watch_game() and analyze_motion() capture, with every screenshot, the
+# VIC-II registers, screen RAM and colour RAM. Consecutive frames are
+# compared three ways: screenshot pixels mapped to C64 palette indices
+# (8x8 cell diff, merged into bounding boxes), screen/colour RAM cells
+# and sprite registers. Then:
+#   skip  nothing changed: the last observation still holds
+#   text  only sprites moved and/or a few cells changed: the structured
+#         diff is the observation, no model call
+#   crop  changes fit in a small region: only that region, upscaled,
+#         goes to the model
+#   full  everything else
+
+C64_PALETTE = [
+    (0x00, 0x00, 0x00), (0xFF, 0xFF, 0xFF), (0x88, 0x00, 0x00), (0xAA, 0xFF, 0xEE),
+    (0xCC, 0x44, 0xCC), (0x00, 0xCC, 0x55), (0x00, 0x00, 0xAA), (0xEE, 0xEE, 0x77),
+    (0xDD, 0x88, 0x55), (0x66, 0x44, 0x00), (0xFF, 0x77, 0x77), (0x33, 0x33, 0x33),
+    (0x77, 0x77, 0x77), (0xAA, 0xFF, 0x66), (0x00, 0x88, 0xFF), (0xBB, 0xBB, 0xBB),
+]
+COLOR_NAMES = ['black', 'white', 'red', 'cyan', 'purple', 'green', 'blue',
+               'yellow', 'orange', 'brown', 'light red', 'dark grey', 'grey',
+               'light green', 'light blue', 'light grey']
+
+TEXT_MAX_CELLS = 40      # more changed cells than this need the model
+CROP_MAX_AREA = 0.5      # a change box above this share of the frame: full
+CROP_MIN_SIDE = 160      # crops are upscaled to at least this many pixels
+
+
+def _read_saved(path: str, size: int) -> bytes:
+    """Data of a monitor save (load address stripped), once it is all there."""
+    for _ in range(40):
+        try:
+            with open(path, 'rb') as f:
+                data = f.read()[2:]
+            if len(data) >= size:
+                return data[:size]
+        except OSError:
+            pass
+        time.sleep(0.025)
+    raise OSError(f"monitor did not save {os.path.basename(path)}")
+
+
+def capture_frame(image_path: str) -> dict:
+    """
+    Screenshot plus machine state in one monitor session.
+
+    Returns:
+        {'image': path or None, 'vic': 47 bytes ($D000-$D02E),
+         'screen': 1000 bytes, 'color': 1000 bytes} (state None on failure)
+    """
+    import tempfile
+    image_path = os.path.abspath(image_path)
+    tmp = tempfile.mkdtemp(prefix='vlm_frame_')
+    vic_file, cia_file = os.path.join(tmp, 'vic'), os.path.join(tmp, 'cia')
+    frame = {'image': None, 'vic': None, 'screen': None, 'color': None}
+    try:
+        sock = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+        sock.settimeout(3.0)
+        sock.connect(('localhost', VICE_PORT))
+        sock.settimeout(0.2)
+        try:
+            sock.recv(1024)             # prompt shown on connect
+        except socket.timeout:
+            pass
+        monitor_batch(sock, [f's "{vic_file}" 0 d000 d02e', f's "{cia_file}" 0 dd00 dd00'],
+                      timeout=3.0)
+        vic = _read_saved(vic_file, 47)
+        cia = _read_saved(cia_file, 1)
+        # Screen RAM from the VIC bank ($DD00) and $D018
+        screen = (3 - (cia[0] & 3)) * 0x4000 + (vic[0x18] >> 4) * 0x400
+        scr_file, col_file = os.path.join(tmp, 'scr'), os.path.join(tmp, 'col')
+        monitor_batch(sock, [f's "{scr_file}" 0 {screen:04x} {screen + 999:04x}',
+                             f's "{col_file}" 0 d800 dbe7',
+                             f'screenshot "{image_path}" 2'], timeout=3.0)
+        sock.close()
+        frame['screen'] = _read_saved(scr_file, 1000)
+        frame['color'] = bytes(c & 0x0F for c in _read_saved(col_file, 1000))
+        frame['vic'] = vic
+    except OSError as e:
+        print(f"Warning: machine state not captured: {e}")
+    finally:
+        import shutil
+        shutil.rmtree(tmp, ignore_errors=True)
+    for _ in range(20):
+        if os.path.exists(image_path):
+            frame['image'] = image_path
+            break
+        time.sleep(0.05)
+    return frame
+
+
+def palette_indices(image_path: str):
+    """(width, height, one C64 colour index per pixel), or None."""
+    if not HAS_PIL or not image_path:
+        return None
+    with Image.open(image_path) as img:
+        img = img.convert('RGB')
+        size = img.size
+        nearest = {}
+        out = bytearray()
+        for rgb in img.getdata():
+            idx = nearest.get(rgb)
+            if idx is None:
+                idx = min(range(16), key=lambda i: sum(
+                    (a - b) ** 2 for a, b in zip(rgb, C64_PALETTE[i])))
+                nearest[rgb] = idx
+            out.append(idx)
+    return size[0], size[1], bytes(out)
+
+
+def changed_boxes(a, b, cell: int = 8) -> list:
+    """
+    Bounding boxes (x0, y0, x1, y1) of changed 8x8 cells between two
+    palette-indexed frames; cells touching (diagonals too) share a box.
+    """
+    if not a or not b or a[:2] != b[:2]:
+        return []
+    w, h = a[0], a[1]
+    cols, rows = (w + cell - 1) // cell, (h + cell - 1) // cell
+    dirty = set()
+    pa, pb = a[2], b[2]
+    for y in range(h):
+        row = y * w
+        if pa[row:row + w] == pb[row:row + w]:
+            continue
+        for x in range(w):
+            if pa[row + x] != pb[row + x]:
+                dirty.add((x // cell, y // cell))
+    boxes = []
+    while dirty:
+        stack = [dirty.pop()]
+        x0 = x1 = stack[0][0]
+        y0 = y1 = stack[0][1]
+        while stack:
+            cx, cy = stack.pop()
+            x0, x1, y0, y1 = min(x0, cx), max(x1, cx), min(y0, cy), max(y1, cy)
+            for dx in (-1, 0, 1):
+                for dy in (-1, 0, 1):
+                    n = (cx + dx, cy + dy)
+                    if n in dirty:
+                        dirty.remove(n)
+                        stack.append(n)
+        boxes.append((x0 * cell, y0 * cell, min((x1 + 1) * cell, w),
+                      min((y1 + 1) * cell, h)))
+    return sorted(boxes)
+
+
+def sprite_state(vic: bytes) -> list:
+    """Per sprite: enabled, 9-bit x, y and colour from $D000-$D02E."""
+    return [{'on': bool(vic[0x15] >> i & 1),
+             'x': vic[i * 2] | (vic[0x10] >> i & 1) << 8,
+             'y': vic[i * 2 + 1],
+             'color': vic[0x27 + i] & 0x0F} for i in range(8)]
+
+
+def _screen_text(codes) -> str:
+    """Screen codes as readable text (letters, digits, punctuation)."""
+    out = ''
+    for c in codes:
+        c &= 0x7F
+        out += chr(c + 64) if 1 <= c <= 26 else chr(c) if 32 <= c < 64 else \
+            '@' if c == 0 else '.'
+    return out
+
+
+def structured_diff(prev: dict, cur: dict) -> dict:
+    """Sprite, cell and VIC setup changes between two captured frames."""
+    if not prev.get('vic') or not cur.get('vic'):
+        return None
+    diff = {'sprites': [], 'rows': [], 'cells': 0, 'colors': 0, 'setup': []}
+    for i, (a, b) in enumerate(zip(sprite_state(prev['vic']),
+                                   sprite_state(cur['vic']))):
+        if a != b:
+            diff['sprites'].append((i, a, b))
+    for row in range(25):
+        s = slice(row * 40, row * 40 + 40)
+        if prev['screen'][s] != cur['screen'][s]:
+            diff['rows'].append((row, prev['screen'][s], cur['screen'][s]))
+    diff['cells'] = sum(a != b for a, b in zip(prev['screen'], cur['screen']))
+    diff['colors'] = sum(a != b for a, b in zip(prev['color'], cur['color']))
+    for reg, name in ((0x11, 'control 1'), (0x16, 'control 2'),
+                      (0x18, 'memory setup'), (0x20, 'border'),
+                      (0x21, 'background')):
+        a, b = prev['vic'][reg], cur['vic'][reg]
+        if reg == 0x11:
+            a, b = a & 0x7F, b & 0x7F     # bit 7 is the raster line
+        if reg >= 0x20:
+            a, b = a & 0x0F, b & 0x0F
+        if a != b:
+            diff['setup'].append((name, a, b))
+    return diff
+
+
+def describe_diff(diff: dict) -> str:
+    """Structured diff as short text an agent (or model) can read."""
+    lines = []
+    for i, a, b in diff['sprites']:
+        if a['on'] != b['on']:
+            lines.append(f"Sprite {i} {'appeared' if b['on'] else 'disappeared'}"
+                         f" at ({b['x']},{b['y']}), {COLOR_NAMES[b['color']]}")
+        elif b['on']:
+            what = []
+            if (a['x'], a['y']) != (b['x'], b['y']):
+                what.append(f"moved ({a['x']},{a['y']}) -> ({b['x']},{b['y']}), "
+                            f"dx={b['x'] - a['x']:+d} dy={b['y'] - a['y']:+d}")
+            if a['color'] != b['color']:
+                what.append(f"colour {COLOR_NAMES[a['color']]} -> "
+                            f"{COLOR_NAMES[b['color']]}")
+            lines.append(f"Sprite {i} " + ', '.join(what))
+    for row, a, b in diff['rows']:
+        lines.append(f"Row {row:2d}: '{_screen_text(a).rstrip()}' -> "
+                     f"'{_screen_text(b).rstrip()}'")
+    if diff['colors']:
+        lines.append(f"{diff['colors']} colour RAM cells changed")
+    for name, a, b in diff['setup']:
+        lines.append(f"VIC {name}: ${a:02X} -> ${b:02X}")
+    return '\n'.join(lines) if lines else "No change."
+
+
+def prefilter(prev: dict, cur: dict) -> tuple:
+    """
+    Decide what a frame needs, compared with the previous one.
+
+    Returns:
+        ('skip', None), ('text', description), ('crop', box) or
+        ('full', None); box is (x0, y0, x1, y1) in screenshot pixels
+    """
+    if prev is None:
+        return 'full', None
+    diff = structured_diff(prev, cur)
+    pa = prev.get('pixels')
+    pb = cur.get('pixels')
+    boxes = changed_boxes(pa, pb) if pa and pb else None
+
+    if diff is not None:
+        quiet = not (diff['sprites'] or diff['cells'] or diff['colors']
+                     or diff['setup'])
+        if quiet and not boxes:
+            return 'skip', None
+        if not diff['setup'] and diff['cells'] <= TEXT_MAX_CELLS \
+                and diff['colors'] <= TEXT_MAX_CELLS:
+            return 'text', describe_diff(diff)
+    elif boxes == []:
+        return 'skip', None
+
+    if boxes:
+        box = (min(b[0] for b in boxes), min(b[1] for b in boxes),
+               max(b[2] for b in boxes), max(b[3] for b in boxes))
+        w, h = pb[0], pb[1]
+        if (box[2] - box[0]) * (box[3] - box[1]) <= CROP_MAX_AREA * w * h:
+            return 'crop', box
+    return 'full', None
+
+
+def crop_patch(image_path: str, box: tuple, out_path: str) -> str:
+    """Crop box out of a screenshot, upscaled (nearest) for the model."""
+    with Image.open(image_path) as img:
+        patch = img.crop(box)
+        scale = max(1, -(-CROP_MIN_SIDE // min(patch.size)))
+        patch = patch.resize((patch.size[0] * scale, patch.size[1] * scale),
+                             Image.NEAREST)
+        patch.save(out_path)
+    return out_path
+
+
+def crop_prompt(prompt: str, box: tuple, previous: str = None) -> str:
+    """Prompt for a cropped patch: where it is and what was there before."""
+    text = (f"This image is only the part of the C64 screen that changed, "
+            f"pixels ({box[0]},{box[1]})-({box[2]},{box[3]}) of the "
+            f"screenshot, enlarged. Describe what changed there.\n\n{prompt}")
+    if previous:
+        text += f"\n\nLast observation of the whole screen (its latest part):\n{previous[-1500:]}"
+    return text
+
+
 def watch_game(interval: float = 2.0, count: int = 5, game: str = None,
-               host: str = None, model: str = None) -> list:
+               host: str = None, model: str = None,
+               use_prefilter: bool = True) -> list:
     """
     Watch the game over time, capturing multiple observations.
     
+    With use_prefilter each frame first goes through prefilter(): frames
+    where nothing changed reuse the last observation, small changes are
+    reported as a structured diff, and local changes send only the
+    changed region to the model.
+    
     Args:
         interval: Seconds between captures
         count: Number of observations to make
         game: Game type for optimized prompts
         host: Ollama host URL
         model: Model name
+        use_prefilter: Skip or shrink model calls using change detection
         
     Returns:
-        List of observations with timestamps
+        List of observations with timestamps; 'mode' says how each was
+        made ('full', 'crop', 'text' or 'skip')
         
     Example:
         >>> observations = watch_game(interval=1.0, count=3, game='snake')
@@ -661,19 +1127,50 @@ def watch_game(interval: float = 2.0, count: int = 5, game: str = None,
     """
     observations = []
     prompt = GAME_PROMPTS.get(game, GAME_PROMPTS['generic']) if game else DEFAULT_PROMPT
+    prompt = prompt or DEFAULT_PROMPT
+    prev = None
+    last = None
     
     for i in range(count):
         print(f"Observation {i+1}/{count}...")
         
-        result = look_with_vlm(prompt=prompt, model=model, host=host, verbose=False)
+        if not use_prefilter:
+            result = look_with_vlm(prompt=prompt, model=model, host=host, verbose=False)
+            mode = 'full'
+        else:
+            image = f"/tmp/vlm_watch_{i % 2}.png"
+            frame = capture_frame(image)
+            if not frame['image']:
+                result, mode = "Error: Failed to capture screenshot", 'full'
+            else:
+                frame['pixels'] = palette_indices(frame['image'])
+                mode, detail = prefilter(prev, frame)
+                if last is None or last.startswith('Error'):
+                    mode = 'full'
+                if mode == 'skip':
+                    result = last
+                elif mode == 'text':
+                    result = detail
+                elif mode == 'crop':
+                    patch = crop_patch(frame['image'], detail, '/tmp/vlm_watch_crop.png')
+                    result = analyze_with_ollama(patch, crop_prompt(prompt, detail, last),
+                                                 model, host, verbose=False)
+                else:
+                    result = analyze_with_ollama(frame['image'], prompt, model, host,
+                                                 verbose=False)
+                if mode in ('full', 'crop'):
+                    last = result if mode == 'full' else f"{last}\n\nUpdate: {result}"
+                prev = frame
         
         observations.append({
             'index': i + 1,
             'time': datetime.now().isoformat(),
-            'observation': result
+            'observation': result,
+            'mode': mode
         })
         
-        add_to_history(result, game=game)
+        if mode != 'skip':
+            add_to_history(result, game=game)
         
         if i < count - 1:
             time.sleep(interval)
@@ -697,7 +1194,8 @@ Be specific about what's moving and how. Use terms like "moving right", "station
 
 
 def analyze_motion(interval: float = 0.5, count: int = 3, game: str = None,
-                   host: str = None, model: str = "gemma3") -> str:
+                   host: str = None, model: str = "gemma3",
+                   use_prefilter: bool = True) -> str:
     """
     Capture multiple screenshots and analyze motion using multi-image VLM.
     Uses Gemma 3 by default for multi-image understanding.
@@ -708,6 +1206,8 @@ def analyze_motion(interval: float = 0.5, count: int = 3, game: str = None,
         game: Game type for context
         host: Ollama host URL
         model: Model name (gemma3 recommended)
+        use_prefilter: Answer from frame diffs when they are enough, and
+            send only the changed region otherwise
         
     Returns:
         Motion analysis description
@@ -722,9 +1222,18 @@ def analyze_motion(interval: float = 0.5, count: int = 3, game: str = None,
     
     # Capture multiple screenshots
     image_paths = []
+    frames = []
     for i in range(count):
         path = f"/tmp/motion_frame_{i}.png"
-        if take_vice_screenshot(path):
+        if use_prefilter:
+            frame = capture_frame(path)
+            ok = frame['image'] is not None
+            if ok:
+                frame['pixels'] = palette_indices(path)
+                frames.append(frame)
+        else:
+            ok = take_vice_screenshot(path)
+        if ok:
             image_paths.append(path)
             print(f"  Frame {i+1}/{count} captured")
         else:
@@ -736,6 +1245,27 @@ def analyze_motion(interval: float = 0.5, count: int = 3, game: str = None,
     if len(image_paths) < 2:
         return "Error: Need at least 2 frames for motion analysis"
     
+    # Change detection: static screens and plain sprite/text motion need
+    # no model; local changes only send the region that changed
+    if use_prefilter:
+        steps = [prefilter(a, b) for a, b in zip(frames, frames[1:])]
+        modes = {m for m, _ in steps}
+        if modes == {'skip'}:
+            return f"No motion: the screen did not change over {len(frames)} frames."
+        if modes <= {'skip', 'text'}:
+            return '\n'.join(f"Frame {i + 1} -> {i + 2}:\n" +
+                             (d if m == 'text' else "No change.")
+                             for i, (m, d) in enumerate(steps))
+        if modes <= {'skip', 'text', 'crop'}:
+            boxes = [d for m, d in steps if m == 'crop']
+            box = (min(b[0] for b in boxes), min(b[1] for b in boxes),
+                   max(b[2] for b in boxes), max(b[3] for b in boxes))
+            w, h = frames[0]['pixels'][:2]
+            if (box[2] - box[0]) * (box[3] - box[1]) <= CROP_MAX_AREA * w * h:
+                image_paths = [crop_patch(p, box, f"/tmp/motion_crop_{i}.png")
+                               for i, p in enumerate(image_paths)]
+                print(f"Sending only the changed region {box}")
+    
     # Build the prompt
     prompt = MOTION_PROMPT.format(count=len(image_paths), interval=interval)
     
@@ -751,7 +1281,7 @@ def analyze_motion(interval: float = 0.5, count: int = 3, game: str = None,
     result = analyze_motion_with_ollama(image_paths, prompt, model=model, host=host)
     
     # Cleanup temp files
-    for path in image_paths:
+    for path in image_paths + [f"/tmp/motion_frame_{i}.png" for i in range(count)]:
         try:
             os.remove(path)
         except:
@@ -781,6 +1311,8 @@ Examples:
   %(prog)s --model llava                # Use LLaVA model
   %(prog)s --existing game.png          # Analyze existing image
   %(prog)s --list-models                # Show available models
+  %(prog)s --cache-stats                # Response cache hits and misses
+  %(prog)s --near 4                     # Reuse answers for near-identical screens
 
 Environment:
   OLLAMA_HOST    Ollama server URL (default: http://192.168.1.62:11434)
@@ -833,15 +1365,35 @@ For AI Agent Integration:
                         help='Capture FRAMES and analyze motion with gemma3')
     parser.add_argument('--motion-interval', type=float, default=0.5,
                         help='Interval between motion frames (default: 0.5)')
+    parser.add_argument('--no-prefilter', action='store_true',
+                        help='Watch/motion: send every frame to the model, '
+                             'without change detection')
     parser.add_argument('--history', action='store_true',
                         help='Show recent observation history')
     parser.add_argument('--clear-history', action='store_true',
                         help='Clear observation history')
     parser.add_argument('--list-models', '-l', action='store_true',
                         help='List available Ollama models')
+    parser.add_argument('--state', metavar='PROJECT',
+                        help='JSON game state read from RAM by symbol, no VLM '
+                             '(game_state.py: pacman, tetris_v1/v2, snake, '
+                             'snake2, invaders)')
+    parser.add_argument('--no-cache', action='store_true',
+                        help='Always ask the model, never the response cache')
+    parser.add_argument('--near', type=int, default=0, metavar='BITS',
+                        help='Accept cached answers for screens within BITS '
+                             'of perceptual hash distance (needs Pillow)')
+    parser.add_argument('--cache-stats', action='store_true',
+                        help='Show response cache hits, misses and size')
+    parser.add_argument('--clear-cache', action='store_true',
+                        help='Delete all cached responses')
     
     args = parser.parse_args()
     
+    global CACHE_ENABLED, CACHE_NEAR
+    CACHE_ENABLED = CACHE_ENABLED and not args.no_cache
+    CACHE_NEAR = args.near
+    
     # --- Handle utility commands first ---
     
     # List models
@@ -878,6 +1430,31 @@ For AI Agent Integration:
         print("History cleared.")
         return 0
     
+    # Response cache
+    if args.cache_stats:
+        stats = cache_stats()
+        looks = stats['hits'] + stats['near_hits'] + stats['misses']
+        rate = 100.0 * (stats['hits'] + stats['near_hits']) / looks if looks else 0.0
+        print(f"Response cache: {CACHE_DIR}")
+        print(f"  entries:   {stats['entries']}")
+        print(f"  hits:      {stats['hits']}")
+        print(f"  near hits: {stats['near_hits']}")
+        print(f"  misses:    {stats['misses']}")
+        print(f"  hit rate:  {rate:.0f}%")
+        return 0
+    
+    if args.clear_cache:
+        clear_cache()
+        print("Cache cleared.")
+        return 0
+    
+    # Symbolic state: no model needed
+    if args.state:
+        from game_state import look_state
+        result = look_state(args.state)
+        print(json.dumps(result, indent=2))
+        return 0 if 'error' not in result else 1
+    
     # Check dependencies
     if not HAS_OLLAMA:
         print("Error: ollama library required. Install with: pip install ollama")
@@ -908,7 +1485,8 @@ For AI Agent Integration:
             count=args.motion,
             game=args.game,
             host=args.host,
-            model="gemma3"  # Gemma 3 for multi-image
+            model="gemma3",  # Gemma 3 for multi-image
+            use_prefilter=not args.no_prefilter
         )
         print("\n" + "="*60)
         print("MOTION ANALYSIS (Gemma 3)")
@@ -925,13 +1503,18 @@ For AI Agent Integration:
             count=args.watch,
             game=args.game,
             host=args.host,
-            model=args.model
+            model=args.model,
+            use_prefilter=not args.no_prefilter
         )
+        modes = [obs['mode'] for obs in observations]
         print("\n" + "="*60)
-        print(f"WATCH RESULTS ({len(observations)} observations)")
+        print(f"WATCH RESULTS ({len(observations)} observations, "
+              f"{modes.count('full') + modes.count('crop')} model calls: "
+              f"{modes.count('crop')} cropped; {modes.count('text')} text diffs, "
+              f"{modes.count('skip')} unchanged)")
         print("="*60)
         for obs in observations:
-            print(f"\n--- Observation {obs['index']} [{obs['time'][:19]}] ---")
+            print(f"\n--- Observation {obs['index']} [{obs['time'][:19]}] ({obs['mode']}) ---")
             print(obs['observation'][:500])
             if len(obs['observation']) > 500:
                 print("...")
@@ -0,0 +1,99 @@
+#!/usr/bin/env python3
+"""
+vlm_stub.py - Offline stand-in for the Ollama server used by vlm_look.py
+
+Answers the two Ollama endpoints vlm_look.py uses, /api/chat and
+/api/tags, without any model: the reply names the prompt and a hash of
+each image, so identical screens get identical answers. JSON prompts get
+a JSON object back. An optional delay imitates a real model's latency,
+which makes the response cache easy to check:
+
+Usage:
+    python3 vlm_stub.py --delay 5 &
+    OLLAMA_HOST=http://localhost:11435 python3 vlm_look.py -e shot.png
+    OLLAMA_HOST=http://localhost:11435 python3 vlm_look.py -e shot.png  # cached
+    python3 vlm_look.py --cache-stats
+
+Author: C64AIToolChain Project
+"""
+
+import argparse
+import base64
+import hashlib
+import json
+import time
+from datetime import datetime, timezone
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+
+DEFAULT_PORT = 11435    # next to Ollama's 11434, so both can run
+
+
+class StubHandler(BaseHTTPRequestHandler):
+    delay = 0.0
+    calls = 0
+
+    def reply(self, body):
+        data = json.dumps(body).encode()
+        self.send_response(200)
+        self.send_header('Content-Type', 'application/json')
+        self.send_header('Content-Length', str(len(data)))
+        self.end_headers()
+        self.wfile.write(data)
+
+    def do_GET(self):
+        if self.path == '/api/tags':
+            self.reply({'models': [{'name': 'stub-vl', 'model': 'stub-vl'}]})
+        else:
+            self.send_error(404)
+
+    def do_POST(self):
+        if self.path != '/api/chat':
+            self.send_error(404)
+            return
+        length = int(self.headers.get('Content-Length', 0))
+        request = json.loads(self.rfile.read(length) or b'{}')
+        message = (request.get('messages') or [{}])[-1]
+        images = [hashlib.sha256(base64.b64decode(i)).hexdigest()[:12]
+                  for i in message.get('images') or []]
+        prompt = message.get('content', '')
+
+        time.sleep(self.delay)
+        StubHandler.calls += 1
+        if 'JSON' in prompt:
+            content = json.dumps({'screen_type': 'game', 'state': 'running',
+                                  'text_content': [], 'sprites': [],
+                                  'visual_issues': [],
+                                  'additional_observations': ' '.join(images)})
+        else:
+            content = (f"Stub analysis #{StubHandler.calls} of "
+                       f"{len(images)} image(s) {' '.join(images)} for prompt "
+                       f"{hashlib.sha256(prompt.encode()).hexdigest()[:8]}.")
+        self.reply({
+            'model': request.get('model', 'stub-vl'),
+            'created_at': datetime.now(timezone.utc).isoformat(),
+            'message': {'role': 'assistant', 'content': content},
+            'done': True,
+        })
+
+    def log_message(self, fmt, *args):
+        pass
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Offline Ollama stand-in')
+    parser.add_argument('--port', type=int, default=DEFAULT_PORT)
+    parser.add_argument('--delay', type=float, default=0.0,
+                        help='Seconds to wait per chat request')
+    args = parser.parse_args()
+
+    StubHandler.delay = args.delay
+    server = ThreadingHTTPServer(('127.0.0.1', args.port), StubHandler)
+    print(f"VLM stub on http://localhost:{args.port} (delay {args.delay}s)")
+    try:
+        server.serve_forever()
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == '__main__':
+    main()